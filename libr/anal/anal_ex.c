@@ -315,7 +315,7 @@ R_API void r_anal_ex_op_to_bb(RAnal *anal, RAnalState *state, RAnalBlock *bb, RA
 	bb->fail = op->fail;
 	bb->jump = op->jump;
 
-	bb->conditional = R_ANAL_EX_COND_OP & op->type2 ? R_ANAL_OP_TYPE_COND : 0;
+	bb->conditional = (R_ANAL_EX_COND_OP & op->type2) != 0;
 	if (r_anal_op_is_eob (op)) {
 		bb->type |= R_ANAL_BB_TYPE_LAST;
 	}
@@ -21,8 +21,9 @@ R_API RAnalBlock *r_anal_bb_new() {
 	bb->fingerprint = NULL;
 	bb->diff = NULL; //r_anal_diff_new ();
 	bb->label = NULL;
-	bb->op_pos = R_NEWS0 (ut16, DFLT_NINSTR);
-	bb->op_pos_size = DFLT_NINSTR;
+	// most blocks are small, op_pos is allocated by r_anal_bb_set_offset
+	bb->op_pos = NULL;
+	bb->op_pos_size = 0;
 	bb->parent_reg_arena = NULL;
 	bb->stackptr = 0;
 	bb->parent_stackptr = INT_MAX;
@@ -265,12 +266,13 @@ R_API ut64 r_anal_bb_opaddr_i(RAnalBlock *bb, int i) {
 R_API bool r_anal_bb_set_offset(RAnalBlock *bb, int i, ut16 v) {
 	// the offset 0 of the instruction 0 is not stored because always 0
 	if (i > 0 && v > 0) {
-		if (i >= bb->op_pos_size) {
-			int new_pos_size = i * 2;
+		if (i > bb->op_pos_size) {
+			int new_pos_size = R_MAX (i * 2, DFLT_NINSTR);
 			ut16 *tmp_op_pos = realloc (bb->op_pos, new_pos_size * sizeof (*bb->op_pos));
 			if (!tmp_op_pos) {
 				return false;
 			}
+			memset (tmp_op_pos + bb->op_pos_size, 0, (new_pos_size - bb->op_pos_size) * sizeof (*bb->op_pos));
 			bb->op_pos_size = new_pos_size;
 			bb->op_pos = tmp_op_pos;
 		}
@@ -0,0 +1,6 @@
+/* radare2 - LGPL - Copyright 2026 - agent */
+
+/* the anal plugins use the capstone linked in libr_anal, keep their
+ * engines apart from the ones in libr_asm */
+#define CS_CACHE(x) r_anal_cs_##x
+#include "../asm/cs_cache.c"
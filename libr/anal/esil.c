@@ -2885,12 +2885,11 @@ static int evalWord(RAnalEsil *esil, const char *ostr, const char **str) {
 	return 3;
 }
 
-R_API int r_anal_esil_parse(RAnalEsil *esil, const char *str) {
+static int esil_parse(RAnalEsil *esil, const char *str) {
 	int wordi = 0;
 	int dorunword;
 	char word[64];
 	const char *ostr = str;
-	r_return_val_if_fail (esil && R_STR_ISNOTEMPTY (str), 0);
 
 	if (esil->cmd_step) {
 		if (esil->cmd (esil, esil->cmd_step, esil->address, 0)) {
@@ -2975,6 +2974,14 @@ repeat:
 	return 1;
 }
 
+R_API int r_anal_esil_parse(RAnalEsil *esil, const char *str) {
+	r_return_val_if_fail (esil && R_STR_ISNOTEMPTY (str), 0);
+	R_PROF_BEGIN (esil_parse);
+	int ret = esil_parse (esil, str);
+	R_PROF_END (esil_parse);
+	return ret;
+}
+
 R_API int r_anal_esil_runword(RAnalEsil *esil, const char *word) {
 	const char *str = NULL;
 	runword (esil, word);
@@ -3,14 +3,16 @@
 #include <r_anal.h>
 
 #define DB esil->db_trace
-#define KEY(x) sdb_fmt ("%d."x, esil->trace_idx)
-#define KEYAT(x,y) sdb_fmt ("%d."x".0x%"PFMT64x, esil->trace_idx, y)
-#define KEYREG(x,y) sdb_fmt ("%d."x".%s", esil->trace_idx, y)
+/* these need a r_strf_buffer in the calling function */
+#define KEY(x) r_strf ("%d."x, esil->trace_idx)
+#define KEYAT(x,y) r_strf ("%d."x".0x%"PFMT64x, esil->trace_idx, y)
+#define KEYREG(x,y) r_strf ("%d."x".%s", esil->trace_idx, y)
 
 static int ocbs_set = false;
 static RAnalEsilCallbacks ocbs = {0};
 
 static int trace_hook_reg_read(RAnalEsil *esil, const char *name, ut64 *res, int *size) {
+	r_strf_buffer (64);
 	int ret = 0;
 	if (*name == '0') {
 		//eprintf ("Register not found in profile\n");
@@ -37,6 +39,7 @@ static int trace_hook_reg_read(RAnalEsil *esil, const char *name, ut64 *res, int
 }
 
 static int trace_hook_reg_write(RAnalEsil *esil, const char *name, ut64 *val) {
+	r_strf_buffer (64);
 	int ret = 0;
 	//eprintf ("[ESIL] REG WRITE %s 0x%08"PFMT64x"\n", name, *val);
 	sdb_array_add (DB, KEY ("reg.write"), name, 0);
@@ -51,6 +54,7 @@ static int trace_hook_reg_write(RAnalEsil *esil, const char *name, ut64 *val) {
 }
 
 static int trace_hook_mem_read(RAnalEsil *esil, ut64 addr, ut8 *buf, int len) {
+	r_strf_buffer (64);
 	char *hexbuf = calloc ((1 + len), 4);
 	int ret = 0;
 	if (esil->cb.mem_read) {
@@ -72,6 +76,7 @@ static int trace_hook_mem_read(RAnalEsil *esil, ut64 addr, ut8 *buf, int len) {
 }
 
 static int trace_hook_mem_write(RAnalEsil *esil, ut64 addr, const ut8 *buf, int len) {
+	r_strf_buffer (64);
 	int ret = 0;
 	char *hexbuf = malloc ((1+len)*3);
 	sdb_array_add_num (DB, KEY ("mem.write"), addr, 0);
@@ -90,6 +95,7 @@ static int trace_hook_mem_write(RAnalEsil *esil, ut64 addr, const ut8 *buf, int
 }
 
 R_API void r_anal_esil_trace (RAnalEsil *esil, RAnalOp *op) {
+	r_strf_buffer (64);
 	if (!esil || !op) {
 		return;
 	}
@@ -143,6 +149,7 @@ R_API void r_anal_esil_trace_list (RAnalEsil *esil) {
 }
 
 R_API void r_anal_esil_trace_show(RAnalEsil *esil, int idx) {
+	r_strf_buffer (64);
 	PrintfCallback p = esil->anal->cb_printf;
 	const char *str2;
 	const char *str;
@@ -372,14 +372,9 @@ R_API RAnalFunction *r_anal_fcn_new() {
 	if (!fcn) {
 		return NULL;
 	}
-	/* Function return type */
-	fcn->rets = 0;
 	fcn->_size = 0;
-	/* Function qualifier: static/volatile/inline/naked/virtual */
-	fcn->fmod = R_ANAL_FQUALIFIER_NONE;
 	/* Function calling convention: cdecl/stdcall/fastcall/etc */
 	fcn->cc = NULL;
-	/* Function attributes: weak/noreturn/format/etc */
 	fcn->addr = UT64_MAX;
 	fcn->fcn_locs = NULL;
 	fcn->bbs = r_anal_bb_list_new ();
@@ -403,7 +398,6 @@ R_API void r_anal_fcn_free(void *_fcn) {
 	}
 	fcn->_size = 0;
 	free (fcn->name);
-	free (fcn->attr);
 	r_tinyrange_fini (&fcn->bbr);
 	r_list_free (fcn->fcn_locs);
 	if (fcn->bbs) {
@@ -413,7 +407,6 @@ R_API void r_anal_fcn_free(void *_fcn) {
 	}
 	free (fcn->fingerprint);
 	r_anal_diff_free (fcn->diff);
-	free (fcn->args);
 	free (fcn);
 }
 
@@ -833,8 +826,8 @@ static bool try_get_jmptbl_info(RAnal *anal, RAnalFunction *fcn, ut64 addr, RAna
 	anal->iob.read_at (anal->iob.io, prev_bb->addr, (ut8 *) bb_buf, prev_bb->size);
 	isValid = false;
 
-	for (i = 0; i < prev_bb->op_pos_size; i++) {
-		ut64 prev_pos = prev_bb->op_pos[i];
+	for (i = 0; i < prev_bb->ninstr; i++) {
+		ut64 prev_pos = r_anal_bb_offset_inst (prev_bb, i);
 		ut64 op_addr = prev_bb->addr + prev_pos;
 		if (prev_pos >= prev_bb->size) {
 			continue;
@@ -1827,7 +1820,9 @@ R_API int r_anal_fcn(RAnal *anal, RAnalFunction *fcn, ut64 addr, ut64 len, int r
 	}
 	fcn->maxstack = 0;
 #if USE_FCN_RECURSE
+	R_PROF_BEGIN (fcn_recurse);
 	ret = fcn_recurse (anal, fcn, addr, len, anal->opt.depth);
+	R_PROF_END (fcn_recurse);
 	// update tinyrange for the function
 	r_anal_fcn_update_tinyrange_bbs (fcn);
 #else
@@ -261,10 +261,6 @@ typedef struct idasig_v10_t {
 	ut16 unknown;
 } idasig_v10_t;
 
-#if DEBUG
-static int header_size = 0;
-#endif
-
 /* newer header only add fields, that's why we'll always read a v5 header first */
 /*
    arch             : target architecture
@@ -318,10 +314,26 @@ typedef struct RFlirtNode {
 	ut64 variant_mask; // this is the mask that will define variant bytes in ut8 *pattern_bytes
 	ut8 *pattern_bytes; // holds the pattern bytes of the signature
 	ut8 *variant_bool_array; // bool array, if true, byte in pattern_bytes is a variant byte
+	// filled by node_compile() for nodes with many children
+	struct RFlirtNode **children; // children with a fixed first byte, sorted by it
+	ut32 *dispatch; // children[dispatch[c]..dispatch[c + 1]] start with byte c
+	struct RFlirtNode **variant_children; // children starting with a variant byte
+	ut32 n_variant_children;
+	ut32 idx; // position in the parent child_list, keeps the matching order
 } RFlirtNode;
 
-static ut8 version; // version of the sig file being parsed
-// used in some cases to parse the right way
+// below this number of children a linear scan is as fast as the dispatch
+#define R_FLIRT_DISPATCH_MIN 8
+
+/* parsing state, one per sig file so several can be parsed at once */
+typedef struct RFlirtParser {
+	RBuffer *b;
+	ut8 version; // version of the sig file being parsed
+	// used in some cases to parse the right way
+	bool eof;
+	bool err;
+	int header_size;
+} RFlirtParser;
 
 // This is from flair tools flair/crc16.cpp
 #define POLY 0x8408
@@ -351,62 +363,58 @@ ut16 crc16(const unsigned char *data_p, size_t length) {
 	return (ut16) (crc);
 }
 
-// this is ugly, but we can't afford to change the return size of read_byte
-static bool buf_eof;
-static bool buf_err;
-
-static ut8 read_byte(RBuffer *b) {
+static ut8 read_byte(RFlirtParser *p) {
 	ut8 r = 0;
 	int length;
 
-	if (buf_eof || buf_err) {
+	if (p->eof || p->err) {
 		return 0;
 	}
-	if ((length = r_buf_read (b, &r, 1)) != 1) {
+	if ((length = r_buf_read (p->b, &r, 1)) != 1) {
 		if (length == -1) {
-			buf_err = true;
+			p->err = true;
 		}
 		if (length == 0) {
-			buf_eof = true;
+			p->eof = true;
 		}
 		return 0;
 	}
 	return r;
 }
 
-static ut16 read_short(RBuffer *b) {
-	ut16 r = (read_byte (b) << 8);
-	r += read_byte (b);
+static ut16 read_short(RFlirtParser *p) {
+	ut16 r = (read_byte (p) << 8);
+	r += read_byte (p);
 	return r;
 }
 
-static ut32 read_word(RBuffer *b) {
-	ut32 r = (read_short (b) << 16);
-	r += read_short (b);
+static ut32 read_word(RFlirtParser *p) {
+	ut32 r = (read_short (p) << 16);
+	r += read_short (p);
 	return r;
 }
 
-static ut16 read_max_2_bytes(RBuffer *b) {
-	ut16 r = read_byte (b);
+static ut16 read_max_2_bytes(RFlirtParser *p) {
+	ut16 r = read_byte (p);
 	return (r & 0x80)
-		? ((r & 0x7f) << 8) + read_byte (b)
+		? ((r & 0x7f) << 8) + read_byte (p)
 		: r;
 }
 
-static ut32 read_multiple_bytes(RBuffer *b) {
-	ut32 r = read_byte (b);
+static ut32 read_multiple_bytes(RFlirtParser *p) {
+	ut32 r = read_byte (p);
 	if ((r & 0x80) != 0x80) {
 		return r;
 	}
 	if ((r & 0xc0) != 0xc0) {
-		return ((r & 0x7f) << 8) + read_byte (b);
+		return ((r & 0x7f) << 8) + read_byte (p);
 	}
 	if ((r & 0xe0) != 0xe0) {
-		r = ((r & 0x3f) << 24) + (read_byte (b) << 16);
-		r += read_short (b);
+		r = ((r & 0x3f) << 24) + (read_byte (p) << 16);
+		r += read_short (p);
 		return r;
 	}
-	return read_word (b);
+	return read_word (p);
 }
 
 static void module_free(RFlirtModule *module) {
@@ -434,6 +442,9 @@ static void node_free(RFlirtNode *node) {
 	}
 	free (node->variant_bool_array);
 	free (node->pattern_bytes);
+	free (node->children);
+	free (node->dispatch);
+	free (node->variant_children);
 	if (node->module_list) {
 		node->module_list->free = (RListFree)module_free;
 		r_list_free (node->module_list);
@@ -621,7 +632,7 @@ static int node_pattern_match(const RFlirtNode *node, ut8 *b, int buf_size) {
 	int i;
 	for (i = 0; i < node->length; i++) {
 		if (!node->variant_bool_array[i]) {
-			if (i < node->length && node->pattern_bytes[i] != b[i]) {
+			if (i >= buf_size || node->pattern_bytes[i] != b[i]) {
 				return false;
 			}
 		}
@@ -629,18 +640,48 @@ static int node_pattern_match(const RFlirtNode *node, ut8 *b, int buf_size) {
 	return true;
 }
 
-static int node_match_buffer(RAnal *anal, const RFlirtNode *node, ut8 *b, ut64 address, ut32 buf_size, ut32 buf_idx) {
-	RListIter *node_child_it, *module_it;
+static int node_match_buffer(RAnal *anal, const RFlirtNode *node, ut8 *b, ut64 address, ut32 buf_size, ut32 buf_idx);
+
+static int node_match_children(RAnal *anal, const RFlirtNode *node, ut8 *b, ut64 address, ut32 buf_size, ut32 buf_idx) {
+	/* Tries the children of node against b + buf_idx, in the order of the sig file */
+	RListIter *node_child_it;
 	RFlirtNode *child;
+
+	if (!node->dispatch) {
+		r_list_foreach (node->child_list, node_child_it, child) {
+			if (node_match_buffer (anal, child, b, address, buf_size, buf_idx)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	// only the children starting with b[buf_idx] and the variant ones can match
+	ut32 i = 0, end = 0, j = 0;
+	if (buf_idx < buf_size) {
+		i = node->dispatch[b[buf_idx]];
+		end = node->dispatch[b[buf_idx] + 1];
+	}
+	while (i < end || j < node->n_variant_children) {
+		if (j == node->n_variant_children ||
+		(i < end && node->children[i]->idx < node->variant_children[j]->idx)) {
+			child = node->children[i++];
+		} else {
+			child = node->variant_children[j++];
+		}
+		if (node_match_buffer (anal, child, b, address, buf_size, buf_idx)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static int node_match_buffer(RAnal *anal, const RFlirtNode *node, ut8 *b, ut64 address, ut32 buf_size, ut32 buf_idx) {
+	RListIter *module_it;
 	RFlirtModule *module;
 
-	if (node_pattern_match (node, b + buf_idx, buf_size - buf_idx)) {
+	if (node_pattern_match (node, b + buf_idx, (int)buf_size - (int)buf_idx)) {
 		if (node->child_list) {
-			r_list_foreach (node->child_list, node_child_it, child) {
-				if (node_match_buffer (anal, child, b, address, buf_size, buf_idx + node->length)) {
-					return true;
-				}
-			}
+			return node_match_children (anal, node, b, address, buf_size, buf_idx + node->length);
 		} else if (node->module_list) {
 			r_list_foreach (node->module_list, module_it, module) {
 				if (module_match_buffer (anal, module, b, address, buf_size)) {
@@ -653,15 +694,16 @@ static int node_match_buffer(RAnal *anal, const RFlirtNode *node, ut8 *b, ut64 a
 	return false;
 }
 
-static int node_match_functions(RAnal *anal, const RFlirtNode *root_node) {
-	/* Tries to find matching functions between the signature infos in root_node
-	* and the analyzed functions in anal
+static int node_match_functions(RAnal *anal, RList *root_nodes) {
+	/* Tries to find matching functions between the signature infos in root_nodes
+	* and the analyzed functions in anal, each function is read once for all of them
 	* Returns false on error. */
 
-	RListIter *it_func, *node_child_it;
+	RListIter *it_func, *it_root;
 	ut8 *func_buf = NULL;
+	int func_buf_size = 0;
 	RAnalFunction *func;
-	RFlirtNode *child;
+	RFlirtNode *root_node;
 	int ret = true;
 
 	if (r_list_length (anal->fcns) == 0) {
@@ -675,19 +717,32 @@ static int node_match_functions(RAnal *anal, const RFlirtNode *root_node) {
 			continue;
 		}
 
-		int func_size = r_anal_fcn_size (func);
-		func_buf = malloc (func_size);
-		if (!anal->iob.read_at (anal->iob.io, func->addr, func_buf, func_size)) {
-			eprintf ("Couldn't read function\n");
-			ret = false;
-			goto exit;
-		}
-		r_list_foreach (root_node->child_list, node_child_it, child) {
-			if (node_match_buffer (anal, child, func_buf, func->addr, func_size, 0)) {
+		int func_size = 0;
+		r_list_foreach (root_nodes, it_root, root_node) {
+			// a match in a previous sig may have resized the function
+			int size = r_anal_fcn_size (func);
+			if (size < 1) {
 				break;
 			}
+			if (size != func_size) {
+				if (size > func_buf_size) {
+					ut8 *tmp = realloc (func_buf, size);
+					if (!tmp) {
+						ret = false;
+						goto exit;
+					}
+					func_buf = tmp;
+					func_buf_size = size;
+				}
+				if (!anal->iob.read_at (anal->iob.io, func->addr, func_buf, size)) {
+					eprintf ("Couldn't read function\n");
+					ret = false;
+					goto exit;
+				}
+				func_size = size;
+			}
+			node_match_children (anal, root_node, func_buf, func->addr, func_size, 0);
 		}
-		R_FREE (func_buf);
 	}
 
 exit:
@@ -695,7 +750,60 @@ exit:
 	return ret;
 }
 
-static ut8 read_module_tail_bytes(RFlirtModule *module, RBuffer *b) {
+static int node_cmp_first_byte(const void *a, const void *b) {
+	const RFlirtNode *na = *(const RFlirtNode **)a;
+	const RFlirtNode *nb = *(const RFlirtNode **)b;
+	if (na->pattern_bytes[0] != nb->pattern_bytes[0]) {
+		return na->pattern_bytes[0] - nb->pattern_bytes[0];
+	}
+	return (na->idx > nb->idx) - (na->idx < nb->idx);
+}
+
+static bool node_compile(RFlirtNode *node) {
+	/* Builds the first byte dispatch tables of the tree below node */
+	/* returns false on allocation error */
+	RListIter *it;
+	RFlirtNode *child;
+	ut32 i, n = 0, n_fixed = 0;
+
+	if (!node->child_list) {
+		return true;
+	}
+	r_list_foreach (node->child_list, it, child) {
+		child->idx = n++;
+		if (child->length > 0 && !child->variant_bool_array[0]) {
+			n_fixed++;
+		}
+		if (!node_compile (child)) {
+			return false;
+		}
+	}
+	if (n < R_FLIRT_DISPATCH_MIN) {
+		return true;
+	}
+	node->children = calloc (n_fixed + 1, sizeof (RFlirtNode *));
+	node->variant_children = calloc (n - n_fixed + 1, sizeof (RFlirtNode *));
+	node->dispatch = calloc (257, sizeof (ut32));
+	if (!node->children || !node->variant_children || !node->dispatch) {
+		return false;
+	}
+	n_fixed = 0;
+	r_list_foreach (node->child_list, it, child) {
+		if (child->length > 0 && !child->variant_bool_array[0]) {
+			node->children[n_fixed++] = child;
+			node->dispatch[child->pattern_bytes[0] + 1]++;
+		} else {
+			node->variant_children[node->n_variant_children++] = child;
+		}
+	}
+	qsort (node->children, n_fixed, sizeof (RFlirtNode *), node_cmp_first_byte);
+	for (i = 1; i < 257; i++) {
+		node->dispatch[i] += node->dispatch[i - 1];
+	}
+	return true;
+}
+
+static ut8 read_module_tail_bytes(RFlirtModule *module, RFlirtParser *p) {
 	/*parses a module tail bytes*/
 	/*returns false on parsing error*/
 	int i;
@@ -705,9 +813,9 @@ static ut8 read_module_tail_bytes(RFlirtModule *module, RBuffer *b) {
 		goto err_exit;
 	}
 
-	if (version >= 8) { // this counter was introduced in version 8
-		number_of_tail_bytes = read_byte (b); // XXX are we sure it's not read_multiple_bytes?
-		if (buf_eof || buf_err) {
+	if (p->version >= 8) { // this counter was introduced in version 8
+		number_of_tail_bytes = read_byte (p); // XXX are we sure it's not read_multiple_bytes?
+		if (p->eof || p->err) {
 			goto err_exit;
 		}
 	} else { // suppose there's only one
@@ -718,20 +826,20 @@ static ut8 read_module_tail_bytes(RFlirtModule *module, RBuffer *b) {
 		if (!tail_byte) {
 			return false;
 		}
-		if (version >= 9) {
+		if (p->version >= 9) {
 			/*/!\ XXX don't trust ./zipsig output because it will write a version 9 header, but keep the old version offsets*/
-			tail_byte->offset = read_multiple_bytes (b);
-			if (buf_eof || buf_err) {
+			tail_byte->offset = read_multiple_bytes (p);
+			if (p->eof || p->err) {
 				goto err_exit;
 			}
 		} else {
-			tail_byte->offset = read_max_2_bytes (b);
-			if (buf_eof || buf_err) {
+			tail_byte->offset = read_max_2_bytes (p);
+			if (p->eof || p->err) {
 				goto err_exit;
 			}
 		}
-		tail_byte->value = read_byte (b);
-		if (buf_eof || buf_err) {
+		tail_byte->value = read_byte (p);
+		if (p->eof || p->err) {
 			goto err_exit;
 		}
 		r_list_append (module->tail_bytes, tail_byte);
@@ -748,7 +856,7 @@ err_exit:
 	return false;
 }
 
-static ut8 read_module_referenced_functions(RFlirtModule *module, RBuffer *b) {
+static ut8 read_module_referenced_functions(RFlirtModule *module, RFlirtParser *p) {
 	/*parses a module referenced functions*/
 	/*returns false on parsing error*/
 	int i, j;
@@ -758,9 +866,9 @@ static ut8 read_module_referenced_functions(RFlirtModule *module, RBuffer *b) {
 
 	module->referenced_functions = r_list_new ();
 
-	if (version >= 8) { // this counter was introduced in version 8
-		number_of_referenced_functions = read_byte (b); // XXX are we sure it's not read_multiple_bytes?
-		if (buf_eof || buf_err) {
+	if (p->version >= 8) { // this counter was introduced in version 8
+		number_of_referenced_functions = read_byte (p); // XXX are we sure it's not read_multiple_bytes?
+		if (p->eof || p->err) {
 			goto err_exit;
 		}
 	} else { // suppose there's only one
@@ -772,25 +880,25 @@ static ut8 read_module_referenced_functions(RFlirtModule *module, RBuffer *b) {
 		if (!ref_function) {
 			goto err_exit;
 		}
-		if (version >= 9) {
-			ref_function->offset = read_multiple_bytes (b);
-			if (buf_eof || buf_err) {
+		if (p->version >= 9) {
+			ref_function->offset = read_multiple_bytes (p);
+			if (p->eof || p->err) {
 				goto err_exit;
 			}
 		} else {
-			ref_function->offset = read_max_2_bytes (b);
-			if (buf_eof || buf_err) {
+			ref_function->offset = read_max_2_bytes (p);
+			if (p->eof || p->err) {
 				goto err_exit;
 			}
 		}
-		ref_function_name_length = read_byte (b);
-		if (buf_eof || buf_err) {
+		ref_function_name_length = read_byte (p);
+		if (p->eof || p->err) {
 			goto err_exit;
 		}
 		if (!ref_function_name_length) {
 			// not sure why it's not read_multiple_bytes() in the first place
-			ref_function_name_length = read_multiple_bytes (b); // XXX might be read_max_2_bytes, need more data
-			if (buf_eof || buf_err) {
+			ref_function_name_length = read_multiple_bytes (p); // XXX might be read_max_2_bytes, need more data
+			if (p->eof || p->err) {
 				goto err_exit;
 			}
 		}
@@ -798,8 +906,8 @@ static ut8 read_module_referenced_functions(RFlirtModule *module, RBuffer *b) {
 			goto err_exit;
 		}
 		for (j = 0; j < ref_function_name_length; j++) {
-			ref_function->name[j] = read_byte (b);
-			if (buf_eof || buf_err) {
+			ref_function->name[j] = read_byte (p);
+			if (p->eof || p->err) {
 				goto err_exit;
 			}
 		}
@@ -822,7 +930,7 @@ err_exit:
 	return false;
 }
 
-static ut8 read_module_public_functions(RFlirtModule *module, RBuffer *b, ut8 *flags) {
+static ut8 read_module_public_functions(RFlirtModule *module, RFlirtParser *p, ut8 *flags) {
 	/* Reads and set the public functions names and offsets associated within a module */
 	/*returns false on parsing error*/
 	int i;
@@ -834,21 +942,21 @@ static ut8 read_module_public_functions(RFlirtModule *module, RBuffer *b, ut8 *f
 
 	do {
 		function = R_NEW0 (RFlirtFunction);
-		if (version >= 9) {   // seems like version 9 introduced some larger offsets
-			offset += read_multiple_bytes (b); // offsets are dependent of the previous ones
-			if (buf_eof || buf_err) {
+		if (p->version >= 9) {   // seems like version 9 introduced some larger offsets
+			offset += read_multiple_bytes (p); // offsets are dependent of the previous ones
+			if (p->eof || p->err) {
 				goto err_exit;
 			}
 		} else {
-			offset += read_max_2_bytes (b); // offsets are dependent of the previous ones
-			if (buf_eof || buf_err) {
+			offset += read_max_2_bytes (p); // offsets are dependent of the previous ones
+			if (p->eof || p->err) {
 				goto err_exit;
 			}
 		}
 		function->offset = offset;
 
-		current_byte = read_byte (b);
-		if (buf_eof || buf_err) {
+		current_byte = read_byte (p);
+		if (p->eof || p->err) {
 			goto err_exit;
 		}
 		if (current_byte < 0x20) {
@@ -863,19 +971,19 @@ static ut8 read_module_public_functions(RFlirtModule *module, RBuffer *b, ut8 *f
 #if DEBUG
 				// XXX investigate
 				eprintf ("INVESTIGATE PUBLIC NAME FLAG: %02X @ %04X\n", current_byte,
-					r_buf_tell (b) + header_size);
+					r_buf_tell (p->b) + p->header_size);
 #endif
 			}
-			current_byte = read_byte (b);
-			if (buf_eof || buf_err) {
+			current_byte = read_byte (p);
+			if (p->eof || p->err) {
 				goto err_exit;
 			}
 		}
 
 		for (i = 0; current_byte >= 0x20 && i < R_FLIRT_NAME_MAX; i++) {
 			function->name[i] = current_byte;
-			current_byte = read_byte (b);
-			if (buf_eof || buf_err) {
+			current_byte = read_byte (p);
+			if (p->eof || p->err) {
 				goto err_exit;
 			}
 		}
@@ -904,7 +1012,7 @@ err_exit:
 	return false;
 }
 
-static ut8 parse_leaf(const RAnal *anal, RBuffer *b, RFlirtNode *node) {
+static ut8 parse_leaf(const RAnal *anal, RFlirtParser *p, RFlirtNode *node) {
 	/*parses a signature leaf: modules with same leading pattern*/
 	/*returns false on parsing error*/
 	ut8 flags, crc_length;
@@ -914,16 +1022,16 @@ static ut8 parse_leaf(const RAnal *anal, RBuffer *b, RFlirtNode *node) {
 	node->module_list = r_list_new ();
 	do { // loop for all modules having the same prefix
 
-		crc_length = read_byte (b); if (buf_eof || buf_err) {
+		crc_length = read_byte (p); if (p->eof || p->err) {
 			goto err_exit;
 		}
-		crc16 = read_short (b); if (buf_eof || buf_err) {
+		crc16 = read_short (p); if (p->eof || p->err) {
 			goto err_exit;
 		}
 #if DEBUG
 		if (crc_length == 0x00 && crc16 != 0x0000) {
 			eprintf ("WARNING non zero crc of zero length @ %04X\n",
-				r_buf_tell (b) + header_size);
+				r_buf_tell (p->b) + p->header_size);
 		}
 		eprintf ("crc_len: %02X crc16: %04X\n", crc_length, crc16);
 #endif
@@ -937,15 +1045,15 @@ static ut8 parse_leaf(const RAnal *anal, RBuffer *b, RFlirtNode *node) {
 			module->crc_length = crc_length;
 			module->crc16 = crc16;
 
-			if (version >= 9) { // seems like version 9 introduced some larger length
+			if (p->version >= 9) { // seems like version 9 introduced some larger length
 				/*/!\ XXX don't trust ./zipsig output because it will write a version 9 header, but keep the old version offsets*/
-				module->length = read_multiple_bytes (b); // should be < 0x8000
-				if (buf_eof || buf_err) {
+				module->length = read_multiple_bytes (p); // should be < 0x8000
+				if (p->eof || p->err) {
 					goto err_exit;
 				}
 			} else {
-				module->length = read_max_2_bytes (b); // should be < 0x8000
-				if (buf_eof || buf_err) {
+				module->length = read_max_2_bytes (p); // should be < 0x8000
+				if (p->eof || p->err) {
 					goto err_exit;
 				}
 			}
@@ -953,17 +1061,17 @@ static ut8 parse_leaf(const RAnal *anal, RBuffer *b, RFlirtNode *node) {
 			eprintf ("module_length: %04X\n", module->length);
 #endif
 
-			if (!read_module_public_functions (module, b, &flags)) {
+			if (!read_module_public_functions (module, p, &flags)) {
 				goto err_exit;
 			}
 
 			if (flags & IDASIG__PARSE__READ_TAIL_BYTES) { // we need to read some tail bytes because in this leaf we have functions with same crc
-				if (!read_module_tail_bytes (module, b)) {
+				if (!read_module_tail_bytes (module, p)) {
 					goto err_exit;
 				}
 			}
 			if (flags & IDASIG__PARSE__READ_REFERENCED_FUNCTIONS) { // we need to read some referenced functions
-				if (!read_module_referenced_functions (module, b)) {
+				if (!read_module_referenced_functions (module, p)) {
 					goto err_exit;
 				}
 			}
@@ -979,9 +1087,9 @@ err_exit:
 	return false;
 }
 
-static ut8 read_node_length(RFlirtNode *node, RBuffer *b) {
-	node->length = read_byte (b);
-	if (buf_eof || buf_err) {
+static ut8 read_node_length(RFlirtNode *node, RFlirtParser *p) {
+	node->length = read_byte (p);
+	if (p->eof || p->err) {
 		return false;
 	}
 #if DEBUG
@@ -990,23 +1098,23 @@ static ut8 read_node_length(RFlirtNode *node, RBuffer *b) {
 	return true;
 }
 
-static ut8 read_node_variant_mask(RFlirtNode *node, RBuffer *b) {
+static ut8 read_node_variant_mask(RFlirtNode *node, RFlirtParser *p) {
 	/*Reads and sets a node's variant bytes mask. This mask is then used to*/
 	/*read the non-variant bytes following.*/
 	/*returns false on parsing error*/
 	if (node->length < 0x10) {
-		node->variant_mask = read_max_2_bytes (b);
-		if (buf_eof || buf_err) {
+		node->variant_mask = read_max_2_bytes (p);
+		if (p->eof || p->err) {
 			return false;
 		}
 	} else if (node->length <= 0x20) {
-		node->variant_mask = read_multiple_bytes (b);
-		if (buf_eof || buf_err) {
+		node->variant_mask = read_multiple_bytes (p);
+		if (p->eof || p->err) {
 			return false;
 		}
 	} else if (node->length <= 0x40) { // it shouldn't be more than 64 bytes
-		node->variant_mask = ((ut64)read_multiple_bytes (b) << 32) + read_multiple_bytes (b);
-		if (buf_eof || buf_err) {
+		node->variant_mask = ((ut64)read_multiple_bytes (p) << 32) + read_multiple_bytes (p);
+		if (p->eof || p->err) {
 			return false;
 		}
 	}
@@ -1014,7 +1122,7 @@ static ut8 read_node_variant_mask(RFlirtNode *node, RBuffer *b) {
 	return true;
 }
 
-static bool read_node_bytes(RFlirtNode *node, RBuffer *b) {
+static bool read_node_bytes(RFlirtNode *node, RFlirtParser *p) {
 	/*Reads the node bytes, and also sets the variant bytes in variant_bool_array*/
 	/*returns false on parsing error*/
 	int i;
@@ -1035,8 +1143,8 @@ static bool read_node_bytes(RFlirtNode *node, RBuffer *b) {
 		if (node->variant_mask & current_mask_bit) {
 			node->pattern_bytes[i] = 0x00;
 		} else {
-			node->pattern_bytes[i] = read_byte (b);
-			if (buf_eof || buf_err) {
+			node->pattern_bytes[i] = read_byte (p);
+			if (p->eof || p->err) {
 				return false;
 			}
 		}
@@ -1044,16 +1152,16 @@ static bool read_node_bytes(RFlirtNode *node, RBuffer *b) {
 	return true;
 }
 
-static ut8 parse_tree(const RAnal *anal, RBuffer *b, RFlirtNode *root_node) {
+static ut8 parse_tree(const RAnal *anal, RFlirtParser *p, RFlirtNode *root_node) {
 	/*parse a signature pattern tree or sub-tree*/
 	/*returns false on parsing error*/
 	RFlirtNode *node = NULL;
-	int i, tree_nodes = read_multiple_bytes (b); // confirmed it's not read_byte(), XXX could it be read_max_2_bytes() ???
-	if (buf_eof || buf_err) {
+	int i, tree_nodes = read_multiple_bytes (p); // confirmed it's not read_byte(), XXX could it be read_max_2_bytes() ???
+	if (p->eof || p->err) {
 		return false;
 	}
 	if (tree_nodes == 0) { // if there's no tree nodes remaining, that means we are on the leaf
-		return parse_leaf (anal, b, root_node);
+		return parse_leaf (anal, p, root_node);
 	}
 	root_node->child_list = r_list_new ();
 
@@ -1061,18 +1169,18 @@ static ut8 parse_tree(const RAnal *anal, RBuffer *b, RFlirtNode *root_node) {
 		if (!(node = R_NEW0 (RFlirtNode))) {
 			goto err_exit;
 		}
-		if (!read_node_length (node, b)) {
+		if (!read_node_length (node, p)) {
 			goto err_exit;
 		}
-		if (!read_node_variant_mask (node, b)) {
+		if (!read_node_variant_mask (node, p)) {
 			goto err_exit;
 		}
-		if (!read_node_bytes (node, b)) {
+		if (!read_node_bytes (node, p)) {
 			goto err_exit;
 		}
 		r_list_append (root_node->child_list, node);
-		if (!parse_tree (anal, b, node)) {
-			goto err_exit; // parse child nodes
+		if (!parse_tree (anal, p, node)) {
+			return false; // parse child nodes, node is owned by the list now
 		}
 	}
 	return true;
@@ -1296,9 +1404,8 @@ static RFlirtNode *flirt_parse(const RAnal *anal, RBuffer *flirt_buf) {
 	idasig_v6_v7_t *v6_v7 = NULL;
 	idasig_v8_v9_t *v8_v9 = NULL;
 	idasig_v10_t *v10 = NULL;
-
-	buf_eof = false;
-	buf_err = false;
+	RFlirtParser ps = {0};
+	ut8 version;
 
 	if (!(version = r_sign_is_flirt (flirt_buf))) {
 		goto exit;
@@ -1356,7 +1463,7 @@ static RFlirtNode *flirt_parse(const RAnal *anal, RBuffer *flirt_buf) {
 	// anal->cb_printf  ("Loading: %s\n", name);
 #if DEBUG
 	print_header (header);
-	header_size = r_buf_tell (flirt_buf);
+	ps.header_size = r_buf_tell (flirt_buf);
 #endif
 
 	size = r_buf_size (flirt_buf) - r_buf_tell (flirt_buf);
@@ -1387,10 +1494,12 @@ static RFlirtNode *flirt_parse(const RAnal *anal, RBuffer *flirt_buf) {
 #if DEBUG
 	r_file_dump ("sig_dump", r_buf->buf, r_buf_size (r_buf));
 #endif
-	if (parse_tree (anal, r_buf, node)) {
+	ps.b = r_buf;
+	ps.version = version;
+	if (parse_tree (anal, &ps, node) && node_compile (node)) {
 		ret = node;
 	} else {
-		free (node);
+		node_free (node);
 	}
 exit:
 	free (buf);
@@ -1452,24 +1561,41 @@ R_API void r_sign_flirt_dump(const RAnal *anal, const char *flirt_file) {
 
 R_API void r_sign_flirt_scan(RAnal *anal, const char *flirt_file) {
 	/*parses a flirt signature file and scan the currently opened file against it.*/
+	RList *files = r_list_new ();
+	if (files) {
+		r_list_append (files, (void *)flirt_file);
+		r_sign_flirt_scan_files (anal, files);
+		r_list_free (files);
+	}
+}
+
+R_API void r_sign_flirt_scan_files(RAnal *anal, RList *flirt_files) {
+	/*parses all the flirt signature files first, then scan the currently opened
+	* file against them, reading each function only once.*/
 	RBuffer *flirt_buf;
 	RFlirtNode *node;
+	RListIter *iter;
+	const char *flirt_file;
+	RList *nodes = r_list_newf ((RListFree)node_free);
 
-	if (!(flirt_buf = r_buf_new_slurp (flirt_file))) {
-		eprintf ("Can't open %s\n", flirt_file);
+	if (!nodes) {
 		return;
 	}
-
-	node = flirt_parse (anal, flirt_buf);
-	r_buf_free (flirt_buf);
-	if (node) {
-		if (!node_match_functions (anal, node)) {
-			eprintf ("Error while scanning the file %s\n", flirt_file);
+	r_list_foreach (flirt_files, iter, flirt_file) {
+		if (!(flirt_buf = r_buf_new_slurp (flirt_file))) {
+			eprintf ("Can't open %s\n", flirt_file);
+			continue;
 		}
-		node_free (node);
-		return;
-	} else {
-		eprintf ("We encountered an error while parsing the file %s. Sorry.\n", flirt_file);
-		return;
+		node = flirt_parse (anal, flirt_buf);
+		r_buf_free (flirt_buf);
+		if (!node) {
+			eprintf ("We encountered an error while parsing the file %s. Sorry.\n", flirt_file);
+			continue;
+		}
+		r_list_append (nodes, node);
+	}
+	if (!r_list_empty (nodes) && !node_match_functions (anal, nodes)) {
+		eprintf ("Error while scanning the file with the FLIRT signatures\n");
 	}
+	r_list_free (nodes);
 }
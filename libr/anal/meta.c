@@ -39,7 +39,7 @@ static char *meta_inrange_get (RAnal *a, ut64 addr, int size) {
 	char *res = NULL;
 	// return string array of all the offsets where there are stuff
 	for (; base <= base2; base++) {
-		const char *key = sdb_fmt ("range.0x%"PFMT64x, base);
+		r_strf_var (key, 64, "range.0x%"PFMT64x, base);
 		char *r = sdb_get (DB, key, 0);
 		if (r) {
 			if (res) {
@@ -61,7 +61,7 @@ static bool meta_inrange_add (RAnal *a, ut64 addr, int size) {
 	base = META_RANGE_BASE (addr);
 	base2 = META_RANGE_BASE (addr + size - 1);
 	for (; base <= base2; base++) {
-		const char *key = sdb_fmt ("range.0x%"PFMT64x, base);
+		r_strf_var (key, 64, "range.0x%"PFMT64x, base);
 		if (sdb_array_add_num (DB, key, addr, 0)) {
 			set = true;
 		}
@@ -77,7 +77,7 @@ static bool meta_inrange_del (RAnal *a, ut64 addr, int size) {
 	ut64 base = META_RANGE_BASE (addr);
 	ut64 base2 = META_RANGE_BASE (addr + size - 1);
 	for (; base <= base2; base++) {
-		const char *key = sdb_fmt ("range.0x%"PFMT64x, base);
+		r_strf_var (key, 64, "range.0x%"PFMT64x, base);
 		if (sdb_array_remove_num (DB, key, addr, 0)) {
 			set = true;
 		}
@@ -169,6 +169,7 @@ R_API int r_meta_set_var_comment(RAnal *a, int type, ut64 idx, ut64 addr, const
 R_API char *r_meta_get_string(RAnal *a, int type, ut64 addr) {
 	char key[100];
 	const char *k, *p, *p2, *p3;
+	R_PROF_COUNT (meta_get_string);
 	snprintf (key, sizeof (key)-1, "meta.%c.0x%"PFMT64x, type, addr);
 	k = sdb_const_get (DB, key, NULL);
 	if (!k) {
@@ -214,10 +215,11 @@ R_API char *r_meta_get_var_comment (RAnal *a, int type, ut64 idx, ut64 addr) {
 }
 
 static bool mustDeleteMetaEntry(RAnal *a, ut64 addr) {
-	const char *tt = sdb_const_get (DB, sdb_fmt ("meta.t.0x%"PFMT64x, addr), NULL);
-	const char *ss = sdb_const_get (DB, sdb_fmt ("meta.s.0x%"PFMT64x, addr), NULL);
-	const char *dd = sdb_const_get (DB, sdb_fmt ("meta.d.0x%"PFMT64x, addr), NULL);
-	const char *cc = sdb_const_get (DB, sdb_fmt ("meta.C.0x%"PFMT64x, addr), NULL);
+	r_strf_buffer (64);
+	const char *tt = sdb_const_get (DB, r_strf ("meta.t.0x%"PFMT64x, addr), NULL);
+	const char *ss = sdb_const_get (DB, r_strf ("meta.s.0x%"PFMT64x, addr), NULL);
+	const char *dd = sdb_const_get (DB, r_strf ("meta.d.0x%"PFMT64x, addr), NULL);
+	const char *cc = sdb_const_get (DB, r_strf ("meta.C.0x%"PFMT64x, addr), NULL);
 	int count = 0;
 	if (tt) count++;
 	if (ss) count++;
@@ -451,6 +453,7 @@ static RAnalMetaItem *r_meta_find_(RAnal *a, ut64 at, int type, int where, int e
 	Sdb *s = a->sdb_meta;
 	static RAnalMetaItem mi = {0};
 	// XXX: return allocated item? wtf
+	R_PROF_COUNT (meta_find);
 	if (where != R_META_WHERE_HERE) {
 		eprintf ("THIS WAS NOT SUPOSED TO HAPPEN\n");
 		return NULL;
@@ -528,7 +531,7 @@ R_API RList *r_meta_find_list_in(RAnal *a, ut64 at, int type, int where) {
 	r_list_foreach (list, iter, meta) {
 		Sdb *s = a->sdb_meta;
 		ut64 mia = r_num_math (NULL, meta);
-		const char *key = sdb_fmt ("meta.0x%" PFMT64x, mia);
+		r_strf_var (key, 64, "meta.0x%" PFMT64x, mia);
 		const char *infos = sdb_const_get (s, key, 0);
 		if (!infos) {
 			continue;
@@ -537,7 +540,7 @@ R_API RList *r_meta_find_list_in(RAnal *a, ut64 at, int type, int where) {
 			if (*infos == ',') {
 				continue;
 			}
-			const char *key = sdb_fmt ("meta.%c.0x%" PFMT64x, *infos, mia);
+			r_strf_var (key, 64, "meta.%c.0x%" PFMT64x, *infos, mia);
 			const char *metas = sdb_const_get (s, key, 0);
 			if (metas) {
 				RAnalMetaItem *mi = R_NEW0 (RAnalMetaItem);
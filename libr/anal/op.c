@@ -132,10 +132,7 @@ static int defaultCycles(RAnalOp *op) {
 	}
 }
 
-R_API int r_anal_op(RAnal *anal, RAnalOp *op, ut64 addr, const ut8 *data, int len, RAnalOpMask mask) {
-	r_anal_op_init (op);
-	r_return_val_if_fail (anal && op && len > 0, -1);
-
+static int anal_op(RAnal *anal, RAnalOp *op, ut64 addr, const ut8 *data, int len, RAnalOpMask mask) {
 	if (anal->pcalign && addr % anal->pcalign) {
 		op->type = R_ANAL_OP_TYPE_ILL;
 		op->addr = addr;
@@ -145,11 +142,6 @@ R_API int r_anal_op(RAnal *anal, RAnalOp *op, ut64 addr, const ut8 *data, int le
 	}
 	int ret = R_MIN (2, len);
 	if (len > 0 && anal->cur && anal->cur->op) {
-		//use core binding to set asm.bits correctly based on the addr
-		//this is because of the hassle of arm/thumb
-		if (anal && anal->coreb.archbits) {
-			anal->coreb.archbits (anal->coreb.core, addr);
-		}
 		ret = anal->cur->op (anal, op, addr, data, len, mask);
 		if (ret < 1) {
 			op->type = R_ANAL_OP_TYPE_ILL;
@@ -185,6 +177,20 @@ R_API int r_anal_op(RAnal *anal, RAnalOp *op, ut64 addr, const ut8 *data, int le
 	return ret;
 }
 
+R_API int r_anal_op(RAnal *anal, RAnalOp *op, ut64 addr, const ut8 *data, int len, RAnalOpMask mask) {
+	r_anal_op_init (op);
+	r_return_val_if_fail (anal && op && len > 0, -1);
+	R_PROF_BEGIN (r_anal_op);
+	//use core binding to set asm.bits correctly based on the addr
+	//this is because of the hassle of arm/thumb
+	if (anal->cur && anal->cur->op && anal->coreb.archbits) {
+		anal->coreb.archbits (anal->coreb.core, addr);
+	}
+	int ret = anal_op (anal, op, addr, data, len, mask);
+	R_PROF_END (r_anal_op);
+	return ret;
+}
+
 R_API RAnalOp *r_anal_op_copy(RAnalOp *op) {
 	RAnalOp *nop = R_NEW0 (RAnalOp);
 	if (!nop) {
@@ -5,6 +5,7 @@
 #include <capstone/capstone.h>
 #include <capstone/arm.h>
 #include "./anal_arm_hacks.inc"
+#include "../../asm/cs_cache.h"
 
 #define esilprintf(op, fmt, ...) r_strbuf_setf (&op->esil, fmt, ##__VA_ARGS__)
 
@@ -3228,23 +3229,15 @@ static void op_fillval(RAnalOp *op , csh handle, cs_insn *insn, int bits) {
 }
 
 static int analop(RAnal *a, RAnalOp *op, ut64 addr, const ut8 *buf, int len, RAnalOpMask mask) {
-	static csh handle = 0;
-	static int omode = -1;
-	static int obits = 32;
+	csh handle;
 	cs_insn *insn = NULL;
 	int mode = (a->bits==16)? CS_MODE_THUMB: CS_MODE_ARM;
-	int n, ret;
+	int n;
 	mode |= (a->big_endian)? CS_MODE_BIG_ENDIAN: CS_MODE_LITTLE_ENDIAN;
 	if (a->cpu && strstr (a->cpu, "cortex")) {
 		mode |= CS_MODE_MCLASS;
 	}
 
-	if (mode != omode || a->bits != obits) {
-		cs_close (&handle);
-		handle = 0; // unnecessary
-		omode = mode;
-		obits = a->bits;
-	}
 	op->type = R_ANAL_OP_TYPE_NULL;
 	op->size = (a->bits==16)? 2: 4;
 	op->stackop = R_ANAL_STACK_NULL;
@@ -3254,15 +3247,12 @@ static int analop(RAnal *a, RAnalOp *op, ut64 addr, const ut8 *buf, int len, RAn
 	op->ptr = op->val = -1;
 	op->refptr = 0;
 	r_strbuf_init (&op->esil);
-	if (handle == 0) {
-		ret = (a->bits == 64)?
-			cs_open (CS_ARCH_ARM64, mode, &handle):
-			cs_open (CS_ARCH_ARM, mode, &handle);
-		cs_option (handle, CS_OPT_DETAIL, CS_OPT_ON);
-		if (ret != CS_ERR_OK) {
-			return -1;
-		}
+	// arm and thumb get their own engine, switching between them is free
+	handle = r_anal_cs_get ((a->bits == 64)? CS_ARCH_ARM64: CS_ARCH_ARM, mode, NULL);
+	if (!handle) {
+		return -1;
 	}
+	cs_option (handle, CS_OPT_DETAIL, CS_OPT_ON);
 	int haa = hackyArmAnal (a, op, buf, len);
 	if (haa > 0) {
 		return haa;
@@ -3680,6 +3670,16 @@ static ut8 *anal_mask(RAnal *anal, int size, const ut8 *data, ut64 at) {
 	return ret;
 }
 
+static int init(void *user) {
+	r_anal_cs_init ();
+	return true;
+}
+
+static int fini(void *user) {
+	r_anal_cs_fini ();
+	return true;
+}
+
 RAnalPlugin r_anal_plugin_arm_cs = {
 	.name = "arm",
 	.desc = "Capstone ARM analyzer",
@@ -3691,6 +3691,8 @@ RAnalPlugin r_anal_plugin_arm_cs = {
 	.anal_mask = anal_mask,
 	.bits = 16 | 32 | 64,
 	.op = &analop,
+	.init = init,
+	.fini = fini,
 };
 
 #ifndef CORELIB
@@ -4,6 +4,7 @@
 #include <r_lib.h>
 #include <capstone/capstone.h>
 #include <capstone/mips.h>
+#include "../../asm/cs_cache.h"
 
 // http://www.mrc.uidaho.edu/mrc/people/jff/digital/MIPSir.html
 
@@ -703,10 +704,8 @@ static void set_opdir(RAnalOp *op) {
 }
 
 static int analop(RAnal *anal, RAnalOp *op, ut64 addr, const ut8 *buf, int len, RAnalOpMask mask) {
-	int n, ret, opsize = -1;
-	static csh hndl = 0;
-	static int omode = -1;
-	static int obits = 32;
+	int n, opsize = -1;
+	csh hndl;
 	cs_insn* insn;
 	int mode = anal->big_endian? CS_MODE_BIG_ENDIAN: CS_MODE_LITTLE_ENDIAN;
 
@@ -724,12 +723,6 @@ static int analop(RAnal *anal, RAnalOp *op, ut64 addr, const ut8 *buf, int len,
 		}
 	}
 	mode |= (anal->bits==64)? CS_MODE_MIPS64: CS_MODE_MIPS32;
-	if (mode != omode || anal->bits != obits) {
-		cs_close (&hndl);
-		hndl = 0;
-		omode = mode;
-		obits = anal->bits;
-	}
 // XXX no arch->cpu ?!?! CS_MODE_MICRO, N64
 	op->delay = 0;
 	op->type = R_ANAL_OP_TYPE_ILL;
@@ -738,13 +731,11 @@ static int analop(RAnal *anal, RAnalOp *op, ut64 addr, const ut8 *buf, int len,
 		return -1;
 	}
 	op->size = 4;
-	if (hndl == 0) {
-		ret = cs_open (CS_ARCH_MIPS, mode, &hndl);
-		if (ret != CS_ERR_OK) {
-			goto fin;
-		}
-		cs_option (hndl, CS_OPT_DETAIL, CS_OPT_ON);
+	hndl = r_anal_cs_get (CS_ARCH_MIPS, mode, NULL);
+	if (!hndl) {
+		goto fin;
 	}
+	cs_option (hndl, CS_OPT_DETAIL, CS_OPT_ON);
 	n = cs_disasm (hndl, (ut8*)buf, len, addr, 1, &insn);
 	if (n < 1 || insn->size < 1) {
 		goto beach;
@@ -1050,6 +1041,16 @@ fin:
 	return opsize;
 }
 
+static int init(void *user) {
+	r_anal_cs_init ();
+	return true;
+}
+
+static int fini(void *user) {
+	r_anal_cs_fini ();
+	return true;
+}
+
 static char *get_reg_profile(RAnal *anal) {
 	const char *p = NULL;
 	switch (anal->bits) {
@@ -1168,6 +1169,8 @@ RAnalPlugin r_anal_plugin_mips_cs = {
 	.archinfo = archinfo,
 	.bits = 16|32|64,
 	.op = &analop,
+	.init = init,
+	.fini = fini,
 };
 
 #ifndef CORELIB
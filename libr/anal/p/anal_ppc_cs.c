@@ -5,6 +5,7 @@
 #include <capstone/capstone.h>
 #include <capstone/ppc.h>
 #include "../../asm/arch/ppc/libvle/vle.h"
+#include "../../asm/cs_cache.h"
 
 #define SPR_HID0 0x3f0 /* Hardware Implementation Register 0 */
 #define SPR_HID1 0x3f1 /* Hardware Implementation Register 1 */
@@ -537,8 +538,7 @@ static void op_fillval(RAnalOp *op, csh handle, cs_insn *insn) {
 }
 
 static int analop(RAnal *a, RAnalOp *op, ut64 addr, const ut8 *buf, int len, RAnalOpMask mask) {
-	static csh handle = 0;
-	static int omode = -1, obits = -1;
+	csh handle;
 	int n, ret;
 	cs_insn *insn;
 	int mode = (a->bits == 64) ? CS_MODE_64 : (a->bits == 32) ? CS_MODE_32 : 0;
@@ -560,19 +560,11 @@ static int analop(RAnal *a, RAnalOp *op, ut64 addr, const ut8 *buf, int len, RAn
 		}
 	}
 
-	if (mode != omode || a->bits != obits) {
-		cs_close (&handle);
-		handle = 0;
-		omode = mode;
-		obits = a->bits;
-	}
-	if (handle == 0) {
-		ret = cs_open (CS_ARCH_PPC, mode, &handle);
-		if (ret != CS_ERR_OK) {
-			return -1;
-		}
-		cs_option (handle, CS_OPT_DETAIL, CS_OPT_ON);
+	handle = r_anal_cs_get (CS_ARCH_PPC, mode, NULL);
+	if (!handle) {
+		return -1;
 	}
+	cs_option (handle, CS_OPT_DETAIL, CS_OPT_ON);
 	op->size = 4;
 
 	r_strbuf_init (&op->esil);
@@ -1183,6 +1175,16 @@ static int archinfo(RAnal *a, int q) {
 	return 4;
 }
 
+static int init(void *user) {
+	r_anal_cs_init ();
+	return true;
+}
+
+static int fini(void *user) {
+	r_anal_cs_fini ();
+	return true;
+}
+
 RAnalPlugin r_anal_plugin_ppc_cs = {
 	.name = "ppc",
 	.desc = "Capstone PowerPC analysis",
@@ -1193,6 +1195,8 @@ RAnalPlugin r_anal_plugin_ppc_cs = {
 	.archinfo = archinfo,
 	.op = &analop,
 	.set_reg_profile = &set_reg_profile,
+	.init = init,
+	.fini = fini,
 };
 
 #ifndef CORELIB
@@ -26,7 +26,7 @@ call = 4
 #define HAVE_CSGRP_PRIVILEGE 0
 #endif
 
-#define USE_ITER_API 0
+#define USE_ITER_API 1
 
 #if CS_API_MAJOR < 2
 #error Old Capstone not supported
@@ -286,7 +286,9 @@ static char *getarg(struct Getarg* gop, int n, int set, char *setop, int sel) {
 	return NULL;
 }
 
-static csh handle = 0;
+static R_TH_LOCAL csh handle = 0;
+
+#include "../../asm/cs_cache.h"
 
 static int cond_x862r2(int id) {
 	switch (id) {
@@ -2869,29 +2871,21 @@ static int cs_len_prefix_opcode(uint8_t *item) {
 }
 
 static int analop(RAnal *a, RAnalOp *op, ut64 addr, const ut8 *buf, int len, RAnalOpMask mask) {
-	static int omode = 0;
-#if USE_ITER_API
-	static
-#endif
 	cs_insn *insn = NULL;
 	int mode = (a->bits==64)? CS_MODE_64:
 		(a->bits==32)? CS_MODE_32:
 		(a->bits==16)? CS_MODE_16: 0;
-	int n, ret;
+	int n;
 
-	if (handle && mode != omode) {
-		if (handle != 0) {
-			cs_close (&handle);
-			handle = 0;
-		}
-	}
-	omode = mode;
-	if (handle == 0) {
-		ret = cs_open (CS_ARCH_X86, mode, &handle);
-		if (ret != CS_ERR_OK) {
-			handle = 0;
-			return 0;
-		}
+#if USE_ITER_API
+	/* cs_disasm_iter decodes into the insn kept with the engine */
+	cs_insn *iter_insn = NULL;
+	handle = r_anal_cs_get (CS_ARCH_X86, mode, &iter_insn);
+#else
+	handle = r_anal_cs_get (CS_ARCH_X86, mode, NULL);
+#endif
+	if (!handle) {
+		return 0;
 	}
 	memset (op, '\0', sizeof (RAnalOp));
 	op->cycles = 1; // aprox
@@ -2909,13 +2903,13 @@ static int analop(RAnal *a, RAnalOp *op, ut64 addr, const ut8 *buf, int len, RAn
 	// capstone-next
 #if USE_ITER_API
 	{
+		// cs_disasm_iter advances its cursor, keep buf pointing at the op
+		const ut8 *cur = buf;
 		ut64 naddr = addr;
 		size_t size = len;
-		if (!insn) {
-			insn = cs_malloc (handle);
-		}
-		n = cs_disasm_iter (handle, (const uint8_t**)&buf,
-			&size, (uint64_t*)&naddr, insn);
+		insn = iter_insn;
+		n = insn? cs_disasm_iter (handle, (const uint8_t**)&cur,
+			&size, (uint64_t*)&naddr, insn): 0;
 	}
 #else
 	n = cs_disasm (handle, (const ut8*)buf, len, addr, 1, &insn);
@@ -2961,7 +2955,7 @@ static int analop(RAnal *a, RAnalOp *op, ut64 addr, const ut8 *buf, int len, RAn
 //#if X86_GRP_PRIVILEGE>0
 	if (insn) {
 #if HAVE_CSGRP_PRIVILEGE
-		if (cs_insn_group (handle, insn, X86_GRP_PRIVILEGE)) {
+		if (n > 0 && cs_insn_group (handle, insn, X86_GRP_PRIVILEGE)) {
 			op->family = R_ANAL_OP_FAMILY_PRIV;
 		}
 #endif
@@ -3027,16 +3021,15 @@ static int esil_x86_cs_init(RAnalEsil *esil) {
 }
 
 static int init(void *p) {
+	r_anal_cs_init ();
 	handle = 0;
 	return true;
 }
 
 static int fini(void *p) {
-	if (handle != 0) {
-		// SEGFAULTS RANDOMLY, better leak on exit
-		// cs_close (&handle);
-		handle = 0;
-	}
+	// the engines are closed when the last capstone plugin is gone
+	r_anal_cs_fini ();
+	handle = 0;
 	return true;
 }
 
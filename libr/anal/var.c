@@ -85,7 +85,7 @@ R_API bool r_anal_var_add(RAnal *a, ut64 addr, int scope, int delta, char kind,
 		eprintf ("Invalid var kind '%c'\n", kind);
 		return false;
 	}
-	const char *var_def = sdb_fmt ("%d,%s,%d,%s", isarg, type, size, name);
+	r_strf_var (var_def, 256, "%d,%s,%d,%s", isarg, type, size, name);
 	if (scope > 0) {
 		const char *sign = "";
 		if (delta < 0) {
@@ -93,10 +93,10 @@ R_API bool r_anal_var_add(RAnal *a, ut64 addr, int scope, int delta, char kind,
 			sign = "_";
 		}
 		/* local variable */
-		const char *fcn_key = sdb_fmt ("fcn.0x%"PFMT64x ".%c", addr, kind);
-		const char *var_key = sdb_fmt ("var.0x%"PFMT64x ".%c.%d.%s%d", addr, kind, scope, sign, delta);
-		const char *name_key = sdb_fmt ("var.0x%"PFMT64x ".%d.%s", addr, scope, name);
-		const char *shortvar = sdb_fmt ("%d.%s%d", scope, sign, delta);
+		r_strf_var (fcn_key, 64, "fcn.0x%"PFMT64x ".%c", addr, kind);
+		r_strf_var (var_key, 256, "var.0x%"PFMT64x ".%c.%d.%s%d", addr, kind, scope, sign, delta);
+		r_strf_var (name_key, 256, "var.0x%"PFMT64x ".%d.%s", addr, scope, name);
+		r_strf_var (shortvar, 256, "%d.%s%d", scope, sign, delta);
 		sdb_array_add (DB, fcn_key, shortvar, 0);
 		sdb_set (DB, var_key, var_def, 0);
 		if (*sign) {
@@ -107,8 +107,8 @@ R_API bool r_anal_var_add(RAnal *a, ut64 addr, int scope, int delta, char kind,
 		free (name_val);
 	} else {
 		/* global variable */
-		const char *var_global = sdb_fmt ("var.0x%"PFMT64x, addr);
-		const char *var_def = sdb_fmt ("%c.%s,%d,%s", kind, type, size, name);
+		r_strf_var (var_global, 64, "var.0x%"PFMT64x, addr);
+		r_strf_var (var_def, 256, "%c.%s,%d,%s", kind, type, size, name);
 		sdb_array_add (DB, var_global, var_def, 0);
 	}
 	return true;
@@ -151,15 +151,15 @@ R_API int r_anal_var_retype(RAnal *a, ut64 addr, int scope, int delta, char kind
 		eprintf ("Invalid var kind '%c'\n", kind);
 		return false;
 	}
-	const char *var_def = sdb_fmt ("%d,%s,%d,%s", isarg, type, size, name);
+	r_strf_var (var_def, 256, "%d,%s,%d,%s", isarg, type, size, name);
 	if (scope > 0) {
 		char *sign = delta >= 0 ? "": "_";
 		/* local variable */
-		const char *fcn_key = sdb_fmt ("fcn.0x%"PFMT64x ".%c", fcn->addr, kind);
-		const char *var_key = sdb_fmt ("var.0x%"PFMT64x ".%c.%d.%s%d", fcn->addr, kind, scope, sign, R_ABS(delta));
-		const char *name_key = sdb_fmt ("var.0x%"PFMT64x ".%d.%s", fcn->addr, scope, name);
-		const char *shortvar = sdb_fmt ("%d.%s%d", scope, sign, R_ABS(delta));
-		const char *name_val = sdb_fmt ("%c,%d", kind, delta);
+		r_strf_var (fcn_key, 64, "fcn.0x%"PFMT64x ".%c", fcn->addr, kind);
+		r_strf_var (var_key, 256, "var.0x%"PFMT64x ".%c.%d.%s%d", fcn->addr, kind, scope, sign, R_ABS(delta));
+		r_strf_var (name_key, 256, "var.0x%"PFMT64x ".%d.%s", fcn->addr, scope, name);
+		r_strf_var (shortvar, 256, "%d.%s%d", scope, sign, R_ABS(delta));
+		r_strf_var (name_val, 64, "%c,%d", kind, delta);
 		sdb_array_add (DB, fcn_key, shortvar, 0);
 		sdb_set (DB, var_key, var_def, 0);
 		sdb_set (DB, name_key, name_val, 0);
@@ -184,7 +184,7 @@ R_API int r_anal_var_retype(RAnal *a, ut64 addr, int scope, int delta, char kind
 		}
 	} else {
 		/* global variable */
-		const char *var_global = sdb_fmt ("var.0x%"PFMT64x, fcn->addr);
+		r_strf_var (var_global, 64, "var.0x%"PFMT64x, fcn->addr);
 		sdb_array_add (DB, var_global, var_def, 0);
 	}
 	return true;
@@ -218,10 +218,10 @@ R_API int r_anal_var_delete(RAnal *a, ut64 addr, const char kind, int scope, int
 			delta = -delta;
 			sign = "_";
 		}
-		char *fcn_key = sdb_fmt ("fcn.0x%"PFMT64x ".%c", addr, kind);
-		char *var_key = sdb_fmt ("var.0x%"PFMT64x ".%c.%d.%s%d", addr, kind, scope, sign, delta);
-		char *name_key = sdb_fmt ("var.0x%"PFMT64x ".%d.%s", addr, scope, av->name);
-		char *shortvar = sdb_fmt ("%d.%s%d", scope, sign, delta);
+		r_strf_var (fcn_key, 64, "fcn.0x%"PFMT64x ".%c", addr, kind);
+		r_strf_var (var_key, 256, "var.0x%"PFMT64x ".%c.%d.%s%d", addr, kind, scope, sign, delta);
+		r_strf_var (name_key, 256, "var.0x%"PFMT64x ".%d.%s", addr, scope, av->name);
+		r_strf_var (shortvar, 256, "%d.%s%d", scope, sign, delta);
 		sdb_array_remove (DB, fcn_key, shortvar, 0);
 		sdb_unset (DB, var_key, 0);
 		sdb_unset (DB, name_key, 0);
@@ -229,8 +229,8 @@ R_API int r_anal_var_delete(RAnal *a, ut64 addr, const char kind, int scope, int
 			delta = -delta;
 		}
 	} else {
-		const char *var_global = sdb_fmt ("var.0x%"PFMT64x, addr);
-		const char *var_def = sdb_fmt ("%c.%s,%d,%s", kind, av->type, av->size, av->name);
+		r_strf_var (var_global, 64, "var.0x%"PFMT64x, addr);
+		r_strf_var (var_def, 256, "%c.%s,%d,%s", kind, av->type, av->size, av->name);
 		sdb_array_remove (DB, var_global, var_def, 0);
 	}
 	r_anal_var_free (av);
@@ -239,11 +239,12 @@ R_API int r_anal_var_delete(RAnal *a, ut64 addr, const char kind, int scope, int
 }
 
 R_API bool r_anal_var_delete_byname(RAnal *a, RAnalFunction *fcn, int kind, const char *name) {
+	r_strf_buffer (256);
 	char *varlist;
 	if (!a || !fcn) {
 		return false;
 	}
-	varlist = sdb_get (DB, sdb_fmt ("fcn.0x%"PFMT64x ".%c",
+	varlist = sdb_get (DB, r_strf ("fcn.0x%"PFMT64x ".%c",
 			fcn->addr, kind), 0);
 	if (varlist) {
 		char *next, *ptr = varlist;
@@ -251,7 +252,7 @@ R_API bool r_anal_var_delete_byname(RAnal *a, RAnalFunction *fcn, int kind, cons
 			do {
 				char *word = sdb_anext (ptr, &next);
 				char *sign = strstr (word, "_");
-				const char *vardef = sdb_const_get (DB, sdb_fmt (
+				const char *vardef = sdb_const_get (DB, r_strf (
 						"var.0x%"PFMT64x ".%c.%s",
 						fcn->addr, kind, word), 0);
 				if (sign) {
@@ -288,7 +289,7 @@ R_API RAnalVar *r_anal_var_get_byname(RAnal *a, ut64 addr, const char *name) {
 		// eprintf ("No something\n");
 		return NULL;
 	}
-	char *name_key = sdb_fmt ("var.0x%"PFMT64x ".%d.%s", addr, 1, name);
+	r_strf_var (name_key, 256, "var.0x%"PFMT64x ".%d.%s", addr, 1, name);
 	char *name_value = sdb_get (DB, name_key, 0);
 	if (!name_value) {
 		// eprintf ("Cant find key for %s\n", name_key);
@@ -318,7 +319,7 @@ R_API RAnalVar *r_anal_var_get(RAnal *a, ut64 addr, char kind, int scope, int de
 		delta = -delta;
 		sign = "_";
 	}
-	const char *varkey = sdb_fmt ("var.0x%"PFMT64x ".%c.%d.%s%d",
+	r_strf_var (varkey, 128, "var.0x%"PFMT64x ".%c.%d.%s%d",
 			fcn->addr, kind, scope, sign, delta);
 	char *vardef = sdb_get (DB, varkey, 0);
 	if (!vardef) {
@@ -449,30 +450,28 @@ R_API int r_anal_var_rename(RAnal *a, ut64 addr, int scope, char kind, const cha
 
 // Used for linking reg based arg and local-var like "mov [local_8h], rsi"
 static void r_anal_var_link(RAnal *a, ut64 addr, RAnalVar *var) {
-	const char *inst_key = sdb_fmt ("inst.0x%" PFMT64x ".lvar", addr);
-	const char *var_def = sdb_fmt ("0x%" PFMT64x ",%c,0x%x,0x%x", var->addr,
+	r_strf_var (inst_key, 64, "inst.0x%" PFMT64x ".lvar", addr);
+	r_strf_var (var_def, 64, "0x%" PFMT64x ",%c,0x%x,0x%x", var->addr,
 		var->kind, var->scope, var->delta);
 	sdb_set (DB, inst_key, var_def, 0);
 }
 
 // avr
 R_API int r_anal_var_access(RAnal *a, ut64 var_addr, char kind, int scope, int delta, int xs_type, ut64 xs_addr) {
-	const char *var_global;
+	r_strf_buffer (64);
 	const char *xs_type_str = xs_type? "writes": "reads";
 	// TODO: kind is not used
 	if (scope > 0) { // local
-		const char *var_local = sdb_fmt ("var.0x%"PFMT64x ".%d.%d.%s",
+		r_strf_var (var_local, 64, "var.0x%"PFMT64x ".%d.%d.%s",
 			var_addr, scope, delta, xs_type_str);
-		const char *inst_key = sdb_fmt ("inst.0x%"PFMT64x ".vars", xs_addr);
-		const char *var_def = sdb_fmt ("0x%"PFMT64x ",%c,0x%x,0x%x", var_addr,
-			kind, scope, delta);
-		sdb_set (DB, inst_key, var_def, 0);
+		r_strf_var (inst_key, 64, "inst.0x%"PFMT64x ".vars", xs_addr);
+		sdb_set (DB, inst_key, r_strf ("0x%"PFMT64x ",%c,0x%x,0x%x", var_addr,
+			kind, scope, delta), 0);
 		return sdb_array_add_num (DB, var_local, xs_addr, 0);
 	}
 	// global
-	sdb_add (DB, sdb_fmt ("var.0x%"PFMT64x, var_addr), "a,", 0);
-	var_global = sdb_fmt ("var.0x%"PFMT64x ".%s", var_addr, xs_type_str);
-	return sdb_array_add_num (DB, var_global, xs_addr, 0);
+	sdb_add (DB, r_strf ("var.0x%"PFMT64x, var_addr), "a,", 0);
+	return sdb_array_add_num (DB, r_strf ("var.0x%"PFMT64x ".%s", var_addr, xs_type_str), xs_addr, 0);
 }
 
 R_API void r_anal_var_access_clear(RAnal *a, ut64 var_addr, int scope, int delta) {
@@ -569,7 +568,7 @@ static char *get_varname(RAnal *a, RAnalFunction *fcn, char type, const char *pf
 	char v_kind = 0;
 	int v_delta = 0;
 	while (1) {
-		char *name_key = sdb_fmt ("var.0x%"PFMT64x ".%d.%s", fcn->addr, 1, varname);
+		r_strf_var (name_key, 256, "var.0x%"PFMT64x ".%d.%s", fcn->addr, 1, varname);
 		char *name_value = sdb_get (a->sdb_fcns, name_key, 0);
 		if (!name_value) {
 			break;
@@ -617,7 +616,8 @@ static void extract_arg(RAnal *anal, RAnalFunction *fcn, RAnalOp *op, const char
 	if (!esil_buf) {
 		return;
 	}
-	char *ptr_end = strstr (esil_buf, sdb_fmt (",%s,%s", reg, sign));
+	r_strf_var (reg_sign, 64, ",%s,%s", reg, sign);
+	char *ptr_end = strstr (esil_buf, reg_sign);
 	if (!ptr_end) {
 		free (esil_buf);
 		return;
@@ -805,7 +805,8 @@ static RList *var_generate_list(RAnal *a, RAnalFunction *fcn, int kind, bool dyn
 	if (kind < 1) {
 		kind = R_ANAL_VAR_KIND_BPV; // by default show vars
 	}
-	char *varlist = sdb_get (DB, sdb_fmt ("fcn.0x%"PFMT64x ".%c", fcn->addr, kind), 0);
+	r_strf_buffer (256);
+	char *varlist = sdb_get (DB, r_strf ("fcn.0x%"PFMT64x ".%c", fcn->addr, kind), 0);
 	if (varlist && *varlist) {
 		char *next, *ptr = varlist;
 		do {
@@ -813,7 +814,7 @@ static RList *var_generate_list(RAnal *a, RAnalFunction *fcn, int kind, bool dyn
 			if (r_str_nlen (word, 3) < 3) {
 				return NULL;
 			}
-			const char *vardef = sdb_const_get (DB, sdb_fmt (
+			const char *vardef = sdb_const_get (DB, r_strf (
 				"var.0x%"PFMT64x ".%c.%s",
 				fcn->addr, kind, word), 0);
 			if (word[2] == '_') {
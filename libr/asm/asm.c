@@ -228,14 +228,13 @@ R_API void r_asm_free(RAsm *a) {
 	if (!a) {
 		return;
 	}
-	if (a->cur && a->cur->fini) {
-		a->cur->fini (a->cur->user);
-	}
+	// plugin_free runs the fini of every plugin, the current one included
 	if (a->plugins) {
 		r_list_free (a->plugins);
 		a->plugins = NULL;
 	}
 	r_syscall_free (a->syscall);
+	r_asm_cache_reset (a);
 	free (a->cpu);
 	sdb_free (a->pair);
 	ht_pp_free (a->flags);
@@ -254,14 +253,15 @@ R_API bool r_asm_add(RAsm *a, RAsmPlugin *foo) {
 	if (!foo->name) {
 		return false;
 	}
-	if (foo->init) {
-		foo->init (a->user);
-	}
 	r_list_foreach (a->plugins, iter, h) {
 		if (!strcmp (h->name, foo->name)) {
 			return false;
 		}
 	}
+	// init and fini are paired, fini runs when the plugin list is freed
+	if (foo->init) {
+		foo->init (a->user);
+	}
 	r_list_append (a->plugins, foo);
 	return true;
 }
@@ -396,6 +396,99 @@ static bool isInvalid (RAsmOp *op) {
 	return (buf_asm && *buf_asm && !strcmp (buf_asm, "invalid"));
 }
 
+R_API void r_asm_cache_reset(RAsm *a) {
+	r_return_if_fail (a);
+	RAsmCache *c = &a->cache;
+	if (c->items) {
+		int i;
+		for (i = 0; i < R_ASM_CACHE_SIZE; i++) {
+			free (c->items[i].text);
+		}
+		R_FREE (c->items);
+	}
+	R_FREE (c->cpu);
+	R_FREE (c->features);
+	c->cur = NULL;
+	c->epoch++;
+}
+
+/* start a new epoch if anything the decoder depends on has changed. bits
+ * are part of the key instead, arm/thumb and x86 16/32 switches are common */
+static void cache_sync(RAsm *a) {
+	RAsmCache *c = &a->cache;
+	// r_asm_filter_output can switch the parse plugin of the same RParse
+	const void *ofilter_cur = a->ofilter? a->ofilter->cur: NULL;
+	if (c->cur == a->cur && c->bin == a->binb.bin && c->ofilter == a->ofilter
+			&& c->ofilter_cur == ofilter_cur
+			&& c->big_endian == a->big_endian
+			&& c->syntax == a->syntax && c->invhex == a->invhex
+			&& c->pcalign == a->pcalign && c->seggrn == a->seggrn
+			&& c->immdisp == a->immdisp
+			&& !strcmp (r_str_get (c->cpu), r_str_get (a->cpu))
+			&& !strcmp (r_str_get (c->features), r_str_get (a->features))) {
+		return;
+	}
+	c->cur = a->cur;
+	c->bin = a->binb.bin;
+	c->ofilter = a->ofilter;
+	c->ofilter_cur = ofilter_cur;
+	c->big_endian = a->big_endian;
+	c->syntax = a->syntax;
+	c->invhex = a->invhex;
+	c->pcalign = a->pcalign;
+	c->seggrn = a->seggrn;
+	c->immdisp = a->immdisp;
+	free (c->cpu);
+	c->cpu = a->cpu? strdup (a->cpu): NULL;
+	free (c->features);
+	c->features = a->features? strdup (a->features): NULL;
+	c->epoch++;
+}
+
+static inline RAsmCacheItem *cache_item(RAsm *a) {
+	return &a->cache.items[(a->pc ^ (a->pc >> 12) ^ a->bits) % R_ASM_CACHE_SIZE];
+}
+
+static bool cache_get(RAsm *a, RAsmOp *op, const ut8 *buf, int len, int *ret) {
+	cache_sync (a);
+	if (!a->cache.items) {
+		a->cache.items = R_NEWS0 (RAsmCacheItem, R_ASM_CACHE_SIZE);
+		if (!a->cache.items) {
+			return false;
+		}
+	}
+	RAsmCacheItem *it = cache_item (a);
+	if (it->text && it->pc == a->pc && it->bits == a->bits && it->epoch == a->cache.epoch
+			&& it->size <= len && !memcmp (it->bytes, buf, it->size)) {
+		R_PROF_COUNT (asm_cache_hit);
+		op->size = it->size;
+		op->payload = it->payload;
+		r_strbuf_set (&op->buf_asm, it->text);
+		r_asm_op_set_buf (op, buf, it->size);
+		*ret = it->ret;
+		return true;
+	}
+	R_PROF_COUNT (asm_cache_miss);
+	return false;
+}
+
+static void cache_set(RAsm *a, RAsmOp *op, const ut8 *buf, int ret) {
+	if (!a->cache.items || ret < 1 || op->bitsize > 0 || op->size < 1
+			|| op->size > R_ASM_CACHE_OPSZ || isInvalid (op)) {
+		return;
+	}
+	RAsmCacheItem *it = cache_item (a);
+	free (it->text);
+	it->text = strdup (r_strbuf_get (&op->buf_asm));
+	it->pc = a->pc;
+	it->bits = a->bits;
+	it->epoch = a->cache.epoch;
+	it->ret = ret;
+	it->size = op->size;
+	it->payload = op->payload;
+	memcpy (it->bytes, buf, op->size);
+}
+
 R_API int r_asm_disassemble(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
 	r_asm_op_init (op);
 	r_return_val_if_fail (a && buf && op, -1);
@@ -415,6 +508,10 @@ R_API int r_asm_disassemble(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
 			return -1;
 		}
 	}
+	bool usecache = a->usecache && !a->bitshift;
+	if (usecache && cache_get (a, op, buf, len, &ret)) {
+		return ret;
+	}
 	if (a->cur && a->cur->disassemble) {
 		// shift buf N bits
 		if (a->bitshift > 0) {
@@ -461,6 +558,9 @@ R_API int r_asm_disassemble(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
 	}
 	int opsz = (op->size > 0)? R_MAX (0, R_MIN (len, op->size)): 1;
 	r_asm_op_set_buf (op, buf, opsz);
+	if (usecache && op->size <= len) {
+		cache_set (a, op, buf, ret);
+	}
 	return ret;
 }
 
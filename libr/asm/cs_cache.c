@@ -0,0 +1,138 @@
+/* radare2 - LGPL - Copyright 2026 - agent */
+
+#include <r_util.h>
+#include "cs_cache.h"
+
+#ifndef CS_CACHE
+#define CS_CACHE(x) r_asm_cs_##x
+#endif
+
+#define CS_CACHE_SIZE 8
+
+typedef struct {
+	cs_arch arch;
+	cs_mode mode;
+	csh handle;
+	cs_insn *insn;
+} CsCacheItem;
+
+typedef struct {
+	CsCacheItem items[CS_CACHE_SIZE];
+	int next;
+} CsCache;
+
+static R_TH_LOCAL CsCache *cs_cache = NULL;
+/* plugin instances using the tables, counted across threads */
+static int cs_cache_users = 0;
+#if HAVE_PTHREAD
+static pthread_mutex_t cs_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void cs_cache_item_close(CsCacheItem *it) {
+	if (it->insn) {
+		cs_free (it->insn, 1);
+		it->insn = NULL;
+	}
+	if (it->handle) {
+		cs_close (&it->handle);
+		it->handle = 0;
+	}
+}
+
+static void cs_cache_free(void *p) {
+	CsCache *c = p;
+	int i;
+	if (c) {
+		for (i = 0; i < CS_CACHE_SIZE; i++) {
+			cs_cache_item_close (&c->items[i]);
+		}
+		free (c);
+	}
+}
+
+#if HAVE_PTHREAD
+/* the key destructor releases the tables of the threads that exit */
+static pthread_key_t cs_cache_key;
+static pthread_once_t cs_cache_once = PTHREAD_ONCE_INIT;
+
+static void cs_cache_key_new(void) {
+	(void)pthread_key_create (&cs_cache_key, cs_cache_free);
+}
+#endif
+
+static CsCache *cs_cache_thread(void) {
+	if (!cs_cache) {
+		cs_cache = R_NEW0 (CsCache);
+#if HAVE_PTHREAD
+		if (cs_cache) {
+			pthread_once (&cs_cache_once, cs_cache_key_new);
+			pthread_setspecific (cs_cache_key, cs_cache);
+		}
+#endif
+	}
+	return cs_cache;
+}
+
+R_API csh CS_CACHE(get)(cs_arch arch, cs_mode mode, cs_insn **insn) {
+	CsCache *c = cs_cache_thread ();
+	CsCacheItem *it = NULL;
+	int i;
+	if (!c) {
+		return 0;
+	}
+	for (i = 0; i < CS_CACHE_SIZE; i++) {
+		CsCacheItem *ci = &c->items[i];
+		if (ci->handle && ci->arch == arch && ci->mode == mode) {
+			it = ci;
+			break;
+		}
+	}
+	if (!it) {
+		it = &c->items[c->next];
+		c->next = (c->next + 1) % CS_CACHE_SIZE;
+		cs_cache_item_close (it);
+		if (cs_open (arch, mode, &it->handle) != CS_ERR_OK) {
+			it->handle = 0;
+			return 0;
+		}
+		it->arch = arch;
+		it->mode = mode;
+	}
+	if (insn) {
+		if (!it->insn) {
+			it->insn = cs_malloc (it->handle);
+		}
+		*insn = it->insn;
+	}
+	return it->handle;
+}
+
+R_API void CS_CACHE(init)(void) {
+#if HAVE_PTHREAD
+	pthread_mutex_lock (&cs_cache_lock);
+#endif
+	cs_cache_users++;
+#if HAVE_PTHREAD
+	pthread_mutex_unlock (&cs_cache_lock);
+#endif
+}
+
+R_API void CS_CACHE(fini)(void) {
+#if HAVE_PTHREAD
+	pthread_mutex_lock (&cs_cache_lock);
+#endif
+	bool last = cs_cache_users < 2;
+	if (cs_cache_users > 0) {
+		cs_cache_users--;
+	}
+#if HAVE_PTHREAD
+	pthread_mutex_unlock (&cs_cache_lock);
+#endif
+	if (last && cs_cache) {
+#if HAVE_PTHREAD
+		pthread_setspecific (cs_cache_key, NULL);
+#endif
+		cs_cache_free (cs_cache);
+		cs_cache = NULL;
+	}
+}
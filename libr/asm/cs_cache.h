@@ -0,0 +1,29 @@
+#ifndef R_CS_CACHE_H
+#define R_CS_CACHE_H
+
+#include <r_types.h>
+#include <capstone/capstone.h>
+
+/* per-thread capstone engines keyed by arch and mode, shared by all the
+ * capstone plugins of a library. switching modes (arm/thumb, 16/32/64
+ * bits) picks an engine that is already open instead of reopening one,
+ * and threads never share a handle. libr_asm and libr_anal link their own
+ * copy of capstone, so each library keeps its own tables (r_asm_cs_*,
+ * r_anal_cs_*) and a handle never crosses from one to the other.
+ *
+ * get returns the engine for (arch, mode). when insn is not NULL it also
+ * gets a cs_insn owned by that engine, for cs_disasm_iter. both stay valid
+ * until the next get or the last fini on the same thread.
+ *
+ * every plugin instance takes a reference with init and drops it with fini,
+ * from its init and fini callbacks. the last fini closes the calling
+ * thread's engines, the ones of other threads are closed when they exit */
+
+R_API void r_asm_cs_init(void);
+R_API csh r_asm_cs_get(cs_arch arch, cs_mode mode, cs_insn **insn);
+R_API void r_asm_cs_fini(void);
+R_API void r_anal_cs_init(void);
+R_API csh r_anal_cs_get(cs_arch arch, cs_mode mode, cs_insn **insn);
+R_API void r_anal_cs_fini(void);
+
+#endif
@@ -6,8 +6,9 @@
 #include "../arch/arm/asm-arm.h"
 
 bool arm64ass(const char *str, ut64 addr, ut32 *op);
-static csh cd = 0;
+static R_TH_LOCAL csh cd = 0;
 
+#include "../cs_cache.h"
 #include "cs_mnemonics.c"
 
 static bool check_features(RAsm *a, cs_insn *insn) {
@@ -40,20 +41,12 @@ static bool check_features(RAsm *a, cs_insn *insn) {
 }
 
 static int disassemble(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
-	static int omode = -1;
-	static int obits = 32;
 	bool disp_hash = a->immdisp;
 	cs_insn* insn = NULL;
 	cs_mode mode = 0;
-	int ret, n = 0;
+	int ret = 0, n = 0;
 	mode |= (a->bits == 16)? CS_MODE_THUMB: CS_MODE_ARM;
 	mode |= (a->big_endian)? CS_MODE_BIG_ENDIAN: CS_MODE_LITTLE_ENDIAN;
-	if (mode != omode || a->bits != obits) {
-		cs_close (&cd);
-		cd = 0; // unnecessary
-		omode = mode;
-		obits = a->bits;
-	}
 
 	if (a->cpu) {
 		if (strstr (a->cpu, "cortex")) {
@@ -74,14 +67,10 @@ static int disassemble(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
 		op->size = 4;
 		r_strbuf_set (&op->buf_asm, "");
 	}
-	if (!cd || mode != omode) {
-		ret = (a->bits == 64)?
-			cs_open (CS_ARCH_ARM64, mode, &cd):
-			cs_open (CS_ARCH_ARM, mode, &cd);
-		if (ret) {
-			ret = -1;
-			goto beach;
-		}
+	cd = r_asm_cs_get ((a->bits == 64)? CS_ARCH_ARM64: CS_ARCH_ARM, mode, NULL);
+	if (!cd) {
+		ret = -1;
+		goto beach;
 	}
 	cs_option (cd, CS_OPT_SYNTAX, (a->syntax == R_ASM_SYNTAX_REGNUM)
 			? CS_OPT_SYNTAX_NOREGNAME
@@ -118,7 +107,6 @@ static int disassemble(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
 	}
 	cs_free (insn, n);
 	beach:
-	cs_close (&cd);
 	if (op) {
 		if (!*r_strbuf_get (&op->buf_asm)) {
 			r_strbuf_set (&op->buf_asm, "invalid");
@@ -177,6 +165,17 @@ static int assemble(RAsm *a, RAsmOp *op, const char *buf) {
 	return opsize;
 }
 
+static bool the_init(void *p) {
+	r_asm_cs_init ();
+	return true;
+}
+
+static bool the_end(void *p) {
+	r_asm_cs_fini ();
+	cd = 0;
+	return true;
+}
+
 RAsmPlugin r_asm_plugin_arm_cs = {
 	.name = "arm",
 	.desc = "Capstone ARM disassembler",
@@ -189,6 +188,8 @@ RAsmPlugin r_asm_plugin_arm_cs = {
 	.disassemble = &disassemble,
 	.mnemonics = mnemonics,
 	.assemble = &assemble,
+	.init = the_init,
+	.fini = the_end,
 #if 0
 	// arm32 and arm64
 	"crypto,databarrier,divide,fparmv8,multpro,neon,t2extractpack,"
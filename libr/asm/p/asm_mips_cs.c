@@ -6,12 +6,13 @@
 
 R_IPI int mips_assemble(const char *str, ut64 pc, ut8 *out);
 
-static csh cd = 0;
+static R_TH_LOCAL csh cd = 0;
+#include "../cs_cache.h"
 #include "cs_mnemonics.c"
 
 static int disassemble(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
 	cs_insn* insn;
-	int mode, n, ret = -1;
+	int mode, n;
 	mode = (a->big_endian)? CS_MODE_BIG_ENDIAN: CS_MODE_LITTLE_ENDIAN;
 	if (!op) {
 		return 0;
@@ -32,11 +33,8 @@ static int disassemble(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
 	mode |= (a->bits == 64)? CS_MODE_MIPS64 : CS_MODE_MIPS32;
 	memset (op, 0, sizeof (RAsmOp));
 	op->size = 4;
-	if (cd != 0) {
-		cs_close (&cd);
-	}
-	ret = cs_open (CS_ARCH_MIPS, mode, &cd);
-	if (ret) {
+	cd = r_asm_cs_get (CS_ARCH_MIPS, mode, NULL);
+	if (!cd) {
 		goto fin;
 	}
 	if (a->syntax == R_ASM_SYNTAX_REGNUM) {
@@ -84,6 +82,17 @@ static int assemble(RAsm *a, RAsmOp *op, const char *str) {
 	return ret;
 }
 
+static bool the_init(void *p) {
+	r_asm_cs_init ();
+	return true;
+}
+
+static bool the_end(void *p) {
+	r_asm_cs_fini ();
+	cd = 0;
+	return true;
+}
+
 RAsmPlugin r_asm_plugin_mips_cs = {
 	.name = "mips",
 	.desc = "Capstone MIPS disassembler",
@@ -94,7 +103,9 @@ RAsmPlugin r_asm_plugin_mips_cs = {
 	.endian = R_SYS_ENDIAN_LITTLE | R_SYS_ENDIAN_BIG,
 	.disassemble = &disassemble,
 	.mnemonics = mnemonics,
-	.assemble = &assemble
+	.assemble = &assemble,
+	.init = the_init,
+	.fini = the_end
 };
 
 #ifndef CORELIB
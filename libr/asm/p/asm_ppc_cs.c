@@ -6,13 +6,18 @@
 #include "../arch/ppc/libvle/vle.h"
 #include "../arch/ppc/libps/libps.h"
 
-static csh handle = 0;
+static R_TH_LOCAL csh handle = 0;
+
+#include "../cs_cache.h"
+
+static bool the_init(void *p) {
+	r_asm_cs_init ();
+	return true;
+}
 
 static bool the_end(void *p) {
-	if (handle) {
-		cs_close (&handle);
-		handle = 0;
-	}
+	r_asm_cs_fini ();
+	handle = 0;
 	return true;
 }
 
@@ -54,7 +59,6 @@ static int decompile_ps(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
 }
 
 static int disassemble(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
-	static int omode = -1, obits = -1;
 	int n, ret;
 	ut64 off = a->pc;
 	cs_insn* insn;
@@ -80,17 +84,9 @@ static int disassemble(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
 			return op->size;
 		}
 	}
-	if (mode != omode || a->bits != obits) {
-		cs_close (&handle);
-		handle = 0;
-		omode = mode;
-		obits = a->bits;
-	}
-	if (handle == 0) {
-		ret = cs_open (CS_ARCH_PPC, mode, &handle);
-		if (ret != CS_ERR_OK) {
-			return -1;
-		}
+	handle = r_asm_cs_get (CS_ARCH_PPC, mode, NULL);
+	if (!handle) {
+		return -1;
 	}
 	op->size = 4;
 	cs_option (handle, CS_OPT_DETAIL, CS_OPT_OFF);
@@ -118,6 +114,7 @@ RAsmPlugin r_asm_plugin_ppc_cs = {
 	.cpus = "ppc,vle,ps",
 	.bits = 32 | 64,
 	.endian = R_SYS_ENDIAN_LITTLE | R_SYS_ENDIAN_BIG,
+	.init = the_init,
 	.fini = the_end,
 	.disassemble = &disassemble,
 };
@@ -6,8 +6,15 @@
 
 #define USE_ITER_API 0
 
-static csh cd = 0;
-static int n = 0;
+static R_TH_LOCAL csh cd = 0;
+static R_TH_LOCAL int n = 0;
+
+#include "../cs_cache.h"
+
+static bool the_init(void *p) {
+	r_asm_cs_init ();
+	return true;
+}
 
 static bool the_end(void *p) {
 #if 0
@@ -18,10 +25,8 @@ static bool the_end(void *p) {
 	}
 #endif
 #endif
-	if (cd) {
-		cs_close (&cd);
-		cd = 0;
-	}
+	r_asm_cs_fini ();
+	cd = 0;
 	return true;
 }
 
@@ -32,26 +37,18 @@ static int check_features(RAsm *a, cs_insn *insn);
 #include "asm_x86_vm.c"
 
 static int disassemble(RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
-	static int omode = 0;
-	int mode, ret;
+	int mode;
 	ut64 off = a->pc;
 
 	mode =  (a->bits == 64)? CS_MODE_64:
 		(a->bits == 32)? CS_MODE_32:
 		(a->bits == 16)? CS_MODE_16: 0;
-	if (cd && mode != omode) {
-		cs_close (&cd);
-		cd = 0;
-	}
 	if (op) {
 		op->size = 0;
 	}
-	omode = mode;
-	if (cd == 0) {
-		ret = cs_open (CS_ARCH_X86, mode, &cd);
-		if (ret) {
-			return 0;
-		}
+	cd = r_asm_cs_get (CS_ARCH_X86, mode, NULL);
+	if (!cd) {
+		return 0;
 	}
 	if (a->features && *a->features) {
 		cs_option (cd, CS_OPT_DETAIL, CS_OPT_ON);
@@ -162,6 +159,7 @@ RAsmPlugin r_asm_plugin_x86_cs = {
 	.arch = "x86",
 	.bits = 16|32|64,
 	.endian = R_SYS_ENDIAN_LITTLE,
+	.init = the_init,
 	.fini = the_end,
 	.mnemonics = mnemonics,
 	.disassemble = &disassemble,
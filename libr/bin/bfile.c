@@ -10,6 +10,10 @@
 
 static RBinString *find_string_at(RBinFile *bf, RList *ret, ut64 addr) {
 	if (addr != 0 && addr != UT64_MAX) {
+		if (bf->rbin && bf->rbin->lazy) {
+			// dumping strings does not fill strings_db
+			r_bin_object_load_items (bf, bf->o, R_BIN_REQ_STRINGS);
+		}
 		RBinString *res = ht_up_find (bf->o->strings_db, addr, NULL);
 		return res;
 	}
@@ -173,11 +173,12 @@ R_API void r_bin_import_free(void *_imp) {
 	}
 }
 
-R_API const char *r_bin_symbol_name(RBinSymbol *s) {
+// the returned string must be freed
+R_API char *r_bin_symbol_name(RBinSymbol *s) {
 	if (s->dup_count) {
-		return sdb_fmt ("%s_%d", s->name, s->dup_count);
+		return r_str_newf ("%s_%d", s->name, s->dup_count);
 	}
-	return s->name;
+	return strdup (s->name);
 }
 
 R_API void r_bin_symbol_free(void *_sym) {
@@ -734,15 +735,24 @@ R_API RList *r_bin_get_entries(RBin *bin) {
 	return o ? o->entries : NULL;
 }
 
+/* current object, parsing the req item kinds first when bin.lazy is set */
+static RBinObject *cur_object_with(RBin *bin, ut64 req) {
+	RBinFile *bf = r_bin_cur (bin);
+	if (bf && bf->o && bin->lazy) {
+		r_bin_object_load_items (bf, bf->o, req);
+	}
+	return bf? bf->o: NULL;
+}
+
 R_API RList *r_bin_get_fields(RBin *bin) {
 	r_return_val_if_fail (bin, NULL);
-	RBinObject *o = r_bin_cur_object (bin);
+	RBinObject *o = cur_object_with (bin, R_BIN_REQ_FIELDS);
 	return o ? o->fields : NULL;
 }
 
 R_API RList *r_bin_get_imports(RBin *bin) {
 	r_return_val_if_fail (bin, NULL);
-	RBinObject *o = r_bin_cur_object (bin);
+	RBinObject *o = cur_object_with (bin, R_BIN_REQ_IMPORTS);
 	return o ? o->imports : NULL;
 }
 
@@ -784,7 +794,7 @@ R_API RList *r_bin_patch_relocs_list(RBin *bin) {
 
 R_API RBNode *r_bin_get_relocs(RBin *bin) {
 	r_return_val_if_fail (bin, NULL);
-	RBinObject *o = r_bin_cur_object (bin);
+	RBinObject *o = cur_object_with (bin, R_BIN_REQ_RELOCS);
 	return o ? o->relocs : NULL;
 }
 
@@ -830,6 +840,7 @@ R_API RList *r_bin_reset_strings(RBin *bin) {
 		r_list_free (o->strings);
 		o->strings = NULL;
 	}
+	o->loaded |= R_BIN_REQ_STRINGS;
 
 	if (bin->minstrlen <= 0) {
 		return NULL;
@@ -849,7 +860,7 @@ R_API RList *r_bin_reset_strings(RBin *bin) {
 
 R_API RList *r_bin_get_strings(RBin *bin) {
 	r_return_val_if_fail (bin, NULL);
-	RBinObject *o = r_bin_cur_object (bin);
+	RBinObject *o = cur_object_with (bin, R_BIN_REQ_STRINGS);
 	return o ? o->strings : NULL;
 }
 
@@ -873,7 +884,7 @@ R_API int r_bin_is_string(RBin *bin, ut64 va) {
 
 R_API RList *r_bin_get_symbols(RBin *bin) {
 	r_return_val_if_fail (bin, NULL);
-	RBinObject *o = r_bin_cur_object (bin);
+	RBinObject *o = cur_object_with (bin, R_BIN_REQ_SYMBOLS);
 	return o? o->symbols: NULL;
 }
 
@@ -1303,7 +1314,7 @@ R_API RBuffer *r_bin_package(RBin *bin, const char *type, const char *file, RLis
 
 R_API RList * /*<RBinClass>*/ r_bin_get_classes(RBin *bin) {
 	r_return_val_if_fail (bin, NULL);
-	RBinObject *o = r_bin_cur_object (bin);
+	RBinObject *o = cur_object_with (bin, R_BIN_REQ_CLASSES);
 	return o ? o->classes : NULL;
 }
 
@@ -1328,10 +1339,14 @@ R_IPI RBinClass *r_bin_class_new(RBinFile *binfile, const char *name, const char
 		return NULL;
 	}
 	RBinObject *o = binfile->o;
-	RList *list = o->classes;
 	if (!name) {
 		return NULL;
 	}
+	if (binfile->rbin && binfile->rbin->lazy) {
+		// or parsing them later would replace this list
+		r_bin_object_load_items (binfile, o, R_BIN_REQ_CLASSES);
+	}
+	RList *list = o->classes;
 	RBinClass *c = class_get (binfile, name);
 	if (c) {
 		if (super) {
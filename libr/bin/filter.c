@@ -30,19 +30,20 @@ static char *hashify(char *s, ut64 vaddr) {
 
 // - name should be allocated on the heap
 R_API char *r_bin_filter_name(RBinFile *bf, Sdb *db, ut64 vaddr, char *name) {
+	r_strf_buffer (256);
 	r_return_val_if_fail (db && name, NULL);
 
 	char *resname = name;
-	const char *uname = sdb_fmt ("%" PFMT64x ".%s", vaddr, resname);
+	const char *uname = r_strf ("%" PFMT64x ".%s", vaddr, resname);
 	ut32 vhash = sdb_hash (uname); // vaddr hash - unique
 	ut32 hash = sdb_hash (resname); // name hash - if dupped and not in unique hash must insert
-	int count = sdb_num_inc (db, sdb_fmt ("%x", hash), 1, 0);
+	int count = sdb_num_inc (db, r_strf ("%x", hash), 1, 0);
 
-	if (sdb_exists (db, sdb_fmt ("%x", vhash))) {
+	if (sdb_exists (db, r_strf ("%x", vhash))) {
 		// TODO: symbol is dupped, so symbol can be removed!
 		return resname;
 	}
-	sdb_num_set (db, sdb_fmt ("%x", vhash), 1, 0);
+	sdb_num_set (db, r_strf ("%x", vhash), 1, 0);
 	if (vaddr) {
 		char *p = hashify (resname, vaddr);
 		if (p) {
@@ -62,6 +63,7 @@ R_API char *r_bin_filter_name(RBinFile *bf, Sdb *db, ut64 vaddr, char *name) {
 }
 
 R_API void r_bin_filter_sym(RBinFile *bf, HtPP *ht, ut64 vaddr, RBinSymbol *sym) {
+	r_strf_buffer (256);
 	r_return_if_fail (ht && sym && sym->name);
 	const char *name = sym->name;
 	// if (!strncmp (sym->name, "imp.", 4)) {
@@ -91,13 +93,13 @@ R_API void r_bin_filter_sym(RBinFile *bf, HtPP *ht, ut64 vaddr, RBinSymbol *sym)
 		}
 	}
 
-	const char *uname = sdb_fmt ("%" PFMT64x ".%s", vaddr, name);
+	const char *uname = r_strf ("%" PFMT64x ".%s", vaddr, name);
 	bool res = ht_pp_insert (ht, uname, sym);
 	if (!res) {
 		return;
 	}
 
-	const char *oname = sdb_fmt ("o.%" PFMT64x ".%s", 0, name);
+	const char *oname = r_strf ("o.%" PFMT64x ".%s", 0, name);
 	ut32 *dup_count = ht_pp_find (ht, oname, NULL);
 	if (!dup_count) {
 		dup_count = R_NEW0 (ut32);
@@ -361,8 +361,9 @@ static PE_DWord bin_pe_va_to_rva(RBinPEObj* bin, PE_DWord va) {
 }
 
 static char* resolveModuleOrdinal(Sdb* sdb, const char* module, int ordinal) {
+	r_strf_buffer (64);
 	Sdb* db = sdb;
-	char* foo = sdb_get (db, sdb_fmt ("%d", ordinal), 0);
+	char* foo = sdb_get (db, r_strf ("%d", ordinal), 0);
 	if (foo && *foo) {
 		return foo;
 	} else {
@@ -384,7 +385,7 @@ static int bin_pe_parse_imports(struct PE_(r_bin_pe_obj_t)* bin,
 	Sdb* db = NULL;
 	char* sdb_module = NULL;
 	char* symname;
-	char* filename;
+	char filename[256] = {0};
 	char* symdllname = NULL;
 
 	if (!dll_name || *dll_name == '0') {
@@ -430,12 +431,12 @@ static int bin_pe_parse_imports(struct PE_(r_bin_pe_obj_t)* bin,
 					db = NULL;
 					free (sdb_module);
 					sdb_module = strdup (symdllname);
-					filename = sdb_fmt ("%s.sdb", symdllname);
+					snprintf (filename, sizeof (filename), "%s.sdb", symdllname);
 					if (r_file_exists (filename)) {
 						db = sdb_new (NULL, filename, 0);
 					} else {
 						const char *dirPrefix = r_sys_prefix (NULL);
-						filename = sdb_fmt (R_JOIN_4_PATHS ("%s", R2_SDB_FORMAT, "dll", "%s.sdb"),
+						snprintf (filename, sizeof (filename), R_JOIN_4_PATHS ("%s", R2_SDB_FORMAT, "dll", "%s.sdb"),
 							dirPrefix, symdllname);
 						if (r_file_exists (filename)) {
 							db = sdb_new (NULL, filename, 0);
@@ -1248,6 +1249,7 @@ static int bin_pe_init_resource(struct PE_(r_bin_pe_obj_t)* bin) {
 }
 
 static void bin_pe_store_tls_callbacks(struct PE_(r_bin_pe_obj_t)* bin, PE_DWord callbacks) {
+	r_strf_buffer (64);
 	PE_DWord paddr, haddr;
 	int count = 0;
 	PE_DWord addressOfTLSCallback = 1;
@@ -1267,12 +1269,12 @@ static void bin_pe_store_tls_callbacks(struct PE_(r_bin_pe_obj_t)* bin, PE_DWord
 				break;
 			}
 		}
-		key = sdb_fmt ("pe.tls_callback%d_vaddr", count);
+		key = r_strf ("pe.tls_callback%d_vaddr", count);
 		sdb_num_set (bin->kv, key, addressOfTLSCallback, 0);
-		key = sdb_fmt ("pe.tls_callback%d_paddr", count);
+		key = r_strf ("pe.tls_callback%d_paddr", count);
 		paddr = bin_pe_rva_to_paddr (bin, bin_pe_va_to_rva (bin, (PE_DWord) addressOfTLSCallback));
 		sdb_num_set (bin->kv, key, paddr,                0);
-		key = sdb_fmt ("pe.tls_callback%d_haddr", count);
+		key = r_strf ("pe.tls_callback%d_haddr", count);
 		haddr = callbacks;
 		sdb_num_set (bin->kv, key, haddr,                0);
 		count++;
@@ -2382,6 +2384,7 @@ static void _parse_resource_directory(struct PE_(r_bin_pe_obj_t) *bin, Pe_image_
 }
 
 static void _store_resource_sdb(struct PE_(r_bin_pe_obj_t) *bin) {
+	r_strf_buffer (64);
 	RListIter *iter;
 	r_pe_resource *rs;
 	int index = 0;
@@ -2392,18 +2395,18 @@ static void _store_resource_sdb(struct PE_(r_bin_pe_obj_t) *bin) {
 		return;
 	}
 	r_list_foreach (bin->resources, iter, rs) {
-		key = sdb_fmt ("resource.%d.timestr", index);
+		key = r_strf ("resource.%d.timestr", index);
 		sdb_set (sdb, key, rs->timestr, 0);
-		key = sdb_fmt ("resource.%d.vaddr", index);
+		key = r_strf ("resource.%d.vaddr", index);
 		vaddr = bin_pe_rva_to_va (bin, rs->data->OffsetToData);
 		sdb_num_set (sdb, key, vaddr, 0);
-		key = sdb_fmt ("resource.%d.name", index);
+		key = r_strf ("resource.%d.name", index);
 		sdb_set (sdb, key, rs->name, 0);
-		key = sdb_fmt ("resource.%d.size", index);
+		key = r_strf ("resource.%d.size", index);
 		sdb_num_set (sdb, key, rs->data->Size, 0);
-		key = sdb_fmt ("resource.%d.type", index);
+		key = r_strf ("resource.%d.type", index);
 		sdb_set (sdb, key, rs->type, 0);
-		key = sdb_fmt ("resource.%d.language", index);
+		key = r_strf ("resource.%d.language", index);
 		sdb_set (sdb, key, rs->language, 0);
 		index++;
 	}
@@ -29,6 +29,7 @@ R_IPI RBinObject *r_bin_object_new(RBinFile *binfile, RBinPlugin *plugin, ut64 b
 R_IPI RBinObject *r_bin_object_get_cur(RBin *bin);
 R_IPI RBinObject *r_bin_object_find_by_arch_bits(RBinFile *binfile, const char *arch, int bits, const char *name);
 R_IPI RBNode *r_bin_object_patch_relocs(RBin *bin, RBinObject *o);
+R_IPI void r_bin_object_load_items(RBinFile *binfile, RBinObject *o, ut64 req);
 
 R_IPI const char *r_bin_lang_tostring(int lang);
 R_IPI int r_bin_lang_type(RBinFile *binfile, const char *def, const char *sym);
@@ -26,10 +26,6 @@ static int reloc_cmp(const void *a, const RBNode *b) {
 	return 0;
 }
 
-static void reloc_free(RBNode *rbn) {
-	free (container_of (rbn, RBinReloc, vrb));
-}
-
 static void object_delete_items(RBinObject *o) {
 	ut32 i = 0;
 	r_return_if_fail (o);
@@ -38,7 +34,8 @@ static void object_delete_items(RBinObject *o) {
 	r_list_free (o->fields);
 	r_list_free (o->imports);
 	r_list_free (o->libs);
-	r_rbtree_free (o->relocs, reloc_free);
+	R_FREE (o->relocs_packed);
+	o->relocs = NULL;
 	r_list_free (o->sections);
 	r_list_free (o->strings);
 	ht_up_free (o->strings_db);
@@ -142,6 +139,7 @@ static RList *classes_from_symbols(RBinFile *bf) {
 
 // TODO: kill offset and sz, because those should be infered from binfile->buf
 R_IPI RBinObject *r_bin_object_new(RBinFile *bf, RBinPlugin *plugin, ut64 baseaddr, ut64 loadaddr, ut64 offset, ut64 sz) {
+	r_strf_buffer (64);
 	r_return_val_if_fail (bf && plugin, NULL);
 	ut64 bytes_sz = r_buf_size (bf->buf);
 	Sdb *sdb = bf->sdb;
@@ -208,7 +206,7 @@ R_IPI RBinObject *r_bin_object_new(RBinFile *bf, RBinPlugin *plugin, ut64 basead
 	//	bf->sdb_addrinfo = sdb_ns (bf->sdb, "addrinfo", 1);
 	//	bf->sdb_addrinfo->refs++;
 		sdb_ns_set (sdb, "cur", bdb); // bf->sdb);
-		const char *fdns = sdb_fmt ("fd.%d", bf->fd);
+		const char *fdns = r_strf ("fd.%d", bf->fd);
 		sdb_ns_set (sdb, fdns, bdb); // bf->sdb);
 		bf->sdb->refs++;
 	}
@@ -249,83 +247,74 @@ static void filter_classes(RBinFile *bf, RList *list) {
 	ht_pp_free (ht);
 }
 
-static RBNode *list2rbtree(RList *relocs) {
+/* relocs are the most numerous items of big binaries, they are copied in a
+ * single array owned by the object instead of one allocation each. the
+ * tree indexes that array by address. relocs takes the ownership of the
+ * items of the list, the list itself is left to the caller */
+static void object_set_relocs(RBinObject *o, RList *relocs) {
 	RListIter *it;
 	RBinReloc *reloc;
-	RBNode *res = NULL;
+	int i = 0, n = r_list_length (relocs);
 
+	R_FREE (o->relocs_packed);
+	o->relocs = NULL;
+	relocs->free = free;
+	if (n < 1 || !(o->relocs_packed = R_NEWS (RBinReloc, n))) {
+		return;
+	}
 	r_list_foreach (relocs, it, reloc) {
-		r_rbtree_insert (&res, reloc, &reloc->vrb, reloc_cmp);
+		RBinReloc *r = &o->relocs_packed[i++];
+		*r = *reloc;
+		r_rbtree_insert (&o->relocs, r, &r->vrb, reloc_cmp);
 	}
-	return res;
 }
 
-R_API int r_bin_object_set_items(RBinFile *binfile, RBinObject *o) {
-	int i;
-	bool isSwift = false;
+/* the language is guessed from the symbols and needs the info */
+static void object_load_lang(RBinFile *binfile, RBinObject *o) {
+	if (o->info && o->lang != R_BIN_NM_SWIFT && binfile->rbin->filter_rules & (R_BIN_REQ_SYMBOLS | R_BIN_REQ_IMPORTS)) {
+		o->lang = r_bin_load_languages (binfile);
+	}
+}
 
-	r_return_val_if_fail (binfile && o && o->plugin, false);
+/* parse the item kinds in req (R_BIN_REQ_IMPORTS, _SYMBOLS, _FIELDS,
+ * _RELOCS, _STRINGS and _CLASSES) that are not loaded yet. With bin.lazy
+ * this is deferred until the first r_bin_get_* call that needs them */
+R_IPI void r_bin_object_load_items(RBinFile *binfile, RBinObject *o, ut64 req) {
+	r_strf_buffer (256);
+	r_return_if_fail (binfile && o && o->plugin);
 
 	RBin *bin = binfile->rbin;
 	RBinObject *old_o = binfile->o;
 	RBinPlugin *cp = o->plugin;
 	int minlen = (binfile->rbin->minstrlen > 0) ? binfile->rbin->minstrlen : cp->minstrlen;
-	binfile->o = o;
-
-	if (cp->file_type) {
-		int type = cp->file_type (binfile);
-		if (type == R_BIN_TYPE_CORE) {
-			if (cp->regstate) {
-				o->regstate = cp->regstate (binfile);
-			}
-			if (cp->maps) {
-				o->maps = cp->maps (binfile);
-			}
-		}
-	}
+	bool isSwift = false;
 
-	if (cp->baddr) {
-		ut64 old_baddr = o->baddr;
-		o->baddr = cp->baddr (binfile);
-		r_bin_object_set_baddr (o, old_baddr);
-	}
-	if (cp->boffset) {
-		o->boffset = cp->boffset (binfile);
-	}
-	// XXX: no way to get info from xtr pluginz?
-	// Note, object size can not be set from here due to potential
-	// inconsistencies
-	if (cp->size) {
-		o->size = cp->size (binfile);
-	}
-	// XXX this is expensive because is O(n^n)
-	if (cp->binsym) {
-		for (i = 0; i < R_BIN_SYM_LAST; i++) {
-			o->binsym[i] = cp->binsym (binfile, i);
-			if (o->binsym[i]) {
-				o->binsym[i]->paddr += o->loadaddr;
-			}
-		}
+	if (req & R_BIN_REQ_CLASSES) {
+		// classes are built from the symbols when the plugin can't
+		req |= R_BIN_REQ_SYMBOLS;
 	}
-	if (cp->entries) {
-		o->entries = cp->entries (binfile);
-		REBASE_PADDR (o, o->entries, RBinAddr);
+	req &= ~o->loaded;
+	if (!req) {
+		return;
 	}
-	if (cp->fields) {
+	o->loaded |= req;
+	binfile->o = o;
+
+	if (req & R_BIN_REQ_FIELDS && cp->fields) {
 		o->fields = cp->fields (binfile);
 		if (o->fields) {
 			o->fields->free = r_bin_field_free;
 			REBASE_PADDR (o, o->fields, RBinField);
 		}
 	}
-	if (cp->imports) {
+	if (req & R_BIN_REQ_IMPORTS && cp->imports) {
 		r_list_free (o->imports);
 		o->imports = cp->imports (binfile);
 		if (o->imports) {
 			o->imports->free = r_bin_import_free;
 		}
 	}
-	if (cp->symbols) {
+	if (req & R_BIN_REQ_SYMBOLS && cp->symbols) {
 		o->symbols = cp->symbols (binfile); // 5s
 		if (o->symbols) {
 			o->symbols->free = r_bin_symbol_free;
@@ -335,32 +324,15 @@ R_API int r_bin_object_set_items(RBinFile *binfile, RBinObject *o) {
 			}
 		}
 	}
-	o->info = cp->info? cp->info (binfile): NULL;
-	if (cp->libs) {
-		o->libs = cp->libs (binfile);
-	}
-	if (cp->sections) {
-		// XXX sections are populated by call to size
-		if (!o->sections) {
-			o->sections = cp->sections (binfile);
-		}
-		REBASE_PADDR (o, o->sections, RBinSection);
-		if (bin->filter) {
-			r_bin_filter_sections (binfile, o->sections);
-		}
-	}
-	if (bin->filter_rules & (R_BIN_REQ_RELOCS | R_BIN_REQ_IMPORTS)) {
-		if (cp->relocs) {
-			RList *l = cp->relocs (binfile);
-			if (l) {
-				REBASE_PADDR (o, l, RBinReloc);
-				o->relocs = list2rbtree (l);
-				l->free = NULL;
-				r_list_free (l);
-			}
+	if (req & R_BIN_REQ_RELOCS && cp->relocs) {
+		RList *l = cp->relocs (binfile);
+		if (l) {
+			REBASE_PADDR (o, l, RBinReloc);
+			object_set_relocs (o, l);
+			r_list_free (l);
 		}
 	}
-	if (bin->filter_rules & R_BIN_REQ_STRINGS) {
+	if (req & R_BIN_REQ_STRINGS) {
 		if (cp->strings) {
 			o->strings = cp->strings (binfile);
 		} else {
@@ -371,12 +343,13 @@ R_API int r_bin_object_set_items(RBinFile *binfile, RBinObject *o) {
 		}
 		REBASE_PADDR (o, o->strings, RBinString);
 	}
-	if (bin->filter_rules & R_BIN_REQ_CLASSES) {
+	if (req & R_BIN_REQ_CLASSES) {
 		if (cp->classes) {
 			o->classes = cp->classes (binfile);
 			isSwift = r_bin_lang_swift (binfile);
 			if (isSwift) {
 				o->classes = classes_from_symbols (binfile);
+				o->lang = R_BIN_NM_SWIFT;
 			}
 		} else {
 			o->classes = classes_from_symbols (binfile);
@@ -395,14 +368,102 @@ R_API int r_bin_object_set_items(RBinFile *binfile, RBinObject *o) {
 				o->addr2klassmethod = sdb_new0 ();
 				r_list_foreach (klasses, iter, klass) {
 					r_list_foreach (klass->methods, iter2, method) {
-						char *km = sdb_fmt ("method.%s.%s", klass->name, method->name);
-						char *at = sdb_fmt ("0x%08"PFMT64x, method->vaddr);
+						char *km = r_strf ("method.%s.%s", klass->name, method->name);
+						char *at = r_strf ("0x%08"PFMT64x, method->vaddr);
 						sdb_set (o->addr2klassmethod, at, km, 0);
 					}
 				}
 			}
 		}
 	}
+	if (req & R_BIN_REQ_SYMBOLS && !isSwift) {
+		object_load_lang (binfile, o);
+	}
+	binfile->o = old_o;
+}
+
+R_API int r_bin_object_set_items(RBinFile *binfile, RBinObject *o) {
+	int i;
+
+	r_return_val_if_fail (binfile && o && o->plugin, false);
+
+	RBin *bin = binfile->rbin;
+	RBinObject *old_o = binfile->o;
+	RBinPlugin *cp = o->plugin;
+	binfile->o = o;
+	o->loaded = 0;
+
+	if (cp->file_type) {
+		int type = cp->file_type (binfile);
+		if (type == R_BIN_TYPE_CORE) {
+			if (cp->regstate) {
+				o->regstate = cp->regstate (binfile);
+			}
+			if (cp->maps) {
+				o->maps = cp->maps (binfile);
+			}
+		}
+	}
+
+	if (cp->baddr) {
+		ut64 old_baddr = o->baddr;
+		o->baddr = cp->baddr (binfile);
+		r_bin_object_set_baddr (o, old_baddr);
+	}
+	if (cp->boffset) {
+		o->boffset = cp->boffset (binfile);
+	}
+	// XXX: no way to get info from xtr pluginz?
+	// Note, object size can not be set from here due to potential
+	// inconsistencies
+	if (cp->size) {
+		o->size = cp->size (binfile);
+	}
+	// XXX this is expensive because is O(n^n)
+	if (cp->binsym) {
+		for (i = 0; i < R_BIN_SYM_LAST; i++) {
+			o->binsym[i] = cp->binsym (binfile, i);
+			if (o->binsym[i]) {
+				o->binsym[i]->paddr += o->loadaddr;
+			}
+		}
+	}
+	if (cp->entries) {
+		o->entries = cp->entries (binfile);
+		REBASE_PADDR (o, o->entries, RBinAddr);
+	}
+	// same order as the plugins always saw: some of them fill their
+	// internal state while parsing these and read it back in info/sections
+	if (!bin->lazy) {
+		r_bin_object_load_items (binfile, o, R_BIN_REQ_FIELDS | R_BIN_REQ_IMPORTS | R_BIN_REQ_SYMBOLS);
+	}
+	o->info = cp->info? cp->info (binfile): NULL;
+	if (cp->libs) {
+		o->libs = cp->libs (binfile);
+	}
+	if (cp->sections) {
+		// XXX sections are populated by call to size
+		if (!o->sections) {
+			o->sections = cp->sections (binfile);
+		}
+		REBASE_PADDR (o, o->sections, RBinSection);
+		if (bin->filter) {
+			r_bin_filter_sections (binfile, o->sections);
+		}
+	}
+	if (!bin->lazy) {
+		ut64 req = 0;
+		if (bin->filter_rules & (R_BIN_REQ_RELOCS | R_BIN_REQ_IMPORTS)) {
+			req |= R_BIN_REQ_RELOCS;
+		}
+		if (bin->filter_rules & R_BIN_REQ_STRINGS) {
+			req |= R_BIN_REQ_STRINGS;
+		}
+		if (bin->filter_rules & R_BIN_REQ_CLASSES) {
+			req |= R_BIN_REQ_CLASSES;
+		}
+		r_bin_object_load_items (binfile, o, req);
+	}
 	if (cp->lines) {
 		o->lines = cp->lines (binfile);
 	}
@@ -416,12 +477,8 @@ R_API int r_bin_object_set_items(RBinFile *binfile, RBinObject *o) {
 	if (cp->mem)  {
 		o->mem = cp->mem (binfile);
 	}
-	if (bin->filter_rules & (R_BIN_REQ_SYMBOLS | R_BIN_REQ_IMPORTS)) {
-		if (isSwift) {
-			o->lang = R_BIN_NM_SWIFT;
-		} else {
-			o->lang = r_bin_load_languages (binfile);
-		}
+	if (!bin->lazy) {
+		object_load_lang (binfile, o);
 	}
 	binfile->o = old_o;
 	return true;
@@ -431,6 +488,9 @@ R_IPI RBNode *r_bin_object_patch_relocs(RBin *bin, RBinObject *o) {
 	r_return_val_if_fail (bin && o, NULL);
 
 	static bool first = true;
+	if (bin->lazy && bin->cur && bin->cur->o == o) {
+		r_bin_object_load_items (bin->cur, o, R_BIN_REQ_RELOCS);
+	}
 	// r_bin_object_set_items set o->relocs but there we don't have access
 	// to io so we need to be run from bin_relocs, free the previous reloc and get
 	// the patched ones
@@ -440,9 +500,9 @@ R_IPI RBNode *r_bin_object_patch_relocs(RBin *bin, RBinObject *o) {
 		if (!tmp) {
 			return o->relocs;
 		}
-		r_rbtree_free (o->relocs, reloc_free);
 		REBASE_PADDR (o, tmp, RBinReloc);
-		o->relocs = list2rbtree (tmp);
+		object_set_relocs (o, tmp);
+		r_list_free (tmp);
 		first = false;
 	}
 	return o->relocs;
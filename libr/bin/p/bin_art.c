@@ -35,24 +35,25 @@ typedef struct {
 } ArtObj;
 
 static int art_header_load(ArtObj *ao, Sdb *db) {
+	r_strf_buffer (64);
 	/* TODO: handle read errors here */
 	if (r_buf_size (ao->buf) < sizeof (ARTHeader)) {
 		return false;
 	}
 	ARTHeader *art = &ao->art;
 	(void) r_buf_fread_at (ao->buf, 0, (ut8 *) art, "IIiiiiiiiiiiii", 1);
-	sdb_set (db, "img.base", sdb_fmt ("0x%x", art->image_base), 0);
-	sdb_set (db, "img.size", sdb_fmt ("0x%x", art->image_size), 0);
-	sdb_set (db, "art.checksum", sdb_fmt ("0x%x", art->checksum), 0);
-	sdb_set (db, "art.version", sdb_fmt ("%c%c%c",
+	sdb_set (db, "img.base", r_strf ("0x%x", art->image_base), 0);
+	sdb_set (db, "img.size", r_strf ("0x%x", art->image_size), 0);
+	sdb_set (db, "art.checksum", r_strf ("0x%x", art->checksum), 0);
+	sdb_set (db, "art.version", r_strf ("%c%c%c",
 			art->version[0], art->version[1], art->version[2]), 0);
-	sdb_set (db, "oat.begin", sdb_fmt ("0x%x", art->oat_file_begin), 0);
-	sdb_set (db, "oat.end", sdb_fmt ("0x%x", art->oat_file_end), 0);
-	sdb_set (db, "oat_data.begin", sdb_fmt ("0x%x", art->oat_data_begin), 0);
-	sdb_set (db, "oat_data.end", sdb_fmt ("0x%x", art->oat_data_end), 0);
-	sdb_set (db, "patch_delta", sdb_fmt ("0x%x", art->patch_delta), 0);
-	sdb_set (db, "image_roots", sdb_fmt ("0x%x", art->image_roots), 0);
-	sdb_set (db, "compile_pic", sdb_fmt ("0x%x", art->compile_pic), 0);
+	sdb_set (db, "oat.begin", r_strf ("0x%x", art->oat_file_begin), 0);
+	sdb_set (db, "oat.end", r_strf ("0x%x", art->oat_file_end), 0);
+	sdb_set (db, "oat_data.begin", r_strf ("0x%x", art->oat_data_begin), 0);
+	sdb_set (db, "oat_data.end", r_strf ("0x%x", art->oat_data_end), 0);
+	sdb_set (db, "patch_delta", r_strf ("0x%x", art->patch_delta), 0);
+	sdb_set (db, "image_roots", r_strf ("0x%x", art->image_roots), 0);
+	sdb_set (db, "compile_pic", r_strf ("0x%x", art->compile_pic), 0);
 	return true;
 }
 
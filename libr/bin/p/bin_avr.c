@@ -123,10 +123,11 @@ static void addsym(RList *ret, const char *name, ut64 addr) {
 }
 
 static void addptr(RList *ret, const char *name, ut64 addr, RBuffer *b) {
+	r_strf_buffer (256);
 	if (b && rjmp (b, 0)) {
-		addsym (ret, sdb_fmt ("vector.%s", name), addr);
+		addsym (ret, r_strf ("vector.%s", name), addr);
 		ut64 ptr_addr = rjmp_dest (addr, b);
-		addsym (ret, sdb_fmt ("syscall.%s", name), ptr_addr);
+		addsym (ret, r_strf ("syscall.%s", name), ptr_addr);
 	}
 }
 
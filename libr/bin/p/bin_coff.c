@@ -42,6 +42,7 @@ static RBinAddr *binsym(RBinFile *bf, int sym) {
 }
 
 static bool _fill_bin_symbol(struct r_bin_coff_obj *bin, int idx, RBinSymbol **sym) {
+	r_strf_buffer (64);
 	RBinSymbol *ptr = *sym;
 	struct coff_symbol *s = NULL;
 	if (idx < 0 || idx > bin->hdr.f_nsyms) {
@@ -76,7 +77,7 @@ static bool _fill_bin_symbol(struct r_bin_coff_obj *bin, int idx, RBinSymbol **s
 		ptr->type = r_str_const ("STATIC");
 		break;
 	default:
-		ptr->type = r_str_const (sdb_fmt ("%i", s->n_sclass));
+		ptr->type = r_str_const (r_strf ("%i", s->n_sclass));
 		break;
 	}
 	if (bin->symbols[idx].n_scnum < bin->hdr.f_nscns &&
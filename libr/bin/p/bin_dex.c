@@ -1105,6 +1105,7 @@ static const ut8 *parse_dex_class_method(RBinFile *binfile, RBinDexObj *bin,
 		const ut8 *p, const ut8 *p_end,
 		int *sym_count, ut64 DM, int *methods,
 		bool is_direct, const ut8 *bufbuf) {
+	r_strf_buffer (64);
 	struct r_bin_t *rbin = binfile->rbin;
 	bool bin_dbginfo = rbin->want_dbginfo;
 	int i;
@@ -1357,7 +1358,7 @@ static const ut8 *parse_dex_class_method(RBinFile *binfile, RBinDexObj *bin,
 				if (!mdb) {
 					mdb = sdb_new0 ();
 				}
-				sdb_num_set (mdb, sdb_fmt ("method.%d", MI), sym->paddr, 0);
+				sdb_num_set (mdb, r_strf ("method.%d", MI), sym->paddr, 0);
 				// -----------------
 				// WORK IN PROGRESS
 				// -----------------
@@ -1367,7 +1368,7 @@ static const ut8 *parse_dex_class_method(RBinFile *binfile, RBinDexObj *bin,
 						if (!cdb) {
 							cdb = sdb_new0 ();
 						}
-						sdb_num_set (cdb, sdb_fmt ("%d", c->class_id), sym->paddr, 0);
+						sdb_num_set (cdb, r_strf ("%d", c->class_id), sym->paddr, 0);
 					}
 				}
 #endif
@@ -1642,6 +1643,7 @@ static bool is_class_idx_in_code_classes(RBinDexObj *bin, int class_idx) {
 }
 
 static int dex_loadcode(RBinFile *bf, RBinDexObj *bin) {
+	r_strf_buffer (64);
 	struct r_bin_t *rbin = bf->rbin;
 	int i;
 	int *methods = NULL;
@@ -1769,7 +1771,7 @@ static int dex_loadcode(RBinFile *bf, RBinDexObj *bin) {
 				sym->paddr = sym->vaddr = bin->header.method_offset + (sizeof (struct dex_method_t) * i) ;
 				sym->ordinal = sym_count++;
 				r_list_append (bin->methods_list, sym);
-				sdb_num_set (mdb, sdb_fmt ("method.%d", i), sym->paddr, 0);
+				sdb_num_set (mdb, r_strf ("method.%d", i), sym->paddr, 0);
 
 			}
 			free (signature);
@@ -1887,8 +1889,9 @@ static RList *entries(RBinFile *bf) {
 }
 
 static ut64 offset_of_method_idx(RBinFile *bf, struct r_bin_dex_obj_t *dex, int idx) {
+	r_strf_buffer (64);
 	// ut64 off = dex->header.method_offset + idx;
-	return sdb_num_get (mdb, sdb_fmt ("method.%d", idx), 0);
+	return sdb_num_get (mdb, r_strf ("method.%d", idx), 0);
 }
 
 static ut64 dex_field_offset(RBinDexObj *bin, int fid) {
@@ -2087,6 +2090,7 @@ static RList *lines(RBinFile *bf) {
 
 // iH*
 static RList *dex_fields(RBinFile *bf) {
+	r_strf_buffer (64);
 	RList *ret = r_list_new ();
 	if (!ret) {
 		return NULL;
@@ -2095,7 +2099,7 @@ static RList *dex_fields(RBinFile *bf) {
 	ut64 addr = 0;
 
 #define ROW(nam,siz,val,fmt) \
-	r_list_append (ret, r_bin_field_new (addr, addr, siz, nam, sdb_fmt ("0x%08"PFMT64x, (ut64)val), fmt)); \
+	r_list_append (ret, r_bin_field_new (addr, addr, siz, nam, r_strf ("0x%08"PFMT64x, (ut64)val), fmt)); \
 	addr += siz;
 
 	r_buf_seek (bf->buf, 0, R_BUF_SET);
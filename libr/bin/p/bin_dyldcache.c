@@ -13,6 +13,9 @@
 
 #define R_IS_PTR_AUTHENTICATED(x) B_IS_SET(x, 63)
 
+// number of rebased pages kept around by dyldcache_io_read
+#define PAGE_CACHE_SIZE 256
+
 typedef struct {
 	ut8 version;
 	ut64 slide;
@@ -62,6 +65,19 @@ typedef struct {
 	ut32 entries_size;
 } RDyldRebaseInfo1;
 
+typedef struct {
+	ut64 addr;
+	ut64 used;
+	ut8 *data;
+} RDyldCachedPage;
+
+typedef struct {
+	HtUP *by_addr;
+	RDyldCachedPage *pages;
+	int count;
+	ut64 tick;
+} RDyldPageCache;
+
 typedef struct _r_dyldcache {
 	ut8 magic[8];
 	RList *bins;
@@ -71,6 +87,7 @@ typedef struct _r_dyldcache {
 	cache_hdr_t *hdr;
 	cache_map_t *maps;
 	cache_accel_t *accel;
+	RDyldPageCache page_cache;
 } RDyldCache;
 
 typedef struct _r_bin_image {
@@ -138,11 +155,23 @@ static void rebase_info_free(RDyldRebaseInfo *rebase_info) {
 	}
 }
 
+static void page_cache_fini(RDyldPageCache *pc) {
+	int i;
+	for (i = 0; i < pc->count; i++) {
+		free (pc->pages[i].data);
+	}
+	R_FREE (pc->pages);
+	ht_up_free (pc->by_addr);
+	pc->by_addr = NULL;
+	pc->count = 0;
+}
+
 static void r_dyldcache_free(RDyldCache *cache) {
 	if (!cache) {
 		return;
 	}
 
+	page_cache_fini (&cache->page_cache);
 	r_list_free (cache->bins);
 	cache->bins = NULL;
 	r_buf_free (cache->buf);
@@ -937,6 +966,83 @@ static void rebase_bytes(RDyldRebaseInfo *rebase_info, ut8 *buf, ut64 offset, in
 	}
 }
 
+/* return the rebased page_size bytes at page_addr, reading and rebasing
+ * them only when the page is not in the cache. Least recently used pages
+ * are recycled once PAGE_CACHE_SIZE pages are cached */
+static ut8 *get_rebased_page(RDyldCache *cache, RIO *io, RIODesc *fd, ut64 page_addr) {
+	RDyldPageCache *pc = &cache->page_cache;
+	ut32 page_size = cache->rebase_info->page_size;
+	if (!pc->by_addr) {
+		pc->by_addr = ht_up_new0 ();
+		pc->pages = R_NEWS0 (RDyldCachedPage, PAGE_CACHE_SIZE);
+		if (!pc->by_addr || !pc->pages) {
+			page_cache_fini (pc);
+			return NULL;
+		}
+	}
+	RDyldCachedPage *page = ht_up_find (pc->by_addr, page_addr, NULL);
+	if (page) {
+		page->used = ++pc->tick;
+		return page->data;
+	}
+	if (pc->count < PAGE_CACHE_SIZE) {
+		page = &pc->pages[pc->count];
+		page->data = malloc (page_size);
+		if (!page->data) {
+			return NULL;
+		}
+		pc->count++;
+	} else {
+		int i;
+		page = &pc->pages[0];
+		for (i = 1; i < pc->count; i++) {
+			if (pc->pages[i].used < page->used) {
+				page = &pc->pages[i];
+			}
+		}
+		ht_up_delete (pc->by_addr, page->addr);
+	}
+	ut64 original_off = io->off;
+	io->off = page_addr;
+	int res = cache->original_io_read (io, fd, page->data, page_size);
+	io->off = original_off;
+	if (res != page_size) {
+		// short read at the end of the file, leave the slot unused
+		page->used = 0;
+		page->addr = UT64_MAX;
+		return NULL;
+	}
+	rebase_bytes (cache->rebase_info, page->data, page_addr, page_size, 0);
+	page->addr = page_addr;
+	page->used = ++pc->tick;
+	ht_up_insert (pc->by_addr, page_addr, page);
+	return page->data;
+}
+
+/* fill buf from the rebased page cache, returns false if any of the pages
+ * can't be cached so the caller can fall back to rebasing in place */
+static bool read_rebased_pages(RDyldCache *cache, RIO *io, RIODesc *fd, ut8 *buf, int count) {
+	ut32 page_size = cache->rebase_info->page_size;
+	ut64 addr = io->off;
+	int done = 0;
+	if (!page_size || (page_size & (page_size - 1))) {
+		return false;
+	}
+	while (done < count) {
+		ut64 page_addr = addr & ~((ut64)page_size - 1);
+		ut64 page_delta = addr - page_addr;
+		int n = R_MIN (count - done, page_size - page_delta);
+		ut8 *page = get_rebased_page (cache, io, fd, page_addr);
+		if (!page) {
+			return false;
+		}
+		memcpy (buf + done, page + page_delta, n);
+		done += n;
+		addr += n;
+	}
+	return true;
+}
+
 static int dyldcache_io_read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
 	if (!io) {
 		return -1;
@@ -951,7 +1057,7 @@ static int dyldcache_io_read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
 	RListIter *iter;
 	RBinFile *bf;
 	r_list_foreach (core->bin->binfiles, iter, bf) {
-		if (bf->fd == fd->fd ) {
+		if (bf->fd == fd->fd && bf->o && bf->o->bin_obj) {
 			if (!strncmp ((char*) bf->o->bin_obj, "dyldcac", 7)) {
 				cache = bf->o->bin_obj;
 			} else {
@@ -972,7 +1078,7 @@ static int dyldcache_io_read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
 	}
 	if (!cache) {
 		r_list_foreach (pending_bin_files, iter, bf) {
-			if (bf->fd == fd->fd && bf->o) {
+			if (bf->fd == fd->fd && bf->o && bf->o->bin_obj) {
 				if (!strncmp ((char*) bf->o->bin_obj, "dyldcac", 7)) {
 					cache = bf->o->bin_obj;
 				} else {
@@ -994,6 +1100,12 @@ static int dyldcache_io_read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
 
 	int result = 0;
 
+	if (includes_data && count > 0 && !(fd->perm & R_PERM_W)) {
+		// pages may not be modified behind our back, serve them from the cache
+		if (read_rebased_pages (cache, io, fd, buf, count)) {
+			return count;
+		}
+	}
 	if (includes_data && count > 0) {
 		RDyldRebaseInfo *rebase_info = cache->rebase_info;
 
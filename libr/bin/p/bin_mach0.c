@@ -222,6 +222,7 @@ static void _handle_arm_thumb(struct MACH0_(obj_t) *bin, RBinSymbol **p) {
 }
 
 static RList *symbols(RBinFile *bf) {
+	r_strf_buffer (64);
 	struct MACH0_(obj_t) *bin;
 	int i;
 	const struct symbol_t *symbols = NULL;
@@ -285,7 +286,7 @@ static RList *symbols(RBinFile *bf) {
 		}
 		ptr->ordinal = i;
 		bin->dbg_info = strncmp (ptr->name, "radr://", 7)? 0: 1;
-		sdb_set (symcache, sdb_fmt ("sym0x%"PFMT64x, ptr->vaddr), "found", 0);
+		sdb_set (symcache, r_strf ("sym0x%"PFMT64x, ptr->vaddr), "found", 0);
 		if (!strncmp (ptr->name, "__Z", 3)) {
 			lang = "c++";
 		}
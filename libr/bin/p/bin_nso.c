@@ -10,7 +10,7 @@
 #ifdef R_MESON_VERSION
 #include <lz4.h>
 #else
-#include "../../../shlr/lz4/lz4.c"
+#include "../../../shlr/lz4/lz4.h"
 #endif
 
 #define NSO_OFF(x) r_offsetof (NSOHeader, x)
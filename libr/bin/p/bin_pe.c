@@ -119,13 +119,14 @@ static char *signature (RBinFile *bf, bool json) {
 }
 
 static RList *fields(RBinFile *bf) {
+	r_strf_buffer (64);
 	RList *ret  = r_list_new ();
 	if (!ret) {
 		return NULL;
 	}
 
 	#define ROWL(nam,siz,val,fmt) \
-	r_list_append (ret, r_bin_field_new (addr, addr, siz, nam, sdb_fmt ("0x%08x", val), fmt));
+	r_list_append (ret, r_bin_field_new (addr, addr, siz, nam, r_strf ("0x%08x", val), fmt));
 	ut64 addr = 128;
 
 	struct PE_(r_bin_pe_obj_t) * bin = bf->o->bin_obj;
@@ -1018,6 +1018,7 @@ static void handle_data_sections(RBinSection *sect) {
 }
 
 static RList *symbols(RBinFile *bf) {
+	r_strf_buffer (64);
 	RList *ret = r_list_newf (free);
 	if (!ret) {
 		return NULL;
@@ -1037,7 +1038,7 @@ static RList *symbols(RBinFile *bf) {
 	RBinSymbol *sym;
 	ut64 enosys_addr = 0;
 	r_list_foreach (ret, iter, sym) {
-		const char *key = sdb_fmt ("%"PFMT64x, sym->vaddr);
+		const char *key = r_strf ("%"PFMT64x, sym->vaddr);
 		sdb_ht_insert (kernel_syms_by_addr, key, sym->dname ? sym->dname : sym->name);
 		if (!enosys_addr && strstr (sym->name, "enosys")) {
 			enosys_addr = sym->vaddr;
@@ -1047,7 +1048,7 @@ static RList *symbols(RBinFile *bf) {
 	RList *syscalls = resolve_syscalls (obj, enosys_addr);
 	if (syscalls) {
 		r_list_foreach (syscalls, iter, sym) {
-			const char *key = sdb_fmt ("%"PFMT64x, sym->vaddr);
+			const char *key = r_strf ("%"PFMT64x, sym->vaddr);
 			sdb_ht_insert (kernel_syms_by_addr, key, sym->name);
 			r_list_append (ret, sym);
 		}
@@ -1058,7 +1059,7 @@ static RList *symbols(RBinFile *bf) {
 	RList *subsystem = resolve_mig_subsystem (obj);
 	if (subsystem) {
 		r_list_foreach (subsystem, iter, sym) {
-			const char *key = sdb_fmt ("%"PFMT64x, sym->vaddr);
+			const char *key = r_strf ("%"PFMT64x, sym->vaddr);
 			sdb_ht_insert (kernel_syms_by_addr, key, sym->name);
 			r_list_append (ret, sym);
 		}
@@ -1316,6 +1317,7 @@ static HtPP *mig_hash_new() {
 }
 
 static RList *resolve_mig_subsystem(RKernelCacheObj *obj) {
+	r_strf_buffer (64);
 	struct section_t *sections = NULL;
 	if (!(sections = MACH0_(get_sections) (obj->mach0))) {
 		return NULL;
@@ -1422,7 +1424,7 @@ static RList *resolve_mig_subsystem(RKernelCacheObj *obj) {
 
 				int num = idx + subs_min_idx;
 				bool found = false;
-				const char *key = sdb_fmt ("%d", num);
+				const char *key = r_strf ("%d", num);
 				const char *name = sdb_ht_find (mig_hash, key, &found);
 				if (found && name && *name) {
 					sym->name = r_str_newf ("mig.%d.%s", num, name);
@@ -1478,6 +1480,7 @@ static ut64 extract_addr_from_code(ut8 *arm64_code, ut64 vaddr) {
 }
 
 static void symbols_from_stubs(RList *ret, HtPP *kernel_syms_by_addr, RKernelCacheObj *obj, RBinFile *bf, RKext *kext, int ordinal) {
+	r_strf_buffer (64);
 	RStubsInfo *stubs_info = get_stubs_info(kext->mach0, kext->range.offset, obj);
 	if (!stubs_info) {
 		return;
@@ -1510,7 +1513,7 @@ static void symbols_from_stubs(RList *ret, HtPP *kernel_syms_by_addr, RKernelCac
 				target_addr = addr;
 			}
 
-			const char *key = sdb_fmt ("%"PFMT64x, addr);
+			const char *key = r_strf ("%"PFMT64x, addr);
 			const char *name = sdb_ht_find (kernel_syms_by_addr, key, &found);
 
 			if (found) {
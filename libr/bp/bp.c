@@ -18,6 +18,20 @@ static void r_bp_item_free (RBreakpointItem *b) {
 	free (b);
 }
 
+/* items are ordered by address and then by pointer, so no two of them
+ * compare equal. probes (size -1, never linked) go before every item at the
+ * same address so r_skiplist_find_geq returns the first one */
+static int bp_addr_cmp(const void *a, const void *b) {
+	const RBreakpointItem *x = a, *y = b;
+	if (x->addr != y->addr) {
+		return x->addr < y->addr ? -1 : 1;
+	}
+	if (x->size < 0 || y->size < 0) {
+		return (y->size < 0) - (x->size < 0);
+	}
+	return (x > y) - (x < y);
+}
+
 R_API RBreakpoint *r_bp_new() {
 	int i;
 	RBreakpointPlugin *static_plugin;
@@ -31,6 +45,7 @@ R_API RBreakpoint *r_bp_new() {
 	bp->traces = r_bp_traptrace_new ();
 	bp->cb_printf = (PrintfCallback)printf;
 	bp->bps = r_list_newf ((RListFree)r_bp_item_free);
+	bp->bps_addr = r_skiplist_new (NULL, bp_addr_cmp);
 	bp->plugins = r_list_newf ((RListFree)free);
 	bp->nhwbps = 0;
 	for (i = 0; bp_static_plugins[i]; i++) {
@@ -44,6 +59,7 @@ R_API RBreakpoint *r_bp_new() {
 }
 
 R_API RBreakpoint *r_bp_free(RBreakpoint *bp) {
+	r_skiplist_free (bp->bps_addr);
 	r_list_free (bp->bps);
 	r_list_free (bp->plugins);
 	r_list_free (bp->traces);
@@ -89,14 +105,9 @@ repeat:
 }
 
 R_API RBreakpointItem *r_bp_get_at(RBreakpoint *bp, ut64 addr) {
-	RListIter *iter;
-	RBreakpointItem *b;
-	r_list_foreach(bp->bps, iter, b) {
-		if (b->addr == addr) {
-			return b;
-		}
-	}
-	return NULL;
+	RBreakpointItem probe = { .addr = addr, .size = -1 };
+	RBreakpointItem *b = r_skiplist_get_geq (bp->bps_addr, &probe);
+	return (b && b->addr == addr)? b: NULL;
 }
 
 static inline bool inRange(RBreakpointItem *b, ut64 addr) {
@@ -109,9 +120,15 @@ static inline bool matchProt(RBreakpointItem *b, int perm) {
 
 R_API RBreakpointItem *r_bp_get_in(RBreakpoint *bp, ut64 addr, int perm) {
 	RBreakpointItem *b;
-	RListIter *iter;
-	r_list_foreach (bp->bps, iter, b) {
-		// eprintf ("---ataddr--- 0x%08"PFMT64x" %d %d %x\n", b->addr, b->size, b->recoil, b->perm);
+	RSkipListNode *it;
+	/* only items starting in (addr - bps_maxsize, addr] can contain addr */
+	RBreakpointItem probe = { .addr = (addr >= bp->bps_maxsize)? addr - bp->bps_maxsize + 1: 0, .size = -1 };
+	it = r_skiplist_find_geq (bp->bps_addr, &probe);
+	for (; it && it != bp->bps_addr->head; it = it->forward[0]) {
+		b = it->data;
+		if (b->addr > addr) {
+			break;
+		}
 		// Check addr within range and provided perm matches (or null)
 		if (inRange (b, addr) && matchProt (b, perm)) {
 			return b;
@@ -144,14 +161,41 @@ R_API int r_bp_stepy_continuation(RBreakpoint *bp) {
 	return bp->stepcont;
 }
 
+/* adds an item returned by r_bp_item_new to the list and the address index */
+R_API void r_bp_item_link(RBreakpoint *bp, RBreakpointItem *b) {
+	bp->nbps++;
+	r_list_append (bp->bps, b);
+	r_skiplist_insert (bp->bps_addr, b);
+	if (b->size > bp->bps_maxsize) {
+		bp->bps_maxsize = b->size;
+	}
+}
+
+R_API void r_bp_item_set_addr(RBreakpoint *bp, RBreakpointItem *b, ut64 addr) {
+	if (b->addr != addr) {
+		bool indexed = r_skiplist_delete (bp->bps_addr, b);
+		b->addr = addr;
+		if (indexed) {
+			r_skiplist_insert (bp->bps_addr, b);
+		}
+	}
+}
+
 static void unlinkBreakpoint(RBreakpoint *bp, RBreakpointItem *b) {
 	int i;
 	for (i = 0; i < bp->bps_idx_count; i++) {
 		if (bp->bps_idx[i] == b) {
 			bp->bps_idx[i] = NULL;
+			if (i < bp->bps_idx_free) {
+				bp->bps_idx_free = i;
+			}
+			break;
 		}
 	}
-	r_list_delete_data (bp->bps, b);
+	r_skiplist_delete (bp->bps_addr, b);
+	if (!r_list_delete_data (bp->bps, b)) {
+		r_bp_item_free (b);
+	}
 }
 
 /* TODO: detect overlapping of breakpoints */
@@ -166,6 +210,9 @@ static RBreakpointItem *r_bp_add(RBreakpoint *bp, const ut8 *obytes, ut64 addr,
 		return NULL;
 	}
 	b = r_bp_item_new (bp);
+	if (!b) {
+		return NULL;
+	}
 	b->addr = addr + bp->delta;
 	b->size = size;
 	b->enabled = true;
@@ -175,12 +222,13 @@ static RBreakpointItem *r_bp_add(RBreakpoint *bp, const ut8 *obytes, ut64 addr,
 	if (!hw) {
 		b->bbytes = calloc (size + 16, 1);
 		if (!b->bbytes) {
+			unlinkBreakpoint (bp, b);
 			return NULL;
 		}
 		if (obytes) {
 			b->obytes = malloc (size);
 			if (!b->obytes) {
-				free (b->bbytes);
+				unlinkBreakpoint (bp, b);
 				return NULL;
 			}
 			memcpy (b->obytes, obytes, size);
@@ -196,8 +244,7 @@ static RBreakpointItem *r_bp_add(RBreakpoint *bp, const ut8 *obytes, ut64 addr,
 		}
 		b->recoil = ret;
 	}
-	bp->nbps++;
-	r_list_append (bp->bps, b);
+	r_bp_item_link (bp, b);
 	return b;
 }
 
@@ -230,22 +277,21 @@ R_API RBreakpointItem* r_bp_add_hw(RBreakpoint *bp, ut64 addr, int size, int per
 
 R_API int r_bp_del_all(RBreakpoint *bp) {
 	if (!r_list_empty (bp->bps)) {
+		r_skiplist_purge (bp->bps_addr);
 		r_list_purge (bp->bps);
+		memset (bp->bps_idx, 0, bp->bps_idx_count * sizeof (RBreakpointItem*));
+		bp->bps_idx_free = 0;
+		bp->bps_maxsize = 0;
 		return true;
 	}
 	return false;
 }
 
 R_API int r_bp_del(RBreakpoint *bp, ut64 addr) {
-	RListIter *iter;
-	RBreakpointItem *b;
-	/* No _safe loop necessary because we return immediately after the delete. */
-	r_list_foreach (bp->bps, iter, b) {
-		if (b->addr == addr) {
-			unlinkBreakpoint (bp, b);
-			// r_list_delete (bp->bps, iter);
-			return true;
-		}
+	RBreakpointItem *b = r_bp_get_at (bp, addr);
+	if (b) {
+		unlinkBreakpoint (bp, b);
+		return true;
 	}
 	return false;
 }
@@ -337,25 +383,26 @@ R_API int r_bp_list(RBreakpoint *bp, int rad) {
 
 R_API RBreakpointItem *r_bp_item_new (RBreakpoint *bp) {
 	int i, j;
-	/* find empty slot */
-	for (i = 0; i < bp->bps_idx_count; i++) {
+	/* find empty slot, all the ones below bps_idx_free are taken */
+	for (i = bp->bps_idx_free; i < bp->bps_idx_count; i++) {
 		if (!bp->bps_idx[i]) {
 			goto return_slot;
 		}
 	}
-	/* allocate new slot */
-	bp->bps_idx_count += 16; // alocate space for 16 more bps
-	RBreakpointItem **newbps = realloc (bp->bps_idx, bp->bps_idx_count * sizeof (RBreakpointItem*));
-	if (newbps) {
-		bp->bps_idx = newbps;
-	} else {
-		bp->bps_idx_count -= 16; // alocate space for 16 more bps
+	/* allocate new slots */
+	int count = bp->bps_idx_count + R_MAX (16, bp->bps_idx_count / 2);
+	RBreakpointItem **newbps = realloc (bp->bps_idx, count * sizeof (RBreakpointItem*));
+	if (!newbps) {
+		return NULL;
 	}
+	bp->bps_idx = newbps;
+	bp->bps_idx_count = count;
 	for (j = i; j < bp->bps_idx_count; j++) {
 		bp->bps_idx[j] = NULL;
 	}
 return_slot:
 	/* empty slot */
+	bp->bps_idx_free = i + 1;
 	return (bp->bps_idx[i] = R_NEW0 (RBreakpointItem));
 }
 
@@ -368,18 +415,20 @@ R_API RBreakpointItem *r_bp_get_index(RBreakpoint *bp, int idx) {
 
 R_API int r_bp_get_index_at (RBreakpoint *bp, ut64 addr) {
 	int i;
-	for (i = 0; i< bp->bps_idx_count; i++) {
-		if (bp->bps_idx[i] && bp->bps_idx[i]->addr == addr) {
-			return i;
+	RBreakpointItem *b = r_bp_get_at (bp, addr);
+	if (b) {
+		for (i = 0; i < bp->bps_idx_count; i++) {
+			if (bp->bps_idx[i] == b) {
+				return i;
+			}
 		}
 	}
 	return -1;
 }
 
 R_API int r_bp_del_index(RBreakpoint *bp, int idx) {
-	if (idx >= 0 && idx < bp->bps_idx_count) {
-		r_list_delete_data (bp->bps, bp->bps_idx[idx]);
-		R_FREE (bp->bps_idx[idx]);
+	if (idx >= 0 && idx < bp->bps_idx_count && bp->bps_idx[idx]) {
+		unlinkBreakpoint (bp, bp->bps_idx[idx]);
 		return true;
 	}
 	return false;
@@ -28,27 +28,78 @@ R_API int r_bp_restore(RBreakpoint *bp, bool set) {
 	return r_bp_restore_except (bp, set, UT64_MAX);
 }
 
+#define BP_PAGE_SIZE 0x1000
+/* largest gap between two breakpoints written with the same read/write */
+#define BP_RUN_GAP 64
+
+/* write the bytes of all the items in run with one io write */
+static void restore_run(RBreakpoint *bp, RPVector *run, bool set) {
+	size_t i, n = r_pvector_len (run);
+	RBreakpointItem *b;
+	ut8 *buf = NULL;
+	if (!n) {
+		return;
+	}
+	ut64 from = ((RBreakpointItem *)r_pvector_at (run, 0))->addr;
+	ut64 to = from;
+	for (i = 0; i < n; i++) {
+		b = r_pvector_at (run, i);
+		to = R_MAX (to, b->addr + b->size);
+	}
+	if (n > 1 && bp->iob.read_at && (buf = malloc (to - from))
+			&& bp->iob.read_at (bp->iob.io, from, buf, (int)(to - from))) {
+		for (i = 0; i < n; i++) {
+			b = r_pvector_at (run, i);
+			memcpy (buf + (b->addr - from), set? b->bbytes: b->obytes, b->size);
+		}
+		bp->iob.write_at (bp->iob.io, from, buf, (int)(to - from));
+	} else {
+		for (i = 0; i < n; i++) {
+			r_bp_restore_one (bp, r_pvector_at (run, i), set);
+		}
+	}
+	free (buf);
+	r_pvector_clear (run);
+}
+
 /**
  * reflect all r_bp stuff in the process using dbg->bp_write or ->breakpoint
  *
  * except the specified breakpoint...
+ *
+ * software breakpoints are walked in address order, and the ones that are
+ * close to each other in the same page are written with one read and one
+ * write instead of one write per breakpoint.
  */
 R_API bool r_bp_restore_except(RBreakpoint *bp, bool set, ut64 addr) {
-	bool rc = true;
-	RListIter *iter;
+	RSkipListNode *it;
 	RBreakpointItem *b;
+	RPVector run;
+	ut64 page = UT64_MAX;
+	ut64 run_end = 0;
 
-	r_list_foreach (bp->bps, iter, b) {
+	r_pvector_init (&run, NULL);
+	r_skiplist_foreach (bp->bps_addr, it, b) {
 		if (addr && b->addr == addr) {
 			continue;
 		}
 		if (bp->breakpoint && bp->breakpoint (bp, b, set)) {
 			continue;
 		}
-
+		if (b->hw || !(set? b->bbytes: b->obytes)) {
+			r_bp_restore_one (bp, b, set);
+			continue;
+		}
 		/* write (o|b)bytes from every breakpoint in r_bp if not handled by plugin */
-		r_bp_restore_one (bp, b, set);
-		rc = true;
+		if ((b->addr & ~(ut64)(BP_PAGE_SIZE - 1)) != page || b->addr > run_end + BP_RUN_GAP) {
+			restore_run (bp, &run, set);
+			page = b->addr & ~(ut64)(BP_PAGE_SIZE - 1);
+			run_end = b->addr;
+		}
+		r_pvector_push (&run, b);
+		run_end = R_MAX (run_end, b->addr + b->size);
 	}
-	return rc;
+	restore_run (bp, &run, set);
+	r_pvector_clear (&run);
+	return true;
 }
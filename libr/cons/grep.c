@@ -300,6 +300,10 @@ while_end:
 			}
 			strncpy (grep->strings[grep->nstrings],
 				optr, R_CONS_GREP_WORD_SIZE - 1);
+			if (grep->icase) {
+				// lowercase once here instead of on every grepped line
+				r_str_case (grep->strings[grep->nstrings], false);
+			}
 			grep->nstrings++;
 			if (grep->nstrings > R_CONS_GREP_WORDS - 1) {
 				eprintf ("too many grep strings\n");
@@ -702,10 +706,6 @@ R_API int r_cons_grep_line(char *buf, int len) {
 			r_str_case (in, false);
 		}
 		for (i = 0; i < grep->nstrings; i++) {
-			char *str = grep->strings[i];
-			if (grep->icase) {
-				r_str_case (str, false);
-			}
 			const char *p = r_strstr_ansi (in, grep->strings[i]);
 			if (!p) {
 				ampfail = 0;
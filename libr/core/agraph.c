@@ -47,28 +47,12 @@ static const char *mousemodes[] = {
 
 #define NORMALIZE_MOV(x) ((x) < 0 ? -1 : ((x) > 0 ? 1 : 0))
 
-#define hash_set(sdb, k, v) (sdb_num_set (sdb, sdb_fmt ("%"PFMT64u, (ut64) (size_t) (k)), (ut64) (size_t) (v), 0))
-#define hash_get(sdb, k) (sdb_num_get (sdb, sdb_fmt ("%"PFMT64u, (ut64) (size_t) (k)), NULL))
-#define hash_get_rnode(sdb, k) ((RGraphNode *) (size_t) hash_get (sdb, k))
-#define hash_get_rlist(sdb, k) ((RList *) (size_t) hash_get (sdb, k))
-#define hash_get_int(sdb, k) ((int) hash_get (sdb, k))
 /* dont use macros for this */
 #define get_anode(gn) ((gn)? (RANode *) (gn)->data: NULL)
 
 #define graph_foreach_anode(list, it, pos, anode)\
 	if (list) for ((it) = (list)->head; (it) && ((pos) = (it)->data) && (pos) && ((anode) = (RANode *) (pos)->data); (it) = (it)->n)
 
-struct len_pos_t {
-	int len;
-	int pos;
-};
-
-struct dist_t {
-	const RGraphNode *from;
-	const RGraphNode *to;
-	int dist;
-};
-
 struct g_cb {
 	RAGraph *graph;
 	RANodeCallback node_cb;
@@ -405,164 +389,95 @@ static void normal_RANode_print(const RAGraph *g, const RANode *n, int cur) {
 	}
 }
 
-static int **get_crossing_matrix(const RGraph *g,
-                                 const struct layer_t layers[],
-                                 int maxlayer, int i, int from_up,
-                                 int *n_rows) {
-	int j, len = layers[i].n_nodes;
+static int cmp_int(const void *a, const void *b) {
+	return *(const int *)a - *(const int *)b;
+}
 
-	int **m = R_NEWS0 (int *, len);
-	if (!m) {
-		return NULL;
-	}
-	for (j = 0; j < len; j++) {
-		m[j] = R_NEWS0 (int, len);
-		if (!m[j]) {
-			goto err_row;
+/* collects the sorted positions of the nodes adjacent to gn in the layer
+ * being compared against: parents on layer i-1 when sweeping down, children
+ * when sweeping up. returns the number of positions stored in *pos */
+static int adjacent_positions(const RGraph *g, const RGraphNode *gn, int layer, int from_up, int **pos, int *size) {
+	const RList *neigh = from_up? r_graph_innodes (g, gn): r_graph_get_neighbours (g, gn);
+	const RGraphNode *gk;
+	const RANode *ak;
+	RListIter *it;
+	int n = 0, len = r_list_length (neigh);
+
+	if (len > *size) {
+		int *p = realloc (*pos, sizeof (int) * len);
+		if (!p) {
+			return -1;
 		}
+		*pos = p;
+		*size = len;
 	}
-	/* calculate crossings between layer i and layer i-1 */
-	/* consider the crossings generated by each pair of edges */
-	if (i > 0 && from_up) {
-		if (r_cons_is_breaked ()) {
-			goto err_row;
-		}
-		for (j = 0; j < layers[i - 1].n_nodes; j++) {
-			const RGraphNode *gj = layers[i - 1].nodes[j];
-			const RList *neigh = r_graph_get_neighbours (g, gj);
-			RGraphNode *gk;
-			RListIter *itk;
-
-			r_list_foreach (neigh, itk, gk) {
-				int s;
-				// skip self-loop
-				if (gj == gk) {
-					continue;
-				}
-				for (s = 0; s < j; ++s) {
-					const RGraphNode *gs = layers[i - 1].nodes[s];
-					const RList *neigh_s = r_graph_get_neighbours (g, gs);
-					RGraphNode *gt;
-					RListIter *itt;
-
-					r_list_foreach (neigh_s, itt, gt) {
-						const RANode *ak, *at; /* k and t should be "indexes" on layer i */
-						if (gt == gk || gt == gs) {
-							continue;
-						}
-						ak = get_anode (gk);
-						at = get_anode (gt);
-						if (ak->layer != i || at->layer != i) {
-							// this should never happen
-							// but it happens if we do graph.dummy = false, so better hide it for now
-#if 0
-							eprintf ("(WARNING) \"%s\" (%d) or \"%s\" (%d) are not on the right layer (%d)\n",
-								ak->title, ak->layer,
-								at->title, at->layer,
-								i);
-#endif
-							continue;
-						}
-						m[ak->pos_in_layer][at->pos_in_layer]++;
-					}
-				}
-			}
+	graph_foreach_anode (neigh, it, gk, ak) {
+		if (from_up && ak->layer != layer - 1) {
+			continue;
 		}
+		(*pos)[n++] = ak->pos_in_layer;
 	}
+	qsort (*pos, n, sizeof (int), cmp_int);
+	return n;
+}
 
-	/* calculate crossings between layer i and layer i+1 */
-	if (i < maxlayer - 1 && !from_up) {
-		if (r_cons_is_breaked ()) {
-			goto err_row;
-		}
-		for (j = 0; j < layers[i].n_nodes; ++j) {
-			const RGraphNode *gj = layers[i].nodes[j];
-			const RList *neigh = r_graph_get_neighbours (g, gj);
-			const RANode *ak, *aj = get_anode (gj);
-			RGraphNode *gk;
-			RListIter *itk;
-
-			if (r_cons_is_breaked ()) {
-				goto err_row;
-			}
-			graph_foreach_anode (neigh, itk, gk, ak) {
-				int s;
-				for (s = 0; s < layers[i].n_nodes; ++s) {
-					const RGraphNode *gs = layers[i].nodes[s];
-					const RList *neigh_s;
-					RGraphNode *gt;
-					RListIter *itt;
-					const RANode *at, *as = get_anode (gs);
-
-					if (gs == gj) {
-						continue;
-					}
-					neigh_s = r_graph_get_neighbours (g, gs);
-					graph_foreach_anode (neigh_s, itt, gt, at) {
-						if (at->pos_in_layer < ak->pos_in_layer) {
-							m[aj->pos_in_layer][as->pos_in_layer]++;
-						}
-					}
-				}
-			}
+/* number of crossings between the edges of u and v if u is placed on the
+ * left of v: the pairs (a, b) with a adjacent to u, b adjacent to v and
+ * a on the right of b. both position arrays must be sorted */
+static int count_crossings(const int *pu, int nu, const int *pv, int nv) {
+	int i, j = 0, res = 0;
+	for (i = 0; i < nu; i++) {
+		while (j < nv && pv[j] < pu[i]) {
+			j++;
 		}
+		res += j;
 	}
-
-	if (n_rows) {
-		*n_rows = len;
-	}
-	return m;
-
-err_row:
-	for (i = 0; i < len; i++) {
-		free (m[i]);
-	}
-	free (m);
-	return NULL;
+	return res;
 }
 
+/* one bubble pass over layer i. only adjacent nodes are ever compared, so
+ * crossings are counted per pair from the sorted neighbour positions
+ * instead of building the full crossing matrix of the layer */
 static int layer_sweep(const RGraph *g, const struct layer_t layers[],
                        int maxlayer, int i, int from_up) {
-	RGraphNode *u, *v;
-	const RANode *au, *av;
-	int n_rows, j, changed = false;
+	int j, changed = false;
 	int len = layers[i].n_nodes;
+	int *pu = NULL, *pv = NULL;
+	int su = 0, sv = 0;
 
-	int **cross_matrix = get_crossing_matrix (g, layers, maxlayer, i, from_up, &n_rows);
-	if (!cross_matrix) {
-		return -1; // ERROR HAPPENS
+	if ((from_up && i == 0) || (!from_up && i >= maxlayer - 1)) {
+		return false;
+	}
+	if (r_cons_is_breaked ()) {
+		return -1;
 	}
-
 	for (j = 0; j < len - 1; ++j) {
-		int auidx, avidx;
-
-		u = layers[i].nodes[j];
-		v = layers[i].nodes[j + 1];
-		au = get_anode (u);
-		av = get_anode (v);
-		auidx = au->pos_in_layer;
-		avidx = av->pos_in_layer;
-
-		if (cross_matrix[auidx][avidx] > cross_matrix[avidx][auidx]) {
+		RGraphNode *u = layers[i].nodes[j];
+		RGraphNode *v = layers[i].nodes[j + 1];
+		int nu = adjacent_positions (g, u, i, from_up, &pu, &su);
+		int nv = adjacent_positions (g, v, i, from_up, &pv, &sv);
+		if (nu < 0 || nv < 0) {
+			changed = -1;
+			break;
+		}
+		if (count_crossings (pu, nu, pv, nv) > count_crossings (pv, nv, pu, nu)) {
 			/* swap elements */
 			layers[i].nodes[j] = v;
 			layers[i].nodes[j + 1] = u;
 			changed = true;
 		}
 	}
+	free (pu);
+	free (pv);
+	if (changed == -1) {
+		return -1;
+	}
 
-	/* update position in the layer of each node. During the swap of some
-	 * elements we didn't swap also the pos_in_layer because the cross_matrix
-	 * is indexed by it, so do it now! */
-	for (j = 0; j < layers[i].n_nodes; ++j) {
+	/* update position in the layer of each node */
+	for (j = 0; j < len; ++j) {
 		RANode *n = get_anode (layers[i].nodes[j]);
 		n->pos_in_layer = j;
 	}
-
-	for (j = 0; j < n_rows; ++j) {
-		free (cross_matrix[j]);
-	}
-	free (cross_matrix);
 	return changed;
 }
 
@@ -670,6 +585,25 @@ static int is_reversed(const RAGraph *g, const RGraphEdge *e) {
 	return r_list_find (g->back_edges, e, (RListComparator) find_edge)? true: false;
 }
 
+/* dummy nodes are only part of the layout: there is no title to look them
+ * up by and nothing to keep in g->db */
+static RANode *add_dummy_node(const RAGraph *g, int layer, int is_reversed) {
+	RANode *res = R_NEW0 (RANode);
+	if (!res) {
+		return NULL;
+	}
+	res->title = strdup ("");
+	res->body = strdup ("");
+	res->layer = layer;
+	res->pos_in_layer = -1;
+	res->is_dummy = true;
+	res->is_reversed = is_reversed;
+	res->klass = -1;
+	res->w = 1;
+	res->gnode = r_graph_add_node (g->graph, res);
+	return res;
+}
+
 /* add dummy nodes when there are edges that span multiple layers */
 static void create_dummy_nodes(RAGraph *g) {
 	if (!g->dummy) {
@@ -692,22 +626,20 @@ static void create_dummy_nodes(RAGraph *g) {
 		RANode *to = get_anode (e->to);
 		int diff_layer = R_ABS (from->layer - to->layer);
 		RANode *prev = get_anode (e->from);
-		int i, nth = e->nth;
+		int i, nth = e->nth, rev = is_reversed (g, e);
 
 		r_agraph_del_edge (g, from, to);
 		for (i = 1; i < diff_layer; ++i) {
-			RANode *dummy = r_agraph_add_node (g, NULL, NULL);
+			RANode *dummy = add_dummy_node (g, from->layer + i, rev);
 			if (!dummy) {
 				return;
 			}
-			dummy->is_dummy = true;
-			dummy->layer = from->layer + i;
-			dummy->is_reversed = is_reversed (g, e);
-			dummy->w = 1;
-			r_agraph_add_edge_at (g, prev, dummy, nth);
-
+			if (prev == from) {
+				r_agraph_add_edge_at (g, prev, dummy, nth);
+			} else {
+				r_graph_add_edge (g->graph, prev->gnode, dummy->gnode);
+			}
 			prev = dummy;
-			nth = -1;
 		}
 		r_graph_add_edge (g->graph, prev->gnode, e->to);
 	}
@@ -789,796 +721,367 @@ static void minimize_crossings(const RAGraph *g) {
 	} while (cross_changed && max_changes);
 }
 
-static int find_dist(const struct dist_t *a, const struct dist_t *b) {
-	return a->from == b->from && a->to == b->to? 0: 1;
-}
-
-/* returns the distance between two nodes */
-/* if the distance between two nodes were explicitly set, returns that;
- * otherwise calculate the distance of two nodes on the same layer */
-static int dist_nodes(const RAGraph *g, const RGraphNode *a, const RGraphNode *b) {
-	struct dist_t d;
-	const RANode *aa, *ab;
-	RListIter *it;
-	int res = 0;
-
-	if (g->dists) {
-		d.from = a;
-		d.to = b;
-		it = r_list_find (g->dists, &d, (RListComparator) find_dist);
-		if (it) {
-			struct dist_t *old = (struct dist_t *) r_list_iter_get_data (it);
-			return old->dist;
-		}
-	}
-
-	aa = get_anode (a);
-	ab = get_anode (b);
-	if (aa && ab && aa->layer == ab->layer) {
-		int i;
-
-		res = aa == ab && !aa->is_reversed? HORIZONTAL_NODE_SPACING: 0;
-		for (i = aa->pos_in_layer; i < ab->pos_in_layer; ++i) {
-			const RGraphNode *cur = g->layers[aa->layer].nodes[i];
-			const RGraphNode *next = g->layers[aa->layer].nodes[i + 1];
-			const RANode *anext = get_anode (next);
-			const RANode *acur = get_anode (cur);
-			int found = false;
-
-			if (g->dists) {
-				d.from = cur;
-				d.to = next;
-				it = r_list_find (g->dists, &d, (RListComparator) find_dist);
-				if (it) {
-					struct dist_t *old = (struct dist_t *) r_list_iter_get_data (it);
-					res += old->dist;
-					found = true;
-				}
-			}
-
-			if (acur && anext && !found) {
-				int space = HORIZONTAL_NODE_SPACING;
-				if (acur->is_reversed && anext->is_reversed) {
-					if (!acur->is_reversed) {
-						res += acur->w / 2;
-					} else if (!anext->is_reversed) {
-						res += anext->w / 2;
-					}
-					res += 1;
-				} else {
-					res += acur->w / 2 + anext->w / 2 + space;
-				}
-			}
-		}
-	}
+/* flat copy of the layers used by the coordinate assignment. nodes are
+ * numbered layer by layer from left to right, so the position of node v in
+ * its layer is v - first[layer]. the neighbours of v on the layer above are
+ * up[up_idx[v]] .. up[up_idx[v + 1] - 1], sorted by position, same for the
+ * layer below with down/down_idx. marks flag the segments in conflict with
+ * an inner segment (between two dummy nodes) */
+struct flat_layers_t {
+	int n;
+	int n_layers;
+	RANode **nodes;
+	int *first;
+	int *up_idx, *up;
+	int *down_idx, *down;
+	ut8 *up_mark, *down_mark;
+};
 
-	return res;
+static void flat_layers_free(struct flat_layers_t *fl) {
+	free (fl->nodes);
+	free (fl->first);
+	free (fl->up_idx);
+	free (fl->up);
+	free (fl->down_idx);
+	free (fl->down);
+	free (fl->up_mark);
+	free (fl->down_mark);
 }
 
-/* explictly set the distance between two nodes on the same layer */
-static void set_dist_nodes(const RAGraph *g, int l, int cur, int next) {
-	struct dist_t *d, find_el;
-	const RGraphNode *vi, *vip;
-	const RANode *avi, *avip;
-	RListIter *it;
-
-	if (!g->dists) {
-		return;
-	}
-	vi = g->layers[l].nodes[cur];
-	vip = g->layers[l].nodes[next];
-	avi = get_anode (vi);
-	avip = get_anode (vip);
-
-	find_el.from = vi;
-	find_el.to = vip;
-	it = r_list_find (g->dists, &find_el, (RListComparator) find_dist);
-	d = it? (struct dist_t *) r_list_iter_get_data (it): R_NEW0 (struct dist_t);
-
-	d->from = vi;
-	d->to = vip;
-	d->dist = (avip && avi)? avip->x - avi->x: 0;
-	if (!it) {
-		r_list_push (g->dists, d);
+/* id of an adjacent node, -1 if it is not in the layers */
+static int flat_id(const struct flat_layers_t *fl, const RANode *a) {
+	if (a->layer < 0 || a->layer >= fl->n_layers) {
+		return -1;
 	}
+	int v = fl->first[a->layer] + a->pos_in_layer;
+	return (v < fl->first[a->layer + 1] && fl->nodes[v] == a)? v: -1;
 }
 
-static int is_valid_pos(const RAGraph *g, int l, int pos) {
-	return pos >= 0 && pos < g->layers[l].n_nodes;
-}
+/* fills idx/adj with the neighbours of every node on the layer at +d */
+static bool flat_adjacency(const RAGraph *g, struct flat_layers_t *fl, int d, int **idx, int **adj) {
+	int v, n = 0;
 
-/* computes the set of vertical classes in the graph */
-/* if v is an original node, L(v) = { v }
- * if v is a dummy node, L(v) is the set of all the dummies node that belongs
- *      to the same long edge */
-static Sdb *compute_vertical_nodes(const RAGraph *g) {
-	Sdb *res = sdb_new0 ();
-	int i, j;
-
-	for (i = 0; i < g->n_layers; ++i) {
-		for (j = 0; j < g->layers[i].n_nodes; ++j) {
-			RGraphNode *gn = g->layers[i].nodes[j];
-			const RList *Ln = hash_get_rlist (res, gn);
-			const RANode *an = get_anode (gn);
-
-			if (!Ln) {
-				RList *vert = r_list_new ();
-				hash_set (res, gn, vert);
-				if (an->is_dummy) {
-					RGraphNode *next = gn;
-					const RANode *anext = get_anode (next);
-
-					while (anext->is_dummy) {
-						r_list_append (vert, next);
-						next = r_graph_nth_neighbour (g->graph, next, 0);
-						if (!next) {
-							break;
-						}
-						anext = get_anode (next);
-					}
-				} else {
-					r_list_append (vert, gn);
-				}
-			}
-		}
-	}
-
-	return res;
-}
-
-/* computes left or right classes, used to place dummies node */
-/* classes respect three properties:
- * - v E C
- * - w E C => L(v) is a subset of C
- * - w E C, the s+(w) exists and is not in any class yet => s+(w) E C */
-static RList **compute_classes(const RAGraph *g, Sdb *v_nodes, int is_left, int *n_classes) {
-	int i, j, c;
-	RList **res = R_NEWS0 (RList *, g->n_layers);
-	RGraphNode *gn;
-	const RListIter *it;
-	RANode *n;
-
-	graph_foreach_anode (r_graph_get_nodes (g->graph), it, gn, n) {
-		n->klass = -1;
+	*idx = R_NEWS0 (int, fl->n + 1);
+	if (!*idx) {
+		return false;
 	}
+	for (v = 0; v < fl->n; v++) {
+		const RANode *a = fl->nodes[v];
+		const RList *neigh = r_graph_all_neighbours (g->graph, a->gnode);
+		const RGraphNode *gk;
+		const RListIter *it;
+		const RANode *ak;
 
-	for (i = 0; i < g->n_layers; ++i) {
-		c = i;
-
-		for (j = is_left? 0: g->layers[i].n_nodes - 1;
-		     (is_left && j < g->layers[i].n_nodes) || (!is_left && j >= 0);
-		     j = is_left? j + 1: j - 1) {
-			const RGraphNode *gj = g->layers[i].nodes[j];
-			const RANode *aj = get_anode (gj);
-
-			if (aj->klass == -1) {
-				const RList *laj = hash_get_rlist (v_nodes, gj);
-
-				if (!res[c]) {
-					res[c] = r_list_new ();
-				}
-				graph_foreach_anode (laj, it, gn, n) {
-					r_list_append (res[c], gn);
-					n->klass = c;
-				}
-			} else {
-				c = aj->klass;
+		(*idx)[v] = n;
+		graph_foreach_anode (neigh, it, gk, ak) {
+			if (ak->layer == a->layer + d && flat_id (fl, ak) != -1) {
+				n++;
 			}
 		}
 	}
-
-	if (n_classes) {
-		*n_classes = g->n_layers;
-	}
-	return res;
-}
-
-static int cmp_dist(const size_t a, const size_t b) {
-	return (int) a < (int) b;
-}
-
-static RGraphNode *get_sibling(const RAGraph *g, const RANode *n, int is_left, int is_adjust_class) {
-	RGraphNode *res = NULL;
-	int pos = n->pos_in_layer;
-
-	if ((is_left && is_adjust_class) || (!is_left && !is_adjust_class)) {
-		pos++;
-	} else {
-		pos--;
-	}
-
-	if (is_valid_pos (g, n->layer, pos)) {
-		res = g->layers[n->layer].nodes[pos];
-	}
-	return res;
-}
-
-static int adjust_class_val(const RAGraph *g, const RGraphNode *gn, const RGraphNode *sibl, Sdb *res, int is_left) {
-	if (is_left) {
-		return hash_get_int (res, sibl) - hash_get_int (res, gn) - dist_nodes (g, gn, sibl);
-	}
-	return hash_get_int (res, gn) - hash_get_int (res, sibl) - dist_nodes (g, sibl, gn);
-}
-
-/* adjusts the position of previously placed left/right classes */
-/* tries to place classes as close as possible */
-static void adjust_class(const RAGraph *g, int is_left, RList **classes, Sdb *res, int c) {
-	const RGraphNode *gn;
-	const RListIter *it;
-	const RANode *an;
-	int dist, v, is_first = true;
-
-	graph_foreach_anode (classes[c], it, gn, an) {
-		const RGraphNode *sibling;
-		const RANode *sibl_anode;
-
-		sibling = get_sibling (g, an, is_left, true);
-		if (!sibling) {
-			continue;
-		}
-		sibl_anode = get_anode (sibling);
-		if (sibl_anode->klass == c) {
-			continue;
-		}
-		v = adjust_class_val (g, gn, sibling, res, is_left);
-		dist = is_first? v: R_MIN (dist, v);
-		is_first = false;
+	(*idx)[fl->n] = n;
+	*adj = R_NEWS0 (int, n + 1);
+	if (!*adj) {
+		return false;
 	}
+	for (v = 0; v < fl->n; v++) {
+		const RANode *a = fl->nodes[v];
+		const RList *neigh = r_graph_all_neighbours (g->graph, a->gnode);
+		const RGraphNode *gk;
+		const RListIter *it;
+		const RANode *ak;
+		int k = (*idx)[v];
 
-	if (is_first) {
-		RList *heap = r_list_new ();
-		int len;
-
-		graph_foreach_anode (classes[c], it, gn, an) {
-			const RList *neigh = r_graph_all_neighbours (g->graph, gn);
-			const RGraphNode *gk;
-			const RListIter *itk;
-			const RANode *ak;
-
-			graph_foreach_anode (neigh, itk, gk, ak) {
-				if (ak->klass < c) {
-					size_t d = (ak->x - an->x);
-					if (d > 0) {
-						r_list_append (heap, (void *) d);
-					}
-				}
+		graph_foreach_anode (neigh, it, gk, ak) {
+			int u = ak->layer == a->layer + d? flat_id (fl, ak): -1;
+			if (u != -1) {
+				(*adj)[k++] = u;
 			}
 		}
-
-		len = r_list_length (heap);
-		if (len == 0) {
-			dist = 0;
-		} else {
-			r_list_sort (heap, (RListComparator) cmp_dist);
-			dist = (int) (size_t) r_list_get_n (heap, len / 2);
-		}
-
-		r_list_free (heap);
-	}
-
-	graph_foreach_anode (classes[c], it, gn, an) {
-		const int old_val = hash_get_int (res, gn);
-		const int new_val = is_left? old_val + dist: old_val - dist;
-		hash_set (res, gn, new_val);
-	}
-}
-
-static int place_nodes_val(const RAGraph *g, const RGraphNode *gn, const RGraphNode *sibl, Sdb *res, int is_left) {
-	if (is_left) {
-		return hash_get_int (res, sibl) + dist_nodes (g, sibl, gn);
+		qsort (*adj + (*idx)[v], k - (*idx)[v], sizeof (int), cmp_int);
 	}
-	return hash_get_int (res, sibl) - dist_nodes (g, gn, sibl);
-}
-
-static int place_nodes_sel_p(int newval, int oldval, int is_first, int is_left) {
-	if (is_first) {
-		return newval;
-	}
-	if (is_left) {
-		return R_MAX (oldval, newval);
-	}
-	return R_MIN (oldval, newval);
+	return true;
 }
 
-/* places left/right the nodes of a class */
-static void place_nodes(const RAGraph *g, const RGraphNode *gn, int is_left, Sdb *v_nodes, RList **classes, Sdb *res, Sdb *placed) {
-	const RList *lv = hash_get_rlist (v_nodes, gn);
-	int p = 0, v, is_first = true;
-	const RGraphNode *gk;
-	const RListIter *itk;
-	const RANode *ak;
+static bool flat_layers_init(const RAGraph *g, struct flat_layers_t *fl) {
+	int i, j, v = 0;
 
-	graph_foreach_anode (lv, itk, gk, ak) {
-		const RGraphNode *sibling;
-		const RANode *sibl_anode;
-
-		sibling = get_sibling (g, ak, is_left, false);
-		if (!sibling) {
-			continue;
-		}
-		sibl_anode = get_anode (sibling);
-		if (ak->klass == sibl_anode->klass) {
-			if (!hash_get (placed, sibling)) {
-				place_nodes (g, sibling, is_left, v_nodes, classes, res, placed);
-			}
-
-			v = place_nodes_val (g, gk, sibling, res, is_left);
-			p = place_nodes_sel_p (v, p, is_first, is_left);
-			is_first = false;
-		}
-	}
-
-	if (is_first) {
-		p = is_left? 0: 50;
+	memset (fl, 0, sizeof (*fl));
+	fl->n_layers = g->n_layers;
+	fl->first = R_NEWS0 (int, g->n_layers + 1);
+	if (!fl->first) {
+		return false;
 	}
-
-	graph_foreach_anode (lv, itk, gk, ak) {
-		hash_set (res, gk, p);
-		hash_set (placed, gk, true);
+	for (i = 0; i < g->n_layers; i++) {
+		fl->first[i] = fl->n;
+		fl->n += g->layers[i].n_nodes;
 	}
-}
-
-/* computes the position to the left/right of all the nodes */
-static Sdb *compute_pos(const RAGraph *g, int is_left, Sdb *v_nodes) {
-	int n_classes, i;
-
-	RList **classes = compute_classes (g, v_nodes, is_left, &n_classes);
-	if (!classes) {
-		return NULL;
+	fl->first[g->n_layers] = fl->n;
+	fl->nodes = R_NEWS0 (RANode *, fl->n + 1);
+	if (!fl->nodes) {
+		return false;
 	}
-
-	Sdb *res = sdb_new0 ();
-	Sdb *placed = sdb_new0 ();
-	for (i = 0; i < n_classes; ++i) {
-		const RGraphNode *gn;
-		const RListIter *it;
-
-		r_list_foreach (classes[i], it, gn) {
-			if (!hash_get_rnode (placed, gn)) {
-				place_nodes (g, gn, is_left, v_nodes, classes, res, placed);
-			}
+	for (i = 0; i < g->n_layers; i++) {
+		for (j = 0; j < g->layers[i].n_nodes; j++) {
+			RANode *a = get_anode (g->layers[i].nodes[j]);
+			a->pos_in_layer = j;
+			fl->nodes[v++] = a;
 		}
-
-		adjust_class (g, is_left, classes, res, i);
 	}
-
-	sdb_free (placed);
-	for (i = 0; i < n_classes; ++i) {
-		if (classes[i]) {
-			r_list_free (classes[i]);
-		}
+	if (!flat_adjacency (g, fl, -1, &fl->up_idx, &fl->up) ||
+	    !flat_adjacency (g, fl, 1, &fl->down_idx, &fl->down)) {
+		return false;
 	}
-	free (classes);
-	return res;
+	fl->up_mark = R_NEWS0 (ut8, fl->up_idx[fl->n] + 1);
+	fl->down_mark = R_NEWS0 (ut8, fl->down_idx[fl->n] + 1);
+	return fl->up_mark && fl->down_mark;
 }
 
-static int free_vertical_nodes_cb(void *user UNUSED, const char *k UNUSED, const char *v) {
-	r_list_free ((RList *) (size_t) sdb_atoi (v));
-	return 1;
+static int flat_pos(const struct flat_layers_t *fl, int v) {
+	return v - fl->first[fl->nodes[v]->layer];
 }
 
-/* calculates position of all nodes, but in particular dummies nodes */
-/* computes two different placements (called "left"/"right") and set the final
- * position of each node to the average of the values in the two placements */
-static void place_dummies(const RAGraph *g) {
-	const RList *nodes;
-	const RGraphNode *gn;
-	const RListIter *it;
-	RANode *n;
-
-	Sdb *vertical_nodes = compute_vertical_nodes (g);
-	if (!vertical_nodes) {
-		return;
-	}
-	Sdb *xminus = compute_pos (g, true, vertical_nodes);
-	if (!xminus) {
-		goto xminus_err;
-	}
-	Sdb *xplus = compute_pos (g, false, vertical_nodes);
-	if (!xplus) {
-		goto xplus_err;
-	}
-
-	nodes = r_graph_get_nodes (g->graph);
-	graph_foreach_anode (nodes, it, gn, n) {
-		n->x = (hash_get_int (xminus, gn) + hash_get_int (xplus, gn)) / 2;
-	}
-
-	sdb_free (xplus);
-xplus_err:
-	sdb_free (xminus);
-xminus_err:
-	sdb_foreach (vertical_nodes, (SdbForeachCallback)free_vertical_nodes_cb, NULL);
-	sdb_free (vertical_nodes);
+/* position of v counted from the side the placement starts from */
+static int flat_side_pos(const struct flat_layers_t *fl, int v, bool left) {
+	return left? flat_pos (fl, v): fl->first[fl->nodes[v]->layer + 1] - 1 - v;
 }
 
-static RGraphNode *get_right_dummy(const RAGraph *g, const RGraphNode *n) {
-	const RANode *an = get_anode (n);
-	if (!an) {
-		return NULL;
-	}
-	int k, layer = an->layer;
-
-	for (k = an->pos_in_layer + 1; k < g->layers[layer].n_nodes; ++k) {
-		RGraphNode *gk = g->layers[layer].nodes[k];
-		const RANode *ak = get_anode (gk);
-		if (!ak) {
-			break;
-		}
-
-		if (ak->is_dummy) {
-			return gk;
-		}
-	}
-	return NULL;
+static bool is_inner_segment(const struct flat_layers_t *fl, int u, int v) {
+	return fl->nodes[u]->is_dummy && fl->nodes[v]->is_dummy;
 }
 
-static void adjust_directions(const RAGraph *g, int i, int from_up, Sdb *D, Sdb *P) {
-	const RGraphNode *vm = NULL, *wm = NULL;
-	const RANode *vma = NULL, *wma = NULL;
-	int j, d = from_up? 1: -1;
-
-	if (i + d < 0 || i + d >= g->n_layers) {
-		return;
-	}
-	for (j = 0; j < g->layers[i + d].n_nodes; ++j) {
-		const RGraphNode *wp, *vp = g->layers[i + d].nodes[j];
-		const RANode *wpa, *vpa = get_anode (vp);
-
-		if (!vpa || !vpa->is_dummy) {
-			continue;
-		}
-		if (from_up) {
-			wp = r_list_get_n (r_graph_innodes (g->graph, vp), 0);
-		} else {
-			wp = r_graph_nth_neighbour (g->graph, vp, 0);
-		}
-		wpa = get_anode (wp);
-		if (!wpa || !wpa->is_dummy) {
-			continue;
-		}
-		if (vm) {
-			int p = hash_get_int (P, wm);
-			int k;
+static void mark_segment(struct flat_layers_t *fl, int k, int w) {
+	int u = fl->up[k], j;
 
-			for (k = wma->pos_in_layer + 1; k < wpa->pos_in_layer; ++k) {
-				const RGraphNode *w = g->layers[wma->layer].nodes[k];
-				const RANode *aw = get_anode (w);
-				if (aw && aw->is_dummy) {
-					p &= hash_get_int (P, w);
-				}
-			}
-			if (p) {
-				hash_set (D, vm, from_up);
-				for (k = vma->pos_in_layer + 1; k < vpa->pos_in_layer; ++k) {
-					const RGraphNode *v = g->layers[vma->layer].nodes[k];
-					const RANode *av = get_anode (v);
-					if (av && av->is_dummy) {
-						hash_set (D, v, from_up);
-					}
-				}
-			}
+	fl->up_mark[k] = true;
+	for (j = fl->down_idx[u]; j < fl->down_idx[u + 1]; j++) {
+		if (fl->down[j] == w) {
+			fl->down_mark[j] = true;
 		}
-		vm = vp;
-		wm = wp;
-		vma = get_anode (vm);
-		wma = get_anode (wm);
 	}
 }
 
-/* find a placement for a single node */
-static void place_single(const RAGraph *g, int l, const RGraphNode *bm, const RGraphNode *bp, int from_up, int va) {
-	const RGraphNode *gk, *v = g->layers[l].nodes[va];
-	const RANode *ak;
-	RANode *av = get_anode (v);
-	if (!av) {
-		return;
-	}
-	const RListIter *itk;
-
-	const RList *neigh = from_up
-	        ? r_graph_innodes (g->graph, v)
-		: r_graph_get_neighbours (g->graph, v);
-
-	int len = r_list_length (neigh);
-	if (len == 0) {
-		return;
-	}
-
-	int sum_x = 0;
-	graph_foreach_anode (neigh, itk, gk, ak) {
-		if (ak->is_reversed) {
-			len--;
-			continue;
-		}
-		sum_x += ak->x;
-	}
-
-	if (len == 0) {
-		return;
-	}
-	if (av) {
-		av->x = sum_x / len;
-	}
-	if (bm) {
-		const RANode *bma = get_anode (bm);
-		av->x = R_MAX (av->x, bma->x + dist_nodes (g, bm, v));
-	}
-	if (bp) {
-		const RANode *bpa = get_anode (bp);
-		av->x = R_MIN (av->x, bpa->x - dist_nodes (g, v, bp));
-	}
-}
-
-static int RM_listcmp(const struct len_pos_t *a, const struct len_pos_t *b) {
-	return a->pos < b->pos;
-}
-
-static int RP_listcmp(const struct len_pos_t *a, const struct len_pos_t *b) {
-	return a->pos >= b->pos;
-}
-
-static void collect_changes(const RAGraph *g, int l, const RGraphNode *b, int from_up, int s, int e, RList *list, int is_left) {
-	const RGraphNode *vt = g->layers[l].nodes[e - 1];
-	const RGraphNode *vtp = g->layers[l].nodes[s];
-	struct len_pos_t *cx;
+/* marks the type 1 conflicts: segments crossing an inner segment. inner
+ * segments are kept straight, the other one gives up its alignment */
+static void mark_conflicts(struct flat_layers_t *fl) {
 	int i;
 
-	RListComparator lcmp = is_left? (RListComparator) RM_listcmp: (RListComparator) RP_listcmp;
-
-	for (i = is_left? s: e - 1; (is_left && i < e) || (!is_left && i >= s); i = is_left? i + 1: i - 1) {
-		const RGraphNode *v, *vi = g->layers[l].nodes[i];
-		const RANode *av, *avi = get_anode (vi);
-		const RList *neigh;
-		const RListIter *it;
-		int c = 0;
-
-		if (!avi) {
-			continue;
-		}
-		neigh = from_up
-		        ? r_graph_innodes (g->graph, vi)
-			: r_graph_get_neighbours (g->graph, vi);
-
-		graph_foreach_anode (neigh, it, v, av) {
-			if ((is_left && av->x >= avi->x) || (!is_left && av->x <= avi->x)) {
-				c++;
-			} else {
-				cx = R_NEW (struct len_pos_t);
-				c--;
-				cx->len = 2;
-				cx->pos = av->x;
-				if (is_left) {
-					cx->pos += dist_nodes (g, vi, vt);
-				} else {
-					cx->pos -= dist_nodes (g, vtp, vi);
+	for (i = 0; i + 1 < fl->n_layers; i++) {
+		int size = fl->first[i + 1] - fl->first[i];
+		int next = fl->first[i + 1], last = fl->first[i + 2] - 1;
+		int k0 = 0, l = next, l1;
+
+		for (l1 = next; l1 <= last; l1++) {
+			int inner = -1, j;
+			if (fl->nodes[l1]->is_dummy) {
+				for (j = fl->up_idx[l1]; j < fl->up_idx[l1 + 1]; j++) {
+					if (is_inner_segment (fl, fl->up[j], l1)) {
+						inner = fl->up[j];
+						break;
+					}
 				}
-				r_list_add_sorted (list, cx, lcmp);
 			}
-		}
-
-		cx = R_NEW0 (struct len_pos_t);
-		cx->len = c;
-		cx->pos = avi->x;
-		if (is_left) {
-			cx->pos += dist_nodes (g, vi, vt);
-		} else {
-			cx->pos -= dist_nodes (g, vtp, vi);
-		}
-		r_list_add_sorted (list, cx, lcmp);
-	}
-
-	if (b) {
-		const RANode *ab = get_anode (b);
-		cx = R_NEW (struct len_pos_t);
-		if (cx) {
-			cx->len = is_left? INT_MAX: INT_MIN;
-			cx->pos = ab->x;
-			if (is_left) {
-				cx->pos += dist_nodes (g, b, vt);
-			} else {
-				cx->pos -= dist_nodes (g, vtp, b);
+			if (l1 != last && inner == -1) {
+				continue;
 			}
-			r_list_add_sorted (list, cx, lcmp);
-		}
-	}
-}
-
-static void combine_sequences(const RAGraph *g, int l, const RGraphNode *bm, const RGraphNode *bp, int from_up, int a, int r) {
-	RList *Rm = r_list_new (), *Rp = r_list_new ();
-	const RGraphNode *vt, *vtp;
-	RANode *at, *atp;
-	int rm, rp, t, m, i;
-	Rm->free = (RListFree) free;
-	Rp->free = (RListFree) free;
-
-	t = (a + r) / 2;
-	vt = g->layers[l].nodes[t - 1];
-	vtp = g->layers[l].nodes[t];
-	at = get_anode (vt);
-	atp = get_anode (vtp);
-
-	collect_changes (g, l, bm, from_up, a, t, Rm, true);
-	collect_changes (g, l, bp, from_up, t, r, Rp, false);
-	rm = rp = 0;
-
-	m = dist_nodes (g, vt, vtp);
-	if (at && atp) {
-		while (atp->x - at->x < m) {
-			if (atp->x == at->x) {
-				int step = m / 2;
-				at->x -= step;
-				atp->x += m - step;
-			} else {
-				if (rm < rp) {
-					if (r_list_empty (Rm)) {
-						at->x = atp->x - m;
-					} else {
-						struct len_pos_t *cx = (struct len_pos_t *) r_list_pop (Rm);
-						rm = rm + cx->len;
-						at->x = R_MAX (cx->pos, atp->x - m);
-						free (cx);
-					}
-				} else {
-					if (r_list_empty (Rp)) {
-						atp->x = at->x + m;
-					} else {
-						struct len_pos_t *cx = (struct len_pos_t *) r_list_pop (Rp);
-						rp = rp + cx->len;
-						atp->x = R_MIN (cx->pos, at->x + m);
-						free (cx);
+			int k1 = inner != -1? flat_pos (fl, inner): size - 1;
+			for (; l <= l1; l++) {
+				for (j = fl->up_idx[l]; j < fl->up_idx[l + 1]; j++) {
+					int k = flat_pos (fl, fl->up[j]);
+					if ((k < k0 || k > k1) && !is_inner_segment (fl, fl->up[j], l)) {
+						mark_segment (fl, j, l);
 					}
 				}
 			}
+			k0 = k1;
 		}
 	}
+}
 
-	r_list_free (Rm);
-	r_list_free (Rp);
-
-	for (i = t - 2; i >= a; --i) {
-		const RGraphNode *gv = g->layers[l].nodes[i];
-		RANode *av = get_anode (gv);
-		if (av && at) {
-			av->x = R_MIN (av->x, at->x - dist_nodes (g, gv, vt));
-		}
-	}
-
-	for (i = t + 1; i < r; ++i) {
-		const RGraphNode *gv = g->layers[l].nodes[i];
-		RANode *av = get_anode (gv);
-		if (av && atp) {
-			av->x = R_MAX (av->x, atp->x + dist_nodes (g, vtp, gv));
-		}
+/* minimal distance between the centers of two nodes next to each other in
+ * a layer */
+static int node_sep(const RANode *a, const RANode *b) {
+	if (a->is_reversed && b->is_reversed) {
+		return 1;
 	}
+	return a->w / 2 + b->w / 2 + HORIZONTAL_NODE_SPACING;
 }
 
-/* places a sequence of consecutive original nodes */
-/* it tries to minimize the distance between each node in the sequence and its
- * neighbours in the "previous" layer. Those neighbours are considered as
- * "fixed". The previous layer depends on the direction used during the layers
- * traversal */
-static void place_sequence(const RAGraph *g, int l, const RGraphNode *bm, const RGraphNode *bp, int from_up, int va, int vr) {
-	if (vr == va + 1) {
-		place_single (g, l, bm, bp, from_up, va);
-	} else if (vr > va + 1) {
-		int vt = (vr + va) / 2;
-		place_sequence (g, l, bm, bp, from_up, va, vt);
-		place_sequence (g, l, bm, bp, from_up, vt, vr);
-		combine_sequences (g, l, bm, bp, from_up, va, vr);
+/* node next to v in the layer, following the horizontal direction */
+static int flat_next(const struct flat_layers_t *fl, int v, bool left) {
+	int l = fl->nodes[v]->layer;
+	if (left) {
+		return v + 1 < fl->first[l + 1]? v + 1: -1;
 	}
+	return v > fl->first[l]? v - 1: -1;
 }
 
-/* finds the placements of nodes while traversing the graph in the given
- * direction */
-/* places all the sequences of consecutive original nodes in each layer. */
-static void original_traverse_l(const RAGraph *g, Sdb *D, Sdb *P, int from_up) {
-	int i, k, va, vr;
-
-	for (i = from_up? 0: g->n_layers - 1;
-			(from_up && i < g->n_layers) || (!from_up && i >= 0);
-			i = from_up? i + 1: i - 1) {
-		int j;
-		const RGraphNode *bm = NULL;
-		const RANode *bma = NULL;
-
-		j = 0;
-		while (j < g->layers[i].n_nodes && !bm) {
-			const RGraphNode *gn = g->layers[i].nodes[j];
-			const RANode *an = get_anode (gn);
-			if (an && an->is_dummy) {
-				va = 0;
-				vr = j;
-				bm = gn;
-				bma = an;
-			}
-			j++;
-		}
-		if (!bm) {
-			va = 0;
-			vr = g->layers[i].n_nodes;
-		}
-		place_sequence (g, i, NULL, bm, from_up, va, vr);
-		for (k = va; k < vr - 1; k++) {
-			set_dist_nodes (g, i, k, k + 1);
-		}
-		if (is_valid_pos (g, i, vr - 1) && bm) {
-			set_dist_nodes (g, i, vr - 1, bma->pos_in_layer);
-		}
-		while (bm) {
-			const RGraphNode *bp = get_right_dummy (g, bm);
-			const RANode *bpa = NULL;
-			bma = get_anode (bm);
-
-			if (!bp) {
-				va = bma->pos_in_layer + 1;
-				vr = g->layers[bma->layer].n_nodes;
-				place_sequence (g, i, bm, NULL, from_up, va, vr);
-				for (k = va; k < vr - 1; ++k) {
-					set_dist_nodes (g, i, k, k + 1);
-				}
+/* scratch arrays of one Brandes-Koepf pass, n entries each */
+struct bk_pass_t {
+	int *root;
+	int *align;
+	int *indeg;
+	int *order;
+	int *xs;
+};
 
-				if (is_valid_pos (g, i, va)) {
-					set_dist_nodes (g, i, bma->pos_in_layer, va);
+/* vertical alignment: sweeping the layers downward (or upward), every node
+ * is aligned with a median of its neighbours in the layer just visited,
+ * unless the segment is marked or the alignment would cross one already
+ * made in this layer. aligned nodes form blocks, kept as a cycle in align
+ * and represented by their topmost node in root */
+static void bk_align(const struct flat_layers_t *fl, struct bk_pass_t *p, bool down, bool left) {
+	int i, k, v;
+
+	for (v = 0; v < fl->n; v++) {
+		p->root[v] = p->align[v] = v;
+	}
+	for (k = 1; k < fl->n_layers; k++) {
+		int l = down? k: fl->n_layers - 1 - k;
+		const int *idx = down? fl->up_idx: fl->down_idx;
+		const int *adj = down? fl->up: fl->down;
+		const ut8 *mark = down? fl->up_mark: fl->down_mark;
+		int size = fl->first[l + 1] - fl->first[l];
+		int r = -1;
+
+		for (i = 0; i < size; i++) {
+			v = left? fl->first[l] + i: fl->first[l + 1] - 1 - i;
+			int d = idx[v + 1] - idx[v], m;
+			for (m = (d - 1) / 2; d > 0 && m <= d / 2 && p->align[v] == v; m++) {
+				int j = idx[v] + (left? m: d - 1 - m);
+				int u = adj[j];
+				int pos = flat_side_pos (fl, u, left);
+				if (!mark[j] && r < pos) {
+					p->align[u] = v;
+					p->root[v] = p->root[u];
+					p->align[v] = p->root[v];
+					r = pos;
 				}
-			} else if (hash_get_int (D, bm) == from_up) {
-				bpa = get_anode (bp);
-				va = bma->pos_in_layer + 1;
-				vr = bpa->pos_in_layer;
-				place_sequence (g, i, bm, bp, from_up, va, vr);
-				hash_set (P, bm, true);
 			}
-			bm = bp;
 		}
-		adjust_directions (g, i, from_up, D, P);
 	}
 }
 
-/* computes a final position of original nodes, considering dummies nodes as
- * fixed */
-/* set the node placements traversing the graph downward and then upward */
-static void place_original(RAGraph *g) {
-	const RList *nodes = r_graph_get_nodes (g->graph);
-	const RGraphNode *gn;
-	const RListIter *itn;
-	const RANode *an;
+/* horizontal compaction: blocks are the nodes of a constraint graph whose
+ * edges keep the nodes of each layer apart. blocks get the smallest x in
+ * topological order, then are pulled back towards their successors so the
+ * gaps left by the first pass are closed */
+static void bk_compact(const struct flat_layers_t *fl, struct bk_pass_t *p, bool left) {
+	int v, w, i, n = 0, head = 0;
 
-	Sdb *D = sdb_new0 ();
-	if (!D) {
-		return;
+	for (v = 0; v < fl->n; v++) {
+		p->indeg[v] = 0;
+		p->xs[v] = 0;
 	}
-	Sdb *P = sdb_new0 ();
-	if (!P) {
-		sdb_free (D);
-		return;
-	}
-	g->dists = r_list_newf ((RListFree) free);
-	if (!g->dists) {
-		sdb_free (D);
-		sdb_free (P);
-		return;
-	}
-
-	graph_foreach_anode (nodes, itn, gn, an) {
-		if (!an->is_dummy) {
-			continue;
+	for (v = 0; v < fl->n; v++) {
+		w = flat_next (fl, v, left);
+		if (w != -1) {
+			p->indeg[p->root[w]]++;
 		}
-		const RGraphNode *right_v = get_right_dummy (g, gn);
-		const RANode *right = get_anode (right_v);
-		if (right_v && right) {
-			hash_set (D, gn, 0);
-			int dt_eq = right->x - an->x == dist_nodes (g, gn, right_v);
-			hash_set (P, gn, dt_eq);
+	}
+	for (v = 0; v < fl->n; v++) {
+		if (p->root[v] == v && !p->indeg[v]) {
+			p->order[n++] = v;
 		}
 	}
-
-	original_traverse_l (g, D, P, true);
-	original_traverse_l (g, D, P, false);
-
-	r_list_free (g->dists);
-	g->dists = NULL;
-	sdb_free (P);
-	sdb_free (D);
+	while (head < n) {
+		int b = p->order[head++];
+		v = b;
+		do {
+			w = flat_next (fl, v, left);
+			if (w != -1) {
+				int c = p->root[w];
+				p->xs[c] = R_MAX (p->xs[c], p->xs[b] + node_sep (fl->nodes[v], fl->nodes[w]));
+				if (!--p->indeg[c]) {
+					p->order[n++] = c;
+				}
+			}
+			v = p->align[v];
+		} while (v != b);
+	}
+	for (i = n - 1; i >= 0; i--) {
+		int b = p->order[i], min = INT_MAX;
+		v = b;
+		do {
+			w = flat_next (fl, v, left);
+			if (w != -1) {
+				min = R_MIN (min, p->xs[p->root[w]] - node_sep (fl->nodes[v], fl->nodes[w]));
+			}
+			v = p->align[v];
+		} while (v != b);
+		if (min != INT_MAX) {
+			p->xs[b] = R_MAX (p->xs[b], min);
+		}
+	}
+}
+
+/* x-coordinate assignment: algorithm based on:
+ * Fast and Simple Horizontal Coordinate Assignment
+ * by U. Brandes, B. Koepf
+ * four placements are computed, aligning the nodes to their upper or lower
+ * neighbours and compacting them to the left or to the right. they are
+ * aligned to the narrowest one and each node is put at the average of its
+ * two median coordinates */
+static void place_nodes(const RAGraph *g) {
+	struct flat_layers_t fl;
+	struct bk_pass_t p = { 0 };
+	int *xs[4] = { 0 };
+	int minx[4], maxx[4];
+	int i, v, best = 0;
+
+	if (!flat_layers_init (g, &fl) || !fl.n) {
+		goto beach;
+	}
+	mark_conflicts (&fl);
+	p.root = R_NEWS0 (int, fl.n);
+	p.align = R_NEWS0 (int, fl.n);
+	p.indeg = R_NEWS0 (int, fl.n);
+	p.order = R_NEWS0 (int, fl.n);
+	p.xs = R_NEWS0 (int, fl.n);
+	if (!p.root || !p.align || !p.indeg || !p.order || !p.xs) {
+		goto beach;
+	}
+	for (i = 0; i < 4; i++) {
+		bool down = i < 2, left = !(i & 1);
+		xs[i] = R_NEWS0 (int, fl.n);
+		if (!xs[i]) {
+			goto beach;
+		}
+		bk_align (&fl, &p, down, left);
+		bk_compact (&fl, &p, left);
+		minx[i] = INT_MAX;
+		maxx[i] = INT_MIN;
+		for (v = 0; v < fl.n; v++) {
+			const RANode *a = fl.nodes[v];
+			int x = p.xs[p.root[v]];
+			/* right to left placements grow towards negative coordinates */
+			xs[i][v] = left? x: -x;
+			minx[i] = R_MIN (minx[i], xs[i][v] - a->w / 2);
+			maxx[i] = R_MAX (maxx[i], xs[i][v] + a->w / 2);
+		}
+		if (maxx[i] - minx[i] < maxx[best] - minx[best]) {
+			best = i;
+		}
+	}
+	for (v = 0; v < fl.n; v++) {
+		int c[4];
+		for (i = 0; i < 4; i++) {
+			int shift = (i & 1)? maxx[best] - maxx[i]: minx[best] - minx[i];
+			c[i] = xs[i][v] + shift;
+		}
+		qsort (c, 4, sizeof (int), cmp_int);
+		fl.nodes[v]->x = (c[1] + c[2]) / 2 - minx[best];
+	}
+beach:
+	for (i = 0; i < 4; i++) {
+		free (xs[i]);
+	}
+	free (p.root);
+	free (p.align);
+	free (p.indeg);
+	free (p.order);
+	free (p.xs);
+	flat_layers_free (&fl);
 }
 
 #if 0
@@ -1901,29 +1404,20 @@ static void backedge_info (RAGraph *g) {
 	return;
 }
 
-/* 1) trasform the graph into a DAG
- * 2) partition the nodes in layers
- * 3) split long edges that traverse multiple layers
- * 4) reorder nodes in each layer to reduce the number of edge crossing
- * 5) assign x and y coordinates to each node
- * 6) restore the original graph, with long edges and cycles */
-static void set_layout(RAGraph *g) {
-	int i, j, k;
+static void free_layers(RAGraph *g) {
+	int i;
 
-	r_list_free (g->edges);
-	g->edges = r_list_new ();
+	for (i = 0; i < g->n_layers && g->layers; ++i) {
+		free (g->layers[i].nodes);
+	}
+	R_FREE (g->layers);
+	g->n_layers = 0;
+}
 
-	remove_cycles (g);
-	assign_layers (g);
-	create_dummy_nodes (g);
-	create_layers (g);
-	minimize_crossings (g);
+/* size of each layer, dummy nodes span the whole layer */
+static void set_layer_sizes(RAGraph *g) {
+	int i, j;
 
-	if (r_cons_is_breaked ()) {
-		r_cons_break_end ();
-		return;
-	}
-	/* identify row height */
 	for (i = 0; i < g->n_layers; i++) {
 		int rh = 0;
 		int rw = 0;
@@ -1954,25 +1448,12 @@ static void set_layout(RAGraph *g) {
 			a->layer_width = g->layers[i].width;
 		}
 	}
+}
 
-	/* x-coordinate assignment: algorithm based on:
-	 * A Fast Layout Algorithm for k-Level Graphs
-	 * by C. Buchheim, M. Junger, S. Leipert */
-	place_dummies (g);
-	place_original (g);
-
-	/* IDEA: need to put this hack because of the way algorithm is implemented.
-	 * I think backedges should be restored to their original state instead of
-	 * converting them to longedges and adding dummy nodes. */
-	const RListIter *it;
-	const RGraphEdge *e;
-	r_list_foreach (g->back_edges, it, e) {
-		RANode *from = e->from? get_anode (e->from): NULL;
-		RANode *to = e->to? get_anode (e->to): NULL;
-		fix_back_edge_dummy_nodes (g, from, to);
-		r_agraph_del_edge (g, to, from);
-		r_agraph_add_edge_at (g, from, to, e->nth);
-	}
+/* turns the x placement into the final coordinates of the nodes, one row
+ * (or column, for the horizontal layout) per layer */
+static void place_layers(RAGraph *g) {
+	int i, j, k;
 
 	switch (g->layout) {
 	default:
@@ -2041,20 +1522,82 @@ static void set_layout(RAGraph *g) {
 	}
 
 	backedge_info (g);
+}
+
+/* 1) trasform the graph into a DAG
+ * 2) partition the nodes in layers
+ * 3) split long edges that traverse multiple layers
+ * 4) reorder nodes in each layer to reduce the number of edge crossing
+ * 5) assign x and y coordinates to each node
+ * 6) restore the original graph, with long edges and cycles
+ *
+ * the layers are kept after the layout, so relayout() can redo step 5
+ * alone when only the size of the nodes changed */
+static void set_layout(RAGraph *g) {
+	r_list_free (g->edges);
+	g->edges = r_list_new ();
+
+	free_layers (g);
+	remove_cycles (g);
+	assign_layers (g);
+	create_dummy_nodes (g);
+	create_layers (g);
+	minimize_crossings (g);
+
+	if (r_cons_is_breaked ()) {
+		free_layers (g);
+		r_cons_break_end ();
+		return;
+	}
+	set_layer_sizes (g);
+	place_nodes (g);
+
+	/* IDEA: need to put this hack because of the way algorithm is implemented.
+	 * I think backedges should be restored to their original state instead of
+	 * converting them to longedges and adding dummy nodes. */
+	const RListIter *it;
+	const RGraphEdge *e;
+	r_list_foreach (g->back_edges, it, e) {
+		RANode *from = e->from? get_anode (e->from): NULL;
+		RANode *to = e->to? get_anode (e->to): NULL;
+		fix_back_edge_dummy_nodes (g, from, to);
+		r_agraph_del_edge (g, to, from);
+		r_agraph_add_edge_at (g, from, to, e->nth);
+	}
+
+	place_layers (g);
 
 	//restore_original_edges (g);
 	//remove_dummy_nodes (g);
 
 	/* free all temporary structures used during layout */
-	for (i = 0; i < g->n_layers; ++i) {
-		free (g->layers[i].nodes);
-	}
-	free (g->layers);
 	r_list_free (g->long_edges);
 	r_list_free (g->back_edges);
+	g->long_edges = NULL;
+	g->back_edges = NULL;
 	r_cons_break_pop ();
 }
 
+/* redo the coordinate assignment on the layers of the last layout, used
+ * when nodes are folded or resized but the graph did not change */
+static void relayout(RAGraph *g) {
+	int i, n = 0;
+
+	for (i = 0; i < g->n_layers && g->layers; i++) {
+		n += g->layers[i].n_nodes;
+	}
+	if (!g->layers || n != g->graph->n_nodes) {
+		set_layout (g);
+		return;
+	}
+	r_list_free (g->edges);
+	g->edges = r_list_new ();
+
+	set_layer_sizes (g);
+	place_nodes (g);
+	place_layers (g);
+}
+
 static char *get_body(RCore *core, ut64 addr, int size, int opts) {
 	char *body;
 	RConfigHold *hc = r_config_hold_new (core->config);
@@ -2667,13 +2210,11 @@ static ut64 rebase(RAGraph *g, int v) {
 	return g->x < 0? -g->x + v: v;
 }
 
-static void agraph_set_layout(RAGraph *g) {
+static void agraph_update_layout(RAGraph *g) {
 	RListIter *it;
 	RGraphNode *n;
 	RANode *a;
 
-	set_layout (g);
-
 	update_graph_sizes (g);
 	graph_foreach_anode (r_graph_get_nodes (g->graph), it, n, a) {
 		if (a->is_dummy) {
@@ -2691,6 +2232,16 @@ static void agraph_set_layout(RAGraph *g) {
 	}
 }
 
+static void agraph_set_layout(RAGraph *g) {
+	set_layout (g);
+	agraph_update_layout (g);
+}
+
+static void agraph_relayout(RAGraph *g) {
+	relayout (g);
+	agraph_update_layout (g);
+}
+
 /* set the willing to center the screen on a particular node */
 static void agraph_update_seek(RAGraph *g, RANode *n, int force) {
 	g->update_seek_on = n;
@@ -3202,7 +2753,7 @@ static void agraph_toggle_tiny (RAGraph *g) {
 	g->is_tiny = !g->is_tiny;
 	g->need_update_dim = 1;
 	agraph_refresh (r_cons_singleton ()->event_data);
-	agraph_set_layout ((RAGraph *) g);
+	agraph_relayout ((RAGraph *) g);
 	//remove_dummy_nodes (g);
 }
 
@@ -3213,7 +2764,7 @@ static void agraph_toggle_mini(RAGraph *g) {
 	}
 	g->need_update_dim = 1;
 	agraph_refresh (r_cons_singleton ()->event_data);
-	agraph_set_layout ((RAGraph *) g);
+	agraph_relayout ((RAGraph *) g);
 }
 
 static void agraph_follow_innodes (RAGraph *g, bool in) {
@@ -3817,6 +3368,7 @@ R_API void r_agraph_del_edge(const RAGraph *g, RANode *a, RANode *b) {
 }
 
 R_API void r_agraph_reset(RAGraph *g) {
+	free_layers (g);
 	agraph_free_nodes (g);
 	r_graph_reset (g->graph);
 	r_agraph_set_title (g, NULL);
@@ -3836,6 +3388,7 @@ R_API void r_agraph_reset(RAGraph *g) {
 
 R_API void r_agraph_free(RAGraph *g) {
 	if (g) {
+		free_layers (g);
 		agraph_free_nodes (g);
 		r_graph_free (g->graph);
 		r_list_free (g->edges);
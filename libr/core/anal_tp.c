@@ -38,13 +38,14 @@ static void r_anal_emul_restore(RCore *core, RConfigHold *hc) {
 	r_config_hold_free (hc);
 }
 
-#define SDB_CONTAINS(i,s) sdb_array_contains (trace, sdb_fmt ("%d.reg.write", i), s, 0)
+#define SDB_CONTAINS(i,s) sdb_array_contains (trace, r_strf ("%d.reg.write", i), s, 0)
 
 static bool type_pos_hit(RAnal *anal, Sdb *trace, bool in_stack, int idx, int size, const char *place) {
+	r_strf_buffer (64);
 	if (in_stack) {
 		const char *sp_name = r_reg_get_name (anal->reg, R_REG_NAME_SP);
 		ut64 sp = r_reg_getv (anal->reg, sp_name);
-		ut64 write_addr = sdb_num_get (trace, sdb_fmt ("%d.mem.write", idx), 0);
+		ut64 write_addr = sdb_num_get (trace, r_strf ("%d.mem.write", idx), 0);
 		return (write_addr == sp + size);
 	}
 	return SDB_CONTAINS (idx, place);
@@ -172,7 +173,7 @@ static ut64 get_addr(Sdb *trace, const char *regname, int idx) {
 	if (!regname || !*regname) {
 		return UT64_MAX;
 	}
-	const char *query = sdb_fmt ("%d.reg.read.%s", idx, regname);
+	r_strf_var (query, 256, "%d.reg.read.%s", idx, regname);
 	return r_num_math (NULL, sdb_const_get (trace, query, 0));
 }
 
@@ -195,16 +196,18 @@ static int cond_invert (int cond) {
 	return res;
 }
 
-#define RKEY(a,k,d) sdb_fmt ("var.range.0x%"PFMT64x ".%c.%d", a, k, d)
+#define RKEY(a,k,d) r_strf ("var.range.0x%"PFMT64x ".%c.%d", a, k, d)
 #define ADB a->sdb_fcns
 
 static void var_add_range (RAnal *a, RAnalVar *var, int cond, ut64 val) {
+	r_strf_buffer (64);
 	const char *key = RKEY (var->addr, var->kind, var->delta);
 	sdb_array_append_num (ADB, key, cond, 0);
 	sdb_array_append_num (ADB, key, val, 0);
 }
 
 R_API RStrBuf *var_get_constraint (RAnal *a, RAnalVar *var) {
+	r_strf_buffer (64);
 	const char *key = RKEY (var->addr, var->kind, var->delta);
 	int i, n = sdb_array_length (ADB, key);
 
@@ -223,22 +226,22 @@ R_API RStrBuf *var_get_constraint (RAnal *a, RAnalVar *var) {
 			if (high) {
 				r_strbuf_append (sb, " && ");
 			}
-			r_strbuf_append (sb, sdb_fmt ("<= 0x%"PFMT64x "", val));
+			r_strbuf_appendf (sb, "<= 0x%"PFMT64x, val);
 			low = true;
 			break;
 		case R_ANAL_COND_LT:
 			if (high) {
 				r_strbuf_append (sb, " && ");
 			}
-			r_strbuf_append (sb, sdb_fmt ("< 0x%"PFMT64x "", val));
+			r_strbuf_appendf (sb, "< 0x%"PFMT64x, val);
 			low = true;
 			break;
 		case R_ANAL_COND_GE:
-			r_strbuf_append (sb, sdb_fmt (">= 0x%"PFMT64x "", val));
+			r_strbuf_appendf (sb, ">= 0x%"PFMT64x, val);
 			high = true;
 			break;
 		case R_ANAL_COND_GT:
-			r_strbuf_append (sb, sdb_fmt ("> 0x%"PFMT64x "", val));
+			r_strbuf_appendf (sb, "> 0x%"PFMT64x, val);
 			high = true;
 			break;
 		}
@@ -276,7 +279,7 @@ static RList *parse_format(RCore *core, char *fmt) {
 			tmp++;
 		}
 		*tmp = '\0';
-		const char *query = sdb_fmt ("spec.%s.%s", spec, arr);
+		r_strf_var (query, 256, "spec.%s.%s", spec, arr);
 		char *type = (char *) sdb_const_get (s, query, 0);
 		if (type) {
 			r_list_append (ret, type);
@@ -292,6 +295,7 @@ static RList *parse_format(RCore *core, char *fmt) {
 
 static void type_match(RCore *core, ut64 addr, char *fcn_name, ut64 baddr, const char* cc,
 		int prev_idx, bool userfnc, ut64 caddr) {
+	r_strf_buffer (64);
 	Sdb *trace = core->anal->esil->db_trace;
 	Sdb *TDB = core->anal->sdb_types;
 	RAnal *anal = core->anal;
@@ -350,7 +354,8 @@ static void type_match(RCore *core, ut64 addr, char *fcn_name, ut64 baddr, const
 		bool res = false;
 		// Backtrace instruction from source sink to prev source sink
 		for (j = idx; j >= prev_idx; j--) {
-			ut64 instr_addr = sdb_num_get (trace, sdb_fmt ("%d.addr", j), 0);
+			r_strf_var (addr_key, 32, "%d.addr", j);
+			ut64 instr_addr = sdb_num_get (trace, addr_key, 0);
 			if (instr_addr < baddr) {
 				break;
 			}
@@ -366,22 +371,23 @@ static void type_match(RCore *core, ut64 addr, char *fcn_name, ut64 baddr, const
 				r_anal_op_free (next_op);
 				break;
 			}
-			char *key = NULL;
+			char key[256];
 			RAnalVar *var = op->var;
 			if (!in_stack) {
-				key = sdb_fmt ("fcn.0x%08"PFMT64x".arg.%s", caddr, place);
+				snprintf (key, sizeof (key), "fcn.0x%08"PFMT64x".arg.%s", caddr, place);
 			} else {
-				key = sdb_fmt ("fcn.0x%08"PFMT64x".arg.%d", caddr, size);
+				snprintf (key, sizeof (key), "fcn.0x%08"PFMT64x".arg.%d", caddr, size);
 			}
-			const char *query = sdb_fmt ("%d.mem.read", j);
+			r_strf_var (query, 64, "%d.mem.read", j);
 			if (op->type == R_ANAL_OP_TYPE_MOV && sdb_const_get (trace, query, 0)) {
 				memref = (!memref && var && (var->kind != R_ANAL_VAR_KIND_REG))? false: true;
 			}
 			// Match type from function param to instr
 			if (type_pos_hit (anal, trace, in_stack, j, size, place)) {
 				if (!cmt_set && type && name) {
-					r_meta_set_string (anal, R_META_TYPE_VARTYPE, instr_addr,
-							sdb_fmt ("%s%s%s", type, r_str_endswith (type, "*") ? "" : " ", name));
+					char *vartype = r_str_newf ("%s%s%s", type, r_str_endswith (type, "*") ? "" : " ", name);
+					r_meta_set_string (anal, R_META_TYPE_VARTYPE, instr_addr, vartype);
+					free (vartype);
 					cmt_set = true;
 					if ((op->ptr && op->ptr != UT64_MAX) && !strcmp (name, "format")) {
 						RFlagItem *f = r_flag_get_i (core->flags, op->ptr);
@@ -513,12 +519,13 @@ R_API void r_core_anal_type_match(RCore *core, RAnalFunction *fcn) {
 				r_anal_op_fini (&aop);
 				continue;
 			}
-			int loop_count = sdb_num_get (anal->esil->db_trace, sdb_fmt ("0x%"PFMT64x".count", addr), 0);
+			r_strf_var (count_key, 32, "0x%"PFMT64x".count", addr);
+			int loop_count = sdb_num_get (anal->esil->db_trace, count_key, 0);
 			if (loop_count > LOOP_MAX || aop.type == R_ANAL_OP_TYPE_RET) {
 				r_anal_op_fini (&aop);
 				break;
 			}
-			sdb_num_set (anal->esil->db_trace, sdb_fmt ("0x%"PFMT64x".count", addr), loop_count + 1, 0);
+			sdb_num_set (anal->esil->db_trace, count_key, loop_count + 1, 0);
 			if (r_anal_op_nonlinear (aop.type)) {   // skip the instr
 				r_reg_set_value (core->dbg->reg, r, addr + ret);
 			} else {
@@ -566,7 +573,7 @@ R_API void r_core_anal_type_match(RCore *core, RAnalFunction *fcn) {
 						resolved = false;
 					}
 					if (!strcmp (fcn_name, "__stack_chk_fail")) {
-						const char *query = sdb_fmt ("%d.addr", cur_idx - 1);
+						r_strf_var (query, 64, "%d.addr", cur_idx - 1);
 						ut64 mov_addr = sdb_num_get (trace, query, 0);
 						RAnalOp *mop = r_core_anal_op (core, mov_addr, R_ANAL_OP_MASK_VAL | R_ANAL_OP_MASK_BASIC);
 						if (mop && mop->var) {
@@ -582,7 +589,7 @@ R_API void r_core_anal_type_match(RCore *core, RAnalFunction *fcn) {
 			} else if (!resolved && ret_type && ret_reg) {
 				// Forward propgation of function return type
 				char src[REG_SZ] = {0};
-				const char *query = sdb_fmt ("%d.reg.write", cur_idx);
+				r_strf_var (query, 64, "%d.reg.write", cur_idx);
 				const char *cur_dest = sdb_const_get (trace, query, 0);
 				get_src_regname (core, aop.addr, src, sizeof (src));
 				if (ret_reg && *src && strstr (ret_reg, src)) {
@@ -696,7 +703,7 @@ R_API void r_core_anal_type_match(RCore *core, RAnalFunction *fcn) {
 				if (var && str_flag) {
 					var_retype (anal, var, NULL, "const char *", addr, false, false);
 				}
-				const char *query = sdb_fmt ("%d.reg.write", cur_idx);
+				r_strf_var (query, 64, "%d.reg.write", cur_idx);
 				prev_dest = sdb_const_get (trace, query, 0);
 				if (var) {
 					strncpy (prev_type, var->type, sizeof (prev_type) - 1);
@@ -722,7 +729,7 @@ R_API void r_core_anal_type_match(RCore *core, RAnalFunction *fcn) {
 		}
 		bool res = true;
 		char *type = NULL;
-		const char *query = sdb_fmt ("fcn.0x%08"PFMT64x".arg.%s", fcn->addr, i->name);
+		r_strf_var (query, 256, "fcn.0x%08"PFMT64x".arg.%s", fcn->addr, i->name);
 		const char *qres = sdb_const_get (anal->sdb_fcns, query, NULL);
 		if (qres) {
 			type = strdup (qres);
@@ -758,7 +765,7 @@ R_API void r_core_anal_type_match(RCore *core, RAnalFunction *fcn) {
 			RList *list2 = r_anal_var_list (anal, fcn, R_ANAL_VAR_KIND_BPV);
 			r_list_foreach (list2, iter2, bp_var) {
 				if (bp_var->isarg) {
-					const char *query = sdb_fmt ("fcn.0x%08" PFMT64x ".arg.%d", fcn->addr, (bp_var->delta - 8));
+					r_strf_var (query, 64, "fcn.0x%08" PFMT64x ".arg.%d", fcn->addr, (bp_var->delta - 8));
 					char *type = (char *)sdb_const_get (anal->sdb_fcns, query, NULL);
 					if (type) {
 						var_retype (anal, bp_var, NULL, type, fcn->addr, false, false);
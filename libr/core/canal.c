@@ -2047,7 +2047,7 @@ R_API void r_core_anal_importxrefs(RCore *core) {
 	if (!obj) {
 		return;
 	}
-	r_list_foreach (obj->imports, iter, imp) {
+	r_list_foreach (r_bin_get_imports (core->bin), iter, imp) {
 		ut64 addr = lit ? r_core_bin_impaddr (core->bin, va, imp->name): 0;
 		if (addr) {
 			r_core_anal_codexrefs (core, addr);
@@ -4932,8 +4932,8 @@ static void analPaths(RCoreAnalPaths *p, PJ *pj) {
 		analPathFollow (p, f, pj);
 		if (p->followCalls) {
 			int i;
-			for (i = 0; i < cur->op_pos_size; i++) {
-				ut64 addr = cur->addr + cur->op_pos[i];
+			for (i = 0; i < cur->ninstr; i++) {
+				ut64 addr = r_anal_bb_opaddr_i (cur, i);
 				RAnalOp *op = r_core_anal_op (p->core, addr, R_ANAL_OP_MASK_BASIC);
 				if (op && op->type == R_ANAL_OP_TYPE_CALL) {
 					analPathFollow (p, op->jump, pj);
@@ -49,15 +49,18 @@ static void pair_bool(const char *key, bool val, int mode, bool last) {
 }
 
 static void pair_int(const char *key, int val, int mode, bool last) {
-	pair (key, sdb_fmt ("%d", val), mode, last);
+	r_strf_buffer (32);
+	pair (key, r_strf ("%d", val), mode, last);
 }
 
 static void pair_ut64(const char *key, ut64 val, int mode, bool last) {
-	pair (key, sdb_fmt ("%"PFMT64d, val), mode, last);
+	r_strf_buffer (32);
+	pair (key, r_strf ("%"PFMT64d, val), mode, last);
 }
 
 static void pair_ut64x(const char *key, ut64 val, int mode, bool last) {
-	const char *str_val = IS_MODE_JSON (mode) ? sdb_fmt ("%"PFMT64d, val) : sdb_fmt ("0x%"PFMT64x, val);
+	r_strf_buffer (32);
+	const char *str_val = IS_MODE_JSON (mode) ? r_strf ("%"PFMT64d, val) : r_strf ("0x%"PFMT64x, val);
 	pair (key, str_val, mode, last);
 }
 
@@ -486,41 +489,42 @@ R_API void r_core_anal_type_init(RCore *core) {
 	const char *os = r_config_get (core->config, "asm.os");
 	// spaguetti ahead
 
-	const char *dbpath = sdb_fmt (R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types.sdb"), dir_prefix);
+	char dbpath[256];
+	snprintf (dbpath, sizeof (dbpath), R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types.sdb"), dir_prefix);
 	if (r_file_exists (dbpath)) {
 		sdb_concat_by_path (types, dbpath);
 	}
-	dbpath = sdb_fmt (R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s.sdb"),
+	snprintf (dbpath, sizeof (dbpath), R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s.sdb"),
 		dir_prefix, anal_arch);
 	if (r_file_exists (dbpath)) {
 		sdb_concat_by_path (types, dbpath);
 	}
-	dbpath = sdb_fmt (R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s.sdb"),
+	snprintf (dbpath, sizeof (dbpath), R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s.sdb"),
 		dir_prefix, os);
 	if (r_file_exists (dbpath)) {
 		sdb_concat_by_path (types, dbpath);
 	}
-	dbpath = sdb_fmt (R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%d.sdb"),
+	snprintf (dbpath, sizeof (dbpath), R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%d.sdb"),
 		dir_prefix, bits);
 	if (r_file_exists (dbpath)) {
 		sdb_concat_by_path (types, dbpath);
 	}
-	dbpath = sdb_fmt (R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s-%d.sdb"),
+	snprintf (dbpath, sizeof (dbpath), R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s-%d.sdb"),
 		dir_prefix, os, bits);
 	if (r_file_exists (dbpath)) {
 		sdb_concat_by_path (types, dbpath);
 	}
-	dbpath = sdb_fmt (R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s-%d.sdb"),
+	snprintf (dbpath, sizeof (dbpath), R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s-%d.sdb"),
 		dir_prefix, anal_arch, bits);
 	if (r_file_exists (dbpath)) {
 		sdb_concat_by_path (types, dbpath);
 	}
-	dbpath = sdb_fmt (R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s-%s.sdb"),
+	snprintf (dbpath, sizeof (dbpath), R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s-%s.sdb"),
 		dir_prefix, anal_arch, os);
 	if (r_file_exists (dbpath)) {
 		sdb_concat_by_path (types, dbpath);
 	}
-	dbpath = sdb_fmt (R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s-%s-%d.sdb"),
+	snprintf (dbpath, sizeof (dbpath), R_JOIN_3_PATHS ("%s", R2_SDB_FCNSIGN, "types-%s-%s-%d.sdb"),
 		dir_prefix, anal_arch, os, bits);
 	if (r_file_exists (dbpath)) {
 		sdb_concat_by_path (types, dbpath);
@@ -532,8 +536,9 @@ static int save_ptr(void *p, const char *k, const char *v) {
 	sdbs[0] = ((Sdb**) p)[0];
 	sdbs[1] = ((Sdb**) p)[1];
 	if (!strncmp (v, "cc", strlen ("cc") + 1)) {
-		const char *x = sdb_const_get (sdbs[1], sdb_fmt ("cc.%s.name", k), 0);
-		char *tmp = sdb_fmt ("%p", x);
+		r_strf_var (key, 256, "cc.%s.name", k);
+		const char *x = sdb_const_get (sdbs[1], key, 0);
+		r_strf_var (tmp, 64, "%p", x);
 		sdb_set (sdbs[0], tmp, x, 0);
 	}
 	return 1;
@@ -548,7 +553,8 @@ R_API void r_core_anal_cc_init(RCore *core) {
 	//save pointers and values stored inside them
 	//to recover from freeing heeps
 	const char *defaultcc = sdb_const_get (sdbs[1], "default.cc", 0);
-	sdb_set (sdbs[0], sdb_fmt ("0x%08"PFMT64x, r_num_get (NULL, defaultcc)), defaultcc, 0);
+	r_strf_var (defaultcc_key, 32, "0x%08"PFMT64x, r_num_get (NULL, defaultcc));
+	sdb_set (sdbs[0], defaultcc_key, defaultcc, 0);
 	sdb_foreach (core->anal->sdb_cc, save_ptr, sdbs);
 	sdb_reset ( core->anal->sdb_cc);
 	const char *anal_arch = r_config_get (core->config, "anal.arch");
@@ -558,7 +564,7 @@ R_API void r_core_anal_cc_init(RCore *core) {
 		bits = 32;
 	}
 
-	char *dbpath = sdb_fmt ("%s/"R2_SDB_FCNSIGN"/cc-%s-%d.sdb", dir_prefix, anal_arch, bits);
+	r_strf_var (dbpath, 256, "%s/"R2_SDB_FCNSIGN"/cc-%s-%d.sdb", dir_prefix, anal_arch, bits);
 	if (r_file_exists (dbpath)) {
 		sdb_concat_by_path (core->anal->sdb_cc, dbpath);
 	}
@@ -566,7 +572,7 @@ R_API void r_core_anal_cc_init(RCore *core) {
 	RListIter *it;
 	RAnalFunction *fcn;
 	r_list_foreach (core->anal->fcns, it, fcn) {
-		char *ptr = sdb_fmt ("%p", fcn->cc);
+		r_strf_var (ptr, 64, "%p", fcn->cc);
 		const char *cc = sdb_const_get (sdbs[0], ptr, 0);
 		if (cc) {
 			fcn->cc = cc;
@@ -826,7 +832,7 @@ static int bin_info(RCore *r, int mode, ut64 laddr) {
 		}
 	}
 	const char *dir_prefix = r_config_get (r->config, "dir.prefix");
-	char *spath = sdb_fmt ("%s/"R2_SDB_FCNSIGN"/spec.sdb", dir_prefix);
+	r_strf_var (spath, 256, "%s/"R2_SDB_FCNSIGN"/spec.sdb", dir_prefix);
 	if (r_file_exists (spath)) {
 		sdb_concat_by_path (r->anal->sdb_fmts, spath);
 	}
@@ -1261,7 +1267,8 @@ static ut8 bin_reloc_size(RBinReloc *reloc) {
 
 static char *resolveModuleOrdinal(Sdb *sdb, const char *module, int ordinal) {
 	Sdb *db = sdb;
-	char *foo = sdb_get (db, sdb_fmt ("%d", ordinal), 0);
+	r_strf_var (key, 32, "%d", ordinal);
+	char *foo = sdb_get (db, key, 0);
 	return (foo && *foo) ? foo : NULL;
 }
 
@@ -1274,7 +1281,7 @@ static char *get_reloc_name(RCore *r, RBinReloc *reloc, ut64 addr) {
 		if (bin_demangle) {
 			demangled_name = r_bin_demangle (r->bin->cur, lang, reloc->import->name, addr);
 		}
-		reloc_name = sdb_fmt ("reloc.%s_%d", demangled_name ? demangled_name : reloc->import->name,
+		reloc_name = r_str_newf ("reloc.%s_%d", demangled_name ? demangled_name : reloc->import->name,
 				      (int)(addr & 0xff));
 		if (!reloc_name) {
 			free (demangled_name);
@@ -1285,7 +1292,7 @@ static char *get_reloc_name(RCore *r, RBinReloc *reloc, ut64 addr) {
 		if (bin_demangle) {
 			demangled_name = r_bin_demangle (r->bin->cur, lang, reloc->symbol->name, addr);
 		}
-		reloc_name = sdb_fmt ("reloc.%s_%d", demangled_name ? demangled_name : reloc->symbol->name,
+		reloc_name = r_str_newf ("reloc.%s_%d", demangled_name ? demangled_name : reloc->symbol->name,
 				      (int)(addr & 0xff));
 		if (!reloc_name) {
 			free (demangled_name);
@@ -1294,7 +1301,7 @@ static char *get_reloc_name(RCore *r, RBinReloc *reloc, ut64 addr) {
 		r_str_replace_char (reloc_name, '$', '_');
 	} else if (reloc->is_ifunc) {
 		// addend is the function pointer for the resolving ifunc
-		reloc_name = sdb_fmt ("reloc.ifunc_%"PFMT64x, reloc->addend);
+		reloc_name = r_str_newf ("reloc.ifunc_%"PFMT64x, reloc->addend);
 	} else {
 		// TODO(eddyb) implement constant relocs.
 	}
@@ -1320,7 +1327,7 @@ static void set_bin_relocs(RCore *r, RBinReloc *reloc, ut64 addr, Sdb **db, char
 
 			r_str_case (module, false);
 			if (import) {
-				char *filename = NULL;
+				char filename[256];
 				int ordinal;
 				*import = 0;
 				import += strlen (TOKEN);
@@ -1331,13 +1338,13 @@ static void set_bin_relocs(RCore *r, RBinReloc *reloc, ut64 addr, Sdb **db, char
 					free (*sdb_module);
 					*sdb_module = strdup (module);
 					/* always lowercase */
-					filename = sdb_fmt ("%s.sdb", module);
+					snprintf (filename, sizeof (filename), "%s.sdb", module);
 					r_str_case (filename, false);
 					if (r_file_exists (filename)) {
 						*db = sdb_new (NULL, filename, 0);
 					} else {
 						const char *dirPrefix = r_sys_prefix (NULL);
-						filename = sdb_fmt (R_JOIN_4_PATHS ("%s", R2_SDB_FORMAT, "dll", "%s.sdb"),
+						snprintf (filename, sizeof (filename), R_JOIN_4_PATHS ("%s", R2_SDB_FORMAT, "dll", "%s.sdb"),
 							dirPrefix, module);
 						if (r_file_exists (filename)) {
 							*db = sdb_new (NULL, filename, 0);
@@ -1380,16 +1387,18 @@ static void set_bin_relocs(RCore *r, RBinReloc *reloc, ut64 addr, Sdb **db, char
 		if (demname) {
 			char *realname;
 			if (r->bin->prefix) {
-				realname = sdb_fmt ("%s.reloc.%s", r->bin->prefix, demname);
+				realname = r_str_newf ("%s.reloc.%s", r->bin->prefix, demname);
 			} else {
-				realname = sdb_fmt ("reloc.%s", demname);
+				realname = r_str_newf ("reloc.%s", demname);
 			}
 			r_flag_item_set_realname (fi, realname);
+			free (realname);
 		}
 	} else {
 		char *reloc_name = get_reloc_name (r, reloc, addr);
 		if (reloc_name) {
 			r_flag_set (r->flags, reloc_name, addr, bin_reloc_size (reloc));
+			free (reloc_name);
 		} else {
 			// eprintf ("Cannot find a name for 0x%08"PFMT64x"\n", addr);
 		}
@@ -1608,6 +1617,7 @@ static RList *osymbols = NULL;
 static RBinSymbol *get_symbol(RBin *bin, RList *symbols, const char *name, ut64 addr) {
 	RBinSymbol *symbol, *res = NULL;
 	RListIter *iter;
+	r_strf_buffer (32);
 	if (mydb && symbols && symbols != osymbols) {
 		sdb_free (mydb);
 		mydb = NULL;
@@ -1616,10 +1626,10 @@ static RBinSymbol *get_symbol(RBin *bin, RList *symbols, const char *name, ut64
 	if (mydb) {
 		if (name) {
 			res = (RBinSymbol*)(void*)(size_t)
-				sdb_num_get (mydb, sdb_fmt ("%x", sdb_hash (name)), NULL);
+				sdb_num_get (mydb, r_strf ("%x", sdb_hash (name)), NULL);
 		} else {
 			res = (RBinSymbol*)(void*)(size_t)
-				sdb_num_get (mydb, sdb_fmt ("0x"PFMT64x, addr), NULL);
+				sdb_num_get (mydb, r_strf ("0x%"PFMT64x, addr), NULL);
 		}
 	} else {
 		mydb = sdb_new0 ();
@@ -1628,11 +1638,11 @@ static RBinSymbol *get_symbol(RBin *bin, RList *symbols, const char *name, ut64
 				continue;
 			}
 			/* ${name}=${ptrToSymbol} */
-			if (!sdb_num_add (mydb, sdb_fmt ("%x", sdb_hash (symbol->name)), (ut64)(size_t)symbol, 0)) {
+			if (!sdb_num_add (mydb, r_strf ("%x", sdb_hash (symbol->name)), (ut64)(size_t)symbol, 0)) {
 			//	eprintf ("DUP (%s)\n", symbol->name);
 			}
 			/* 0x${vaddr}=${ptrToSymbol} */
-			if (!sdb_num_add (mydb, sdb_fmt ("0x"PFMT64x, symbol->vaddr), (ut64)(size_t)symbol, 0)) {
+			if (!sdb_num_add (mydb, r_strf ("0x%"PFMT64x, symbol->vaddr), (ut64)(size_t)symbol, 0)) {
 			//	eprintf ("DUP (%s)\n", symbol->name);
 			}
 			if (name) {
@@ -1846,7 +1856,9 @@ static void snInit(RCore *r, SymName *sn, RBinSymbol *sym, const char *lang) {
 	}
 	pfx = getPrefixFor (sym->type);
 	sn->name = strdup (sym->name);
-	sn->nameflag = r_str_newf ("%s.%s", pfx, r_bin_symbol_name (sym));
+	char *symname = r_bin_symbol_name (sym);
+	sn->nameflag = r_str_newf ("%s.%s", pfx, symname);
+	free (symname);
 	r_name_filter (sn->nameflag, MAXFLAG_LEN);
 	if (sym->classname && sym->classname[0]) {
 		sn->classname = strdup (sym->classname);
@@ -1948,6 +1960,27 @@ static void select_flag_space(RCore *core, RBinSymbol *symbol) {
 	}
 }
 
+static void symbol_flag_fini(void *e, void *user) {
+	RFlagBatchItem *bi = e;
+	free ((char *)bi->name);
+	free ((char *)bi->realname);
+}
+
+/* symbol flags are queued and set in one r_flag_set_batch call, which
+ * is much cheaper than a r_flag_set per symbol on big binaries */
+static void flush_symbol_flags(RCore *core, RVector *flags) {
+	if (flags->len > 0) {
+		r_flag_set_batch (core->flags, flags->a, flags->len);
+		RFlagBatchItem *bi;
+		r_vector_foreach (flags, bi) {
+			if (!bi->item && bi->name) {
+				eprintf ("[Warning] Can't find flag (%s)\n", bi->name);
+			}
+		}
+		r_vector_clear (flags);
+	}
+}
+
 static int bin_symbols(RCore *r, int mode, ut64 laddr, int va, ut64 at, const char *name, bool exponly, const char *args) {
 	RBinInfo *info = r_bin_get_info (r->bin);
 	RList *entries = r_bin_get_entries (r->bin);
@@ -1995,6 +2028,8 @@ static int bin_symbols(RCore *r, int mode, ut64 laddr, int va, ut64 at, const ch
 
 
 	size_t count = 0;
+	RVector flags;
+	r_vector_init (&flags, sizeof (RFlagBatchItem), symbol_flag_fini, NULL);
 	r_list_foreach (symbols, iter, symbol) {
 		if (!symbol->name) {
 			continue;
@@ -2041,6 +2076,7 @@ static int bin_symbols(RCore *r, int mode, ut64 laddr, int va, ut64 at, const ch
 			select_flag_space (r, symbol);
 			/* If that's a Classed symbol (method or so) */
 			if (sn.classname) {
+				flush_symbol_flags (r, &flags);
 				RFlagItem *fi = r_flag_get (r->flags, sn.methflag);
 				if (r->bin->prefix) {
 					char *prname = r_str_newf ("%s.%s", r->bin->prefix, sn.methflag);
@@ -2065,18 +2101,16 @@ static int bin_symbols(RCore *r, int mode, ut64 laddr, int va, ut64 at, const ch
 			} else {
 				const char *n = sn.demname ? sn.demname : sn.name;
 				const char *fn = sn.demflag ? sn.demflag : sn.nameflag;
-				char *fnp = (r->bin->prefix) ?
-					r_str_newf ("%s.%s", r->bin->prefix, fn):
-					strdup (fn);
-				RFlagItem *fi = r_flag_set (r->flags, fnp, addr, symbol->size);
-				if (fi) {
-					r_flag_item_set_realname (fi, n);
-				} else {
-					if (fn) {
-						eprintf ("[Warning] Can't find flag (%s)\n", fn);
-					}
-				}
-				free (fnp);
+				RFlagBatchItem bi = {
+					.name = (r->bin->prefix) ?
+						r_str_newf ("%s.%s", r->bin->prefix, fn):
+						strdup (fn),
+					.realname = n? strdup (n): NULL,
+					.offset = addr,
+					.size = symbol->size,
+					.space = r_flag_space_cur (r->flags)
+				};
+				r_vector_push (&flags, &bi);
 			}
 			if (sn.demname) {
 				r_meta_add (r->anal, R_META_TYPE_COMMENT,
@@ -2132,17 +2166,19 @@ static int bin_symbols(RCore *r, int mode, ut64 laddr, int va, ut64 at, const ch
 					}
 					lastfs = 's';
 				}
+				char *symname = r_bin_symbol_name (symbol);
 				if (r->bin->prefix) {
 					r_cons_printf ("f %s.sym.%s %u 0x%08" PFMT64x "\n",
-						r->bin->prefix, r_bin_symbol_name (symbol), symbol->size, addr);
+						r->bin->prefix, symname, symbol->size, addr);
 				} else {
 					if (*name) {
 						r_cons_printf ("f sym.%s %u 0x%08" PFMT64x "\n",
-							r_bin_symbol_name (symbol), symbol->size, addr);
+							symname, symbol->size, addr);
 					} else {
 						// we dont want unnamed symbol flags
 					}
 				}
+				free (symname);
 				binfile = r_core_bin_cur (r);
 				plugin = r_bin_file_cur_plugin (binfile);
 				if (plugin && plugin->name) {
@@ -2188,6 +2224,8 @@ static int bin_symbols(RCore *r, int mode, ut64 laddr, int va, ut64 at, const ch
 			break;
 		}
 	}
+	flush_symbol_flags (r, &flags);
+	r_vector_clear (&flags);
 	if (count == 0 && IS_MODE_JSON (mode)) {
 		r_cons_printf ("{}");
 	}
@@ -2840,15 +2878,16 @@ static int bin_classes(RCore *r, int mode) {
 		}
 
 		if (IS_MODE_SET (mode)) {
-			const char *classname = sdb_fmt ("class.%s", name);
+			r_strf_var (classname, 256, "class.%s", name);
 			r_flag_set (r->flags, classname, c->addr, 1);
 			r_list_foreach (c->methods, iter2, sym) {
 				char *mflags = r_core_bin_method_flags_str (sym->method_flags, mode);
-				char *method = sdb_fmt ("method%s.%s.%s",
+				char *method = r_str_newf ("method%s.%s.%s",
 					mflags, c->name, sym->name);
 				R_FREE (mflags);
 				r_name_filter (method, -1);
 				r_flag_set (r->flags, method, sym->vaddr, 1);
+				free (method);
 			}
 		} else if (IS_MODE_SIMPLEST (mode)) {
 			r_cons_printf ("%s\n", c->name);
@@ -3078,7 +3117,7 @@ static void bin_pe_versioninfo(RCore *r, int mode) {
 	}
 	bool firstit_dowhile = true;
 	do {
-		char *path_version = sdb_fmt (format_version, num_version);
+		r_strf_var (path_version, 64, format_version, num_version);
 		if (!(sdb = sdb_ns_path (r->sdb, path_version, 0))) {
 			break;
 		}
@@ -3090,7 +3129,7 @@ static void bin_pe_versioninfo(RCore *r, int mode) {
 		} else {
 			r_cons_printf ("# VS_FIXEDFILEINFO\n\n");
 		}
-		const char *path_fixedfileinfo = sdb_fmt ("%s/fixed_file_info", path_version);
+		r_strf_var (path_fixedfileinfo, 256, "%s/fixed_file_info", path_version);
 		if (!(sdb = sdb_ns_path (r->sdb, path_fixedfileinfo, 0))) {
 			r_cons_printf ("}");
 			break;
@@ -3203,7 +3242,7 @@ static void bin_elf_versioninfo(RCore *r, int mode) {
 		r_cons_printf ("{\"versym\":[");
 	}
 	for (num_versym = 0;; num_versym++) {
-		const char *versym_path = sdb_fmt (format, "versym", num_versym);
+		r_strf_var (versym_path, 64, format, "versym", num_versym);
 		if (!(sdb = sdb_ns_path (r->sdb, versym_path, 0))) {
 			break;
 		}
@@ -3227,7 +3266,7 @@ static void bin_elf_versioninfo(RCore *r, int mode) {
 		}
 		int i;
 		for (i = 0; i < num_entries; i++) {
-			const char *key = sdb_fmt ("entry%d", i);
+			r_strf_var (key, 64, "entry%d", i);
 			const char *value = sdb_const_get (sdb, key, 0);
 			if (value) {
 				if (oValue && !strcmp (value, oValue)) {
@@ -3286,7 +3325,7 @@ static void bin_elf_versioninfo(RCore *r, int mode) {
 			const char *filename = NULL;
 			int num_vernaux = 0;
 
-			char *path_version = sdb_fmt ("%s/version%d", verneed_path, num_version);
+			r_strf_var (path_version, 256, "%s/version%d", verneed_path, num_version);
 			if (!(sdb = sdb_ns_path (r->sdb, path_version, 0))) {
 				break;
 			}
@@ -3318,7 +3357,7 @@ static void bin_elf_versioninfo(RCore *r, int mode) {
 			}
 			bool firstit_dowhile_vernaux = true;
 			do {
-				const char *path_vernaux = sdb_fmt ("%s/vernaux%d", path_version, num_vernaux++);
+				r_strf_var (path_vernaux, 512, "%s/vernaux%d", path_version, num_vernaux++);
 				if (!(sdb = sdb_ns_path (r->sdb, path_vernaux, 0))) {
 					break;
 				}
@@ -3373,12 +3412,12 @@ static void bin_pe_resources(RCore *r, int mode) {
 		pj_a (pj);
 	}
 	while (true) {
-		const char *timestrKey = sdb_fmt ("resource.%d.timestr", index);
-		const char *vaddrKey = sdb_fmt ("resource.%d.vaddr", index);
-		const char *sizeKey  = sdb_fmt ("resource.%d.size", index);
-		const char *typeKey  = sdb_fmt ("resource.%d.type", index);
-		const char *languageKey = sdb_fmt ("resource.%d.language", index);
-		const char *nameKey = sdb_fmt ("resource.%d.name", index);
+		r_strf_var (timestrKey, 64, "resource.%d.timestr", index);
+		r_strf_var (vaddrKey, 64, "resource.%d.vaddr", index);
+		r_strf_var (sizeKey, 64, "resource.%d.size", index);
+		r_strf_var (typeKey, 64, "resource.%d.type", index);
+		r_strf_var (languageKey, 64, "resource.%d.language", index);
+		r_strf_var (nameKey, 64, "resource.%d.name", index);
 		char *timestr = sdb_get (sdb, timestrKey, 0);
 		if (!timestr) {
 			break;
@@ -3390,7 +3429,7 @@ static void bin_pe_resources(RCore *r, int mode) {
 		char *lang = sdb_get (sdb, languageKey, 0);
 
 		if (IS_MODE_SET (mode)) {
-			const char *name = sdb_fmt ("resource.%d", index);
+			r_strf_var (name, 64, "resource.%d", index);
 			r_flag_set (r->flags, name, vaddr, size);
 		} else if (IS_MODE_RAD (mode)) {
 			r_cons_printf ("f resource.%d %d 0x%08"PFMT32x"\n", index, size, vaddr);
@@ -776,6 +776,16 @@ static bool cb_asm_invhex(void *user, void *data) {
 	return true;
 }
 
+static bool cb_asm_cache(void *user, void *data) {
+	RCore *core = (RCore *) user;
+	RConfigNode *node = (RConfigNode *) data;
+	core->assembler->usecache = node->i_value;
+	if (!node->i_value) {
+		r_asm_cache_reset (core->assembler);
+	}
+	return true;
+}
+
 static bool cb_asm_pcalign(void *user, void *data) {
 	RCore *core = (RCore *) user;
 	RConfigNode *node = (RConfigNode *) data;
@@ -837,6 +847,13 @@ static bool cb_binfilter(void *user, void *data) {
 	return true;
 }
 
+static bool cb_binlazy(void *user, void *data) {
+	RCore *core = (RCore*) user;
+	RConfigNode *node = (RConfigNode*) data;
+	core->bin->lazy = node->i_value;
+	return true;
+}
+
 /* BinDemangleCmd */
 static bool cb_bdc(void *user, void *data) {
 	RCore *core = (RCore*) user;
@@ -1797,6 +1814,26 @@ static bool cb_ioff(void *user, void *data) {
 	return true;
 }
 
+static bool cb_io_gzip_index(void *user, void *data) {
+	RCore *core = (RCore *) user;
+	RConfigNode *node = (RConfigNode *) data;
+	if (*node->value == '?') {
+		print_node_options (node);
+		return false;
+	}
+	if (!strcmp (node->value, "cache")) {
+		core->io->gzip_index = R_IO_GZIP_INDEX_CACHE;
+	} else if (!strcmp (node->value, "file")) {
+		core->io->gzip_index = R_IO_GZIP_INDEX_FILE;
+	} else if (!strcmp (node->value, "none")) {
+		core->io->gzip_index = R_IO_GZIP_INDEX_NONE;
+	} else {
+		eprintf ("io.gzip.index: cannot find '%s'\n", node->value);
+		return false;
+	}
+	return true;
+}
+
 static bool cb_io_oxff(void *user, void *data) {
 	RCore *core = (RCore *) user;
 	RConfigNode *node = (RConfigNode *) data;
@@ -2803,6 +2840,7 @@ R_API int r_core_config_init(RCore *core) {
 	SETPREF ("asm.xrefs.code", "true",  "Show the code xrefs (generated by jumps instead of calls)");
 	SETI ("asm.xrefs.max", 20,  "Maximum number of xrefs to be displayed without folding");
 	SETCB ("asm.invhex", "false", &cb_asm_invhex, "Show invalid instructions as hexadecimal numbers");
+	SETCB ("asm.cache", "false", &cb_asm_cache, "Cache disassembled instructions by address and bits (hit rate in ?T)");
 	SETPREF ("asm.instr", "true", "Display the disassembled instruction");
 	SETPREF ("asm.meta", "true", "Display the code/data/format conversions in disasm");
 	SETPREF ("asm.bytes", "true", "Display the bytes of each instruction");
@@ -2966,6 +3004,7 @@ R_API int r_core_config_init(RCore *core) {
 	SETDESC (n, "Filter strings");
 	SETOPTIONS (n, "a", "8", "p", "e", "u", "i", "U", "f", NULL);
 	SETCB ("bin.filter", "true", &cb_binfilter, "Filter symbol names to fix dupped names");
+	SETCB ("bin.lazy", "false", &cb_binlazy, "Parse symbols, imports, relocs, strings and classes on first use");
 	SETCB ("bin.force", "", &cb_binforce, "Force that rbin plugin");
 	SETPREF ("bin.lang", "", "Language for bin.demangle");
 	SETPREF ("bin.demangle", "true", "Import demangled symbols from RBin");
@@ -3248,6 +3287,7 @@ R_API int r_core_config_init(RCore *core) {
 	SETPREF ("http.ui", "m", "Default webui (enyo, m, p, t)");
 	SETPREF ("http.sandbox", "true", "Sandbox the HTTP server");
 	SETI ("http.timeout", 3, "Disconnect clients after N seconds of inactivity");
+	SETI ("http.workers", 4, "Number of threads accepting and parsing HTTP connections");
 	SETI ("http.dietime", 0, "Kill server after N seconds with no client");
 	SETPREF ("http.verbose", "false", "Output server logs to stdout");
 	SETPREF ("http.upget", "false", "/up/ answers GET requests, in addition to POST");
@@ -3413,6 +3453,7 @@ R_API int r_core_config_init(RCore *core) {
 	SETPREF ("rop.subchains", "false", "Display every length gadget from rop.len=X to 2 in /Rl");
 	SETPREF ("rop.conditional", "false", "Include conditional jump, calls and returns in ropsearch");
 	SETPREF ("rop.comments", "false", "Display comments in rop search output");
+	SETPREF ("rop.stats", "false", "Print gadgets/s and decoded instruction counts after /R");
 
 	/* io */
 	SETCB ("io.cache", "false", &cb_io_cache, "Change both of io.cache.{read,write}");
@@ -3429,6 +3470,9 @@ R_API int r_core_config_init(RCore *core) {
 	SETCB ("io.va", "true", &cb_iova, "Use virtual address layout");
 	SETCB ("io.pava", "false", &cb_io_pava, "Use EXPERIMENTAL paddr -> vaddr address mode");
 	SETCB ("io.autofd", "true", &cb_ioautofd, "Change fd when opening a new file");
+	n = NODECB ("io.gzip.index", "cache", &cb_io_gzip_index);
+	SETDESC (n, "Where to keep the inflate index of gzip:// files");
+	SETOPTIONS (n, "cache", "file", "none", NULL);
 
 	/* file */
 	SETPREF ("file.desc", "", "User defined file description (used by projects)");
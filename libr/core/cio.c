@@ -276,11 +276,15 @@ R_API void r_core_seek_archbits(RCore *core, ut64 addr) {
 		//if we found bits related with anal hints pick it up
 		__choose_bits_anal_hints (core, addr, &bits);
 	}
-	if (bits && !core->fixedbits) {
+	// only touch the config when it changes, this runs once per decoded op
+	if (bits && !core->fixedbits && bits != r_config_get_i (core->config, "asm.bits")) {
 		r_config_set_i (core->config, "asm.bits", bits);
 	}
 	if (arch && !core->fixedarch) {
-		r_config_set (core->config, "asm.arch", arch);
+		const char *cur = r_config_get (core->config, "asm.arch");
+		if (!cur || strcmp (cur, arch)) {
+			r_config_set (core->config, "asm.arch", arch);
+		}
 	}
 }
 
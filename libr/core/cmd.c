@@ -2072,6 +2072,44 @@ static char *parse_tmp_evals(RCore *core, const char *str) {
 	return res;
 }
 
+/* bookkeeping every command goes through, shared by r_core_cmd,
+ * r_core_cmd_subst and the plain `@@` path in foreach_plan_run */
+static bool cmd_depth_enter(RCore *core) {
+	if (core->cmd_depth < 1) {
+		R_FREE (core->oobi);
+		core->oobi_len = 0;
+		return false;
+	}
+	core->cmd_depth--;
+	return true;
+}
+
+static void cmd_depth_leave(RCore *core) {
+	run_pending_anal (core);
+	core->cmd_depth++;
+	R_FREE (core->oobi);
+	core->oobi_len = 0;
+}
+
+static void cmd_prompt_offset(RCore *core) {
+	if (core->max_cmd_depth - core->cmd_depth == 1) {
+		core->prompt_offset = core->offset;
+	}
+}
+
+/* the cursor is only honoured by commands run from the selected panel tab */
+static void cmd_cursor_select(RCore *core, bool ocur_enabled) {
+	if (core->print) {
+		core->print->cur_enabled = ocur_enabled && core->seltab >= 0 && core->seltab == core->curtab;
+	}
+}
+
+static void cmd_cursor_restore(RCore *core, bool ocur_enabled) {
+	if (core->print) {
+		core->print->cur_enabled = ocur_enabled;
+	}
+}
+
 static int r_core_cmd_subst(RCore *core, char *cmd) {
 	ut64 rep = strtoull (cmd, NULL, 10);
 	int ret = 0, orep;
@@ -2100,9 +2138,7 @@ static int r_core_cmd_subst(RCore *core, char *cmd) {
 	ut64 orig_offset = core->offset;
 	icmd = strdup (cmd);
 
-	if (core->max_cmd_depth - core->cmd_depth == 1) {
-		core->prompt_offset = core->offset;
-	}
+	cmd_prompt_offset (core);
 	cmd = r_str_trim_head_tail (icmd);
 	// lines starting with # are ignored (never reach cmd_hash()), except #! and #?
 	if (!*cmd) {
@@ -2157,16 +2193,9 @@ static int r_core_cmd_subst(RCore *core, char *cmd) {
 	const char *cmdrep = core->cmdtimes ? core->cmdtimes: "";
 	orep = rep;
 
-	int ocur_enabled = core->print && core->print->cur_enabled;
+	bool ocur_enabled = core->print && core->print->cur_enabled;
 	while (rep-- && *cmd) {
-		if (core->print) {
-			core->print->cur_enabled = false;
-			if (ocur_enabled && core->seltab >= 0) {
-				if (core->seltab == core->curtab) {
-					core->print->cur_enabled = true;
-				}
-			}
-		}
+		cmd_cursor_select (core, ocur_enabled);
 		char *cr = strdup (cmdrep);
 		core->break_loop = false;
 		ret = r_core_cmd_subst_i (core, cmd, colon, (rep == orep - 1) ? &tmpseek : NULL);
@@ -2191,9 +2220,7 @@ static int r_core_cmd_subst(RCore *core, char *cmd) {
 		r_core_seek (core, orig_offset, 1);
 		core->tmpseek = original_tmpseek;
 	}
-	if (core->print) {
-		core->print->cur_enabled = ocur_enabled;
-	}
+	cmd_cursor_restore (core, ocur_enabled);
 	if (colon && colon[1]) {
 		for (++colon; *colon == ';'; colon++) {
 			;
@@ -3302,6 +3329,99 @@ fail:
 	goto beach;
 }
 
+/* `@@` and `@@@` run the same command for every item, so it is classified
+ * once. plain commands (no pipes, redirections, greps, temporary seeks,
+ * subcommands or repeats) skip the r_core_cmd parser and are dispatched
+ * straight to r_cmd_call, and the ones known not to look at core->block
+ * don't pay for a block read on every item */
+typedef struct {
+	char *cmd;
+	char *buf;
+	int len;
+	bool plain;
+	bool noblock;
+	bool dirty;
+} ForeachPlan;
+
+/* command names (without arguments) that never read core->block */
+static const char *foreach_noblock[] = { "afi", "afij", "afi*", "afn", "fd", "fdj", NULL };
+
+static void foreach_plan_init(RCore *core, ForeachPlan *p, const char *cmd) {
+	memset (p, 0, sizeof (ForeachPlan));
+	p->cmd = r_str_trim (strdup (cmd));
+	if (!p->cmd) {
+		return;
+	}
+	p->len = strlen (p->cmd);
+	p->buf = malloc (p->len + 1);
+	if (!p->buf || !*p->cmd || core->cmdfilter || core->cmdremote) {
+		return;
+	}
+	if (strpbrk (p->cmd, ";|>~@`$\"'&#\\(\n") || strstr (p->cmd, "?*")) {
+		return;
+	}
+	if (IS_DIGIT (*p->cmd) || *p->cmd == '.' || r_str_startswith (p->cmd, "GET /")) {
+		return;
+	}
+	p->plain = true;
+	const char *sp = strchr (p->cmd, ' ');
+	int i, namelen = sp ? sp - p->cmd : p->len;
+	for (i = 0; foreach_noblock[i]; i++) {
+		const char *name = foreach_noblock[i];
+		if (strlen (name) == namelen && !strncmp (p->cmd, name, namelen)) {
+			p->noblock = true;
+			break;
+		}
+	}
+}
+
+/* seek to the next item and resize the block if size is not negative,
+ * reading it at most once */
+static void foreach_plan_seek(RCore *core, ForeachPlan *p, ut64 addr, int size) {
+	r_core_seek (core, addr, false);
+	if (size >= 0 && size != core->blocksize && r_core_block_size (core, size)) {
+		return;
+	}
+	if (p->noblock) {
+		p->dirty = true;
+	} else {
+		r_core_block_read (core);
+	}
+}
+
+static int foreach_plan_run(RCore *core, ForeachPlan *p) {
+	if (!p->cmd) {
+		return false;
+	}
+	if (!p->plain || !p->buf || core->incomment || core->cmd_depth < 1) {
+		return r_core_cmd (core, p->cmd, 0);
+	}
+	if (!cmd_depth_enter (core)) {
+		return false;
+	}
+	bool ocur_enabled = core->print && core->print->cur_enabled;
+	cmd_prompt_offset (core);
+	cmd_cursor_select (core, ocur_enabled);
+	core->break_loop = false;
+	// handlers may write into their input
+	memcpy (p->buf, p->cmd, p->len + 1);
+	int ret = r_cmd_call (core->rcmd, p->buf);
+	if (ret == -1) {
+		eprintf ("|ERROR| Invalid command '%s' (0x%02x)\n", p->cmd, *p->cmd);
+	}
+	cmd_cursor_restore (core, ocur_enabled);
+	cmd_depth_leave (core);
+	return ret;
+}
+
+static void foreach_plan_fini(RCore *core, ForeachPlan *p) {
+	if (p->dirty) {
+		r_core_block_read (core);
+	}
+	free (p->cmd);
+	free (p->buf);
+}
+
 static int foreach_comment(void *user, const char *k, const char *v) {
 	RAnalMetaUserItem *ui = user;
 	RCore *core = ui->anal->user;
@@ -3319,18 +3439,17 @@ static int foreach_comment(void *user, const char *k, const char *v) {
 
 struct exec_command_t {
 	RCore *core;
-	const char *cmd;
+	ForeachPlan *plan;
 };
 
 static bool exec_command_on_flag(RFlagItem *flg, void *u) {
 	struct exec_command_t *user = (struct exec_command_t *)u;
-	r_core_block_size (user->core, flg->size);
-	r_core_seek (user->core, flg->offset, 1);
-	r_core_cmd0 (user->core, user->cmd);
+	foreach_plan_seek (user->core, user->plan, flg->offset, flg->size);
+	foreach_plan_run (user->core, user->plan);
 	return true;
 }
 
-static void foreach_pairs (RCore *core, const char *cmd, const char *each) {
+static void foreach_pairs (RCore *core, ForeachPlan *plan, const char *each) {
 	const char *arg;
 	int pair = 0;
 	for (arg = each ; ; ) {
@@ -3342,7 +3461,7 @@ static void foreach_pairs (RCore *core, const char *cmd, const char *each) {
 			ut64 n = r_num_get (NULL, arg);
 			if (pair%2) {
 				r_core_block_size (core, n);
-				r_core_cmd0 (core, cmd);
+				foreach_plan_run (core, plan);
 			} else {
 				r_core_seek (core, n, 1);
 			}
@@ -3361,14 +3480,16 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 	RListIter *iter;
 	int i;
 	const char *filter = NULL;
+	ForeachPlan plan;
 
 	if (each[1] == ':') {
 		filter = each + 2;
 	}
+	foreach_plan_init (core, &plan, cmd);
 
 	switch (each[0]) {
 	case '=':
-		foreach_pairs (core, cmd, each + 1);
+		foreach_pairs (core, &plan, each + 1);
 		break;
 	case '?':
 		r_core_cmd_help (core, help_msg_at_at_at);
@@ -3376,7 +3497,7 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 	case 'c':
 		if (filter) {
 			char *arg = r_core_cmd_str (core, filter);
-			foreach_pairs (core, cmd, arg);
+			foreach_pairs (core, &plan, arg);
 			free (arg);
 		} else {
 			eprintf ("Usage: @@@c:command   # same as @@@=`command`\n");
@@ -3394,9 +3515,8 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 			if (maps) {
 				RListIter *iter;
 				r_list_foreach (maps, iter, map) {
-					r_core_seek (core, map->itv.addr, 1);
-					r_core_block_size (core, map->itv.size);
-					r_core_cmd0 (core, cmd);
+					foreach_plan_seek (core, &plan, map->itv.addr, map->itv.size);
+					foreach_plan_run (core, &plan);
 				}
 				r_list_free (maps);
 			}
@@ -3406,9 +3526,9 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 		if (dbg && dbg->h && dbg->maps) {
 			RDebugMap *map;
 			r_list_foreach (dbg->maps, iter, map) {
-				r_core_seek (core, map->addr, 1);
 				//r_core_block_size (core, map->size);
-				r_core_cmd0 (core, cmd);
+				foreach_plan_seek (core, &plan, map->addr, -1);
+				foreach_plan_run (core, &plan);
 			}
 		}
 		break;
@@ -3419,12 +3539,13 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 			RDebugPid *p;
 			list = dbg->h->threads (dbg, dbg->pid);
 			if (!list) {
+				foreach_plan_fini (core, &plan);
 				return false;
 			}
 			r_list_foreach (list, iter, p) {
 				r_core_cmdf (core, "dp %d", p->pid);
 				r_cons_printf ("PID %d\n", p->pid);
-				r_core_cmd0 (core, cmd);
+				foreach_plan_run (core, &plan);
 			}
 			r_core_cmdf (core, "dp %d", origpid);
 			r_list_free (list);
@@ -3446,9 +3567,9 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 						continue;
 					}
 					value = r_reg_get_value (dbg->reg, item);
-					r_core_seek (core, value, 1);
+					foreach_plan_seek (core, &plan, value, -1);
 					r_cons_printf ("%s: ", item->name);
-					r_core_cmd0 (core, cmd);
+					foreach_plan_run (core, &plan);
 				}
 			}
 			r_core_seek (core, offorig, 1);
@@ -3465,8 +3586,8 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 				ut64 addr = r_num_math (core->num, impflag);
 				free (impflag);
 				if (addr && addr != UT64_MAX) {
-					r_core_seek (core, addr, 1);
-					r_core_cmd0 (core, cmd);
+					foreach_plan_seek (core, &plan, addr, -1);
+					foreach_plan_run (core, &plan);
 				}
 			}
 			r_core_seek (core, offorig, 1);
@@ -3481,9 +3602,8 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 				RBinSection *sec;
 				RListIter *iter;
 				r_list_foreach (obj->sections, iter, sec) {
-					r_core_seek (core, sec->vaddr, 1);
-					r_core_block_size (core, sec->vsize);
-					r_core_cmd0 (core, cmd);
+					foreach_plan_seek (core, &plan, sec->vaddr, sec->vsize);
+					foreach_plan_run (core, &plan);
 				}
 				r_core_block_size (core, bszorig);
 				r_core_seek (core, offorig, 1);
@@ -3517,9 +3637,8 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 				ut64 offorig = core->offset;
 				ut64 obs = core->blocksize;
 				r_list_foreach (list, iter, s) {
-					r_core_block_size (core, s->size);
-					r_core_seek (core, s->vaddr, 1);
-					r_core_cmd0 (core, cmd);
+					foreach_plan_seek (core, &plan, s->vaddr, s->size);
+					foreach_plan_run (core, &plan);
 				}
 				r_core_block_size (core, obs);
 				r_core_seek (core, offorig, 1);
@@ -3535,9 +3654,8 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 				if (r_cons_is_breaked ()) {
 					break;
 				}
-				r_core_block_size (core, sym->size);
-				r_core_seek (core, sym->vaddr, 1);
-				r_core_cmd0 (core, cmd);
+				foreach_plan_seek (core, &plan, sym->vaddr, sym->size);
+				foreach_plan_run (core, &plan);
 			}
 			r_cons_break_pop ();
 			r_core_block_size (core, obs);
@@ -3550,7 +3668,7 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 			char *glob = filter? r_str_trim (strdup (filter)): NULL;
 			ut64 off = core->offset;
 			ut64 obs = core->blocksize;
-			struct exec_command_t u = { .core = core, .cmd = cmd };
+			struct exec_command_t u = { .core = core, .plan = &plan };
 			r_flag_foreach_glob (core->flags, glob, exec_command_on_flag, &u);
 			r_core_seek (core, off, 0);
 			r_core_block_size (core, obs);
@@ -3569,9 +3687,8 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 					break;
 				}
 				if (!filter || r_str_glob (fcn->name, filter)) {
-					r_core_seek (core, fcn->addr, 1);
-					r_core_block_size (core, r_anal_fcn_size (fcn));
-					r_core_cmd0 (core, cmd);
+					foreach_plan_seek (core, &plan, fcn->addr, r_anal_fcn_size (fcn));
+					foreach_plan_run (core, &plan);
 				}
 			}
 			r_cons_break_pop ();
@@ -3588,9 +3705,8 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 				RListIter *iter;
 				RAnalBlock *bb;
 				r_list_foreach (fcn->bbs, iter, bb) {
-					r_core_seek (core, bb->addr, 1);
-					r_core_block_size (core, bb->size);
-					r_core_cmd0 (core, cmd);
+					foreach_plan_seek (core, &plan, bb->addr, bb->size);
+					foreach_plan_run (core, &plan);
 				}
 				r_core_block_size (core, obs);
 				r_core_seek (core, offorig, 1);
@@ -3598,11 +3714,11 @@ R_API int r_core_cmd_foreach3(RCore *core, const char *cmd, char *each) { // "@@
 		}
 		break;
 	}
+	foreach_plan_fini (core, &plan);
 	return 0;
 }
 
-static void foreachOffset (RCore *core, const char *_cmd, const char *each) {
-	char *cmd = strdup (_cmd);
+static void foreachOffset (RCore *core, ForeachPlan *plan, const char *each) {
 	char *nextLine = NULL;
 	ut64 addr;
 	/* foreach list of items */
@@ -3647,13 +3763,12 @@ static void foreachOffset (RCore *core, const char *_cmd, const char *each) {
 				addr = r_num_math (core->num, each);
 				each = NULL;
 			}
-			r_core_seek (core, addr, 1);
-			r_core_cmd (core, cmd, 0);
+			foreach_plan_seek (core, plan, addr, -1);
+			foreach_plan_run (core, plan);
 			r_cons_flush ();
 		}
 		each = nextLine;
 	}
-	free (cmd);
 }
 
 struct duplicate_flag_t {
@@ -3682,6 +3797,7 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 	RListIter *iter;
 	RFlagItem *flag;
 	ut64 oseek, addr;
+	ForeachPlan plan;
 
 	for (; *cmd == ' '; cmd++) {
 		;
@@ -3690,6 +3806,7 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 	oseek = core->offset;
 	ostr = str = strdup (each);
 	r_cons_break_push (NULL, NULL); //pop on return
+	foreach_plan_init (core, &plan, cmd);
 	switch (each[0]) {
 	case '/': // "@@/"
 		{
@@ -3699,6 +3816,7 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 		r_config_set (core->config, "cmd.hit", cmdhit);
 		free (cmdhit);
 		}
+		foreach_plan_fini (core, &plan);
 		free (ostr);
 		return 0;
 	case '?': // "@@?"
@@ -3713,9 +3831,8 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 			if (fcn) {
 				r_list_sort (fcn->bbs, bb_cmp);
 				r_list_foreach (fcn->bbs, iter, bb) {
-					r_core_block_size (core, bb->size);
-					r_core_seek (core, bb->addr, 1);
-					r_core_cmd (core, cmd, 0);
+					foreach_plan_seek (core, &plan, bb->addr, bb->size);
+					foreach_plan_run (core, &plan);
 					if (r_cons_is_breaked ()) {
 						break;
 					}
@@ -3738,8 +3855,8 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 				ut64 to = r_num_math (core->num, r_str_word_get0 (str, 1));
 				ut64 step = r_num_math (core->num, r_str_word_get0 (str, 2));
 				for (cur = from; cur < to; cur += step) {
-					(void)r_core_seek (core, cur, 1);
-					r_core_cmd (core, cmd, 0);
+					foreach_plan_seek (core, &plan, cur, -1);
+					foreach_plan_run (core, &plan);
 					if (r_cons_is_breaked ()) {
 						break;
 					}
@@ -3759,10 +3876,10 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 			if (fcn) {
 				r_list_sort (fcn->bbs, bb_cmp);
 				r_list_foreach (fcn->bbs, iter, bb) {
-					for (i = 0; i < bb->op_pos_size; i++) {
-						ut64 addr = bb->addr + bb->op_pos[i];
-						r_core_seek (core, addr, 1);
-						r_core_cmd (core, cmd, 0);
+					for (i = 0; i < bb->ninstr; i++) {
+						ut64 addr = r_anal_bb_opaddr_i (bb, i);
+						foreach_plan_seek (core, &plan, addr, -1);
+						foreach_plan_run (core, &plan);
 						if (r_cons_is_breaked ()) {
 							break;
 						}
@@ -3779,8 +3896,8 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 			if (core->anal) {
 				r_list_foreach (core->anal->fcns, iter, fcn) {
 					if (each[2] && strstr (fcn->name, each + 2)) {
-						r_core_seek (core, fcn->addr, 1);
-						r_core_cmd (core, cmd, 0);
+						foreach_plan_seek (core, &plan, fcn->addr, -1);
+						foreach_plan_run (core, &plan);
 						if (r_cons_is_breaked ()) {
 							break;
 						}
@@ -3795,9 +3912,9 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 				RConsGrep grep = core->cons->context->grep;
 				r_list_foreach (core->anal->fcns, iter, fcn) {
 					char *buf;
-					r_core_seek (core, fcn->addr, 1);
+					foreach_plan_seek (core, &plan, fcn->addr, -1);
 					r_cons_push ();
-					r_core_cmd (core, cmd, 0);
+					foreach_plan_run (core, &plan);
 					buf = (char *)r_cons_get_buffer ();
 					if (buf) {
 						buf = strdup (buf);
@@ -3823,7 +3940,7 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 				r_list_foreach (list, iter, p) {
 					r_cons_printf ("# PID %d\n", p->pid);
 					r_debug_select (core->dbg, p->pid, p->pid);
-					r_core_cmd (core, cmd, 0);
+					foreach_plan_run (core, &plan);
 					r_cons_newline ();
 				}
 				r_list_free (list);
@@ -3836,13 +3953,13 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 		if (each[1] == ':') {
 			char *arg = r_core_cmd_str (core, each + 2);
 			if (arg) {
-				foreachOffset (core, cmd, arg);
+				foreachOffset (core, &plan, arg);
 				free (arg);
 			}
 		}
 		break;
 	case '=': // "@@="
-		foreachOffset (core, cmd, str + 1);
+		foreachOffset (core, &plan, str + 1);
 		break;
 	case 'd': // "@@d"
 		if (each[1] == 'b' && each[2] == 't') {
@@ -3865,7 +3982,7 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 					r_core_seek (core, frame->addr, 1);
 					break;
 				}
-				r_core_cmd (core, cmd, 0);
+				foreach_plan_run (core, &plan);
 				r_cons_newline ();
 				i++;
 			}
@@ -3898,8 +4015,8 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 				}
 				//eprintf ("; 0x%08"PFMT64x":\n", addr);
 				each = str + 1;
-				r_core_seek (core, addr, 1);
-				r_core_cmd (core, cmd, 0);
+				foreach_plan_seek (core, &plan, addr, -1);
+				foreach_plan_run (core, &plan);
 				r_cons_flush ();
 			} while (str != NULL);
 			free (out);
@@ -3996,9 +4113,9 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 
 					char *buf = NULL;
 					const char *tmp = NULL;
-					r_core_seek (core, flag->offset, 1);
+					foreach_plan_seek (core, &plan, flag->offset, -1);
 					r_cons_push ();
-					r_core_cmd (core, cmd, 0);
+					foreach_plan_run (core, &plan);
 					tmp = r_cons_get_buffer ();
 					buf = tmp? strdup (tmp): NULL;
 					r_cons_pop ();
@@ -4015,11 +4132,13 @@ R_API int r_core_cmd_foreach(RCore *core, const char *cmd, char *each) {
 	r_cons_break_pop ();
 	// XXX: use r_core_seek here
 	core->offset = oseek;
+	foreach_plan_fini (core, &plan);
 
 	free (word);
 	free (ostr);
 	return true;
 out_finish:
+	foreach_plan_fini (core, &plan);
 	free (ostr);
 	r_cons_break_pop ();
 	return false;
@@ -4095,14 +4214,11 @@ R_API int r_core_cmd(RCore *core, const char *cstr, int log) {
 		r_line_hist_add (cstr);
 	}
 
-	if (core->cmd_depth < 1) {
+	if (!cmd_depth_enter (core)) {
 		eprintf ("r_core_cmd: That was too deep (%s)...\n", cmd);
 		free (ocmd);
-		R_FREE (core->oobi);
-		core->oobi_len = 0;
 		goto beach;
 	}
-	core->cmd_depth--;
 	for (rcmd = cmd;;) {
 		ptr = strchr (rcmd, '\n');
 		if (ptr) {
@@ -4119,11 +4235,8 @@ R_API int r_core_cmd(RCore *core, const char *cstr, int log) {
 		rcmd = ptr + 1;
 	}
 	/* run pending analysis commands */
-	run_pending_anal (core);
-	core->cmd_depth++;
+	cmd_depth_leave (core);
 	free (ocmd);
-	R_FREE (core->oobi);
-	core->oobi_len = 0;
 	return ret;
 beach:
 	if (r_list_empty (core->tasks)) {
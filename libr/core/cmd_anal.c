@@ -8139,6 +8139,7 @@ static int cmd_anal_all(RCore *core, const char *input) {
 		} else {
 			bool didAap = false;
 			char *dh_orig = NULL;
+			R_PROF_BEGIN (aaa);
 			if (!strncmp (input, "aaaaa", 5)) {
 				eprintf ("An r2 developer is coming to your place to manually analyze this program. Please wait for it\n");
 				if (r_cons_is_interactive ()) {
@@ -8150,7 +8151,9 @@ static int cmd_anal_all(RCore *core, const char *input) {
 			oldstr = r_print_rowlog (core->print, "Analyze all flags starting with sym. and entry0 (aa)");
 			r_cons_break_push (NULL, NULL);
 			r_cons_break_timeout (r_config_get_i (core->config, "anal.timeout"));
+			R_PROF_BEGIN (aa);
 			r_core_anal_all (core);
+			R_PROF_END (aa);
 			r_print_rowlog_done (core->print, oldstr);
 			// Run pending analysis immediately after analysis
 			// Usefull when running commands with ";" or via r2 -c,-i
@@ -8189,7 +8192,9 @@ static int cmd_anal_all(RCore *core, const char *input) {
 				}
 
 				oldstr = r_print_rowlog (core->print, "Analyze function calls (aac)");
+				R_PROF_BEGIN (aac);
 				(void)cmd_anal_calls (core, "", false, false); // "aac"
+				R_PROF_END (aac);
 				r_core_seek (core, curseek, 1);
 				// oldstr = r_print_rowlog (core->print, "Analyze data refs as code (LEA)");
 				// (void) cmd_anal_aad (core, NULL); // "aad"
@@ -8200,7 +8205,9 @@ static int cmd_anal_all(RCore *core, const char *input) {
 
 				if (is_unknown_file (core)) {
 					oldstr = r_print_rowlog (core->print, "find and analyze function preludes (aap)");
+					R_PROF_BEGIN (aap);
 					(void)r_core_search_preludes (core, false); // "aap"
+					R_PROF_END (aap);
 					didAap = true;
 					r_print_rowlog_done (core->print, oldstr);
 					if (r_cons_is_breaked ()) {
@@ -8209,7 +8216,9 @@ static int cmd_anal_all(RCore *core, const char *input) {
 				}
 				
 				oldstr = r_print_rowlog (core->print, "Analyze len bytes of instructions for references (aar)");
+				R_PROF_BEGIN (aar);
 				(void)r_core_anal_refs (core, ""); // "aar"
+				R_PROF_END (aar);
 				r_print_rowlog_done (core->print, oldstr);
 				if (r_cons_is_breaked ()) {
 					goto jacuzzi;
@@ -8226,11 +8235,15 @@ static int cmd_anal_all(RCore *core, const char *input) {
 					goto jacuzzi;
 				}
 				if (!r_str_startswith (r_config_get (core->config, "asm.arch"), "x86")) {
+					R_PROF_BEGIN (aav);
 					r_core_cmd0 (core, "aav");
+					R_PROF_END (aav);
 					bool ioCache = r_config_get_i (core->config, "io.pcache");
 					r_config_set_i (core->config, "io.pcache", 1);
 					oldstr = r_print_rowlog (core->print, "Emulate code to find computed references (aae)");
+					R_PROF_BEGIN (aae);
 					r_core_cmd0 (core, "aae");
+					R_PROF_END (aae);
 					r_print_rowlog_done (core->print, oldstr);
 					if (!ioCache) {
 						r_core_cmd0 (core, "wc-*");
@@ -8243,7 +8256,9 @@ static int cmd_anal_all(RCore *core, const char *input) {
 				if (r_config_get_i (core->config, "anal.autoname")) {
 					oldstr = r_print_rowlog (core->print, "Speculatively constructing a function name "
 					                         "for fcn.* and sym.func.* functions (aan)");
+					R_PROF_BEGIN (aan);
 					r_core_anal_autoname_all_fcns (core);
+					R_PROF_END (aan);
 					r_print_rowlog_done (core->print, oldstr);
 				}
 				if (core->anal->opt.vars) {
@@ -8270,7 +8285,9 @@ static int cmd_anal_all(RCore *core, const char *input) {
 				}
 
 				oldstr = r_print_rowlog (core->print, "Type matching analysis for all functions (aaft)");
+				R_PROF_BEGIN (aaft);
 				r_core_cmd0 (core, "aaft");
+				R_PROF_END (aaft);
 				r_print_rowlog_done (core->print, oldstr);
 				oldstr = r_print_rowlog (core->print, "Use -AA or aaaa to perform additional experimental analysis.");
 				r_print_rowlog_done (core->print, oldstr);
@@ -8297,6 +8314,7 @@ static int cmd_anal_all(RCore *core, const char *input) {
 			flag_every_function (core);
 			r_cons_break_pop ();
 			R_FREE (dh_orig);
+			R_PROF_END (aaa);
 		}
 		break;
 	case 't': { // "aat"
@@ -424,6 +424,7 @@ static const char *help_msg_dt[] = {
 	"dt-", "", "Reset traces (instruction/calls)",
 	"dt=", "", "Show ascii-art color bars with the debug trace ranges",
 	"dta", " 0x804020 ...", "Only trace given addresses",
+	"dtb", "[?] [from] [to]", "Basic block coverage using one-shot breakpoints",
 	"dtc[?][addr]|([from] [to] [addr])", "", "Trace call/ret",
 	"dtd", "[qi] [nth-start]", "List all traced disassembled (quiet, instructions)",
 	"dte", "[?]", "Show esil trace logs",
@@ -435,6 +436,15 @@ static const char *help_msg_dt[] = {
 	NULL
 };
 
+static const char *help_msg_dtb[] = {
+	"Usage:", "dtb", " Basic block coverage (analyze first)",
+	"dtb", " [from] [to]", "Trap every block start once and continue until the process stops",
+	"dtbc", " [from] [to]", "Same but keep the traps to count every hit (slower)",
+	"dtbl", "", "List covered blocks in hit order with their hit count",
+	"dtbd", " [file]", "Export the coverage in drcov format",
+	NULL
+};
+
 static const char *help_msg_dte[] = {
 	"Usage:", "dte", " Show esil trace logs",
 	"dte", "", "Esil trace log for a single instruction",
@@ -515,6 +525,7 @@ static void cmd_debug_init(RCore *core) {
 	DEFINE_CMD_DESCRIPTOR (core, drx);
 	DEFINE_CMD_DESCRIPTOR (core, ds);
 	DEFINE_CMD_DESCRIPTOR (core, dt);
+	DEFINE_CMD_DESCRIPTOR (core, dtb);
 	DEFINE_CMD_DESCRIPTOR (core, dte);
 	DEFINE_CMD_DESCRIPTOR (core, dts);
 	DEFINE_CMD_DESCRIPTOR (core, dx);
@@ -3773,6 +3784,96 @@ static void debug_trace_calls(RCore *core, const char *input) {
 	r_cons_break_pop ();
 }
 
+static void debug_trace_bbcov(RCore *core, const char *input) {
+	RDebug *dbg = core->dbg;
+	RDebugBBCov *cov = dbg->bbcov;
+	RDebugBBCovBlock *blocks, *block;
+	RListIter *iter, *iter2;
+	RAnalFunction *fcn;
+	RAnalBlock *bb;
+	ut32 *idx;
+
+	switch (*input) {
+	case 0: // "dtb"
+	case ' ': // "dtb [from] [to]"
+	case 'c': { // "dtbc"
+		bool oneshot = *input != 'c';
+		ut64 from = 0, to = UT64_MAX;
+		char *arg = strchr (input, ' ');
+		if (arg) {
+			arg = (char *)r_str_trim_ro (arg);
+			from = r_num_math (core->num, arg);
+			if ((arg = strchr (arg, ' '))) {
+				to = r_num_math (core->num, arg + 1);
+			}
+		}
+		if (r_debug_is_dead (dbg)) {
+			eprintf ("No process to debug.\n");
+			break;
+		}
+		r_debug_bbcov_free (dbg->bbcov);
+		cov = dbg->bbcov = r_debug_bbcov_new ();
+		if (!cov) {
+			break;
+		}
+		r_list_foreach (core->anal->fcns, iter, fcn) {
+			r_list_foreach (fcn->bbs, iter2, bb) {
+				if (bb->addr >= from && bb->addr < to) {
+					r_debug_bbcov_add (cov, bb->addr, bb->size);
+				}
+			}
+		}
+		if (r_vector_empty (&cov->blocks)) {
+			eprintf ("No basic blocks to trace, analyze the program first.\n");
+			break;
+		}
+		r_cons_break_push (static_debug_stop, dbg);
+		int hits = r_debug_bbcov_run (dbg, cov, oneshot);
+		r_cons_break_pop ();
+		if (hits < 0) {
+			eprintf ("Cannot trace with this debugger backend.\n");
+			break;
+		}
+		int covered = 0;
+		r_vector_foreach (&cov->blocks, block) {
+			covered += block->hits > 0;
+		}
+		double secs = cov->elapsed / 1000000000.0;
+		eprintf ("%d hits, %d/%d blocks covered in %.3fs (%.0f blocks/s)\n",
+			hits, covered, (int)cov->blocks.len, secs, secs > 0? hits / secs: 0);
+		break;
+	}
+	case 'l': // "dtbl"
+		if (cov) {
+			ut8 *seen = calloc (cov->blocks.len + 1, 1);
+			blocks = cov->blocks.a;
+			r_vector_foreach (&cov->log, idx) {
+				if (seen && !seen[*idx]) {
+					seen[*idx] = 1;
+					block = &blocks[*idx];
+					r_cons_printf ("0x%08"PFMT64x" %d %d\n", block->addr, block->size, block->hits);
+				}
+			}
+			free (seen);
+		}
+		break;
+	case 'd': // "dtbd"
+		if (!cov) {
+			eprintf ("No coverage collected, run dtb first.\n");
+		} else if (input[1] == ' ' && input[2]) {
+			if (!r_debug_bbcov_drcov (dbg, cov, r_str_trim_ro (input + 2))) {
+				eprintf ("Cannot write drcov file.\n");
+			}
+		} else {
+			eprintf ("Usage: dtbd [file]\n");
+		}
+		break;
+	default:
+		r_core_cmd_help (core, help_msg_dtb);
+		break;
+	}
+}
+
 static void r_core_debug_esil (RCore *core, const char *input) {
 	switch (input[0]) {
 	case '\0': // "de"
@@ -4522,6 +4623,9 @@ static int cmd_debug(void *data, const char *input) {
 		case 'a': // "dta"
 			r_debug_trace_at (core->dbg, input + 3);
 			break;
+		case 'b': // "dtb"
+			debug_trace_bbcov (core, input + 2);
+			break;
 		case 't': // "dtt"
 			r_debug_trace_tag (core->dbg, atoi (input + 3));
 			break;
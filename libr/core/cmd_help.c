@@ -152,7 +152,7 @@ static const char *help_msg_question[] = {
 	"?r", " [from] [to]", "generate random number between from-to",
 	"?s", " from to step", "sequence of numbers from to by steps",
 	"?t", " cmd", "returns the time to run a command",
-	"?T", "", "show loading times",
+	"?T", "[?+-0pjf]", "show loading times, analysis profiler",
 	"?u", " num", "get value in human units (KB, MB, GB, TB)",
 	"?v", " eip-0x804800", "show hex value of math expr",
 	"?vi", " rsp-rbp", "show decimal value of math expr",
@@ -229,6 +229,18 @@ static const char *help_msg_question_V[] = {
 	NULL
 };
 
+static const char *help_msg_question_T[] = {
+	"Usage: ?T[+-0pjf]","","",
+	"?T", "", "show loading times",
+	"?T+", "", "reset and enable the analysis profiler",
+	"?T-", "", "disable the analysis profiler",
+	"?T0", "", "reset the profiler timers and counters",
+	"?Tp", "", "show per pass timings and counters",
+	"?Tj", "", "same as above but in JSON",
+	"?Tf", "", "show folded stacks (flamegraph.pl input)",
+	NULL
+};
+
 static const char *help_msg_greater_sign[] = {
 	"Usage:", "[cmd]>[file]", "redirects console from 'cmd' output to 'file'",
 	"[cmd] > [file]", "", "redirect STDOUT of 'cmd' to 'file'",
@@ -260,6 +272,7 @@ static void cmd_help_init(RCore *core) {
 	DEFINE_CMD_DESCRIPTOR_SPECIAL (core, ?, question);
 	DEFINE_CMD_DESCRIPTOR_SPECIAL (core, ?v, question_v);
 	DEFINE_CMD_DESCRIPTOR_SPECIAL (core, ?V, question_V);
+	DEFINE_CMD_DESCRIPTOR_SPECIAL (core, ?T, question_T);
 }
 
 static const char* findBreakChar(const char *s) {
@@ -500,12 +513,42 @@ static int cmd_help(void *data, const char *input) {
 		r_cons_printf ("0%"PFMT64o"\n", n);
 		break;
 	case 'T': // "?T"
-		r_cons_printf("plug.init = %"PFMT64d"\n"
-			"plug.load = %"PFMT64d"\n"
-			"file.load = %"PFMT64d"\n",
-			core->times->loadlibs_init_time,
-			core->times->loadlibs_time,
-			core->times->file_open_time);
+		switch (input[1]) {
+		case '?': // "?T?"
+			r_core_cmd_help (core, help_msg_question_T);
+			break;
+		case '+': // "?T+"
+			r_prof_reset ();
+			r_prof_enable (true);
+			break;
+		case '-': // "?T-"
+			r_prof_enable (false);
+			break;
+		case '0': // "?T0"
+			r_prof_reset ();
+			break;
+		case 'p': // "?Tp"
+		case 'j': // "?Tj"
+		case 'f': // "?Tf"
+			{
+				char *s = r_prof_dump (input[1] == 'p'? 0: input[1]);
+				if (s && input[1] == 'j') {
+					r_cons_println (s);
+				} else if (s) {
+					r_cons_print (s);
+				}
+				free (s);
+			}
+			break;
+		default:
+			r_cons_printf("plug.init = %"PFMT64d"\n"
+				"plug.load = %"PFMT64d"\n"
+				"file.load = %"PFMT64d"\n",
+				core->times->loadlibs_init_time,
+				core->times->loadlibs_time,
+				core->times->file_open_time);
+			break;
+		}
 		break;
 	case 'u': // "?u"
 		{
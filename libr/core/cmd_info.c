@@ -676,16 +676,18 @@ static int cmd_info(void *data, const char *input) {
 			goto done;
 		}
 		case 's': { // "is"
-			RBinObject *obj = r_bin_cur_object (core->bin);
+			// the getter parses the symbols first with bin.lazy
+			RList *symbols = r_bin_get_symbols (core->bin);
+			int nsymbols = symbols? r_list_length (symbols): 0;
 			// Case for isj.
 			if (input[1] == 'j' && input[2] == '.') {
 				mode = R_MODE_JSON;
-				RBININFO ("symbols", R_CORE_BIN_ACC_SYMBOLS, input + 2, (obj && obj->symbols)? r_list_length (obj->symbols): 0);
+				RBININFO ("symbols", R_CORE_BIN_ACC_SYMBOLS, input + 2, nsymbols);
 			} else if (input[1] == 'q' && input[2] == 'q') {
 				mode = R_MODE_SIMPLEST;
-				RBININFO ("symbols", R_CORE_BIN_ACC_SYMBOLS, input + 1, (obj && obj->symbols)? r_list_length (obj->symbols): 0);
+				RBININFO ("symbols", R_CORE_BIN_ACC_SYMBOLS, input + 1, nsymbols);
 			} else {
-				RBININFO ("symbols", R_CORE_BIN_ACC_SYMBOLS, input + 1, (obj && obj->symbols)? r_list_length (obj->symbols): 0);
+				RBININFO ("symbols", R_CORE_BIN_ACC_SYMBOLS, input + 1, nsymbols);
 			}
 			while (*(++input)) ;
 			input--;
@@ -807,9 +809,9 @@ static int cmd_info(void *data, const char *input) {
 			}
 			break;
 		case 'i': { // "ii"
-			RBinObject *obj = r_bin_cur_object (core->bin);
+			RList *imports = r_bin_get_imports (core->bin);
 			RBININFO ("imports", R_CORE_BIN_ACC_IMPORTS, NULL,
-				(obj && obj->imports)? r_list_length (obj->imports): 0);
+				imports? r_list_length (imports): 0);
 			break;
 		}
 		case 'I': // "iI"
@@ -899,8 +901,9 @@ static int cmd_info(void *data, const char *input) {
 					input++;
 				}
 				if (obj) {
+					RList *strings = r_bin_get_strings (core->bin);
 					RBININFO ("strings", R_CORE_BIN_ACC_STRINGS, NULL,
-						(obj && obj->strings)? r_list_length (obj->strings): 0);
+						strings? r_list_length (strings): 0);
 				}
 			}
 			break;
@@ -912,6 +915,7 @@ static int cmd_info(void *data, const char *input) {
 				RBinClass *cls;
 				RBinSymbol *sym;
 				RListIter *iter, *iter2;
+				r_bin_get_classes (core->bin); // parses them with bin.lazy
 				RBinObject *obj = r_bin_cur_object (core->bin);
 				if (obj) {
 					if (input[2]) {
@@ -1016,6 +1020,7 @@ static int cmd_info(void *data, const char *input) {
 					}
         			}
 			} else {
+				r_bin_get_classes (core->bin); // parses them with bin.lazy
 				RBinObject *obj = r_bin_cur_object (core->bin);
 				if (obj && obj->classes) {
 					int len = r_list_length (obj->classes);
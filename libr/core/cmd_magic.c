@@ -5,13 +5,70 @@
 /* ugly global vars */
 static int magicdepth = 99; //XXX: do not use global var here
 static RMagic *ck = NULL; // XXX: Use RCore->magic
-static char *ofile = NULL;
+static RMagicIndex *ck_index = NULL; // prefilter for the tests in ck
+static RList *magic_sets = NULL; // MagicSet, every file loaded so far
 static int kw_count = 0;
 
+typedef struct {
+	char *path;
+	RMagic *ms;
+	RMagicIndex *mi;
+} MagicSet;
+
+static void magic_set_free(MagicSet *set) {
+	if (set) {
+		r_magic_index_free (set->mi);
+		r_magic_free (set->ms);
+		free (set->path);
+		free (set);
+	}
+}
+
 static void r_core_magic_reset(RCore *core) {
 	kw_count = 0;
 }
 
+/* make the tests of file (or dir.magic) the current ones, loading each
+ * file once: nested formats switch between files at every hit */
+static bool r_core_magic_load(RCore *core, const char *file) {
+	RListIter *iter;
+	MagicSet *set;
+	if (file) {
+		if (*file == ' ') file++;
+		if (!*file) file = NULL;
+	}
+	const char *path = file? file: r_config_get (core->config, "dir.magic");
+	if (!path) {
+		eprintf ("failed r_magic_load (\"\")\n");
+		return false;
+	}
+	if (!magic_sets && !(magic_sets = r_list_newf ((RListFree)magic_set_free))) {
+		return false;
+	}
+	r_list_foreach (magic_sets, iter, set) {
+		if (!strcmp (set->path, path)) {
+			ck = set->ms;
+			ck_index = set->mi;
+			return true;
+		}
+	}
+	ck = NULL;
+	ck_index = NULL;
+	// TODO: Move RMagic into RCore
+	set = R_NEW0 (MagicSet);
+	if (!set || !(set->ms = r_magic_new (0)) || r_magic_load (set->ms, path) == -1) {
+		eprintf ("failed r_magic_load (\"%s\") %s\n", path, (set && set->ms)? r_magic_error (set->ms): "");
+		magic_set_free (set);
+		return false;
+	}
+	set->path = strdup (path);
+	set->mi = r_magic_index_new (set->ms);
+	r_list_append (magic_sets, set);
+	ck = set->ms;
+	ck_index = set->mi;
+	return true;
+}
+
 static int r_core_magic_at(RCore *core, const char *file, ut64 addr, int depth, int v, bool json, int *hits) {
 	const char *fmt;
 	char *q, *p;
@@ -53,35 +110,9 @@ static int r_core_magic_at(RCore *core, const char *file, ut64 addr, int depth,
 		if (*file == ' ') file++;
 		if (!*file) file = NULL;
 	}
-	if (file && ofile && file != ofile) {
-		if (strcmp (file, ofile)) {
-			r_magic_free (ck);
-			ck = NULL;
-		}
-	}
-	if (!ck) {
-		// TODO: Move RMagic into RCore
-		r_magic_free (ck);
-		// allocate once
-		ck = r_magic_new (0);
-		if (file) {
-			free (ofile);
-			ofile = strdup (file);
-			if (r_magic_load (ck, file) == -1) {
-				eprintf ("failed r_magic_load (\"%s\") %s\n", file, r_magic_error (ck));
-				ck = NULL;
-				ret = -1;
-				goto seek_exit;
-			}
-		} else {
-			const char *magicpath = r_config_get (core->config, "dir.magic");
-			if (r_magic_load (ck, magicpath) == -1) {
-				ck = NULL;
-				eprintf ("failed r_magic_load (dir.magic) %s\n", r_magic_error (ck));
-				ret = -1;
-				goto seek_exit;
-			}
-		}
+	if (!r_core_magic_load (core, file)) {
+		ret = -1;
+		goto seek_exit;
 	}
 //repeat:
 	//if (v) r_cons_printf ("  %d # pm %s @ 0x%"PFMT64x"\n", depth, file? file: "", addr);
@@ -90,7 +121,9 @@ static int r_core_magic_at(RCore *core, const char *file, ut64 addr, int depth,
 		ret = -1;
 		goto seek_exit;
 	}
-	str = r_magic_buffer (ck, core->block+delta, core->blocksize - delta);
+	str = ck_index
+		? r_magic_index_buffer (ck_index, core->block + delta, core->blocksize - delta)
+		: r_magic_buffer (ck, core->block + delta, core->blocksize - delta);
 	if (str) {
 		const char *cmdhit;
 #if USE_LIB_MAGIC
@@ -164,8 +197,6 @@ static int r_core_magic_at(RCore *core, const char *file, ut64 addr, int depth,
 			}
 		}
 		free (p);
-		r_magic_free (ck);
-		ck = NULL;
 
 		found ++;
 //		return adelta+1;
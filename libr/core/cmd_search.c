@@ -208,20 +208,24 @@ static int search_hash(RCore *core, const char *hashname, const char *hashstr, u
 				eprintf ("Hash length is bigger than range 0x%"PFMT64x "\n", from);
 				continue;
 			}
-			buf = malloc (bufsz);
-			if (!buf) {
+			const ut8 *data = bufsz < ST32_MAX? r_io_peek_at (core->io, from, (int)bufsz): NULL;
+			buf = data? NULL: malloc (bufsz);
+			if (!data && !buf) {
 				eprintf ("Cannot allocate %"PFMT64d " bytes\n", bufsz);
 				goto hell;
 			}
 			eprintf ("Search in range 0x%08"PFMT64x " and 0x%08"PFMT64x "\n", from, to);
 			int blocks = (int) (to - from - len);
 			eprintf ("Carving %d blocks...\n", blocks);
-			(void) r_io_read_at (core->io, from, buf, bufsz);
+			if (!data) {
+				(void) r_io_read_at (core->io, from, buf, bufsz);
+				data = buf;
+			}
 			for (i = 0; (from + i + len) < to; i++) {
 				if (r_cons_is_breaked ()) {
 					break;
 				}
-				char *s = r_hash_to_string (NULL, hashname, buf + i, len);
+				char *s = r_hash_to_string (NULL, hashname, data + i, len);
 				if (!(i % 5)) {
 					eprintf ("%d\r", i);
 				}
@@ -996,11 +1000,58 @@ static bool insert_into(void *user, const ut64 k, const ut64 v) {
 	return true;
 }
 
+#define ROP_INSN_INVALID 0xff
+
+/* gadget candidates overlap a lot, so every offset of the map being searched
+ * is decoded at most once. sizes has one byte per offset: 0 when it was not
+ * decoded yet, ROP_INSN_INVALID when it does not decode, the size otherwise.
+ * the text is rendered again for the few that are grepped */
+static int rop_insn_size(RCore *core, ut8 *sizes, ut64 addr, const ut8 *buf, int idx, int len) {
+	if (idx < 0 || idx >= len) {
+		return 0;
+	}
+	if (sizes[idx]) {
+		return sizes[idx] == ROP_INSN_INVALID? 0: sizes[idx];
+	}
+	int size = 0;
+	{
+		RAsmOp asmop;
+		r_asm_set_pc (core->assembler, addr);
+		if (r_asm_disassemble (core->assembler, &asmop, buf + idx, len - idx) > 0) {
+			const char *opst = r_asm_op_get_asm (&asmop);
+			if (r_str_ncasecmp (opst, "invalid", strlen ("invalid")) &&
+			    r_str_ncasecmp (opst, ".byte", strlen (".byte"))) {
+				size = asmop.size;
+			}
+		}
+		r_asm_op_fini (&asmop);
+	}
+	sizes[idx] = (size > 0 && size < ROP_INSN_INVALID)? size: ROP_INSN_INVALID;
+	return sizes[idx] == ROP_INSN_INVALID? 0: size;
+}
+
+static ut64 rop_insn_count(const ut8 *sizes, int len) {
+	ut64 n = 0;
+	int i;
+	for (i = 0; i < len; i++) {
+		n += sizes[i] != 0;
+	}
+	return n;
+}
+
+static char *rop_insn_str(RCore *core, ut64 addr, const ut8 *buf, int idx, int len) {
+	RAsmOp asmop;
+	r_asm_set_pc (core->assembler, addr);
+	r_asm_disassemble (core->assembler, &asmop, buf + idx, len - idx);
+	char *opst = strdup (r_asm_op_get_asm (&asmop));
+	r_asm_op_fini (&asmop);
+	return opst;
+}
+
 // TODO: follow unconditional jumps
-static RList *construct_rop_gadget(RCore *core, ut64 addr, ut8 *buf, int idx, const char *grep, int regex, RList *rx_list, struct endlist_pair *end_gadget, HtUU *badstart) {
+static RList *construct_rop_gadget(RCore *core, ut64 addr, ut8 *buf, int idx, int len, const char *grep, int regex, RList *rx_list, struct endlist_pair *end_gadget, HtUU *badstart, ut8 *sizes) {
 	int endaddr = end_gadget->instr_offset;
 	int branch_delay = end_gadget->delay_size;
-	RAsmOp asmop;
 	const char *start = NULL, *end = NULL;
 	char *grep_str = NULL;
 	RCoreAsmHit *hit = NULL;
@@ -1010,7 +1061,7 @@ static RList *construct_rop_gadget(RCore *core, ut64 addr, ut8 *buf, int idx, co
 	bool valid = false;
 	int grep_find;
 	int search_hit;
-	char *rx = NULL;
+	RRegex *rx = NULL;
 	HtUUOptions opt = { 0 };
 	HtUU *localbadstart = ht_uu_new_opt (&opt);
 	int count = 0;
@@ -1042,19 +1093,13 @@ static RList *construct_rop_gadget(RCore *core, ut64 addr, ut8 *buf, int idx, co
 
 	while (nb_instr < max_instr) {
 		ht_uu_insert (localbadstart, idx, 1);
-		r_asm_set_pc (core->assembler, addr);
-		if (!r_asm_disassemble (core->assembler, &asmop, buf + idx, 15)) {
-			goto ret;
-		} else {
-			opsz = asmop.size;
-			// opsz = r_strbuf_length (asmop.buf);
-			opst = r_asm_op_get_asm (&asmop);
-		}
-		if (!r_str_ncasecmp (opst, "invalid", strlen ("invalid")) ||
-		    !r_str_ncasecmp (opst, ".byte", strlen (".byte"))) {
+		opsz = rop_insn_size (core, sizes, addr, buf, idx, len);
+		if (!opsz) {
 			valid = false;
 			goto ret;
 		}
+		free (opst);
+		opst = (grep && (end || rx))? rop_insn_str (core, addr, buf, idx, len): NULL;
 
 		hit = r_core_asm_hit_new ();
 		hit->addr = addr;
@@ -1065,7 +1110,7 @@ static RList *construct_rop_gadget(RCore *core, ut64 addr, ut8 *buf, int idx, co
 		idx += opsz;
 		addr += opsz;
 		if (rx) {
-			grep_find = !r_regex_match (rx, "e", opst);
+			grep_find = r_regex_check (rx, opst);
 			search_hit = (end && grep && (grep_find < 1));
 		} else {
 			search_hit = (end && grep && strstr (opst, grep_str));
@@ -1096,6 +1141,7 @@ static RList *construct_rop_gadget(RCore *core, ut64 addr, ut8 *buf, int idx, co
 	}
 ret:
 	free (grep_str);
+	free (opst);
 	if (regex && rx) {
 		r_list_free (hitlist);
 		ht_uu_free (localbadstart);
@@ -1278,7 +1324,7 @@ static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const c
 	const ut8 max_instr = r_config_get_i (core->config, "rop.len");
 	const char *arch = r_config_get (core->config, "asm.arch");
 	int max_count = r_config_get_i (core->config, "search.maxhits");
-	int i = 0, end = 0, mode = 0, increment = 1, ret, result = true;
+	int i = 0, end = 0, mode = 0, increment = 1, result = true;
 	RList /*<endlist_pair>*/ *end_list = r_list_newf (free);
 	RList /*<RRegex>*/ *rx_list = NULL;
 	int align = core->search->align;
@@ -1286,11 +1332,14 @@ static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const c
 	char *tok, *gregexp = NULL;
 	char *grep_arg = NULL;
 	bool json_first = true;
-	char *rx = NULL;
-	int delta = 0;
+	int delta = 0, delta_sizes = 0;
 	ut8 *buf;
 	RIOMap *map;
-	RAsmOp asmop;
+	const bool rop_stats = r_config_get_i (core->config, "rop.stats");
+	ut64 ngadgets = 0, ndecoded = 0;
+	ut64 t0 = r_sys_now_mono ();
+	HtUU *badstart = NULL;
+	ut8 *sizes = NULL;
 
 	Sdb *gadgetSdb = NULL;
 	if (r_config_get_i (core->config, "rop.sdb")) {
@@ -1346,12 +1395,21 @@ static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const c
 	// Deal with the grep guy.
 	if (grep && regexp) {
 		if (!rx_list) {
-			rx_list = r_list_newf (free);
+			rx_list = r_list_newf ((RListFree)r_regex_free);
 		}
 		gregexp = strdup (grep);
 		tok = strtok (gregexp, ";");
 		while (tok) {
-			rx = strdup (tok);
+			// compiled once here, matched against every gadget instruction
+			RRegex *rx = r_regex_new (tok, "e");
+			if (!rx) {
+				eprintf ("Cannot compile '%s' regexp\n", tok);
+				r_list_free (rx_list);
+				r_list_free (end_list);
+				free (grep_arg);
+				free (gregexp);
+				return false;
+			}
 			r_list_append (rx_list, rx);
 			tok = strtok (NULL, ";");
 		}
@@ -1363,7 +1421,6 @@ static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const c
 
 	r_list_foreach (param->boundaries, itermap, map) {
 		HtUUOptions opt = { 0 };
-		HtUU *badstart = ht_uu_new_opt (&opt);
 		if (!r_itv_overlap (search_itv, map->itv)) {
 			continue;
 		}
@@ -1378,6 +1435,18 @@ static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const c
 			result = false;
 			goto bad;
 		}
+		ht_uu_free (badstart);
+		badstart = ht_uu_new_opt (&opt);
+		if (sizes) {
+			ndecoded += rop_insn_count (sizes, delta_sizes);
+			free (sizes);
+		}
+		delta_sizes = delta;
+		if (!(sizes = calloc (1, delta))) {
+			free (buf);
+			result = false;
+			goto bad;
+		}
 		(void) r_io_read_at (core->io, from, buf, delta);
 
 		// Find the end gadgets.
@@ -1474,13 +1543,12 @@ static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const c
 						R_MIN ((delta - i), 4096));
 					end = i + 2048;
 				}
-				ret = r_asm_disassemble (core->assembler, &asmop, buf + i, delta - i);
-				if (ret) {
+				if (rop_insn_size (core, sizes, from + i, buf, i, delta)) {
 					RList *hitlist;
 					r_asm_set_pc (core->assembler, from + i);
 					hitlist = construct_rop_gadget (core,
-						from + i, buf, i, grep, regexp,
-						rx_list, end_gadget, badstart);
+						from + i, buf, i, delta, grep, regexp,
+						rx_list, end_gadget, badstart, sizes);
 					if (!hitlist) {
 						continue;
 					}
@@ -1521,6 +1589,7 @@ static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const c
 					} else {
 						print_rop (core, hitlist, mode, &json_first);
 					}
+					ngadgets++;
 					r_list_free (hitlist);
 					if (max_count > 0) {
 						max_count--;
@@ -1545,6 +1614,16 @@ static int r_core_search_rop(RCore *core, RInterval search_itv, int opt, const c
 		r_cons_printf ("]\n");
 	}
 bad:
+	if (sizes) {
+		ndecoded += rop_insn_count (sizes, delta_sizes);
+		free (sizes);
+	}
+	ht_uu_free (badstart);
+	if (rop_stats) {
+		double secs = (double)(r_sys_now_mono () - t0) / 1000000000.0;
+		eprintf ("%"PFMT64d" gadgets, %"PFMT64d" instructions decoded in %.3fs (%.0f gadgets/s)\n",
+			ngadgets, ndecoded, secs, secs > 0? ngadgets / secs: 0.0);
+	}
 	r_list_free (rx_list);
 	r_list_free (end_list);
 	free (grep_arg);
@@ -2281,6 +2360,49 @@ static void do_asm_search(RCore *core, struct search_parameters *param, const ch
 	r_cons_break_pop ();
 }
 
+/* run the magic tests only at the offsets where the prefilter of the magic
+ * set finds a candidate, reading the map in big chunks */
+static bool do_magic_search(RCore *core, const char *file, RMagicIndex *mi, RIOMap *map, bool json, int *hits) {
+	const int window = core->blocksize;
+	const int chunk = R_MAX (window, 1024 * 1024);
+	int maxHits = r_config_get_i (core->config, "search.maxhits");
+	int align = core->search->align;
+	ut64 addr, to = r_itv_end (map->itv);
+	ut8 *buf = malloc (chunk + window);
+	if (!buf) {
+		return false;
+	}
+	for (addr = map->itv.addr; addr < to; addr += chunk) {
+		int i = 0, count = R_MIN (chunk, to - addr);
+		if (!json) {
+			eprintf ("0x%08"PFMT64x"\r", addr);
+		}
+		(void)r_io_read_at (core->io, addr, buf, count + window);
+		while (i < count) {
+			if (r_cons_is_breaked ()) {
+				goto beach;
+			}
+			i += r_magic_index_next (mi, buf + i, count + window - i, count - i, window);
+			if (i >= count) {
+				break;
+			}
+			ut64 at = addr + i;
+			if (align && at % align) {
+				i += align - at % align;
+				continue;
+			}
+			int ret = r_core_magic_at (core, file, at, 99, false, json, hits);
+			if (ret == -1 || (maxHits && *hits >= maxHits)) {
+				goto beach;
+			}
+			i += R_MAX (ret, 1);
+		}
+	}
+beach:
+	free (buf);
+	return true;
+}
+
 static void do_string_search(RCore *core, RInterval search_itv, struct search_parameters *param) {
 	ut64 at;
 	ut8 *buf;
@@ -2351,27 +2473,34 @@ static void do_string_search(RCore *core, RInterval search_itv, struct search_pa
 					eprintf ("\n\n");
 					break;
 				}
+				const ut8 *data;
 				if (search->bckwrds) {
 					len = R_MIN (core->blocksize, at - from);
 					// TODO prefix_read_at
 					if (!r_io_is_valid_offset (core->io, at - len, 0)) {
 						break;
 					}
-					(void)r_io_read_at (core->io, at - len, buf, len);
+					if (!(data = r_io_peek_at (core->io, at - len, len))) {
+						(void)r_io_read_at (core->io, at - len, buf, len);
+						data = buf;
+					}
 				} else {
 					len = R_MIN (core->blocksize, to - at);
 					if (!r_io_is_valid_offset (core->io, at, 0)) {
 						break;
 					}
-					(void)r_io_read_at (core->io, at, buf, len);
+					if (!(data = r_io_peek_at (core->io, at, len))) {
+						(void)r_io_read_at (core->io, at, buf, len);
+						data = buf;
+					}
 				}
 				if (param->crypto_search) {
 					// TODO support backward search
 					int delta = 0;
 					if (param->aes_search) {
-						delta = r_search_aes_update (core->search, at, buf, len);
+						delta = r_search_aes_update (core->search, at, data, len);
 					} else if (param->rsa_search) {
-						delta = r_search_rsa_update (core->search, at, buf, len);
+						delta = r_search_rsa_update (core->search, at, data, len);
 					}
 					if (delta != -1) {
 						int t = r_search_hit_new (core->search, &aeskw, at + delta);
@@ -2380,7 +2509,7 @@ static void do_string_search(RCore *core, RInterval search_itv, struct search_pa
 						}
 					}
 				} else {
-					(void)r_search_update (core->search, at, buf, len);
+					(void)r_search_update (core->search, at, data, len);
 					if (core->search->maxhits > 0 && core->search->nhits >= core->search->maxhits) {
 						goto done;
 					}
@@ -3225,12 +3354,19 @@ reread:
 			r_core_magic_reset (core);
 			int maxHits = r_config_get_i (core->config, "search.maxhits");
 			int hits = 0;
+			// load the tests once, nested formats keep them cached
+			RMagicIndex *mi = r_core_magic_load (core, file) && ck_index
+				&& r_magic_index_complete (ck_index)? ck_index: NULL;
 			r_list_foreach (param.boundaries, iter, map) {
 				if (!json) {
 					eprintf ("-- %llx %llx\n", map->itv.addr, r_itv_end (map->itv));
 				}
 				r_cons_break_push (NULL, NULL);
-				for (addr = map->itv.addr; addr < r_itv_end (map->itv); addr++) {
+				addr = map->itv.addr;
+				if (mi && do_magic_search (core, file, mi, map, json, &hits)) {
+					addr = r_itv_end (map->itv);
+				}
+				for (; addr < r_itv_end (map->itv); addr++) {
 					if (r_cons_is_breaked ()) {
 						break;
 					}
@@ -684,7 +684,7 @@ static int rop_classify_nops(RCore *core, RList *ropList) {
 }
 
 static void rop_classify (RCore *core, Sdb *db, RList *ropList, const char *key, unsigned int size) {
-	int nop = 0;  rop_classify_nops (core, ropList);
+	int nop = 0;
 	char *mov, *ct, *arithm, *arithm_ct, *str;
 	Sdb *db_nop = sdb_ns (db, "nop", true);
 	Sdb *db_mov = sdb_ns (db, "mov", true);
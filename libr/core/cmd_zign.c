@@ -641,12 +641,8 @@ static int cmdFlirt(void *data, const char *input) {
 			return false;
 		}
 		int depth = r_config_get_i (core->config, "dir.depth");
-		char *file;
-		RListIter *iter;
 		RList *files = r_file_globsearch (input + 2, depth);
-		r_list_foreach (files, iter, file) {
-			r_sign_flirt_scan (core->anal, file);
-		}
+		r_sign_flirt_scan_files (core->anal, files);
 		r_list_free (files);
 		break;
 	case 'z':
@@ -2927,6 +2927,62 @@ static void rap_break (void *u) {
 	}
 }
 
+#define RAP_CACHE_ALIGN 0xffff
+
+typedef struct {
+	RCore *core;
+	ut64 addr;
+	ut8 *buf;
+	int len;
+	int features;
+} RapSession;
+
+static void rap_cache_reset(RapSession *rs) {
+	R_FREE (rs->buf);
+	rs->len = 0;
+}
+
+// serve reads from an aligned read-ahead window, so scrolling clients hit memory
+static int rap_cache_read(void *user, ut64 addr, ut8 *out, int len) {
+	RapSession *rs = user;
+	RIO *io = rs->core->io;
+	if (len < 1 || addr > UT64_MAX - len) {
+		return 0;
+	}
+	if (rs->buf && addr >= rs->addr && addr + len <= rs->addr + rs->len) {
+		memcpy (out, rs->buf + (addr - rs->addr), len);
+		return len;
+	}
+	ut64 from = addr & ~(ut64)RAP_CACHE_ALIGN;
+	ut64 size = R_MAX ((addr - from) + len, RAP_CACHE_ALIGN + 1);
+	if (from > UT64_MAX - size + 1) {
+		size = (addr - from) + len;
+	}
+	ut8 *buf = realloc (rs->buf, size);
+	if (!buf) {
+		rap_cache_reset (rs);
+		return r_io_read_at (io, addr, out, len)? len: 0;
+	}
+	rs->buf = buf;
+	if (!r_io_read_at (io, from, rs->buf, size)) {
+		// do not keep a window with holes, serve just what was asked
+		rap_cache_reset (rs);
+		memset (out, io->Oxff, len);
+		(void)r_io_read_at (io, addr, out, len);
+		return len;
+	}
+	rs->addr = from;
+	rs->len = size;
+	memcpy (out, rs->buf + (addr - from), len);
+	return len;
+}
+
+static int rap_cache_write(void *user, ut64 addr, const ut8 *buf, int len) {
+	RapSession *rs = user;
+	rap_cache_reset (rs);
+	return r_core_write_at (rs->core, addr, buf, len)? len: 0;
+}
+
 // TODO: PLEASE move into core/io/rap? */
 // TODO: use static buffer instead of mallocs all the time. it's network!
 R_API bool r_core_serve(RCore *core, RIODesc *file) {
@@ -2940,6 +2996,7 @@ R_API bool r_core_serve(RCore *core, RIODesc *file) {
 		return false;
 	}
 	RSocket *fd = rior->fd;
+	RapSession rs = { .core = core };
 	eprintf ("RAP Server started (rap.loop=%s)\n",
 			r_config_get (core->config, "rap.loop"));
 	r_cons_break_push (rap_break, rior);
@@ -2958,6 +3015,8 @@ reaccept:
 			goto out_of_function;
 		}
 		eprintf ("rap: client connected\n");
+		rap_cache_reset (&rs);
+		rs.features = 0;
 		for (;!r_cons_is_breaked ();) {
 			if (!r_socket_read (c, &cmd, 1)) {
 				eprintf ("rap: connection closed\n");
@@ -2969,7 +3028,17 @@ reaccept:
 				goto out_of_function;
 			}
 			switch ((ut8)cmd) {
+			case RMT_HELLO:
+			case RMT_READ_AT:
+			case RMT_WRITE_AT:
+				if (!r_socket_rap_server_v2 (c, cmd, &rs.features,
+						rap_cache_read, rap_cache_write, &rs)) {
+					eprintf ("rap: invalid v2 packet\n");
+					r_socket_close (c);
+				}
+				break;
 			case RMT_OPEN:
+				rap_cache_reset (&rs);
 				r_socket_read_block (c, &flg, 1); // flags
 				eprintf ("open (%d): ", cmd);
 				r_socket_read_block (c, &cmd, 1); // len
@@ -3051,6 +3120,7 @@ reaccept:
 				int i;
 
 				/* read */
+				rap_cache_reset (&rs);
 				r_socket_read_block (c, (ut8*)&bufr, 4);
 				i = r_read_be32 (bufr);
 				if (i > 0 && i < RMT_MAX) {
@@ -3116,6 +3186,7 @@ reaccept:
 				break;
 				}
 			case RMT_WRITE:
+				rap_cache_reset (&rs);
 				r_socket_read (c, buf, 4);
 				x = r_read_at_be32 (buf, 0);
 				ptr = malloc (x);
@@ -3205,6 +3276,7 @@ reaccept:
 		r_socket_free (c);
 	}
 out_of_function:
+	rap_cache_reset (&rs);
 	r_cons_break_pop ();
 	return false;
 }
@@ -3132,7 +3132,7 @@ static bool ds_print_labels(RDisasmState *ds, RAnalFunction *f) {
 
 #if 0
 static void ds_print_import_name(RDisasmState *ds) {
-	RListIter *iter = NULL;
+	RBIter iter;
 	RBinReloc *rel = NULL;
 	RCore * core = ds->core;
 
@@ -3140,8 +3140,9 @@ static void ds_print_import_name(RDisasmState *ds) {
 	case R_ANAL_OP_TYPE_JMP:
 	case R_ANAL_OP_TYPE_CJMP:
 	case R_ANAL_OP_TYPE_CALL:
-		if (core->bin->cur->o->imports && core->bin->cur->o->relocs) {
-			r_list_foreach (core->bin->cur->o->relocs, iter, rel) {
+		if (r_bin_get_imports (core->bin)) {
+			RBNode *relocs = r_bin_get_relocs (core->bin);
+			r_rbtree_foreach (relocs, iter, rel, RBinReloc, vrb) {
 				if ((rel->vaddr == ds->analop.jump) &&
 					(rel->import != NULL)) {
 					if (ds->show_color) {
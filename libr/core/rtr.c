@@ -54,23 +54,27 @@ R_API void r_core_wait(RCore *core) {
 	r_th_wait (rapthread);
 }
 
+static void http_vlogf(bool enabled, const char *logfile, const char *fmt, va_list ap) {
+	if (!enabled) {
+		return;
+	}
+	if (logfile && *logfile) {
+		char * msg = calloc (4096, 1);
+		if (msg) {
+			vsnprintf (msg, 4095, fmt, ap);
+			r_file_dump (logfile, (const ut8*)msg, -1, true);
+			free (msg);
+		}
+	} else {
+		vfprintf (stderr, fmt, ap);
+	}
+}
+
 static void http_logf(RCore *core, const char *fmt, ...) {
-	bool http_log_enabled = r_config_get_i (core->config, "http.log");
 	va_list ap;
 	va_start (ap, fmt);
-	if (http_log_enabled) {
-		const char *http_log_file = r_config_get (core->config, "http.logfile");
-		if (http_log_file && *http_log_file) {
-			char * msg = calloc (4096, 1);
-			if (msg) {
-				vsnprintf (msg, 4095, fmt, ap);
-				r_file_dump (http_log_file, (const ut8*)msg, -1, true);
-				free (msg);
-			}
-		} else {
-			vfprintf (stderr, fmt, ap);
-		}
-	}
+	http_vlogf (r_config_get_i (core->config, "http.log"),
+		r_config_get (core->config, "http.logfile"), fmt, ap);
 	va_end (ap);
 }
 
@@ -1,21 +1,488 @@
 // included from rtr.c
 
+enum {
+	HTTP_DONE = 0, // response sent, the connection can be reused
+	HTTP_CLOSE,
+	HTTP_RESTART, // =h*
+	HTTP_STOP, // =h--
+};
+
+typedef struct {
+	RSocketHTTPRequest *rs;
+	RThreadSemaphore *done;
+	int status;
+} HttpJob;
+
+/* connections are accepted and parsed by a pool of workers, static files are
+ * served from there and everything else is queued to the thread owning RCore */
+typedef struct {
+	RSocket *s;
+	RSocketHTTPOptions *so;
+	RThreadLock *lock;
+	RThreadLock *accept_lock;
+	RThreadSemaphore *ready;
+	RList *jobs;
+	RList *workers;
+	volatile bool stop;
+	int idle;
+	bool verbose;
+	bool log;
+	char *logfile;
+	char *allow;
+	char *root;
+	char *homeroot;
+	const char *headers;
+} HttpPool;
+
+static char *http_file_path(const char *root, const char *homeroot, const char *rpath) {
+	char *path;
+	if (homeroot && *homeroot) {
+		char *homepath = r_file_abspath (homeroot);
+		path = r_file_root (homepath, rpath);
+		free (homepath);
+		if (!r_file_exists (path) && !r_file_is_directory (path)) {
+			free (path);
+			path = r_file_root (root, rpath);
+		}
+	} else {
+		path = r_file_root (root, rpath);
+	}
+	if (rpath[strlen (rpath) - 1] == '/') {
+		path = r_str_append (path, "index.html");
+	}
+	return path;
+}
+
+static const char *http_content_type(const char *path) {
+	const char *ct = NULL;
+	if (strstr (path, ".js")) {
+		ct = "Content-Type: application/javascript\n";
+	}
+	if (strstr (path, ".css")) {
+		ct = "Content-Type: text/css\n";
+	}
+	if (strstr (path, ".html")) {
+		ct = "Content-Type: text/html\n";
+	}
+	return ct;
+}
+
+static bool http_allowed(HttpPool *hp, RSocket *c) {
+	bool accepted = false;
+	if (!hp->allow || !*hp->allow) {
+		return true;
+	}
+	char *p, *peer = r_socket_to_string (c);
+	char *allows = strdup (hp->allow);
+	int i, count = r_str_split (allows, ',');
+	p = strchr (peer, ':');
+	if (p) {
+		*p = 0;
+	}
+	for (i = 0; i < count; i++) {
+		if (!strcmp (r_str_word_get0 (allows, i), peer)) {
+			accepted = true;
+			break;
+		}
+	}
+	free (peer);
+	free (allows);
+	return accepted;
+}
+
+// http_logf for the workers, with the settings taken when the pool started
+static void http_pool_logf(HttpPool *hp, const char *fmt, ...) {
+	va_list ap;
+	va_start (ap, fmt);
+	http_vlogf (hp->log, hp->logfile, fmt, ap);
+	va_end (ap);
+}
+
+// runs in the workers, must not touch RCore. errors are left to http_handle
+static bool http_serve_file(HttpPool *hp, RSocketHTTPRequest *rs) {
+	if (!rs->auth || strcmp (rs->method, "GET") || !*rs->path
+			|| r_str_startswith (rs->path, "/cmd/") || r_str_startswith (rs->path, "/up/")) {
+		return false;
+	}
+	const char *rpath = strcmp (rs->path, "/")? rs->path: "/index.html";
+	char *path = http_file_path (hp->root, hp->homeroot, rpath);
+	int sz = 0;
+	char *f = (path && !r_file_is_directory (path))? r_file_slurp (path, &sz): NULL;
+	if (!f) {
+		free (path);
+		return false;
+	}
+	if (hp->verbose) {
+		char *peer = r_socket_to_string (rs->s);
+		http_pool_logf (hp, "[HTTP] %s %s\n", peer, rs->path);
+		free (peer);
+	}
+	char *hdr = r_str_newf ("%s%s", r_str_get (http_content_type (path)), hp->headers);
+	r_socket_http_response (rs, 200, f, sz, hdr);
+	free (hdr);
+	free (f);
+	free (path);
+	return true;
+}
+
+static bool http_wait_request(HttpPool *hp, RSocket *c) {
+	int i;
+	for (i = 0; i < hp->idle && !hp->stop; i++) {
+		// r_socket_ready only honours the usecs
+		int r = r_socket_ready (c, 0, 1000 * 1000);
+		if (r) {
+			return r > 0;
+		}
+	}
+	return false;
+}
+
+static RThreadFunctionRet http_worker(RThread *th) {
+	HttpPool *hp = th->user;
+	RThreadSemaphore *done = r_th_sem_new (0);
+	if (!done) {
+		return R_TH_STOP;
+	}
+	while (!hp->stop) {
+		r_th_lock_enter (hp->accept_lock);
+		RSocket *c = hp->stop? NULL: r_socket_accept_timeout (hp->s, 1);
+		r_th_lock_leave (hp->accept_lock);
+		if (!c) {
+			continue;
+		}
+		if (!http_allowed (hp, c)) {
+			r_socket_free (c);
+			continue;
+		}
+		if (hp->so->timeout > 0) {
+			r_socket_block_time (c, 1, hp->so->timeout, 0);
+		}
+		/* serve all the requests of a keep-alive connection in order */
+		while (c && http_wait_request (hp, c)) {
+			RSocketHTTPRequest *rs = r_socket_http_request (c, hp->so);
+			if (!rs) {
+				break;
+			}
+			int status = HTTP_DONE;
+			if (!http_serve_file (hp, rs)) {
+				HttpJob job = { rs, done, HTTP_CLOSE };
+				// stop is set under the lock before the queue is drained
+				r_th_lock_enter (hp->lock);
+				bool queued = !hp->stop;
+				if (queued) {
+					r_list_append (hp->jobs, &job);
+				}
+				r_th_lock_leave (hp->lock);
+				if (queued) {
+					r_th_sem_post (hp->ready);
+					r_th_sem_wait (done);
+				}
+				status = job.status;
+			}
+			if (status == HTTP_DONE && rs->keepalive) {
+				c = r_socket_http_detach (rs);
+			} else {
+				r_socket_http_close (rs);
+				c = NULL;
+			}
+		}
+		r_socket_free (c);
+	}
+	r_th_sem_free (done);
+	return R_TH_STOP;
+}
+
+static void http_pool_break(void *user) {
+	HttpPool *hp = user;
+	hp->stop = true;
+	r_th_sem_post (hp->ready);
+}
+
+static HttpJob *http_pool_next(HttpPool *hp) {
+	r_th_sem_wait (hp->ready);
+	r_th_lock_enter (hp->lock);
+	HttpJob *job = r_list_pop_head (hp->jobs);
+	r_th_lock_leave (hp->lock);
+	return job;
+}
+
+static HttpPool *http_pool_new(RCore *core, RSocket *s, RSocketHTTPOptions *so, const char *headers) {
+	HttpPool *hp = R_NEW0 (HttpPool);
+	if (!hp) {
+		return NULL;
+	}
+	hp->s = s;
+	hp->so = so;
+	hp->lock = r_th_lock_new (false);
+	hp->accept_lock = r_th_lock_new (false);
+	hp->ready = r_th_sem_new (0);
+	hp->jobs = r_list_new ();
+	hp->workers = r_list_newf ((RListFree)r_th_free);
+	hp->idle = R_MAX (r_config_get_i (core->config, "http.timeout"), 1);
+	hp->verbose = r_config_get_i (core->config, "http.verbose");
+	hp->log = r_config_get_i (core->config, "http.log");
+	hp->logfile = strdup (r_config_get (core->config, "http.logfile"));
+	hp->allow = strdup (r_config_get (core->config, "http.allow"));
+	hp->root = strdup (r_config_get (core->config, "http.root"));
+	hp->homeroot = strdup (r_config_get (core->config, "http.homeroot"));
+	hp->headers = headers;
+	int i, n = R_MAX (r_config_get_i (core->config, "http.workers"), 1);
+	for (i = 0; i < n; i++) {
+		RThread *th = r_th_new (http_worker, hp, 0);
+		if (th) {
+			r_th_setname (th, "httpworker");
+			r_list_append (hp->workers, th);
+		}
+	}
+	return hp;
+}
+
+static void http_pool_free(HttpPool *hp) {
+	RListIter *iter;
+	RThread *th;
+	HttpJob *job;
+	r_th_lock_enter (hp->lock);
+	hp->stop = true;
+	while ((job = r_list_pop_head (hp->jobs))) {
+		job->status = HTTP_CLOSE;
+		r_th_sem_post (job->done);
+	}
+	r_th_lock_leave (hp->lock);
+	r_list_foreach (hp->workers, iter, th) {
+		r_th_wait (th);
+	}
+	r_list_free (hp->workers);
+	r_list_free (hp->jobs);
+	r_th_sem_free (hp->ready);
+	r_th_lock_free (hp->lock);
+	r_th_lock_free (hp->accept_lock);
+	free (hp->allow);
+	free (hp->logfile);
+	free (hp->root);
+	free (hp->homeroot);
+	free (hp);
+}
+
+static int http_handle(RCore *core, RSocketHTTPRequest *rs, const char *port, const char *headers) {
+	int status = HTTP_DONE;
+	char *dir = NULL;
+	void *bed;
+
+	if (!rs->method || !rs->path) {
+		http_logf (core, "Invalid http headers received from client\n");
+		return HTTP_CLOSE;
+	}
+	if (!rs->auth) {
+		r_socket_http_response (rs, 401, "", 0, NULL);
+		return HTTP_DONE;
+	}
+	if (r_config_get_i (core->config, "http.verbose")) {
+		char *peer = r_socket_to_string (rs->s);
+		http_logf (core, "[HTTP] %s %s\n", peer, rs->path);
+		free (peer);
+	}
+	if (r_config_get_i (core->config, "http.dirlist")) {
+		if (r_file_is_directory (rs->path)) {
+			dir = strdup (rs->path);
+		}
+	}
+	if (!strcmp (rs->method, "OPTIONS")) {
+		r_socket_http_response (rs, 200, "", 0, headers);
+	} else if (!strcmp (rs->method, "GET")) {
+		if (!strncmp (rs->path, "/up/", 4)) {
+			if (r_config_get_i (core->config, "http.upget")) {
+				const char *uproot = r_config_get (core->config, "http.uproot");
+				if (!rs->path[3] || (rs->path[3]=='/' && !rs->path[4])) {
+					char *ptr = rtr_dir_files (uproot);
+					r_socket_http_response (rs, 200, ptr, 0, headers);
+					free (ptr);
+				} else {
+					char *path = r_file_root (uproot, rs->path + 4);
+					if (r_file_exists (path)) {
+						int sz = 0;
+						char *f = r_file_slurp (path, &sz);
+						if (f) {
+							r_socket_http_response (rs, 200, f, sz, headers);
+							free (f);
+						} else {
+							r_socket_http_response (rs, 403, "Permission denied", 0, headers);
+							http_logf (core, "http: Cannot open '%s'\n", path);
+						}
+					} else {
+						if (dir) {
+							char *resp = rtr_dir_files (dir);
+							r_socket_http_response (rs, 404, resp, 0, headers);
+							free (resp);
+						} else {
+							http_logf (core, "File '%s' not found\n", path);
+							r_socket_http_response (rs, 404, "File not found\n", 0, headers);
+						}
+					}
+					free (path);
+				}
+			} else {
+				r_socket_http_response (rs, 403, "", 0, NULL);
+			}
+		} else if (!strncmp (rs->path, "/cmd/", 5)) {
+			const bool colon = r_config_get_i (core->config, "http.colon");
+			if (colon && rs->path[5] != ':') {
+				r_socket_http_response (rs, 403, "Permission denied", 0, headers);
+			} else {
+				char *cmd = rs->path + 5;
+				const char *httpcmd = r_config_get (core->config, "http.uri");
+				const char *httpref = r_config_get (core->config, "http.referer");
+				const bool httpref_enabled = (httpref && *httpref);
+				char *refstr = NULL;
+				if (httpref_enabled) {
+					if (strstr (httpref, "http")) {
+						refstr = strdup (httpref);
+					} else {
+						refstr = r_str_newf ("http://localhost:%d/", atoi (port));
+					}
+				}
+
+				while (*cmd == '/') {
+					cmd++;
+				}
+				if (httpref_enabled && (!rs->referer || (refstr && !strstr (rs->referer, refstr)))) {
+					r_socket_http_response (rs, 503, "", 0, headers);
+				} else {
+					if (httpcmd && *httpcmd) {
+						int len; // do remote http query and proxy response
+						char *res, *bar = r_str_newf ("%s/%s", httpcmd, cmd);
+						bed = r_cons_sleep_begin ();
+						res = r_socket_http_get (bar, NULL, &len);
+						r_cons_sleep_end (bed);
+						if (res) {
+							res[len] = 0;
+						}
+						r_socket_http_response (rs, 200, res, 0, headers);
+						free (bar);
+						free (res);
+					} else {
+						char *out, *cmd = rs->path + 5;
+						r_str_uri_decode (cmd);
+						r_config_set (core->config, "scr.interactive", "false");
+
+						if (!r_sandbox_enable (0) &&
+								(!strcmp (cmd, "=h*") ||
+								 !strcmp (cmd, "=h--"))) {
+							out = NULL;
+						} else if (*cmd == ':') {
+							/* commands in /cmd/: starting with : do not show any output */
+							r_core_cmd0 (core, cmd + 1);
+							out = NULL;
+						} else {
+							out = r_core_cmd_str_pipe (core, cmd);
+						}
+
+						if (out) {
+							char *newheaders = r_str_newf (
+									"Content-Type: text/plain\n%s", headers);
+							r_socket_http_response (rs, 200, out, 0, newheaders);
+							free (out);
+							free (newheaders);
+						} else {
+							r_socket_http_response (rs, 200, "", 0, headers);
+						}
+
+						if (!r_sandbox_enable (0)) {
+							if (!strcmp (cmd, "=h*")) {
+								status = HTTP_RESTART;
+							} else if (!strcmp (cmd, "=h--")) {
+								status = HTTP_STOP;
+							}
+						}
+					}
+				}
+				free (refstr);
+			}
+		} else {
+			const char *root = r_config_get (core->config, "http.root");
+			const char *homeroot = r_config_get (core->config, "http.homeroot");
+			if (!strcmp (rs->path, "/")) {
+				free (rs->path);
+				rs->path = strdup ("/index.html");
+			}
+			char *path = http_file_path (root, homeroot, rs->path);
+			// FD IS OK HERE
+			if (rs->path [strlen (rs->path) - 1] != '/' && r_file_is_directory (path)) {
+				char *res = r_str_newf ("Location: %s/\n%s", rs->path, headers);
+				r_socket_http_response (rs, 302, NULL, 0, res);
+				free (res);
+			} else if (r_file_exists (path)) {
+				int sz = 0;
+				char *f = r_file_slurp (path, &sz);
+				if (f) {
+					char *hdr = r_str_newf ("%s%s", r_str_get (http_content_type (path)), headers);
+					r_socket_http_response (rs, 200, f, sz, hdr);
+					free (hdr);
+					free (f);
+				} else {
+					r_socket_http_response (rs, 403, "Permission denied", 0, headers);
+					http_logf (core, "http: Cannot open '%s'\n", path);
+				}
+			} else {
+				if (dir) {
+					char *resp = rtr_dir_files (dir);
+					http_logf (core, "Dirlisting %s\n", dir);
+					r_socket_http_response (rs, 404, resp, 0, headers);
+					free (resp);
+				} else {
+					http_logf (core, "File '%s' not found\n", path);
+					r_socket_http_response (rs, 404, "File not found\n", 0, headers);
+				}
+			}
+			free (path);
+		}
+	} else if (!strcmp (rs->method, "POST")) {
+		ut8 *ret;
+		int retlen;
+		char buf[128];
+		if (r_config_get_i (core->config, "http.upload")) {
+			ret = r_socket_http_handle_upload (rs->data, rs->data_length, &retlen);
+			if (ret) {
+				ut64 size = r_config_get_i (core->config, "http.maxsize");
+				if (size && retlen > size) {
+					r_socket_http_response (rs, 403, "403 File too big\n", 0, headers);
+				} else {
+					char *filename = r_file_root (
+						r_config_get (core->config, "http.uproot"),
+						rs->path + 4);
+					http_logf (core, "UPLOADED '%s'\n", filename);
+					r_file_dump (filename, ret, retlen, 0);
+					free (filename);
+					snprintf (buf, sizeof (buf),
+						"<html><body><h2>uploaded %d byte(s). Thanks</h2>\n", retlen);
+						r_socket_http_response (rs, 200, buf, 0, headers);
+				}
+				free (ret);
+			} else {
+				status = HTTP_CLOSE;
+			}
+		} else {
+			r_socket_http_response (rs, 403, "403 Forbidden\n", 0, headers);
+		}
+	} else {
+		r_socket_http_response (rs, 404, "Invalid protocol", 0, headers);
+	}
+	free (dir);
+	return status;
+}
+
 // return 1 on error
 static int r_core_rtr_http_run(RCore *core, int launch, int browse, const char *path) {
 	RConfig *newcfg = NULL, *origcfg = NULL;
 	char headers[128] = R_EMPTY;
-	RSocketHTTPRequest *rs;
 	char buf[32];
 	int ret = 0;
 	RSocket *s;
 	RSocketHTTPOptions so;
-	char *dir;
 	int iport;
 	const char *host = r_config_get (core->config, "http.bind");
 	const char *root = r_config_get (core->config, "http.root");
 	const char *homeroot = r_config_get (core->config, "http.homeroot");
 	const char *port = r_config_get (core->config, "http.port");
-	const char *allow = r_config_get (core->config, "http.allow");
 	const char *httpui = r_config_get (core->config, "http.ui");
 	const char *httpauthfile = r_config_get (core->config, "http.authfile");
 	char *pfile = NULL;
@@ -93,6 +560,8 @@ static int r_core_rtr_http_run(RCore *core, int launch, int browse, const char *
 	}
 
 	so.httpauth = r_config_get_i (core->config, "http.auth");
+	so.timeout = r_config_get_i (core->config, "http.timeout");
+	so.keepalive = true;
 
 	if (so.httpauth) {
 		if (!httpauthfile) {
@@ -111,9 +580,11 @@ static int r_core_rtr_http_run(RCore *core, int launch, int browse, const char *
 			eprintf ("Empty list of HTTP users\n");
 			return 1;
 		}
-
-		so.timeout = r_config_get_i (core->config, "http.timeout");
-		so.accept_timeout = 1;
+	}
+	if (r_config_get_i (core->config, "http.cors")) {
+		strcpy (headers, "Access-Control-Allow-Origin: *\n"
+			"Access-Control-Allow-Headers: Origin, "
+			"X-Requested-With, Content-Type, Accept\n");
 	}
 
 	origcfg = core->config;
@@ -153,8 +624,14 @@ static int r_core_rtr_http_run(RCore *core, int launch, int browse, const char *
 	memcpy (newblk, core->block, core->blocksize);
 
 	core->block = newblk;
-// TODO: handle mutex lock/unlock here
-	r_cons_break_push ((RConsBreak)r_core_rtr_http_stop, core);
+	HttpPool *hp = http_pool_new (core, s, &so, headers);
+	if (!hp) {
+		r_socket_free (s);
+		r_list_free (so.authtokens);
+		free (pfile);
+		return 1;
+	}
+	r_cons_break_push (http_pool_break, hp);
 	while (!r_cons_is_breaked ()) {
 		/* restore environment */
 		core->config = origcfg;
@@ -177,7 +654,7 @@ static int r_core_rtr_http_run(RCore *core, int launch, int browse, const char *
 		activateDieTime (core);
 
 		void *bed = r_cons_sleep_begin ();
-		rs = r_socket_http_accept (s, &so);
+		HttpJob *job = http_pool_next (hp);
 		r_cons_sleep_end (bed);
 
 		origoff = core->offset;
@@ -194,288 +671,21 @@ static int r_core_rtr_http_run(RCore *core, int launch, int browse, const char *
 		r_config_set_i (newcfg, "scr.color", r_config_get_i (newcfg, "scr.color"));
 		r_config_set (newcfg, "scr.interactive", r_config_get (newcfg, "scr.interactive"));
 
-		if (!rs) {
-			bed = r_cons_sleep_begin ();
-			r_sys_usleep (100);
-			r_cons_sleep_end (bed);
-			continue;
-		}
-		if (allow && *allow) {
-			bool accepted = false;
-			const char *allows_host;
-			char *p, *peer = r_socket_to_string (rs->s);
-			char *allows = strdup (allow);
-			//eprintf ("Firewall (%s)\n", allows);
-			int i, count = r_str_split (allows, ',');
-			p = strchr (peer, ':');
-			if (p) {
-				*p = 0;
-			}
-			for (i = 0; i < count; i++) {
-				allows_host = r_str_word_get0 (allows, i);
-				//eprintf ("--- (%s) (%s)\n", host, peer);
-				if (!strcmp (allows_host, peer)) {
-					accepted = true;
-					break;
-				}
-			}
-			free (peer);
-			free (allows);
-			if (!accepted) {
-				r_socket_http_close (rs);
-				continue;
-			}
-		}
-		if (!rs->method || !rs->path) {
-			http_logf (core, "Invalid http headers received from client\n");
-			r_socket_http_close (rs);
+		if (!job) {
 			continue;
 		}
-		dir = NULL;
-
-		if (!rs->auth) {
-			r_socket_http_response (rs, 401, "", 0, NULL);
-		}
-
-		if (r_config_get_i (core->config, "http.verbose")) {
-			char *peer = r_socket_to_string (rs->s);
-			http_logf (core, "[HTTP] %s %s\n", peer, rs->path);
-			free (peer);
-		}
-		if (r_config_get_i (core->config, "http.dirlist")) {
-			if (r_file_is_directory (rs->path)) {
-				dir = strdup (rs->path);
-			}
+		int status = http_handle (core, job->rs, port, headers);
+		job->status = status;
+		r_th_sem_post (job->done);
+		if (status == HTTP_RESTART) {
+			ret = -2;
+			break;
 		}
-		if (r_config_get_i (core->config, "http.cors")) {
-			strcpy (headers, "Access-Control-Allow-Origin: *\n"
-				"Access-Control-Allow-Headers: Origin, "
-				"X-Requested-With, Content-Type, Accept\n");
-		}
-		if (!strcmp (rs->method, "OPTIONS")) {
-			r_socket_http_response (rs, 200, "", 0, headers);
-		} else if (!strcmp (rs->method, "GET")) {
-			if (!strncmp (rs->path, "/up/", 4)) {
-				if (r_config_get_i (core->config, "http.upget")) {
-					const char *uproot = r_config_get (core->config, "http.uproot");
-					if (!rs->path[3] || (rs->path[3]=='/' && !rs->path[4])) {
-						char *ptr = rtr_dir_files (uproot);
-						r_socket_http_response (rs, 200, ptr, 0, headers);
-						free (ptr);
-					} else {
-						char *path = r_file_root (uproot, rs->path + 4);
-						if (r_file_exists (path)) {
-							int sz = 0;
-							char *f = r_file_slurp (path, &sz);
-							if (f) {
-								r_socket_http_response (rs, 200, f, sz, headers);
-								free (f);
-							} else {
-								r_socket_http_response (rs, 403, "Permission denied", 0, headers);
-								http_logf (core, "http: Cannot open '%s'\n", path);
-							}
-						} else {
-							if (dir) {
-								char *resp = rtr_dir_files (dir);
-								r_socket_http_response (rs, 404, resp, 0, headers);
-								free (resp);
-							} else {
-								http_logf (core, "File '%s' not found\n", path);
-								r_socket_http_response (rs, 404, "File not found\n", 0, headers);
-							}
-						}
-						free (path);
-					}
-				} else {
-					r_socket_http_response (rs, 403, "", 0, NULL);
-				}
-			} else if (!strncmp (rs->path, "/cmd/", 5)) {
-				const bool colon = r_config_get_i (core->config, "http.colon");
-				if (colon && rs->path[5] != ':') {
-					r_socket_http_response (rs, 403, "Permission denied", 0, headers);
-				} else {
-					char *cmd = rs->path + 5;
-					const char *httpcmd = r_config_get (core->config, "http.uri");
-					const char *httpref = r_config_get (core->config, "http.referer");
-					const bool httpref_enabled = (httpref && *httpref);
-					char *refstr = NULL;
-					if (httpref_enabled) {
-						if (strstr (httpref, "http")) {
-							refstr = strdup (httpref);
-						} else {
-							refstr = r_str_newf ("http://localhost:%d/", atoi (port));
-						}
-					}
-
-					while (*cmd == '/') {
-						cmd++;
-					}
-					if (httpref_enabled && (!rs->referer || (refstr && !strstr (rs->referer, refstr)))) {
-						r_socket_http_response (rs, 503, "", 0, headers);
-					} else {
-						if (httpcmd && *httpcmd) {
-							int len; // do remote http query and proxy response
-							char *res, *bar = r_str_newf ("%s/%s", httpcmd, cmd);
-							bed = r_cons_sleep_begin ();
-							res = r_socket_http_get (bar, NULL, &len);
-							r_cons_sleep_end (bed);
-							if (res) {
-								res[len] = 0;
-								r_cons_println (res);
-							}
-							free (bar);
-						} else {
-							char *out, *cmd = rs->path + 5;
-							r_str_uri_decode (cmd);
-							r_config_set (core->config, "scr.interactive", "false");
-
-							if (!r_sandbox_enable (0) &&
-									(!strcmp (cmd, "=h*") ||
-									 !strcmp (cmd, "=h--"))) {
-								out = NULL;
-							} else if (*cmd == ':') {
-								/* commands in /cmd/: starting with : do not show any output */
-								r_core_cmd0 (core, cmd + 1);
-								out = NULL;
-							} else {
-								out = r_core_cmd_str_pipe (core, cmd);
-							}
-
-							if (out) {
-								char *res = r_str_uri_encode (out);
-								char *newheaders = r_str_newf (
-										"Content-Type: text/plain\n%s", headers);
-								r_socket_http_response (rs, 200, out, 0, newheaders);
-								free (out);
-								free (newheaders);
-								free (res);
-							} else {
-								r_socket_http_response (rs, 200, "", 0, headers);
-							}
-
-							if (!r_sandbox_enable (0)) {
-								if (!strcmp (cmd, "=h*")) {
-									/* do stuff */
-									r_socket_http_close (rs);
-									free (dir);
-									free (refstr);
-									ret = -2;
-									goto the_end;
-								} else if (!strcmp (cmd, "=h--")) {
-									r_socket_http_close (rs);
-									free (dir);
-									free (refstr);
-									ret = 0;
-									goto the_end;
-								}
-							}
-						}
-					}
-					free (refstr);
-				}
-			} else {
-				const char *root = r_config_get (core->config, "http.root");
-				const char *homeroot = r_config_get (core->config, "http.homeroot");
-				char *path;
-				if (!strcmp (rs->path, "/")) {
-					free (rs->path);
-					rs->path = strdup ("/index.html");
-				}
-				if (homeroot && *homeroot) {
-					char *homepath = r_file_abspath (homeroot);
-					path = r_file_root (homepath, rs->path);
-					free (homepath);
-					if (!r_file_exists (path) && !r_file_is_directory (path)) {
-						free (path);
-						path = r_file_root (root, rs->path);
-					}
-				} else {
-					path = r_file_root (root, rs->path);
-				}
-				// FD IS OK HERE
-				if (rs->path [strlen (rs->path) - 1] == '/') {
-					path = r_str_append (path, "index.html");
-					//rs->path = r_str_append (rs->path, "index.html");
-				} else {
-					//snprintf (path, sizeof (path), "%s/%s", root, rs->path);
-					if (r_file_is_directory (path)) {
-						char *res = r_str_newf ("Location: %s/\n%s", rs->path, headers);
-						r_socket_http_response (rs, 302, NULL, 0, res);
-						r_socket_http_close (rs);
-						free (path);
-						free (res);
-						R_FREE (dir);
-						continue;
-					}
-				}
-				if (r_file_exists (path)) {
-					int sz = 0;
-					char *f = r_file_slurp (path, &sz);
-					if (f) {
-						const char *ct = NULL;
-						if (strstr (path, ".js")) {
-							ct = "Content-Type: application/javascript\n";
-						}
-						if (strstr (path, ".css")) {
-							ct = "Content-Type: text/css\n";
-						}
-						if (strstr (path, ".html")) {
-							ct = "Content-Type: text/html\n";
-						}
-						char *hdr = r_str_newf ("%s%s", ct, headers);
-						r_socket_http_response (rs, 200, f, sz, hdr);
-						free (hdr);
-						free (f);
-					} else {
-						r_socket_http_response (rs, 403, "Permission denied", 0, headers);
-						http_logf (core, "http: Cannot open '%s'\n", path);
-					}
-				} else {
-					if (dir) {
-						char *resp = rtr_dir_files (dir);
-						http_logf (core, "Dirlisting %s\n", dir);
-						r_socket_http_response (rs, 404, resp, 0, headers);
-						free (resp);
-					} else {
-						http_logf (core, "File '%s' not found\n", path);
-						r_socket_http_response (rs, 404, "File not found\n", 0, headers);
-					}
-				}
-				free (path);
-			}
-		} else if (!strcmp (rs->method, "POST")) {
-			ut8 *ret;
-			int retlen;
-			char buf[128];
-			if (r_config_get_i (core->config, "http.upload")) {
-				ret = r_socket_http_handle_upload (rs->data, rs->data_length, &retlen);
-				if (ret) {
-					ut64 size = r_config_get_i (core->config, "http.maxsize");
-					if (size && retlen > size) {
-						r_socket_http_response (rs, 403, "403 File too big\n", 0, headers);
-					} else {
-						char *filename = r_file_root (
-							r_config_get (core->config, "http.uproot"),
-							rs->path + 4);
-						http_logf (core, "UPLOADED '%s'\n", filename);
-						r_file_dump (filename, ret, retlen, 0);
-						free (filename);
-						snprintf (buf, sizeof (buf),
-							"<html><body><h2>uploaded %d byte(s). Thanks</h2>\n", retlen);
-							r_socket_http_response (rs, 200, buf, 0, headers);
-					}
-					free (ret);
-				}
-			} else {
-				r_socket_http_response (rs, 403, "403 Forbidden\n", 0, headers);
-			}
-		} else {
-			r_socket_http_response (rs, 404, "Invalid protocol", 0, headers);
+		if (status == HTTP_STOP) {
+			ret = 0;
+			break;
 		}
-		r_socket_http_close (rs);
-		free (dir);
 	}
-the_end:
 	{
 		int timeout = r_config_get_i (core->config, "http.timeout");
 		const char *host = r_config_get (core->config, "http.bind");
@@ -492,7 +702,9 @@ the_end:
 		r_config_set (core->config, "http.ui", httpui);
 	}
 	r_cons_break_pop ();
+	http_pool_free (hp);
 	core->http_up = false;
+	r_list_free (so.authtokens);
 	free (pfile);
 	r_socket_free (s);
 	r_config_free (newcfg);
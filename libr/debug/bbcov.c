@@ -0,0 +1,266 @@
+/* radare - LGPL - Copyright 2026 - agent */
+
+#include <r_debug.h>
+
+/* basic block coverage: instead of single stepping, every block start gets
+ * a software trap that is removed (or rearmed) when it fires, so the target
+ * only stops once per block */
+
+R_API RDebugBBCov *r_debug_bbcov_new(void) {
+	RDebugBBCov *cov = R_NEW0 (RDebugBBCov);
+	if (!cov) {
+		return NULL;
+	}
+	r_vector_init (&cov->blocks, sizeof (RDebugBBCovBlock), NULL, NULL);
+	r_vector_init (&cov->log, sizeof (ut32), NULL, NULL);
+	cov->at = ht_up_new0 ();
+	if (!cov->at) {
+		free (cov);
+		return NULL;
+	}
+	return cov;
+}
+
+R_API void r_debug_bbcov_free(RDebugBBCov *cov) {
+	if (cov) {
+		r_vector_clear (&cov->blocks);
+		r_vector_clear (&cov->log);
+		ht_up_free (cov->at);
+		free (cov);
+	}
+}
+
+R_API bool r_debug_bbcov_add(RDebugBBCov *cov, ut64 addr, ut32 size) {
+	r_return_val_if_fail (cov, false);
+	if (ht_up_find (cov->at, addr, NULL)) {
+		return false;
+	}
+	RDebugBBCovBlock block = { addr, size, 0 };
+	if (!r_vector_push (&cov->blocks, &block)) {
+		return false;
+	}
+	return ht_up_insert (cov->at, addr, (void *)(size_t)cov->blocks.len);
+}
+
+static void bbcov_hit(RDebugBBCov *cov, ut64 addr) {
+	ut32 idx = (ut32)(size_t)ht_up_find (cov->at, addr, NULL);
+	if (idx--) {
+		RDebugBBCovBlock *block = r_vector_index_ptr (&cov->blocks, idx);
+		block->hits++;
+		r_vector_push (&cov->log, &idx);
+	}
+}
+
+/* find the trap that stopped the target, same rules as r_debug_bp_hit */
+static RBreakpointItem *bbcov_trap_at(RDebug *dbg, RBreakpoint *traps, ut64 pc) {
+	RBreakpointItem *b = NULL;
+	if (!dbg->pc_at_bp_set || !dbg->pc_at_bp) {
+		b = r_bp_get_at (traps, pc - dbg->bpsize);
+	}
+	return b? b: r_bp_get_at (traps, pc);
+}
+
+static int bbcov_addr_cmp(const void *a, const void *b) {
+	ut64 x = *(const ut64 *)a, y = *(const ut64 *)b;
+	return (x > y) - (x < y);
+}
+
+/* a trap takes bpsize bytes, so a block starting less than bpsize after
+ * the previous trap can't get its own without clobbering it: it is left
+ * untrapped and never counted. returns the number of traps */
+static int bbcov_arm(RDebug *dbg, RDebugBBCov *cov, RBreakpoint *traps) {
+	RDebugBBCovBlock *block;
+	int i, n = 0, armed = 0;
+	ut64 *addrs = R_NEWS (ut64, cov->blocks.len + 1);
+	if (!addrs) {
+		return -1;
+	}
+	r_vector_foreach (&cov->blocks, block) {
+		addrs[n++] = block->addr;
+	}
+	qsort (addrs, n, sizeof (ut64), bbcov_addr_cmp);
+	ut64 next = 0;
+	for (i = 0; i < n; i++) {
+		if (i > 0 && addrs[i] < next) {
+			continue;
+		}
+		if (r_bp_add_sw (traps, addrs[i], dbg->bpsize, R_BP_PROT_EXEC)) {
+			armed++;
+		}
+		next = addrs[i] + dbg->bpsize;
+	}
+	free (addrs);
+	return armed;
+}
+
+/**
+ * run the target until it dies or stops for some other reason, counting the
+ * blocks of cov it goes through. oneshot removes every trap after its first
+ * hit, otherwise the block is stepped over and the trap is set again.
+ *
+ * user breakpoints are not armed meanwhile. returns the number of hits.
+ */
+R_API int r_debug_bbcov_run(RDebug *dbg, RDebugBBCov *cov, bool oneshot) {
+	RBreakpointItem *b;
+	RDebugReasonType reason;
+	int hits = 0;
+
+	r_return_val_if_fail (dbg && cov, -1);
+	if (r_debug_is_dead (dbg) || !dbg->h || !dbg->h->cont || !dbg->bp->cur) {
+		return -1;
+	}
+	if (!oneshot && !dbg->h->step) {
+		eprintf ("This debugger plugin cannot step\n");
+		return -1;
+	}
+	RBreakpoint *traps = r_bp_new ();
+	if (!traps) {
+		return -1;
+	}
+	traps->iob = dbg->bp->iob;
+	traps->endian = dbg->bp->endian;
+	r_bp_use (traps, dbg->bp->cur->name, dbg->bp->bits);
+	if (bbcov_arm (dbg, cov, traps) < 0) {
+		r_bp_free (traps);
+		return -1;
+	}
+	r_bp_restore (traps, true);
+	RDebugRecoilMode orecoil = dbg->recoil_mode;
+	dbg->recoil_mode = R_DBG_RECOIL_NONE;
+
+	ut64 start = r_sys_now_mono ();
+	while (!r_cons_is_breaked ()) {
+		dbg->h->cont (dbg, dbg->pid, dbg->tid, 0);
+		reason = r_debug_wait (dbg, NULL);
+		if (reason == R_DEBUG_REASON_DEAD || r_debug_is_dead (dbg)) {
+			break;
+		}
+		if (reason == R_DEBUG_REASON_NEW_TID || reason == R_DEBUG_REASON_EXIT_TID) {
+			continue;
+		}
+		if (reason != R_DEBUG_REASON_BREAKPOINT) {
+			break;
+		}
+		ut64 pc = r_debug_reg_get (dbg, "PC");
+		if (!(b = bbcov_trap_at (dbg, traps, pc))) {
+			/* not one of ours, let the user look at it */
+			break;
+		}
+		if (b->addr != pc) {
+			r_debug_reg_set (dbg, "PC", b->addr);
+		}
+		bbcov_hit (cov, b->addr);
+		hits++;
+		r_bp_restore_one (traps, b, false);
+		if (oneshot) {
+			r_bp_del (traps, b->addr);
+			continue;
+		}
+		dbg->h->step (dbg);
+		reason = r_debug_wait (dbg, NULL);
+		if (reason == R_DEBUG_REASON_DEAD || r_debug_is_dead (dbg)) {
+			break;
+		}
+		r_bp_restore_one (traps, b, true);
+	}
+	cov->elapsed += r_sys_now_mono () - start;
+	dbg->recoil_mode = orecoil;
+	if (!r_debug_is_dead (dbg)) {
+		r_bp_restore (traps, false);
+	}
+	r_bp_free (traps);
+	dbg->reason.bp_addr = 0;
+	return hits;
+}
+
+typedef struct {
+	const char *path;
+	ut64 base;
+	ut64 end;
+} BBCovModule;
+
+/* one module per mapped file, spanning all its maps */
+static void bbcov_modules(RDebug *dbg, RVector *mods) {
+	RDebugMap *map;
+	RListIter *iter;
+	BBCovModule *mod;
+	r_debug_map_sync (dbg);
+	r_list_foreach (dbg->maps, iter, map) {
+		const char *path = map->file? map->file: map->name;
+		if (!path || *path != '/') {
+			continue;
+		}
+		bool found = false;
+		r_vector_foreach (mods, mod) {
+			if (!strcmp (mod->path, path)) {
+				mod->base = R_MIN (mod->base, map->addr);
+				mod->end = R_MAX (mod->end, map->addr_end);
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			BBCovModule m = { path, map->addr, map->addr_end };
+			r_vector_push (mods, &m);
+		}
+	}
+}
+
+/* write the hit blocks in drcov format (version 2), readable by lighthouse
+ * and friends */
+R_API bool r_debug_bbcov_drcov(RDebug *dbg, RDebugBBCov *cov, const char *file) {
+	RDebugBBCovBlock *block;
+	BBCovModule *mod;
+	ut32 *idx;
+	int i, count = 0;
+
+	r_return_val_if_fail (dbg && cov && file, false);
+	RVector *mods = r_vector_new (sizeof (BBCovModule), NULL, NULL);
+	ut8 *bbs = malloc (cov->blocks.len * 8 + 1);
+	if (!mods || !bbs) {
+		r_vector_free (mods);
+		free (bbs);
+		return false;
+	}
+	bbcov_modules (dbg, mods);
+	/* blocks in first hit order, each one once */
+	RDebugBBCovBlock *blocks = cov->blocks.a;
+	ut8 *seen = calloc (cov->blocks.len + 1, 1);
+	r_vector_foreach (&cov->log, idx) {
+		if (!seen || seen[*idx]) {
+			continue;
+		}
+		seen[*idx] = 1;
+		block = &blocks[*idx];
+		i = 0;
+		r_vector_foreach (mods, mod) {
+			if (block->addr >= mod->base && block->addr < mod->end) {
+				ut8 *e = bbs + count * 8;
+				r_write_le32 (e, (ut32)(block->addr - mod->base));
+				r_write_le16 (e + 4, (ut16)R_MIN (block->size, UT16_MAX));
+				r_write_le16 (e + 6, (ut16)i);
+				count++;
+				break;
+			}
+			i++;
+		}
+	}
+	free (seen);
+
+	RStrBuf *sb = r_strbuf_new ("DRCOV VERSION: 2\nDRCOV FLAVOR: drcov\n");
+	r_strbuf_appendf (sb, "Module Table: version 2, count %d\n", (int)mods->len);
+	r_strbuf_append (sb, "Columns: id, base, end, entry, checksum, timestamp, path\n");
+	i = 0;
+	r_vector_foreach (mods, mod) {
+		r_strbuf_appendf (sb, "%2d, 0x%016"PFMT64x", 0x%016"PFMT64x
+			", 0x0000000000000000, 0x00000000, 0x00000000, %s\n",
+			i++, mod->base, mod->end, mod->path);
+	}
+	r_strbuf_appendf (sb, "BB Table: %d bbs\n", count);
+	bool ret = r_file_dump (file, (const ut8 *)r_strbuf_get (sb), r_strbuf_length (sb), false)
+		&& r_file_dump (file, bbs, count * 8, true);
+	r_strbuf_free (sb);
+	free (bbs);
+	r_vector_free (mods);
+	return ret;
+}
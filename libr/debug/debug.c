@@ -40,7 +40,7 @@ R_API void r_debug_bp_update(RDebug *dbg) {
 	RListIter *iter;
 	r_list_foreach (dbg->bp->bps, iter, bp) {
 		if (bp->expr) {
-			bp->addr = dbg->corebind.numGet (dbg->corebind.core, bp->expr);
+			r_bp_item_set_addr (dbg->bp, bp, dbg->corebind.numGet (dbg->corebind.core, bp->expr));
 		}
 	}
 }
@@ -416,6 +416,7 @@ R_API RDebug *r_debug_free(RDebug *dbg) {
 		free (dbg->btalgo);
 		r_debug_trace_free (dbg->trace);
 		dbg->trace = NULL;
+		r_debug_bbcov_free (dbg->bbcov);
 		r_egg_free (dbg->egg);
 		free (dbg->arch);
 		free (dbg->glob_libs);
@@ -1247,11 +1248,152 @@ R_API int r_debug_continue_until_nontraced(RDebug *dbg) {
 	return false;
 }
 
-R_API int r_debug_continue_until_optype(RDebug *dbg, int type, int over) {
-	int ret, n = 0;
-	ut64 pc, buf_pc = 0;
-	RAnalOp op;
+#define UNTIL_MAX_BLOCKS 64
+
+typedef struct {
+	ut64 addr;
+	bool match;
+} UntilStop;
+
+/* true if execution may not fall through to the next instruction */
+static bool op_leaves_block(RAnalOp *op) {
+	if (op->eob || op->delay) {
+		return true;
+	}
+	switch (op->type & R_ANAL_OP_TYPE_MASK & ~R_ANAL_OP_TYPE_COND) {
+	case R_ANAL_OP_TYPE_JMP:
+	case R_ANAL_OP_TYPE_UJMP:
+	case R_ANAL_OP_TYPE_CALL:
+	case R_ANAL_OP_TYPE_UCALL:
+	case R_ANAL_OP_TYPE_RET:
+	case R_ANAL_OP_TYPE_ILL:
+	case R_ANAL_OP_TYPE_UNK:
+	case R_ANAL_OP_TYPE_TRAP:
+		return true;
+	}
+	return false;
+}
+
+static void until_push(ut64 *list, int *n, ut64 addr) {
+	int i;
+	for (i = 0; i < *n; i++) {
+		if (list[i] == addr) {
+			return;
+		}
+	}
+	list[(*n)++] = addr;
+}
+
+static void until_stop(UntilStop *stops, int *n, ut64 addr, bool match) {
+	int i;
+	for (i = 0; i < *n; i++) {
+		if (stops[i].addr == addr) {
+			return;
+		}
+	}
+	stops[*n].addr = addr;
+	stops[*n].match = match;
+	(*n)++;
+}
+
+/* follow the direct jumps from pc and collect the instructions where the
+ * target must stop: the ones of the requested type and every branch whose
+ * destination is not known (calls, returns, indirect jumps..). returns the
+ * number of stops or -1 when pc cannot be decoded */
+static int until_stops(RDebug *dbg, ut64 pc, int type, UntilStop *stops) {
+	ut64 todo[UNTIL_MAX_BLOCKS];
 	ut8 buf[DBG_BUF_SIZE];
+	int i, ntodo = 0, nstops = 0;
+	RAnalOp op;
+
+	todo[ntodo++] = pc;
+	for (i = 0; i < ntodo; i++) {
+		ut64 from = todo[i], at = from;
+		if (!dbg->iob.read_at (dbg->iob.io, from, buf, sizeof (buf))) {
+			if (from == pc) {
+				return -1;
+			}
+			until_stop (stops, &nstops, from, false);
+			continue;
+		}
+		while (at - from < sizeof (buf)) {
+			int len = r_anal_op (dbg->anal, &op, at, buf + (at - from),
+				sizeof (buf) - (at - from), R_ANAL_OP_MASK_BASIC);
+			if (len < 1 || op.size < 1) {
+				r_anal_op_fini (&op);
+				if (at == pc) {
+					return -1;
+				}
+				until_stop (stops, &nstops, at, false);
+				break;
+			}
+			int base = op.type & ~R_ANAL_OP_TYPE_COND;
+			if (op.type == type || op.delay) {
+				until_stop (stops, &nstops, at, op.type == type);
+				r_anal_op_fini (&op);
+				break;
+			}
+			if (base == R_ANAL_OP_TYPE_JMP && op.jump != UT64_MAX) {
+				/* direct jump, keep following while there is room */
+				ut64 next[2] = { op.jump, UT64_MAX };
+				if (op.type & R_ANAL_OP_TYPE_COND) {
+					next[1] = (op.fail != UT64_MAX)? op.fail: at + op.size;
+				}
+				if (ntodo + 2 > UNTIL_MAX_BLOCKS) {
+					until_stop (stops, &nstops, at, false);
+				} else {
+					until_push (todo, &ntodo, next[0]);
+					if (next[1] != UT64_MAX) {
+						until_push (todo, &ntodo, next[1]);
+					}
+				}
+				r_anal_op_fini (&op);
+				break;
+			}
+			bool leaves = op_leaves_block (&op);
+			r_anal_op_fini (&op);
+			if (leaves) {
+				until_stop (stops, &nstops, at, false);
+				break;
+			}
+			at += op.size;
+		}
+		if (at - from >= sizeof (buf)) {
+			/* straight line code longer than the buffer */
+			if (ntodo < UNTIL_MAX_BLOCKS) {
+				until_push (todo, &ntodo, at);
+			} else {
+				until_stop (stops, &nstops, at, false);
+			}
+		}
+	}
+	return nstops;
+}
+
+static UntilStop *until_find(UntilStop *stops, int n, ut64 addr) {
+	int i;
+	for (i = 0; i < n; i++) {
+		if (stops[i].addr == addr) {
+			return &stops[i];
+		}
+	}
+	return NULL;
+}
+
+/**
+ * continue until an instruction of the given type is about to run. Instead
+ * of stepping every instruction, the code reachable from pc through direct
+ * jumps is decoded and runs at full speed with temporary breakpoints on the
+ * matching instructions and on the branches that cannot be followed
+ * statically. Only those branches are stepped (over calls if asked to).
+ */
+R_API int r_debug_continue_until_optype(RDebug *dbg, int type, int over) {
+	/* each explored block ends in at most two stops */
+	UntilStop stops[UNTIL_MAX_BLOCKS * 2];
+	bool added[UNTIL_MAX_BLOCKS * 2];
+	UntilStop *stop;
+	int i, ret, nstops, n = 0;
+	ut64 pc;
 
 	if (r_debug_is_dead (dbg)) {
 		return false;
@@ -1262,34 +1404,44 @@ R_API int r_debug_continue_until_optype(RDebug *dbg, int type, int over) {
 		return false;
 	}
 
+	// step first, we dont want to check current optype
 	r_debug_step (dbg, 1);
-	r_debug_reg_sync (dbg, R_REG_TYPE_GPR, false);
-
-	// Initial refill
-	buf_pc = r_debug_reg_get (dbg, dbg->reg->name[R_REG_NAME_PC]);
-	dbg->iob.read_at (dbg->iob.io, buf_pc, buf, sizeof (buf));
 
-	// step first, we dont want to check current optype
 	for (;;) {
 		if (!r_debug_reg_sync (dbg, R_REG_TYPE_GPR, false)) {
 			break;
 		}
-
 		pc = r_debug_reg_get (dbg, dbg->reg->name[R_REG_NAME_PC]);
-		// Try to keep the buffer full
-		if (pc - buf_pc > sizeof (buf)) {
-			buf_pc = pc;
-			dbg->iob.read_at (dbg->iob.io, buf_pc, buf, sizeof (buf));
-		}
-		// Analyze the opcode
-		if (!r_anal_op (dbg->anal, &op, pc, buf + (pc - buf_pc), sizeof (buf) - (pc - buf_pc), R_ANAL_OP_MASK_BASIC)) {
+		nstops = until_stops (dbg, pc, type, stops);
+		if (nstops < 0) {
 			eprintf ("Decode error at %"PFMT64x"\n", pc);
 			return false;
 		}
-		if (op.type == type) {
+		if (!(stop = until_find (stops, nstops, pc))) {
+			for (i = 0; i < nstops; i++) {
+				added[i] = !r_bp_get_in (dbg->bp, stops[i].addr, R_BP_PROT_EXEC)
+					&& r_bp_add_sw (dbg->bp, stops[i].addr, dbg->bpsize, R_BP_PROT_EXEC);
+			}
+			r_debug_continue (dbg);
+			for (i = 0; i < nstops; i++) {
+				if (added[i]) {
+					r_bp_del (dbg->bp, stops[i].addr);
+				}
+			}
+			n++;
+			if (r_debug_is_dead (dbg)) {
+				break;
+			}
+			pc = r_debug_reg_get (dbg, dbg->reg->name[R_REG_NAME_PC]);
+			if (!(stop = until_find (stops, nstops, pc))) {
+				/* stopped somewhere else: breakpoint, signal.. */
+				break;
+			}
+		}
+		if (stop->match) {
 			break;
 		}
-		// Step over and repeat
+		// Step over the branch and repeat
 		ret = over
 			? r_debug_step_over (dbg, 1)
 			: r_debug_step (dbg, 1);
@@ -498,6 +498,7 @@ R_API bool r_flag_exist_at(RFlag *f, const char *flag_prefix, ut16 fp_size, ut64
  * Otherwise, NULL is returned. */
 R_API RFlagItem *r_flag_get(RFlag *f, const char *name) {
 	r_return_val_if_fail (f, NULL);
+	R_PROF_COUNT (flag_get);
 	RFlagItem *r = ht_pp_find (f->ht_name, name, NULL);
 	return r? evalFlag (f, r): NULL;
 }
@@ -505,6 +506,7 @@ R_API RFlagItem *r_flag_get(RFlag *f, const char *name) {
 /* return the first flag item that can be found at offset "off", or NULL otherwise */
 R_API RFlagItem *r_flag_get_i(RFlag *f, ut64 off) {
 	r_return_val_if_fail (f, NULL);
+	R_PROF_COUNT (flag_get_i);
 	const RList *list = r_flag_get_list (f, off);
 	return list? evalFlag (f, r_list_get_top (list)): NULL;
 }
@@ -742,6 +744,110 @@ err:
 	return NULL;
 }
 
+typedef struct {
+	RFlagItem *item;
+	ut64 offset;
+	int seq;
+} FlagPending;
+
+static int flag_pending_cmp(const void *a, const void *b) {
+	const FlagPending *pa = a, *pb = b;
+	if (pa->offset != pb->offset) {
+		return pa->offset < pb->offset? -1: 1;
+	}
+	return pa->seq - pb->seq;
+}
+
+/* set many flags at once, like calling r_flag_set (and
+ * r_flag_item_set_realname when realname is given) on each item in order,
+ * except that flags moved to another offset keep their name and realname.
+ * Names are filtered once and the offset skiplist is walked once per
+ * distinct offset after sorting, instead of once per flag.
+ * The item field of every entry is filled with the flag that was set, or
+ * NULL where r_flag_set would have failed.
+ * Returns the number of items that were set. */
+R_API int r_flag_set_batch(RFlag *f, RFlagBatchItem *items, int count) {
+	r_return_val_if_fail (f && (items || count < 1), 0);
+	if (count < 1) {
+		return 0;
+	}
+	FlagPending *pending = calloc (count, sizeof (FlagPending));
+	if (!pending) {
+		return 0;
+	}
+	RSpace *cur = r_flag_space_cur (f);
+	int i, n = 0, done = 0;
+	for (i = 0; i < count; i++) {
+		RFlagBatchItem *bi = &items[i];
+		bi->item = NULL;
+		if (R_STR_ISEMPTY (bi->name)) {
+			continue;
+		}
+		char *name = filter_item_name (bi->name);
+		if (!name) {
+			continue;
+		}
+		RFlagItem *item = r_flag_get (f, name);
+		if (item && item->offset == bi->offset) {
+			free (name);
+			item->size = bi->size;
+		} else {
+			if (item) {
+				// the name is the same once filtered, only offset, size and space move.
+				// flags already moved by this batch are in no offset list yet
+				free (name);
+				remove_offsetmap (f, item);
+			} else {
+				item = R_NEW0 (RFlagItem);
+				if (!item) {
+					free (name);
+					continue;
+				}
+				if (!ht_pp_insert (f->ht_name, name, item)) {
+					free (item);
+					free (name);
+					continue;
+				}
+				set_name (item, name);
+			}
+			item->space = bi->space? bi->space: cur;
+			item->size = bi->size;
+			item->offset = bi->offset + f->base;
+			pending[n].item = item;
+			pending[n].offset = item->offset;
+			pending[n].seq = i;
+			n++;
+		}
+		if (bi->realname) {
+			r_flag_item_set_realname (item, bi->realname);
+		}
+		bi->item = item;
+		done++;
+	}
+	qsort (pending, n, sizeof (FlagPending), flag_pending_cmp);
+	RFlagsAtOffset *at = NULL;
+	for (i = 0; i < n; i++) {
+		RFlagItem *item = pending[i].item;
+		if (pending[i].offset != item->offset) {
+			// moved again later in the batch
+			continue;
+		}
+		if (!at || at->off != item->offset) {
+			at = flags_at_offset (f, item->offset);
+			if (!at) {
+				continue;
+			}
+		}
+		if (i > 0 && pending[i - 1].offset == item->offset) {
+			// set twice at this offset, keep the order of the last one
+			r_list_delete_data (at->flags, item);
+		}
+		r_list_append (at->flags, item);
+	}
+	free (pending);
+	return done;
+}
+
 /* add/replace/remove the alias of a flag item */
 R_API void r_flag_item_set_alias(RFlagItem *item, const char *alias) {
 	r_return_if_fail (item);
@@ -951,7 +1057,23 @@ R_API void r_flag_foreach_range(RFlag *f, ut64 from, ut64 to, RFlagItemCb cb, vo
 }
 
 R_API void r_flag_foreach_glob(RFlag *f, const char *glob, RFlagItemCb cb, void *user) {
-	FOREACH_BODY (!glob || r_str_glob (fi->name, glob));
+	RStrGlob *g = r_str_glob_new (glob);
+	if (!g) {
+		return;
+	}
+	RSkipListNode *it, *tmp;
+	RFlagsAtOffset *flags_at;
+	RListIter *it2, *tmp2;
+	RFlagItem *fi;
+	r_skiplist_foreach_safe (f->by_off, it, tmp, flags_at) {
+		r_list_foreach_safe (flags_at->flags, it2, tmp2, fi) {
+			if (r_str_glob_match (g, fi->name) && !cb (fi, user)) {
+				goto beach;
+			}
+		}
+	}
+beach:
+	r_str_glob_free (g);
 }
 
 R_API void r_flag_foreach_space(RFlag *f, const RSpace *space, RFlagItemCb cb, void *user) {
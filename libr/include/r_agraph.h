@@ -76,7 +76,6 @@ typedef struct r_ascii_graph_t {
 	RList *long_edges;
 	struct layer_t *layers;
 	int n_layers;
-	RList *dists; /* RList<struct dist_t> */
 	RList *edges; /* RList<AEdge> */
 } RAGraph;
 
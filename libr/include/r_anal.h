@@ -267,37 +267,32 @@ typedef struct r_anal_fcn_meta_t {
  * description */
 typedef struct r_anal_function_t {
 	char* name;
-	char* dsc; // For producing nice listings
+	ut64 addr;
 	ut32 _size;
 	int bits; // ((> bits 0) (set-bits bits))
 	int type;
-	/*item_list *rets; // Type of return value */
-	char *rets;
-	short fmod; //  static, inline or volatile?
-	const char *cc; // calling convention
-	char* attr; // __attribute__(()) list
-	ut64 addr;
-	ut64 rb_max_addr; // maximum of meta.min + _size - 1 in the subtree, for fcn interval tree
 	int stack; //stack frame size
 	int maxstack;
 	int ninstr;
 	int nargs; // Function arguments counter
 	int depth;
-	bool folded;
-	bool is_pure;
-	bool has_changed; // true if function may have changed since last anaysis TODO: set this attribute where necessary
-	bool bp_frame;
-	RAnalType *args; // list of arguments
+	RList *bbs;
+	RRangeTiny bbr;
+	RBNode rb;
+	RBNode addr_rb;
+	ut64 rb_max_addr; // maximum of meta.min + _size - 1 in the subtree, for fcn interval tree
+	RAnalFcnMeta meta;
+	const char *cc; // calling convention
+	char* dsc; // For producing nice listings
 	ut8 *fingerprint; // TODO: make is fuzzy and smarter
 	RAnalDiff *diff;
 	RList *locs; // list of local variables
 	RList *fcn_locs; //sorted list of a function *.loc refs
 	//RList *locals; // list of local labels -> moved to anal->sdb_fcns
-	RList *bbs;
-	RAnalFcnMeta meta;
-	RRangeTiny bbr;
-	RBNode rb;
-	RBNode addr_rb;
+	bool folded;
+	bool is_pure;
+	bool has_changed; // true if function may have changed since last anaysis TODO: set this attribute where necessary
+	bool bp_frame;
 } RAnalFunction;
 
 typedef struct r_anal_func_arg_t {
@@ -866,46 +861,45 @@ typedef struct r_anal_cond_t {
 } RAnalCond;
 
 typedef struct r_anal_bb_t {
-	char *name;
+	/* hot fields first, they are read on every block lookup and walk */
 	ut64 addr;
 	ut64 jump;
-	ut64 type2;
 	ut64 fail;
 	int size;
 	int type;
-	int type_ex;
 	int ninstr;
-	int returnbb;
-	int conditional;
-	int traced;
-	ut32 colorize;
+	// size of the op_pos array, allocated on demand
+	int op_pos_size;
+	// offsets of instructions in this block
+	ut16 *op_pos;
+	RAnalBlock *next;
+	/* these are used also in pdr: */
+	RAnalBlock *prev;
+	RAnalBlock *failbb;
+	RAnalBlock *jumpbb;
+	int stackptr;
+	int parent_stackptr;
+	/* cold fields, mostly NULL */
+	ut64 type2;
+	ut64 cmpval;
+	const char *cmpreg;
 	char *label;
 	ut8 *fingerprint;
 	RAnalDiff *diff;
 	RAnalCond *cond;
 	RAnalSwitchOp *switch_op;
-	// offsets of instructions in this block
-	ut16 *op_pos;
-	// size of the op_pos array
-	int op_pos_size;
 	ut8 *op_bytes;
-	ut8 op_sz;
+	ut8 *parent_reg_arena;
 	/* deprecate ??? where is this used? */
 	/* iirc only java. we must use r_anal_bb_from_offset(); instead */
 	RAnalBlock *head;
 	RAnalBlock *tail;
-	RAnalBlock *next;
-	/* these are used also in pdr: */
-	RAnalBlock *prev;
-	RAnalBlock *failbb;
-	RAnalBlock *jumpbb;
 	RList /*struct r_anal_bb_t*/ *cases;
-	ut8 *parent_reg_arena;
-	int stackptr;
-	int parent_stackptr;
+	ut32 colorize;
+	ut8 op_sz;
+	bool conditional;
+	bool traced;
 	bool folded;
-	ut64 cmpval;
-	const char *cmpreg;
 #undef RAnalBlock
 } RAnalBlock;
 
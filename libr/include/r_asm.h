@@ -71,6 +71,41 @@ typedef struct r_asm_op_t {
 	RBuffer *buf_inc; // must die
 } RAsmOp;
 
+#define R_ASM_CACHE_SIZE 4096
+#define R_ASM_CACHE_OPSZ 16
+
+typedef struct r_asm_cache_item_t {
+	ut64 pc;
+	ut32 epoch;
+	int bits;
+	int ret;
+	int size;
+	int payload;
+	ut8 bytes[R_ASM_CACHE_OPSZ];
+	char *text;
+} RAsmCacheItem;
+
+/* decoded instructions keyed by pc and bits. hits are validated against
+ * the input bytes, so io writes and map changes need no explicit
+ * invalidation. any other change in the decoder configuration starts a new
+ * epoch. hits and misses are counted by the profiler (?T) */
+typedef struct r_asm_cache_t {
+	RAsmCacheItem *items;
+	ut32 epoch;
+	const void *cur;
+	const void *bin;
+	const void *ofilter;
+	const void *ofilter_cur;
+	int big_endian;
+	int syntax;
+	int invhex;
+	int pcalign;
+	int seggrn;
+	bool immdisp;
+	char *cpu;
+	char *features;
+} RAsmCache;
+
 typedef struct r_asm_code_t {
 #if 1
 	int len;
@@ -116,6 +151,8 @@ typedef struct r_asm_t {
 	bool immdisp; // Display immediates with # symbol (for arm stuff).
 	HtPP *flags;
 	int seggrn;
+	bool usecache;
+	RAsmCache cache;
 } RAsm;
 
 typedef bool (*RAsmModifyCallback)(RAsm *a, ut8 *buf, int field, ut64 val);
@@ -175,6 +212,7 @@ R_API int r_asm_filter_output(RAsm *a, const char *f);
 R_API char *r_asm_describe(RAsm *a, const char* str);
 R_API RList* r_asm_get_plugins(RAsm *a);
 R_API void r_asm_list_directives(void);
+R_API void r_asm_cache_reset(RAsm *a);
 
 /* code.c */
 R_API RAsmCode *r_asm_code_new(void);
@@ -241,6 +241,7 @@ typedef struct r_bin_object_t {
 	RList/*<??>*/ *fields;
 	RList/*<??>*/ *libs;
 	RBNode/*<RBinReloc>*/ *relocs;
+	struct r_bin_reloc_t *relocs_packed; // storage of the nodes in relocs
 	RList/*<??>*/ *strings;
 	RList/*<RBinClass>*/ *classes;
 	HtPP *classes_ht;
@@ -253,6 +254,7 @@ typedef struct r_bin_object_t {
 	RBinAddr *binsym[R_BIN_SYM_LAST];
 	struct r_bin_plugin_t *plugin;
 	int lang;
+	ut64 loaded; // R_BIN_REQ_* item kinds already parsed, see bin.lazy
 	Sdb *kv;
 	Sdb *addr2klassmethod;
 	void *bin_obj; // internal pointer used by formats
@@ -327,6 +329,7 @@ typedef struct r_bin_t {
 	bool verbose;
 	bool use_xtr; // use extract plugins when loading a file?
 	bool use_ldr; // use loader plugins when loading a file?
+	bool lazy; // parse symbols, imports, relocs, strings.. on first access
 } RBin;
 
 typedef struct r_bin_xtr_metadata_t {
@@ -624,7 +627,7 @@ typedef struct r_bin_options_t {
 } RBinOptions;
 
 R_API RBinImport *r_bin_import_clone(RBinImport *o);
-R_API const char *r_bin_symbol_name(RBinSymbol *s);
+R_API char *r_bin_symbol_name(RBinSymbol *s);
 typedef void (*RBinSymbolCallback)(RBinObject *obj, RBinSymbol *symbol);
 
 // options functions
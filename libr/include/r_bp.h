@@ -5,6 +5,7 @@
 #include <r_lib.h>
 #include <r_io.h>
 #include <r_list.h>
+#include <r_skiplist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,7 +44,7 @@ typedef struct r_bp_item_t {
 	char *name;
 	char *module_name; /*module where you get the base address*/
 	st64 module_delta; /*delta to apply to module */
-	ut64 addr;
+	ut64 addr; /* indexed, change it with r_bp_item_set_addr */
 	int size; /* size of breakpoint area */
 	int recoil; /* recoil */
 	bool swstep; 	/* is this breakpoint from a swstep? */
@@ -80,8 +81,11 @@ typedef struct r_bp_t {
 	int nbps;
 	int nhwbps;
 	RList *bps; // list of breakpoints
+	RSkipList *bps_addr; // same items sorted by address
+	int bps_maxsize; // largest item size, bounds the r_bp_get_in lookup
 	RBreakpointItem **bps_idx;
 	int bps_idx_count;
+	int bps_idx_free; // lowest slot in bps_idx that may be empty
 	st64 delta;
 } RBreakpoint;
 
@@ -132,6 +136,8 @@ R_API int r_bp_del_index(RBreakpoint *bp, int idx);
 R_API RBreakpointItem *r_bp_get_index(RBreakpoint *bp, int idx);
 R_API int r_bp_get_index_at (RBreakpoint *bp, ut64 addr);
 R_API RBreakpointItem *r_bp_item_new (RBreakpoint *bp);
+R_API void r_bp_item_link(RBreakpoint *bp, RBreakpointItem *b);
+R_API void r_bp_item_set_addr(RBreakpoint *bp, RBreakpointItem *b, ut64 addr);
 
 R_API RBreakpointItem *r_bp_get_at (RBreakpoint *bp, ut64 addr);
 R_API RBreakpointItem *r_bp_get_in (RBreakpoint *bp, ut64 addr, int perm);
@@ -245,6 +245,20 @@ typedef struct r_debug_tracepoint_t {
 	ut64 stamp;
 } RDebugTracepoint;
 
+typedef struct r_debug_bbcov_block_t {
+	ut64 addr;
+	ut32 size;
+	ut32 hits;
+} RDebugBBCovBlock;
+
+/* basic block coverage collected with one trap per block (see dtb) */
+typedef struct r_debug_bbcov_t {
+	RVector blocks; // RDebugBBCovBlock
+	HtUP *at; // block address -> index + 1
+	RVector log; // ut32 block indexes in hit order
+	ut64 elapsed; // nanoseconds spent running the target
+} RDebugBBCov;
+
 typedef struct r_debug_t {
 	char *arch;
 	int bits; /// XXX: MUST SET ///
@@ -289,6 +303,7 @@ typedef struct r_debug_t {
 	Sdb *tracenodes;
 	RTree *tree;
 	RList *call_frames;
+	RDebugBBCov *bbcov;
 
 	RReg *reg;
 	RList *q_regs;
@@ -549,6 +564,13 @@ R_API RDebugTracepoint *r_debug_trace_add(RDebug *dbg, ut64 addr, int size);
 R_API RDebugTrace *r_debug_trace_new(void);
 R_API void r_debug_trace_free(RDebugTrace *dbg);
 R_API int r_debug_trace_tag(RDebug *dbg, int tag);
+
+/* bbcov */
+R_API RDebugBBCov *r_debug_bbcov_new(void);
+R_API void r_debug_bbcov_free(RDebugBBCov *cov);
+R_API bool r_debug_bbcov_add(RDebugBBCov *cov, ut64 addr, ut32 size);
+R_API int r_debug_bbcov_run(RDebug *dbg, RDebugBBCov *cov, bool oneshot);
+R_API bool r_debug_bbcov_drcov(RDebug *dbg, RDebugBBCov *cov, const char *file);
 R_API int r_debug_child_fork(RDebug *dbg);
 R_API int r_debug_child_clone(RDebug *dbg);
 
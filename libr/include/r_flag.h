@@ -47,6 +47,16 @@ typedef struct r_flag_item_t {
 	char *alias;    /* used to define a flag based on a math expression (e.g. foo + 3) */
 } RFlagItem;
 
+/* one entry of a r_flag_set_batch () call */
+typedef struct r_flag_batch_item_t {
+	const char *name;     /* flag name, filtered like in r_flag_set */
+	const char *realname; /* optional realname, NULL keeps the current one */
+	ut64 offset;
+	ut32 size;
+	RSpace *space;        /* NULL means the current flag space */
+	RFlagItem *item;      /* filled in with the flag that was set, NULL on failure */
+} RFlagBatchItem;
+
 typedef struct r_flag_t {
 	RSpaces spaces;   /* handle flag spaces */
 	st64 base;         /* base address for all flag items */
@@ -114,6 +124,7 @@ R_API bool r_flag_unset_name(RFlag *f, const char *name);
 R_API bool r_flag_unset_off(RFlag *f, ut64 addr);
 R_API void r_flag_unset_all (RFlag *f);
 R_API RFlagItem *r_flag_set(RFlag *fo, const char *name, ut64 addr, ut32 size);
+R_API int r_flag_set_batch(RFlag *f, RFlagBatchItem *items, int count);
 R_API RFlagItem *r_flag_set_next(RFlag *fo, const char *name, ut64 addr, ut32 size);
 R_API void r_flag_item_set_alias(RFlagItem *item, const char *alias);
 R_API void r_flag_item_free (RFlagItem *item);
@@ -14,6 +14,11 @@
 
 #define R_IO_UNDOS 64
 
+/* io.gzip.index, where the inflate index of gzip:// files is kept */
+#define R_IO_GZIP_INDEX_CACHE 0
+#define R_IO_GZIP_INDEX_FILE  1
+#define R_IO_GZIP_INDEX_NONE  2
+
 #if HAVE_PTRACE
 
 #if __sun
@@ -87,6 +92,7 @@ typedef struct r_io_t {
 	int cached;
 	bool cachemode; // write in cache all the read operations (EXPERIMENTAL)
 	int p_cache;
+	int gzip_index; // R_IO_GZIP_INDEX_*
 	int debug;
 //#warning remove debug from RIO
 	RIDPool *map_ids;
@@ -138,6 +144,10 @@ typedef struct {
 	RSocket *fd;
 	RSocket *client;
 	int listener;
+	int version; // 2 when talking rap v2 (rap2://)
+	int features; // RAP_V2_F_* accepted by the server
+	ut64 offset; // v2 seeks are tracked locally
+	ut32 id; // next v2 request id
 } RIORap;
 
 #define RMT_MAX    4096
@@ -148,6 +158,9 @@ typedef struct {
 #define RMT_CLOSE  0x05
 #define RMT_SYSTEM 0x06
 #define RMT_CMD    0x07
+#define RMT_READ_AT  0x08
+#define RMT_WRITE_AT 0x09
+#define RMT_HELLO  0x0a
 #define RMT_REPLY  0x80
 
 typedef struct r_io_plugin_t {
@@ -180,6 +193,8 @@ typedef struct r_io_plugin_t {
 	bool (*accept)(RIO *io, RIODesc *desc, int fd);
 	int (*create)(RIO *io, const char *file, int mode, int type);
 	bool (*check)(RIO *io, const char *, bool many);
+	// borrowed pointer to count bytes at addr if the plugin has them in memory
+	const ut8 *(*peek)(RIO *io, RIODesc *fd, ut64 addr, int count);
 } RIOPlugin;
 
 typedef struct r_io_map_t {
@@ -337,6 +352,7 @@ R_API bool r_io_vread_at_mapped(RIO* io, ut64 vaddr, ut8* buf, int len);
 R_API bool r_io_read_at (RIO *io, ut64 addr, ut8 *buf, int len);
 R_API bool r_io_read_at_mapped(RIO *io, ut64 addr, ut8 *buf, int len);
 R_API int r_io_nread_at (RIO *io, ut64 addr, ut8 *buf, int len);
+R_API const ut8 *r_io_peek_at(RIO *io, ut64 addr, int len);
 R_API void r_io_alprint(RList *ls);
 R_API bool r_io_write_at (RIO *io, ut64 addr, const ut8 *buf, int len);
 R_API bool r_io_read (RIO *io, ut8 *buf, int len);
@@ -414,6 +430,7 @@ R_API int r_io_desc_get_pid (RIODesc *desc);
 R_API int r_io_desc_get_tid (RIODesc *desc);
 R_API bool r_io_desc_get_base (RIODesc *desc, ut64 *base);
 R_API int r_io_desc_read_at (RIODesc *desc, ut64 addr, ut8 *buf, int len);
+R_API const ut8 *r_io_desc_peek_at(RIODesc *desc, ut64 addr, int len);
 R_API int r_io_desc_write_at (RIODesc *desc, ut64 addr, const ut8 *buf, int len);
 R_API bool r_io_desc_fini (RIO *io);
 
@@ -33,6 +33,15 @@ R_LIB_VERSION_HEADER(r_magic);
 #define r_magic_compile(x,y)        magic_compile(x,y)
 #define r_magic_check(x,y)          magic_check(x,y)
 #define r_magic_errno(x)            magic_errno(x)
+
+/* the rules of the system libmagic are not reachable, no prefilter */
+typedef void RMagicIndex;
+#define r_magic_index_new(x)        NULL
+#define r_magic_index_free(x)       {}
+#define r_magic_index_complete(x)   false
+#define r_magic_index_candidate(x,y,z) true
+#define r_magic_index_next(x,y,z,c,w) 0
+#define r_magic_index_buffer(x,y,z) magic_buffer(((RMagicIndex *)x), y, z)
 #endif
 
 #else
@@ -308,6 +317,14 @@ R_API int r_magic_load(RMagic*, const char *);
 R_API int r_magic_compile(RMagic*, const char *);
 R_API int r_magic_check(RMagic*, const char *);
 R_API int r_magic_errno(RMagic*);
+
+typedef struct r_magic_index_t RMagicIndex;
+R_API RMagicIndex *r_magic_index_new(RMagic *ms);
+R_API void r_magic_index_free(RMagicIndex *mi);
+R_API bool r_magic_index_complete(RMagicIndex *mi);
+R_API bool r_magic_index_candidate(RMagicIndex *mi, const ut8 *buf, size_t nb);
+R_API int r_magic_index_next(RMagicIndex *mi, const ut8 *buf, int len, int count, int window);
+R_API const char *r_magic_index_buffer(RMagicIndex *mi, const void *buf, size_t nb);
 #endif
 
 
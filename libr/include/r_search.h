@@ -41,6 +41,7 @@ typedef struct r_search_keyword_t {
 	int icase; // ignore case
 	int type;
 	ut64 last; // last hit hint
+	RRegex *rx; // bin_keyword compiled on the first regexp search
 } RSearchKeyword;
 
 typedef struct r_search_hit_t {
@@ -131,6 +131,7 @@ R_API RList *r_sign_fcn_vars(RAnal *a, RAnalFunction *fcn);
 R_API int r_sign_is_flirt(RBuffer *buf);
 R_API void r_sign_flirt_dump(const RAnal *anal, const char *flirt_file);
 R_API void r_sign_flirt_scan(RAnal *anal, const char *flirt_file);
+R_API void r_sign_flirt_scan_files(RAnal *anal, RList *flirt_files);
 
 R_API bool r_sign_diff(RAnal *a, RSignOptions *options, const char *other_space_name);
 R_API bool r_sign_diff_by_name(RAnal *a, RSignOptions *options, const char *other_space_name, bool not_matching);
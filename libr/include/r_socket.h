@@ -53,8 +53,15 @@ typedef struct {
 	int output[2];
 #endif
 	RCoreBind coreb;
+	bool framed; // the other end understands R2PIPE_FRAME_* packets
 } R2Pipe;
 
+/* framed r2pipe protocol: [type:1][id:4][len:4][data:len] */
+#define R2PIPE_FRAME_CMD 0x01
+#define R2PIPE_FRAME_REPLY 0x81
+#define R2PIPE_FRAME_HDRSZ 9
+#define R2PIPE_FRAME_BATCH (32 * 1024)
+
 typedef struct r_socket_t {
 #ifdef _MSC_VER
 	SOCKET fd;
@@ -78,6 +85,7 @@ typedef struct r_socket_http_options {
 	bool accept_timeout;
 	int timeout;
 	bool httpauth;
+	bool keepalive;
 } RSocketHTTPOptions;
 
 
@@ -148,11 +156,15 @@ typedef struct r_socket_http_request {
 	ut8 *data;
 	int data_length;
 	bool auth;
+	bool http11;
+	bool keepalive;
 } RSocketHTTPRequest;
 
 R_API RSocketHTTPRequest *r_socket_http_accept(RSocket *s, RSocketHTTPOptions *so);
+R_API RSocketHTTPRequest *r_socket_http_request(RSocket *s, RSocketHTTPOptions *so);
 R_API void r_socket_http_response(RSocketHTTPRequest *rs, int code, const char *out, int x, const char *headers);
 R_API void r_socket_http_close(RSocketHTTPRequest *rs);
+R_API RSocket *r_socket_http_detach(RSocketHTTPRequest *rs);
 R_API ut8 *r_socket_http_handle_upload(const ut8 *str, int len, int *olen);
 
 typedef int (*rap_server_open)(void *user, const char *file, int flg, int mode);
@@ -161,6 +173,8 @@ typedef int (*rap_server_read)(void *user, ut8 *buf, int len);
 typedef int (*rap_server_write)(void *user, ut8 *buf, int len);
 typedef char *(*rap_server_cmd)(void *user, const char *command);
 typedef int (*rap_server_close)(void *user, int fd);
+typedef int (*rap_server_read_at)(void *user, ut64 addr, ut8 *buf, int len);
+typedef int (*rap_server_write_at)(void *user, ut64 addr, const ut8 *buf, int len);
 
 enum {
 	RAP_RMT_OPEN = 1,
@@ -170,10 +184,26 @@ enum {
 	RAP_RMT_CLOSE = 5,
 	// system was deprecated in slot 6,
 	RAP_RMT_CMD = 7,
+	// rap v2 packets: [type:1][id:4][len:4][payload:len]
+	RAP_RMT_READ_AT = 8,
+	RAP_RMT_WRITE_AT = 9,
+	RAP_RMT_HELLO = 10,
 	RAP_RMT_REPLY = 0x80,
 	RAP_RMT_MAX = 4096
 };
 
+#define RAP_V2_VERSION 2
+#define RAP_V2_HDRSZ 9
+#define RAP_V2_MAX (4 * 1024 * 1024)
+#define RAP_V2_F_LZ4 1
+
+typedef struct r_socket_rap_packet_t {
+	ut8 type;
+	ut32 id;
+	ut32 len;
+	ut8 *data;
+} RSocketRapPacket;
+
 typedef struct r_socket_rap_server_t {
 	RSocket *fd;
 	char *port;
@@ -185,6 +215,7 @@ typedef struct r_socket_rap_server_t {
 	rap_server_cmd system;
 	rap_server_cmd cmd;
 	rap_server_close close;
+	int features;	// RAP_V2_F_* negotiated with RAP_RMT_HELLO
 	void *user;	// Always first arg for callbacks
 } RSocketRapServer;
 
@@ -194,6 +225,14 @@ R_API void r_socket_rap_server_free(RSocketRapServer *rap_s);
 R_API int r_socket_rap_server_listen(RSocketRapServer *rap_s, const char *certfile);
 R_API RSocket *r_socket_rap_server_accept(RSocketRapServer *rap_s);
 R_API bool r_socket_rap_server_continue(RSocketRapServer *rap_s);
+R_API bool r_socket_rap_server_v2(RSocket *fd, ut8 type, int *features, rap_server_read_at read_at, rap_server_write_at write_at, void *user);
+
+/* rap v2 framing */
+R_API bool r_socket_rap_packet_send(RSocket *s, ut8 type, ut32 id, const ut8 *data, ut32 len);
+R_API bool r_socket_rap_packet_read(RSocket *s, RSocketRapPacket *pkt);
+R_API void r_socket_rap_packet_fini(RSocketRapPacket *pkt);
+R_API bool r_socket_rap_packet_send_data(RSocket *s, ut8 type, ut32 id, const ut8 *buf, int len, int features);
+R_API int r_socket_rap_packet_data(RSocketRapPacket *pkt, ut8 *out, int outlen);
 
 /* run.c */
 #define R_RUN_PROFILE_NARGS 512
@@ -266,6 +305,7 @@ R_API R2Pipe *r2pipe_open_corebind(RCoreBind *coreb);
 R_API R2Pipe *r2pipe_open(const char *cmd);
 R_API char *r2pipe_cmd(R2Pipe *r2pipe, const char *str);
 R_API char *r2pipe_cmdf(R2Pipe *r2pipe, const char *fmt, ...);
+R_API int r2pipe_cmd_batch(R2Pipe *r2pipe, const char **cmds, int n, char **res);
 #endif
 
 #ifdef __cplusplus
@@ -36,6 +36,14 @@
 #define R_UNUSED /* unused */
 #endif
 
+#if defined(_MSC_VER)
+#define R_TH_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define R_TH_LOCAL __thread
+#else
+#define R_TH_LOCAL
+#endif
+
 #ifdef R_NEW
 #undef R_NEW
 #endif
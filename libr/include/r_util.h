@@ -40,9 +40,11 @@ int gettimeofday (struct timeval* p, void* tz);
 #include "r_util/r_date.h"
 #include "r_util/r_debruijn.h"
 #include "r_util/r_cache.h"
+#include "r_util/r_prof.h"
 #include "r_util/r_ctypes.h"
 #include "r_util/r_file.h"
 #include "r_util/r_hex.h"
+#include "r_util/r_inflate.h"
 #include "r_util/r_log.h"
 #include "r_util/r_mem.h"
 #include "r_util/r_name.h"
@@ -0,0 +1,23 @@
+#ifndef R_INFLATE_H
+#define R_INFLATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* random access to deflated data (gzip files, zip members) without inflating
+ * all of it: checkpoints taken on a first pass let reads start decompressing
+ * near the requested offset */
+typedef struct r_inflate_index_t RInflateIndex;
+
+R_API RInflateIndex *r_inflate_index_new(const char *file, ut64 from, ut64 size, bool gzip);
+R_API RInflateIndex *r_inflate_index_load(const char *file, ut64 from, ut64 size, bool gzip, const char *path);
+R_API bool r_inflate_index_save(RInflateIndex *zi, const char *path);
+R_API void r_inflate_index_free(RInflateIndex *zi);
+R_API ut64 r_inflate_index_size(RInflateIndex *zi);
+R_API int r_inflate_index_read(RInflateIndex *zi, ut64 addr, ut8 *buf, int len);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //  R_INFLATE_H
@@ -0,0 +1,61 @@
+#ifndef R_PROF_H
+#define R_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* hot path profiler: named counters and nested timers, kept per thread.
+ * sites cost a load and a branch while it is off, build with -DR_PROF=0 to
+ * remove them completely */
+#ifndef R_PROF
+#define R_PROF 1
+#endif
+
+typedef struct r_prof_site_t {
+	const char *name;
+	bool timer;
+	int id; // assigned on first hit
+} RProfSite;
+
+typedef struct r_prof_node_t {
+	RProfSite *site;
+	struct r_prof_node_t *parent;
+	struct r_prof_node_t *child;
+	struct r_prof_node_t *next;
+	ut64 calls;
+	ut64 total; // ns
+	ut64 start;
+} RProfNode;
+
+R_API extern bool r_prof_on;
+
+R_API void r_prof_enable(bool enable);
+R_API void r_prof_reset(void);
+R_API void r_prof_thread_exit(void);
+R_API void r_prof_count(RProfSite *site);
+R_API RProfNode *r_prof_enter(RProfSite *site);
+R_API void r_prof_leave(RProfNode *node);
+R_API char *r_prof_dump(int mode);
+
+#if R_PROF
+#define R_PROF_COUNT(n) do { \
+		static RProfSite _rps = { #n, false, 0 }; \
+		if (r_prof_on) { \
+			r_prof_count (&_rps); \
+		} \
+	} while (0)
+#define R_PROF_BEGIN(n) \
+	static RProfSite _rps_##n = { #n, true, 0 }; \
+	RProfNode *_rpn_##n = r_prof_on? r_prof_enter (&_rps_##n): NULL
+#define R_PROF_END(n) if (_rpn_##n) { r_prof_leave (_rpn_##n); }
+#else
+#define R_PROF_COUNT(n)
+#define R_PROF_BEGIN(n)
+#define R_PROF_END(n)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif //  R_PROF_H
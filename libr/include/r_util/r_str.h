@@ -19,6 +19,9 @@ typedef enum {
 
 typedef int (*RStrRangeCallback) (void *, int);
 
+/* a glob compiled once by r_str_glob_new, to match it against many strings */
+typedef struct r_str_glob_t RStrGlob;
+
 static inline void r_str_rmch(char *s, char ch) {
 	for (;*s; s++) {
 		if (*s==ch) {
@@ -31,6 +34,19 @@ static inline void r_str_rmch(char *s, char ch) {
 #define R_STR_ISNOTEMPTY(x) ((x) && *(x))
 #define R_STR_DUP(x) ((x) ? strdup ((x)) : NULL)
 #define r_str_array(x,y) ((y>=0 && y<(sizeof(x)/sizeof(*x)))?x[y]:"")
+/* stack allocated, thread safe alternatives to sdb_fmt() for building keys.
+ * the strings live until the end of the enclosing block.
+ * r_strf_var declares a pointer to a buffer of the given size:
+ *   r_strf_var (key, 64, "fcn.0x%"PFMT64x, addr);
+ * r_strf_buffer sets the size of the buffers used by r_strf() in the block.
+ * every r_strf() call has a buffer of its own, several can be mixed in an
+ * expression:
+ *   r_strf_buffer (64);
+ *   sdb_set (db, r_strf ("meta.0x%"PFMT64x, addr), r_strf ("%d", n), 0); */
+#define r_strf_var(n, s, f, ...) char *n = r_strf_into ((char[s]){ 0 }, s, f, __VA_ARGS__)
+#define r_strf_buffer(s) enum { r_strf_size = (s) }
+#define r_strf(f, ...) r_strf_into ((char[r_strf_size]){ 0 }, r_strf_size, f, __VA_ARGS__)
+R_API char *r_strf_into(char *buf, size_t size, const char *fmt, ...);
 R_API const char *r_str_pad(const char ch, int len);
 R_API const char *r_str_rstr(const char *base, const char *p);
 R_API const char *r_strstr_ansi (const char *a, const char *b);
@@ -179,6 +195,9 @@ R_API void r_str_truncate_cmd(char *string);
 R_API char* r_str_replace_thunked(char *str, char *clean, int *thunk, int clen,
 				  const char *key, const char *val, int g);
 R_API bool r_str_glob(const char *str, const char *glob);
+R_API RStrGlob *r_str_glob_new(const char *glob);
+R_API bool r_str_glob_match(const RStrGlob *g, const char *str);
+R_API void r_str_glob_free(RStrGlob *g);
 R_API int r_str_binstr2bin(const char *str, ut8 *out, int outlen);
 R_API char *r_str_between(const char *str, const char *prefix, const char *suffix);
 R_API bool r_str_startswith(const char *str, const char *needle);
@@ -33,6 +33,7 @@ R_API char **r_sys_get_environ(void);
 R_API void r_sys_set_environ(char **e);
 R_API os_info *r_sys_get_osinfo();
 R_API ut64 r_sys_now(void);
+R_API ut64 r_sys_now_mono(void);
 R_API const char *r_time_to_string (ut64 ts);
 R_API int r_sys_fork(void);
 // nocleanup = false => exit(); true => _exit()
@@ -87,6 +88,8 @@ R_API bool r_sys_cmd_str_full_w32(const char *cmd, const char *input, char **out
 R_API bool r_sys_create_child_proc_w32(const char *cmdline, HANDLE in, HANDLE out, HANDLE err);
 #endif
 R_API int r_sys_truncate(const char *file, int sz);
+R_API bool r_sys_write_full(int fd, const ut8 *buf, int len);
+R_API bool r_sys_read_full(int fd, ut8 *buf, int len);
 R_API int r_sys_cmd(const char *cmd);
 R_API int r_sys_cmdbg(const char *cmd);
 R_API int r_sys_cmdf(const char *fmt, ...);
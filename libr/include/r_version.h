@@ -0,0 +1,8 @@
+#ifndef R_VERSION_H
+#define R_VERSION_H 1
+#define R2_VERSION_COMMIT 1
+#define R2_VERSION "3.6.0-git"
+#define R2_GITTAP "3.6.0-git"
+#define R2_GITTIP "c66c73519aa10660825c64949800560431f00eb7"
+#define R2_BIRTH "2026-10-19__14:48:41"
+#endif
@@ -324,6 +324,20 @@ R_API int r_io_desc_read_at(RIODesc *desc, ut64 addr, ut8 *buf, int len) {
 	return 0;
 }
 
+// Returns a pointer to the len bytes at addr in the plugin's own memory (a
+// mapped file) without copying them, or NULL when the plugin cannot provide
+// them or the caches may patch them. It is valid until the next peek, write
+// or close on desc.
+R_API const ut8 *r_io_desc_peek_at(RIODesc *desc, ut64 addr, int len) {
+	if (!desc || !desc->plugin || !desc->plugin->peek || len < 1 || !(desc->perm & R_PERM_R)) {
+		return NULL;
+	}
+	if (desc->io && (desc->io->cachemode || desc->io->p_cache)) {
+		return NULL;
+	}
+	return desc->plugin->peek (desc->io, desc, addr, len);
+}
+
 R_API int r_io_desc_write_at(RIODesc *desc, ut64 addr, const ut8 *buf, int len) {
 	if (desc && buf && (r_io_desc_seek (desc, addr, R_IO_SEEK_SET) == addr)) {
 		return r_io_desc_write (desc, buf, len);
@@ -279,12 +279,14 @@ R_API bool r_io_read_at(RIO *io, ut64 addr, ut8 *buf, int len) {
 	if (len == 0) {
 		return false;
 	}
+	R_PROF_BEGIN (r_io_read_at);
 	bool ret = (io->va)
 		? r_io_vread_at_mapped (io, addr, buf, len)
 		: r_io_pread_at (io, addr, buf, len) > 0;
 	if (io->cached & R_PERM_R) {
 		(void)r_io_cache_read (io, addr, buf, len);
 	}
+	R_PROF_END (r_io_read_at);
 	return ret;
 }
 
@@ -309,6 +311,49 @@ R_API bool r_io_read_at_mapped(RIO *io, ut64 addr, ut8 *buf, int len) {
 	return ret;
 }
 
+// Zero-copy read: returns a borrowed pointer to the len bytes at addr when
+// they come contiguous from a single map of a plugin that keeps them in
+// memory and nothing in the write cache covers them; NULL otherwise, then
+// use r_io_read_at. The pointer stays valid across reads, until the next
+// peek, write or close on the same file.
+R_API const ut8 *r_io_peek_at(RIO *io, ut64 addr, int len) {
+	r_return_val_if_fail (io && len >= 0, NULL);
+	if (!len || addr + len - 1 < addr) {
+		return NULL;
+	}
+	if (io->cached & R_PERM_R) {
+		RIOCache *c;
+		RListIter *iter;
+		RInterval range = (RInterval){ addr, len };
+		r_list_foreach (io->cache, iter, c) {
+			if (r_itv_overlap (c->itv, range)) {
+				return NULL;
+			}
+		}
+	}
+	if (!io->va) {
+		return r_io_desc_peek_at (io->desc, addr, len);
+	}
+	const RPVector *skyline = &io->map_skyline;
+	size_t i;
+#define CMP(addr, part) ((addr) < r_itv_end (((RIOMapSkyline *)(part))->itv) - 1 ? -1 : \
+			(addr) > r_itv_end (((RIOMapSkyline *)(part))->itv) - 1 ? 1 : 0)
+	r_pvector_lower_bound (skyline, addr, i, CMP);
+#undef CMP
+	if (i == r_pvector_len (skyline)) {
+		return NULL;
+	}
+	const RIOMapSkyline *part = r_pvector_at (skyline, i);
+	if (addr < part->itv.addr || addr + len - 1 > r_itv_end (part->itv) - 1) {
+		return NULL;
+	}
+	if (!(part->map->perm & R_PERM_R)) {
+		return NULL;
+	}
+	RIODesc *desc = r_io_desc_get (io, part->map->fd);
+	return r_io_desc_peek_at (desc, part->map->delta + addr - part->map->itv.addr, len);
+}
+
 // For both virtual and physical mode, returns the number of bytes of read
 // prefix.
 // Returns -1 on error.
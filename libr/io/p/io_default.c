@@ -4,6 +4,24 @@
 #include <r_io.h>
 #include <r_lib.h>
 #include <stdio.h>
+#if __UNIX__
+#include <sys/mman.h>
+#define USE_MMAP_WINDOW 1
+#else
+#define USE_MMAP_WINDOW 0
+#endif
+
+/* files too big to be mapped whole are read through a window of this size
+ * which slides over them, aligned to R_IO_MMAP_ALIGN */
+#define R_IO_MMAP_WINDOW (64 * 1024 * 1024)
+#define R_IO_MMAP_ALIGN 0x10000
+
+typedef struct r_io_mmap_window_t {
+	ut8 *buf;
+	ut64 addr;
+	ut64 size;
+	ut64 next; // end of the last access, to spot sequential scans
+} RIOMMapWindow;
 
 typedef struct r_io_mmo_t {
 	char * filename;
@@ -16,6 +34,9 @@ typedef struct r_io_mmo_t {
 	RBuffer *buf;
 	RIO * io_backref;
 	int rawio;
+	/* windows over huge files (rawio): one for reads and one pinned by the
+	 * last peek, so reads never unmap a pointer handed out by peek */
+	RIOMMapWindow win[2];
 } RIOMMapFileObj;
 
 static int __io_posix_open(const char *file, int perm, int mode) {
@@ -50,7 +71,8 @@ static ut64 r_io_def_mmap_seek(RIO *io, RIOMMapFileObj *mmo, ut64 offset, int wh
 		return UT64_MAX;
 	}
 	if (mmo->rawio) {
-		return lseek (mmo->fd, offset, whence);
+		io->off = lseek (mmo->fd, offset, whence);
+		return io->off;
 	}
 	if (!mmo->buf) {
 		return UT64_MAX;
@@ -60,6 +82,67 @@ static ut64 r_io_def_mmap_seek(RIO *io, RIOMMapFileObj *mmo, ut64 offset, int wh
 	return io->off;
 }
 
+static void r_io_def_mmap_unmap_window(RIOMMapWindow *w) {
+#if USE_MMAP_WINDOW
+	if (w->buf) {
+		munmap (w->buf, w->size);
+	}
+#endif
+	memset (w, 0, sizeof (RIOMMapWindow));
+}
+
+static void r_io_def_mmap_unmap_windows(RIOMMapFileObj *mmo) {
+	r_io_def_mmap_unmap_window (&mmo->win[0]);
+	r_io_def_mmap_unmap_window (&mmo->win[1]);
+}
+
+static inline bool window_has(RIOMMapWindow *w, ut64 addr, int len) {
+	return w->buf && addr >= w->addr && addr + len <= w->addr + w->size;
+}
+
+/* returns a pointer to the len bytes at addr of a huge file, sliding w over
+ * them if needed. NULL if the range is past the end of the file or too big
+ * for a window, callers must use read() then */
+static const ut8 *r_io_def_mmap_window(RIOMMapFileObj *mmo, RIOMMapWindow *w, ut64 addr, int len) {
+#if USE_MMAP_WINDOW
+	if (mmo->nocache || len < 1 || addr + len < addr) {
+		return NULL;
+	}
+	if (window_has (w, addr, len)) {
+		w->next = addr + len;
+		return w->buf + (addr - w->addr);
+	}
+	if (len > R_IO_MMAP_WINDOW / 2) {
+		return NULL;
+	}
+	struct stat st;
+	if (fstat (mmo->fd, &st) == -1 || addr + len > (ut64)st.st_size) {
+		return NULL;
+	}
+	const bool sequential = w->buf && addr == w->next;
+	r_io_def_mmap_unmap_window (w);
+	ut64 base = addr & ~(ut64)(R_IO_MMAP_ALIGN - 1);
+	ut64 size = R_MIN (R_IO_MMAP_WINDOW, (ut64)st.st_size - base);
+	void *buf = mmap (NULL, size, PROT_READ, MAP_SHARED, mmo->fd, (off_t)base);
+	if (buf == MAP_FAILED) {
+		return NULL;
+	}
+#ifdef MADV_SEQUENTIAL
+	if (sequential) {
+		// scanning forward, ask for aggressive readahead
+		(void)madvise (buf, size, MADV_SEQUENTIAL);
+	}
+#endif
+	w->buf = buf;
+	w->addr = base;
+	w->size = size;
+	w->next = addr + len;
+	return w->buf + (addr - base);
+#else
+	return NULL;
+#endif
+}
+
 static int r_io_def_mmap_refresh_def_mmap_buf(RIOMMapFileObj *mmo) {
 	RIO* io = mmo->io_backref;
 	ut64 cur;
@@ -70,9 +153,10 @@ static int r_io_def_mmap_refresh_def_mmap_buf(RIOMMapFileObj *mmo) {
 	} else {
 		cur = 0;
 	}
+	r_io_def_mmap_unmap_windows (mmo);
 	st64 sz = r_file_size (mmo->filename);
 	if (sz > ST32_MAX) {
-		// Do not use mmap if the file is huge
+		// Do not map the whole file if it is huge, read it through windows
 		mmo->rawio = 1;
 	}
 	if (mmo->rawio) {
@@ -102,6 +186,7 @@ static int r_io_def_mmap_refresh_def_mmap_buf(RIOMMapFileObj *mmo) {
 }
 
 static void r_io_def_mmap_free (RIOMMapFileObj *mmo) {
+	r_io_def_mmap_unmap_windows (mmo);
 	free (mmo->filename);
 	r_buf_free (mmo->buf);
 	close (mmo->fd);
@@ -214,6 +299,13 @@ static int r_io_def_mmap_read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
 			free (a_buf);
 			return count;
 		}
+		RIOMMapWindow *w = window_has (&mmo->win[1], io->off, count)? &mmo->win[1]: &mmo->win[0];
+		const ut8 *p = r_io_def_mmap_window (mmo, w, io->off, count);
+		if (p) {
+			memcpy (buf, p, count);
+			io->off += count;
+			return count;
+		}
 		if (lseek (mmo->fd, io->off, SEEK_SET) < 0) {
 			return -1;
 		}
@@ -230,6 +322,19 @@ static int r_io_def_mmap_read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
 	return r;
 }
 
+static const ut8 *r_io_def_mmap_peek(RIODesc *fd, ut64 addr, int count) {
+	RIOMMapFileObj *mmo = fd->data;
+	if (mmo->rawio) {
+		return fd->obsz? NULL: r_io_def_mmap_window (mmo, &mmo->win[1], addr, count);
+	}
+	ut64 size = 0;
+	const ut8 *data = mmo->buf? r_buf_data (mmo->buf, &size): NULL;
+	if (!data || addr + count < addr || addr + count > size) {
+		return NULL;
+	}
+	return data + addr;
+}
+
 static int r_io_def_mmap_write(RIO *io, RIODesc *fd, const ut8 *buf, int count) {
 	int len = -1;
 	ut64 addr = io->off;
@@ -358,6 +463,11 @@ static int __write(RIO *io, RIODesc *fd, const ut8 *buf, int len) {
 	return r_io_def_mmap_write(io, fd, buf, len);
 }
 
+static const ut8 *__peek(RIO *io, RIODesc *fd, ut64 addr, int len) {
+	r_return_val_if_fail (io && fd && fd->data, NULL);
+	return r_io_def_mmap_peek (fd, addr, len);
+}
+
 static ut64 __lseek(RIO *io, RIODesc *fd, ut64 offset, int whence) {
 	return r_io_def_mmap_lseek (io, fd, offset, whence);
 }
@@ -399,6 +509,7 @@ RIOPlugin r_io_plugin_default = {
 	.open = __open_default,
 	.close = __close,
 	.read = __read,
+	.peek = __peek,
 	.check = __plugin_open_default,
 	.lseek = __lseek,
 	.write = __write,
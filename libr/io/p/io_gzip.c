@@ -1,4 +1,4 @@
-/* radare - LGPL - Copyright 2008-2017 - pancake */
+/* radare - LGPL - Copyright 2008-2019 - pancake */
 
 #include "r_io.h"
 #include "r_lib.h"
@@ -6,101 +6,78 @@
 #include <stdlib.h>
 #include <sys/types.h>
 
+/* the file is not inflated at open, reads go through an index of checkpoints
+ * which is kept in a .r2zi file (see io.gzip.index) so later opens skip the
+ * first pass. writes are kept in memory on top of the inflated data */
+
 typedef struct {
-	ut8 *buf;
-	ut32 size;
+	RInflateIndex *zi;
+	ut64 size;
+	ut64 end; // inflated bytes left after shrinking, the rest reads as 0
 	ut64 offset;
+	RBuffer *patches; // sparse, only the written bytes
 } RIOGzip;
 
-static inline ut32 _io_malloc_sz(RIODesc *desc) {
-	if (!desc) {
-		return 0;
-	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	return mal? mal->size: 0;
-}
-
-static inline void _io_malloc_set_sz(RIODesc *desc, ut32 sz) {
-	if (!desc) {
-		return;
-	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	if (mal) {
-		mal->size = sz;
-	}
-}
-
-static inline ut8* _io_malloc_buf(RIODesc *desc) {
-	if (!desc) {
-		return NULL;
-	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	return mal->buf;
-}
-
-
-static inline ut8* _io_malloc_set_buf(RIODesc *desc, ut8* buf) {
-	if (!desc) {
-		return NULL;
+static int __write(RIO *io, RIODesc *fd, const ut8 *buf, int count) {
+	if (!fd || !buf || count < 0 || !fd->data) {
+		return -1;
 	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	return mal->buf = buf;
-}
-
-static inline ut64 _io_malloc_off(RIODesc *desc) {
-	if (!desc) {
-		return 0;
+	RIOGzip *gz = fd->data;
+	if (gz->offset > gz->size) {
+		return -1;
 	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	return mal->offset;
-}
-
-static inline void _io_malloc_set_off(RIODesc *desc, ut64 off) {
-	if (!desc) {
-		return;
+	if (gz->offset + count > gz->size) {
+		count = gz->size - gz->offset;
 	}
-	RIOGzip *mal = (RIOGzip*)desc->data;
-	mal->offset = off;
-}
-
-static int __write(RIO *io, RIODesc *fd, const ut8 *buf, int count) {
-	if (!fd || !buf || count < 0 || !fd->data) {
+	if (count < 1) {
 		return -1;
 	}
-	if (_io_malloc_off (fd) > _io_malloc_sz (fd)) {
+	if (r_buf_write_at (gz->patches, gz->offset, buf, count) != count) {
 		return -1;
 	}
-	if (_io_malloc_off (fd) + count > _io_malloc_sz (fd)) {
-		count -= (_io_malloc_off (fd) + count -_io_malloc_sz (fd));
+	gz->offset += count;
+	return count;
+}
+
+/* drop the written bytes past size */
+static bool patches_trim(RIOGzip *gz, ut64 size) {
+	RBuffer *b = r_buf_new_sparse (0);
+	RList *chunks = r_buf_nonempty_list (gz->patches);
+	RBufferSparse *c;
+	RListIter *iter;
+	bool ret = b && chunks;
+	if (ret) {
+		r_list_foreach (chunks, iter, c) {
+			if (c->from >= size) {
+				break;
+			}
+			ut64 len = R_MIN (c->to, size) - c->from;
+			if (r_buf_write_at (b, c->from, c->data, len) != len) {
+				ret = false;
+				break;
+			}
+		}
 	}
-	if (count > 0) {
-		memcpy (_io_malloc_buf (fd) + _io_malloc_off (fd), buf, count);
-		_io_malloc_set_off (fd, _io_malloc_off (fd) + count);
-		return count;
+	r_list_free (chunks);
+	if (!ret) {
+		r_buf_free (b);
+		return false;
 	}
-	return -1;
+	r_buf_free (gz->patches);
+	gz->patches = b;
+	return true;
 }
 
 static bool __resize(RIO *io, RIODesc *fd, ut64 count) {
-	ut8 * new_buf = NULL;
 	if (!fd || !fd->data || count == 0) {
 		return false;
 	}
-	ut32 mallocsz = _io_malloc_sz (fd);
-	if (_io_malloc_off (fd) > mallocsz) {
+	RIOGzip *gz = fd->data;
+	if (count < r_buf_size (gz->patches) && !patches_trim (gz, count)) {
 		return false;
 	}
-	new_buf = malloc (count);
-	if (!new_buf) {
-		return -1;
-	}
-	memcpy (new_buf, _io_malloc_buf (fd), R_MIN (count, mallocsz));
-	if (count > mallocsz) {
-		memset (new_buf + mallocsz, 0, count - mallocsz);
-	}
-	free (_io_malloc_buf (fd));
-	_io_malloc_set_buf (fd, new_buf);
-	_io_malloc_set_sz (fd, count);
+	gz->end = R_MIN (gz->end, count);
+	gz->size = count;
 	return true;
 }
 
@@ -109,26 +86,51 @@ static int __read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
 	if (!fd || !fd->data) {
 		return -1;
 	}
-	ut32 mallocsz = _io_malloc_sz (fd);
-	if (_io_malloc_off (fd) > mallocsz) {
+	RIOGzip *gz = fd->data;
+	if (gz->offset > gz->size) {
 		return -1;
 	}
-	if (_io_malloc_off (fd) + count >= mallocsz) {
-		count = mallocsz - _io_malloc_off (fd);
+	if (gz->offset + count >= gz->size) {
+		count = gz->size - gz->offset;
+	}
+	int n = gz->offset < gz->end? R_MIN (count, gz->end - gz->offset): 0;
+	if (n > 0) {
+		n = r_inflate_index_read (gz->zi, gz->offset, buf, n);
+	}
+	if (n < count) {
+		// past the inflated data after a resize
+		memset (buf + R_MAX (n, 0), 0, count - R_MAX (n, 0));
+	}
+	if (r_buf_size (gz->patches) > gz->offset) {
+		RList *chunks = r_buf_nonempty_list (gz->patches);
+		RBufferSparse *c;
+		RListIter *iter;
+		r_list_foreach (chunks, iter, c) {
+			if (c->from >= gz->offset + count) {
+				break;
+			}
+			if (c->to > gz->offset) {
+				ut64 from = R_MAX (c->from, gz->offset);
+				ut64 to = R_MIN (c->to, gz->offset + count);
+				memcpy (buf + (from - gz->offset), c->data + (from - c->from), to - from);
+			}
+		}
+		r_list_free (chunks);
 	}
-	memcpy (buf, _io_malloc_buf (fd) + _io_malloc_off (fd), count);
 	return count;
 }
 
 static int __close(RIODesc *fd) {
-	RIOGzip *riom;
 	if (!fd || !fd->data) {
 		return -1;
 	}
-	riom = fd->data;
-	R_FREE (riom->buf);
+	RIOGzip *gz = fd->data;
+	if (r_buf_size (gz->patches)) {
+		eprintf ("TODO: Writing changes into gzipped files is not yet supported\n");
+	}
+	r_inflate_index_free (gz->zi);
+	r_buf_free (gz->patches);
 	R_FREE (fd->data);
-	eprintf ("TODO: Writing changes into gzipped files is not yet supported\n");
 	return 0;
 }
 
@@ -137,42 +139,78 @@ static ut64 __lseek(RIO* io, RIODesc *fd, ut64 offset, int whence) {
 	if (!fd || !fd->data) {
 		return offset;
 	}
-	ut32 mallocsz = _io_malloc_sz (fd);
+	RIOGzip *gz = fd->data;
 	switch (whence) {
 	case SEEK_SET:
-		r_offset = (offset <= mallocsz) ? offset : mallocsz;
+		r_offset = (offset <= gz->size) ? offset : gz->size;
 		break;
 	case SEEK_CUR:
-		r_offset = (_io_malloc_off (fd) + offset <= mallocsz ) ? _io_malloc_off (fd) + offset : mallocsz;
+		r_offset = (gz->offset + offset <= gz->size) ? gz->offset + offset : gz->size;
 		break;
 	case SEEK_END:
-		r_offset = _io_malloc_sz (fd);
+		r_offset = gz->size;
 		break;
 	}
-	_io_malloc_set_off (fd, r_offset);
+	gz->offset = r_offset;
 	return r_offset;
 }
 
+/* where io.gzip.index says to keep the index of file, NULL for nowhere:
+ * "cache" in the radare2 cache directory, "file" next to it */
+static char *index_path(RIO *io, const char *file) {
+	char *path = NULL;
+	switch (io->gzip_index) {
+	case R_IO_GZIP_INDEX_FILE:
+		path = r_str_newf ("%s.r2zi", file);
+		break;
+	case R_IO_GZIP_INDEX_CACHE: {
+		char *abs = r_file_abspath (file);
+		char *dir = r_str_home (R_JOIN_2_PATHS (R2_HOME_CACHEDIR, "gzip"));
+		if (abs && dir && r_sys_mkdirp (dir)) {
+			// the hash of the full path keeps files with the same name apart
+			path = r_str_newf ("%s" R_SYS_DIR "%s-%08x.r2zi", dir, r_file_basename (abs), sdb_hash (abs));
+		}
+		free (abs);
+		free (dir);
+		break;
+	}
+	}
+	return path;
+}
+
 static bool __plugin_open(RIO *io, const char *pathname, bool many) {
 	return (!strncmp (pathname, "gzip://", 7));
 }
 
 static RIODesc *__open(RIO *io, const char *pathname, int rw, int mode) {
 	if (__plugin_open (io, pathname, 0)) {
-		RIOGzip *mal = R_NEW0 (RIOGzip);
-		if (!mal) {
+		const char *file = pathname + 7;
+		RIOGzip *gz = R_NEW0 (RIOGzip);
+		if (!gz) {
 			return NULL;
 		}
-		int len;
-		ut8 *data = (ut8*)r_file_slurp (pathname+7, &len);	//memleak here?
-		int *size = (int*)&mal->size;
-		mal->buf = r_inflate (data, len, NULL, size);
-		if (mal->buf) {
-			return r_io_desc_new (io, &r_io_plugin_gzip, pathname, rw, mode, mal);
+		char *cache = index_path (io, file);
+		gz->zi = cache? r_inflate_index_load (file, 0, 0, true, cache): NULL;
+		if (!gz->zi) {
+			gz->zi = r_inflate_index_new (file, 0, 0, true);
+			if (gz->zi && cache) {
+				// best effort, the directory may be read-only
+				(void)r_inflate_index_save (gz->zi, cache);
+			}
+		}
+		free (cache);
+		if (gz->zi) {
+			gz->size = gz->end = r_inflate_index_size (gz->zi);
+			gz->patches = r_buf_new_sparse (0);
+			if (!gz->patches) {
+				r_inflate_index_free (gz->zi);
+				free (gz);
+				return NULL;
+			}
+			return r_io_desc_new (io, &r_io_plugin_gzip, pathname, rw, mode, gz);
 		}
-		free (data);
-		eprintf ("Cannot allocate (%s) %d byte(s)\n", pathname+9, mal->size);
-		free (mal);
+		eprintf ("Cannot inflate (%s)\n", file);
+		free (gz);
 	}
 	return NULL;
 }
@@ -67,49 +67,34 @@ static int __write(RIO *io, RIODesc *fd, const ut8 *buf, int count) {
 	}
 
 	/* disk write : process each sparse chunk */
-	//TODO : sort addresses + check overlap?
+	// chunks come sorted and coalesced, so they may span many 64k
+	// segments: emit them one segment (and one fwblock) at a time, with
+	// a 04 record only when the upper 16 bits of the address change
 	RList *nonempty = r_buf_nonempty_list (rih->rbuf);
+	ut32 upper = UT32_MAX;
 	r_list_foreach (nonempty, iter, rbs) {
-		ut16 addl0 = rbs->from & 0xffff;
-		ut16 addh0 = rbs->from >> 16;
-		ut16 addh1 = rbs->to >> 16;
-		ut16 tsiz =0;
-		if (rbs->size == 0) {
-			continue;
-		}
-
-		if (addh0 != addh1) {
-			//we cross a 64k boundary, so write in two steps
+		ut64 addr = rbs->from;
+		while (addr < rbs->to) {
+			ut64 seg_end = R_MIN (rbs->to, (addr | 0xffff) + 1);
+			ut16 tsiz = R_MIN (seg_end - addr, 0x8000);
 			//04 record (ext address)
-			if (fw04b (out, addh0) < 0) {
-				eprintf("ihex:write: file error\n");
-				r_list_free (nonempty);
-				fclose (out);
-				return -1;
+			if ((addr >> 16) != upper) {
+				upper = addr >> 16;
+				if (fw04b (out, upper) < 0) {
+					eprintf ("ihex:write: file error\n");
+					r_list_free (nonempty);
+					fclose (out);
+					return -1;
+				}
 			}
 			//00 records (data)
-			tsiz = -addl0;
-			addl0 = 0;
-			if (fwblock (out, rbs->data, rbs->from, tsiz)) {
+			if (fwblock (out, rbs->data + (addr - rbs->from), addr, tsiz)) {
 				eprintf ("ihex:fwblock error\n");
 				r_list_free (nonempty);
 				fclose (out);
 				return -1;
 			}
-		}
-		//04 record (ext address)
-		if (fw04b (out, addh1) < 0) {
-			eprintf ("ihex:write: file error\n");
-			r_list_free (nonempty);
-			fclose (out);
-			return -1;
-		}
-		//00 records (remaining data)
-		if (fwblock (out, rbs->data + tsiz, (addh1 << 16) | addl0, rbs->size - tsiz)) {
-			eprintf ("ihex:fwblock error\n");
-			r_list_free (nonempty);
-			fclose (out);
-			return -1;
+			addr += tsiz;
 		}
 	}	//list_foreach
 
@@ -117,15 +102,15 @@ static int __write(RIO *io, RIODesc *fd, const ut8 *buf, int count) {
 	fprintf (out, ":00000001FF\n");
 	fclose (out);
 	out = NULL;
-	return 0;
+	return count;
 }
 
 //write contiguous block of data to file; ret 0 if ok
-//max 65535 bytes; assumes a 04 rec was written before
+//max 65535 bytes, must not cross a 64k boundary; assumes a 04 rec was written before
 static int fwblock(FILE *fd, ut8 *b, ut32 start_addr, ut16 size) {
 	ut8 cks;
 	char linebuf[80];
-	ut16 last_addr;
+	ut16 addr;
 	int j;
 	ut32 i;	//has to be bigger than size !
 
@@ -134,43 +119,37 @@ static int fwblock(FILE *fd, ut8 *b, ut32 start_addr, ut16 size) {
 	}
 
 	for (i = 0; (i + 0x10) < size; i += 0x10) {
+		addr = start_addr + i;
 		cks = 0x10;
-		cks += (i + start_addr) >> 8;
-		cks += (i + start_addr);
+		cks += addr >> 8;
+		cks += addr;
 		for (j = 0; j < 0x10; j++) {
 			cks += b[j];
 		}
 		cks = 0 - cks;
 		if (fprintf (fd, ":10%04x00%02x%02x%02x%02x%02x%02x%02x"
 				 "%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x\n",
-			    (i + start_addr) & 0xffff, b[0], b[1], b[2], b[3], b[4], b[5], b[6],
+			    addr, b[0], b[1], b[2], b[3], b[4], b[5], b[6],
 			    b[7], b[8], b[9], b[10], b[11], b[12], b[13],
 			    b[14], b[15], cks) < 0) {
 			return -1;
 		}
-		start_addr += 0x10;
 		b += 0x10;
-		if ((start_addr & 0xffff) < 0x10) {
-			//addr rollover: write ext address record
-			if (fw04b (fd, start_addr >> 16) < 0) {
-				return -1;
-			}
-		}
 	}
 	if (i == size) {
 		return 0;
 	}
 	//write crumbs
-	last_addr = i+start_addr;
-	cks = -last_addr;
-	cks -= last_addr>>8;
-	for (j=0;i<size; i++, j++) {
+	addr = start_addr + i;
+	cks = -addr;
+	cks -= addr >> 8;
+	for (j = 0; i < size; i++, j++) {
 		cks -= b[j];
-		sprintf(linebuf+(2*j), "%02X", b[j]);
+		sprintf (linebuf + (2 * j), "%02X", b[j]);
 	}
 	cks -= j;
 
-	if (fprintf (fd, ":%02X%04X00%.*s%02X\n", j, last_addr, 2 * j, linebuf, cks) < 0) {
+	if (fprintf (fd, ":%02X%04X00%.*s%02X\n", j, addr, 2 * j, linebuf, cks) < 0) {
 		return -1;
 	}
 	return 0;
@@ -11,6 +11,107 @@
 #define RIORAP_IS_LISTEN(x) (((RIORap*)((x)->data))->listener)
 #define RIORAP_IS_VALID(x) ((x) && ((x)->data) && ((x)->plugin == &r_io_plugin_rap))
 
+#define RAP_V2_CHUNK (1024 * 1024)
+#define RAP_V2_WINDOW 8
+
+static bool rap_v2_reply(RSocket *s, ut8 type, RSocketRapPacket *pkt) {
+	if (r_socket_read_block (s, &pkt->type, 1) != 1) {
+		return false;
+	}
+	if (pkt->type != (type | RMT_REPLY)) {
+		eprintf ("rap: unexpected reply 0x%02x\n", pkt->type);
+		return false;
+	}
+	return r_socket_rap_packet_read (s, pkt);
+}
+
+// keep up to RAP_V2_WINDOW chunk requests in flight and match replies by id
+static int rap_v2_read(RIORap *rap, ut8 *buf, int count) {
+	RSocket *s = rap->client;
+	const int nchunks = (count + RAP_V2_CHUNK - 1) / RAP_V2_CHUNK;
+	const ut32 base = rap->id;
+	int sent = 0, recv = 0, total = 0;
+	ut8 req[12];
+
+	rap->id += nchunks;
+	while (recv < nchunks) {
+		for (; sent < nchunks && sent - recv < RAP_V2_WINDOW; sent++) {
+			int off = sent * RAP_V2_CHUNK;
+			r_write_be64 (req, rap->offset + off);
+			r_write_be32 (req + 8, R_MIN (RAP_V2_CHUNK, count - off));
+			if (!r_socket_rap_packet_send (s, RMT_READ_AT, base + sent, req, sizeof (req))) {
+				return -1;
+			}
+		}
+		RSocketRapPacket pkt = {0};
+		if (!rap_v2_reply (s, RMT_READ_AT, &pkt)) {
+			r_socket_rap_packet_fini (&pkt);
+			return -1;
+		}
+		ut32 idx = pkt.id - base;
+		if (idx < (ut32)sent) {
+			int off = idx * RAP_V2_CHUNK;
+			int n = r_socket_rap_packet_data (&pkt, buf + off, R_MIN (RAP_V2_CHUNK, count - off));
+			if (n > 0) {
+				total += n;
+			}
+		}
+		r_socket_rap_packet_fini (&pkt);
+		recv++;
+	}
+	rap->offset += count;
+	return total;
+}
+
+static int rap_v2_write(RIORap *rap, const ut8 *buf, int count) {
+	RSocket *s = rap->client;
+	const int nchunks = (count + RAP_V2_CHUNK - 1) / RAP_V2_CHUNK;
+	int i, total = 0;
+	ut8 *req = malloc (R_MIN (RAP_V2_CHUNK, count) + 8);
+	if (!req) {
+		return -1;
+	}
+	for (i = 0; i < nchunks; i++) {
+		int off = i * RAP_V2_CHUNK;
+		int len = R_MIN (RAP_V2_CHUNK, count - off);
+		r_write_be64 (req, rap->offset + off);
+		memcpy (req + 8, buf + off, len);
+		if (!r_socket_rap_packet_send (s, RMT_WRITE_AT, rap->id + i, req, len + 8)) {
+			free (req);
+			return -1;
+		}
+	}
+	free (req);
+	for (i = 0; i < nchunks; i++) {
+		RSocketRapPacket pkt = {0};
+		if (!rap_v2_reply (s, RMT_WRITE_AT, &pkt)) {
+			r_socket_rap_packet_fini (&pkt);
+			return -1;
+		}
+		if (pkt.len >= 4) {
+			total += r_read_be32 (pkt.data);
+		}
+		r_socket_rap_packet_fini (&pkt);
+	}
+	rap->id += nchunks;
+	rap->offset += count;
+	return total? total: -1;
+}
+
+static bool rap_v2_hello(RIORap *rap) {
+	ut8 req[2] = { RAP_V2_VERSION, RAP_V2_F_LZ4 };
+	RSocketRapPacket pkt = {0};
+	if (!r_socket_rap_packet_send (rap->client, RMT_HELLO, rap->id++, req, sizeof (req))
+			|| !rap_v2_reply (rap->client, RMT_HELLO, &pkt) || pkt.len < 2) {
+		r_socket_rap_packet_fini (&pkt);
+		return false;
+	}
+	rap->version = pkt.data[0];
+	rap->features = pkt.data[1];
+	r_socket_rap_packet_fini (&pkt);
+	return rap->version >= RAP_V2_VERSION;
+}
+
 static int __rap_write(RIO *io, RIODesc *fd, const ut8 *buf, int count) {
 	RSocket *s = RIORAP_FD (fd);
 	ut8 *tmp;
@@ -19,6 +120,9 @@ static int __rap_write(RIO *io, RIODesc *fd, const ut8 *buf, int count) {
 	if (count < 1) {
 		return count;
 	}
+	if (((RIORap *)fd->data)->version >= RAP_V2_VERSION) {
+		return rap_v2_write (fd->data, buf, count);
+	}
 	// TOOD: if count > RMT_MAX iterate !
 	if (count > RMT_MAX) {
 		count = RMT_MAX;
@@ -60,6 +164,9 @@ static int __rap_read(RIO *io, RIODesc *fd, ut8 *buf, int count) {
 	int ret, i = (int)count;
 	ut8 tmp[5];
 
+	if (count > 0 && ((RIORap *)fd->data)->version >= RAP_V2_VERSION) {
+		return rap_v2_read (fd->data, buf, count);
+	}
 	// XXX. if count is > RMT_MAX, just perform multiple queries
 	if (count > RMT_MAX) {
 		count = RMT_MAX;
@@ -109,7 +216,17 @@ static int __rap_close(RIODesc *fd) {
 
 static ut64 __rap_lseek(RIO *io, RIODesc *fd, ut64 offset, int whence) {
 	RSocket *s = RIORAP_FD (fd);
+	RIORap *rap = fd->data;
 	ut8 tmp[10];
+	if (rap->version >= RAP_V2_VERSION) {
+		// reads and writes carry the address, only SEEK_END needs a round trip
+		switch (whence) {
+		case R_IO_SEEK_SET:
+			return rap->offset = offset;
+		case R_IO_SEEK_CUR:
+			return rap->offset += offset;
+		}
+	}
 	tmp[0] = RMT_SEEK;
 	tmp[1] = (ut8)whence;
 	r_write_be64 (tmp + 2, offset);
@@ -122,11 +239,30 @@ static ut64 __rap_lseek(RIO *io, RIODesc *fd, ut64 offset, int whence) {
 		eprintf ("Unexpected lseek reply\n");
 		return -1;
 	}
-	return r_read_at_be64 (tmp, 1);
+	return rap->offset = r_read_at_be64 (tmp, 1);
+}
+
+// returns the length of the rap://, raps://, rap2:// or raps2:// prefix
+static int rap_uri_prefix(const char *pathname, bool *is_ssl, bool *is_v2) {
+	const char *p = pathname;
+	if (!r_str_startswith (p, "rap")) {
+		return 0;
+	}
+	p += 3;
+	*is_ssl = (*p == 's');
+	if (*is_ssl) {
+		p++;
+	}
+	*is_v2 = (*p == '2');
+	if (*is_v2) {
+		p++;
+	}
+	return r_str_startswith (p, "://")? (int)(p - pathname) + 3: 0;
 }
 
 static bool __rap_plugin_open(RIO *io, const char *pathname, bool many) {
-	return r_str_startswith (pathname, "rap://") || r_str_startswith (pathname, "raps://");
+	bool is_ssl, is_v2;
+	return rap_uri_prefix (pathname, &is_ssl, &is_v2) > 0;
 }
 
 static RIODesc *__rap_open(RIO *io, const char *pathname, int rw, int mode) {
@@ -137,11 +273,12 @@ static RIODesc *__rap_open(RIO *io, const char *pathname, int rw, int mode) {
 	char buf[1024];
 	RIORap *rior;
 
-	if (!__rap_plugin_open (io, pathname, 0)) {
+	bool is_ssl, is_v2;
+	int plen = rap_uri_prefix (pathname, &is_ssl, &is_v2);
+	if (!plen) {
 		return NULL;
 	}
-	bool is_ssl = (!strncmp (pathname, "raps://", 7));
-	ptr = pathname + (is_ssl? 7: 6);
+	ptr = pathname + plen;
 	if (!(port = strchr (ptr, ':'))) {
 		eprintf ("rap: wrong uri\n");
 		return NULL;
@@ -212,6 +349,12 @@ static RIODesc *__rap_open(RIO *io, const char *pathname, int rw, int mode) {
 	}
 	rior->listener = false;
 	rior->client = rior->fd = rap_fd;
+	if (is_v2 && !rap_v2_hello (rior)) {
+		eprintf ("rap: the server does not speak rap v2\n");
+		r_socket_free (rap_fd);
+		free (rior);
+		return NULL;
+	}
 	if (file && *file) {
 		// send
 		buf[0] = RMT_OPEN;
@@ -375,7 +518,7 @@ static char *__rap_system(RIO *io, RIODesc *fd, const char *command) {
 RIOPlugin r_io_plugin_rap = {
 	.name = "rap",
 	.desc = "Remote binary protocol plugin",
-	.uris = "rap://,raps://",
+	.uris = "rap://,raps://,rap2://,raps2://",
 	.license = "MIT",
 	.listener = __rap_listener,
 	.open = __rap_open,
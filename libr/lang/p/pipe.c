@@ -119,6 +119,87 @@ static void env(const char *s, int f) {
 }
 #endif
 
+#if __UNIX__
+/* serve R2PIPE_FRAME_CMD packets until the input is drained. replies are
+ * written in order and coalesced while more requests are already buffered */
+static bool lang_pipe_frames(RLang *lang, int wfd, int rfd, const char *data, int len) {
+	RStrBuf *in = r_strbuf_new (NULL);
+	RStrBuf *out = r_strbuf_new (NULL);
+	ut8 hdr[R2PIPE_FRAME_HDRSZ];
+	bool ok = true;
+	int pos = 0;
+	r_strbuf_append_n (in, data, len);
+	while (ok) {
+		for (;;) {
+			const ut8 *b = (const ut8 *)r_strbuf_get (in) + pos;
+			int avail = r_strbuf_length (in) - pos;
+			if (avail < R2PIPE_FRAME_HDRSZ) {
+				break;
+			}
+			if (b[0] != R2PIPE_FRAME_CMD) {
+				eprintf ("r_lang_pipe: invalid frame 0x%02x\n", b[0]);
+				ok = false;
+				break;
+			}
+			ut32 clen = r_read_be32 (b + 5);
+			if ((ut32)(avail - R2PIPE_FRAME_HDRSZ) < clen) {
+				break;
+			}
+			char *cmd = r_str_ndup ((const char *)b + R2PIPE_FRAME_HDRSZ, clen);
+			char *res = lang->cmd_str ((RCore*)lang->user, cmd);
+			int rlen = res? strlen (res): 0;
+			hdr[0] = R2PIPE_FRAME_REPLY;
+			memcpy (hdr + 1, b + 1, 4);
+			r_write_be32 (hdr + 5, rlen);
+			r_strbuf_append_n (out, (const char *)hdr, sizeof (hdr));
+			r_strbuf_append_n (out, r_str_get (res), rlen);
+			free (res);
+			free (cmd);
+			pos += R2PIPE_FRAME_HDRSZ + clen;
+			if (r_strbuf_length (out) >= R2PIPE_FRAME_BATCH) {
+				break;
+			}
+		}
+		if (ok && r_strbuf_length (out) > 0) {
+			ok = r_sys_write_full (wfd, (const ut8 *)r_strbuf_get (out), r_strbuf_length (out));
+			r_strbuf_set (out, "");
+		}
+		if (!ok || pos == r_strbuf_length (in)) {
+			break;
+		}
+		if (r_strbuf_length (in) - pos >= R2PIPE_FRAME_HDRSZ
+				&& (ut32)(r_strbuf_length (in) - pos - R2PIPE_FRAME_HDRSZ)
+				>= r_read_be32 (r_strbuf_get (in) + pos + 5)) {
+			continue;
+		}
+		/* partial frame, wait for the rest of it */
+		char buf[4096];
+		void *bed = r_cons_sleep_begin ();
+		int ret = read (rfd, buf, sizeof (buf));
+		r_cons_sleep_end (bed);
+		if (ret < 1) {
+			ok = false;
+			break;
+		}
+		int restlen = r_strbuf_length (in) - pos;
+		// frames are binary, r_str_ndup would stop at the first zero
+		char *rest = r_mem_dup (r_strbuf_get (in) + pos, restlen);
+		if (!rest) {
+			ok = false;
+			break;
+		}
+		r_strbuf_set (in, "");
+		r_strbuf_append_n (in, rest, restlen);
+		r_strbuf_append_n (in, buf, ret);
+		free (rest);
+		pos = 0;
+	}
+	r_strbuf_free (in);
+	r_strbuf_free (out);
+	return ok;
+}
+#endif
+
 static int lang_pipe_run(RLang *lang, const char *code, int len) {
 #if __UNIX__
 	int safe_in = dup (0);
@@ -143,6 +224,7 @@ static int lang_pipe_run(RLang *lang, const char *code, int len) {
 	
 	env ("R2PIPE_IN", input[0]);
 	env ("R2PIPE_OUT", output[1]);
+	env ("R2PIPE_FRAMED", 1);
 
 	child = r_sys_fork ();
 	if (child == -1) {
@@ -178,6 +260,12 @@ static int lang_pipe_run(RLang *lang, const char *code, int len) {
 			if (ret < 1 || !buf[0]) {
 				break;
 			}
+			if (buf[0] == R2PIPE_FRAME_CMD) {
+				if (!lang_pipe_frames (lang, input[1], output[0], buf, ret)) {
+					break;
+				}
+				continue;
+			}
 			buf[sizeof (buf) - 1] = 0;
 			res = lang->cmd_str ((RCore*)lang->user, buf);
 			//eprintf ("%d %s\n", ret, buf);
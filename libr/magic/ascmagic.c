@@ -48,6 +48,7 @@
 #include <stdlib.h>
 #include "names.h"
 
+#define ASCMAGIC 0	/* text tests are disabled, see file_looks_text */
 #define MAXLINELEN 300	/* longest sane line length */
 #define ISSPC(x) ((x) == ' ' || (x) == '\t' || (x) == '\r' || (x) == '\n' \
 		  || (x) == 0x85 || (x) == '\f')
@@ -64,7 +65,9 @@ static int ascmatch(const ut8 *, const unichar *, size_t);
 static ut8 *encode_utf8(ut8 *, size_t, unichar *, size_t);
 
 int file_ascmagic(RMagic *ms, const ut8 *buf, size_t nbytes) {
-return 0;
+	if (!ASCMAGIC) {
+		return 0;
+	}
 	size_t i;
 	ut8 *nbuf = NULL, *utf8_buf = NULL, *utf8_end;
 	unichar *ubuf = NULL;	
@@ -400,6 +403,45 @@ done:
 	return rv;
 }
 
+/* false only when file_ascmagic can not run the text tests on buf */
+int file_looks_text(const ut8 *buf, size_t nbytes) {
+	unichar *ubuf;
+	ut8 *nbuf;
+	size_t ulen;
+	int rv;
+
+	if (!ASCMAGIC) {
+		return 0;
+	}
+	while (nbytes > 1 && buf[nbytes - 1] == '\0') {
+		nbytes--;
+	}
+	if (nbytes <= 1) {
+		return 0;
+	}
+	ubuf = calloc (nbytes + 1, sizeof (unichar));
+	nbuf = calloc (nbytes + 1, 1);
+	if (!ubuf || !nbuf) {
+		free (ubuf);
+		free (nbuf);
+		return 1;
+	}
+	rv = looks_ascii (buf, nbytes, ubuf, &ulen)
+		|| looks_utf8_with_BOM (buf, nbytes, ubuf, &ulen) > 0
+		|| file_looks_utf8 (buf, nbytes, ubuf, &ulen) > 1
+		|| looks_ucs16 (buf, nbytes, ubuf, &ulen)
+		|| (looks_latin1 (buf, nbytes, ubuf, &ulen) && memcmp (buf, "\xff\xff\xff\xff", 4))
+		|| looks_extended (buf, nbytes, ubuf, &ulen);
+	if (!rv) {
+		from_ebcdic (buf, nbytes, nbuf);
+		rv = looks_ascii (nbuf, nbytes, ubuf, &ulen)
+			|| looks_latin1 (nbuf, nbytes, ubuf, &ulen);
+	}
+	free (ubuf);
+	free (nbuf);
+	return rv;
+}
+
 static int ascmatch(const ut8 *s, const unichar *us, size_t ulen) {
 	size_t i;
 	for (i = 0; i < ulen; i++) {
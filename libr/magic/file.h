@@ -67,6 +67,7 @@ int file_tryelf(struct r_magic_set *, int, const unsigned char *,
 int file_zmagic(struct r_magic_set *, int, const char *,
     const unsigned char *, size_t);
 int file_ascmagic(struct r_magic_set *, const unsigned char *, size_t);
+int file_looks_text(const unsigned char *, size_t);
 int file_is_tar(struct r_magic_set *, const unsigned char *, size_t);
 int file_softmagic(struct r_magic_set *, const unsigned char *, size_t, int);
 struct mlist *file_apprentice(struct r_magic_set *, const char *, int);
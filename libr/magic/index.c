@@ -0,0 +1,461 @@
+/* radare - LGPL - Copyright 2026 - agent */
+
+#include <r_userconf.h>
+
+#if !USE_LIB_MAGIC
+
+#include "file.h"
+#include <r_util.h>
+#include <ctype.h>
+
+/*
+ * Prefilter to run a magic set at many offsets of the same buffer.
+ *
+ * Every top level binary test comparing bytes at a fixed offset becomes a
+ * pattern (offset, value, mask), and the patterns are indexed by one of
+ * their bytes. When no pattern matches at an offset none of those tests
+ * can match there either, so only the tests that could not be turned into
+ * patterns (kept in the slow list, in their original order) need to run.
+ * The text tests only run on buffers that look like text (file_ascmagic),
+ * those offsets are always candidates when there are any.
+ */
+
+#define INDEX_MAX_OFFSET 0x100000
+#define INDEX_MAX_RANGE 64
+
+typedef struct {
+	ut32 off;
+	ut32 len;
+	ut8 val[MAXstring];
+	ut8 alt[MAXstring]; // also accepted, for case insensitive strings
+	ut8 msk[MAXstring];
+} MagicPattern;
+
+typedef struct {
+	ut32 off; // of the key byte
+	ut32 at[257]; // ids[at[c]..at[c + 1]] are the patterns with c as key
+	ut32 *ids;
+} MagicKey;
+
+typedef struct {
+	ut32 off;
+	ut32 c;
+	ut32 id;
+} MagicKeyEntry;
+
+struct r_magic_index_t {
+	RMagic *ms;
+	RVector *patterns; // MagicPattern
+	RVector *keys; // MagicKey
+	struct mlist *slow; // NULL when every binary test got indexed
+	struct mlist *text; // NULL when there are no text tests
+	bool tar;
+};
+
+static bool pattern_num(MagicPattern *p, struct r_magic *m) {
+	int i, w, be = R_SYS_ENDIAN;
+	ut64 mask = UT64_MAX;
+
+	switch (m->type) {
+	case FILE_BYTE: w = 1; break;
+	case FILE_SHORT: w = 2; break;
+	case FILE_BESHORT: w = 2; be = 1; break;
+	case FILE_LESHORT: w = 2; be = 0; break;
+	case FILE_LONG: w = 4; break;
+	case FILE_BELONG: w = 4; be = 1; break;
+	case FILE_LELONG: w = 4; be = 0; break;
+	case FILE_QUAD: w = 8; break;
+	case FILE_BEQUAD: w = 8; be = 1; break;
+	case FILE_LEQUAD: w = 8; be = 0; break;
+	default:
+		return false;
+	}
+	if (m->mask_op & FILE_OPINVERSE) {
+		return false;
+	}
+	if (m->num_mask) {
+		if ((m->mask_op & FILE_OPS_MASK) != FILE_OPAND) {
+			return false;
+		}
+		mask = m->num_mask;
+	}
+	// the value is compared sign extended, its low bytes are what we look for
+	for (i = 0; i < w; i++) {
+		int shift = 8 * (be? w - 1 - i: i);
+		p->val[i] = (m->value.q >> shift) & 0xff;
+		p->msk[i] = (mask >> shift) & 0xff;
+		p->val[i] &= p->msk[i];
+		p->alt[i] = p->val[i];
+	}
+	p->len = w;
+	return true;
+}
+
+/* the part of a string test that does not depend on blank compaction */
+static bool pattern_str(MagicPattern *p, struct r_magic *m) {
+	ut32 i, flags = m->str_flags;
+	ut32 len = R_MIN (m->vallen, MAXstring);
+
+	for (i = 0; i < len; i++) {
+		ut8 a = m->value.s[i];
+		if ((flags & (STRING_COMPACT_BLANK | STRING_COMPACT_OPTIONAL_BLANK)) && isspace (a)) {
+			break;
+		}
+		p->val[i] = p->alt[i] = a;
+		p->msk[i] = 0xff;
+		if ((flags & STRING_IGNORE_LOWERCASE) && islower (a)) {
+			p->alt[i] = toupper (a);
+		} else if ((flags & STRING_IGNORE_UPPERCASE) && isupper (a)) {
+			p->alt[i] = tolower (a);
+		}
+	}
+	p->len = i;
+	return i > 0;
+}
+
+/* adds the patterns for a top level test, false if it can not be indexed */
+static bool index_test(RMagicIndex *mi, struct r_magic *m) {
+	MagicPattern p = {0};
+	ut32 i, range = 1;
+
+	if (m->reln != '=' || m->cond != COND_NONE || m->offset > INDEX_MAX_OFFSET) {
+		return false;
+	}
+	if (m->flag & (INDIR | OFFADD | INDIROFFADD)) {
+		return false;
+	}
+	switch (m->type) {
+	case FILE_STRING:
+		if (!pattern_str (&p, m)) {
+			return false;
+		}
+		break;
+	case FILE_SEARCH:
+		// a search test is a string test at each offset of its range
+		range = m->str_range;
+		if (!range || range > INDEX_MAX_RANGE || !pattern_str (&p, m)) {
+			return false;
+		}
+		break;
+	default:
+		if (!pattern_num (&p, m)) {
+			return false;
+		}
+		break;
+	}
+	for (i = 0; i < range; i++) {
+		p.off = m->offset + i;
+		if (!r_vector_push (mi->patterns, &p)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static struct mlist *slow_new(void) {
+	struct mlist *ml = R_NEW0 (struct mlist);
+	if (ml) {
+		ml->next = ml->prev = ml;
+	}
+	return ml;
+}
+
+static void slow_free(struct mlist *head) {
+	struct mlist *ml, *next;
+	if (!head) {
+		return;
+	}
+	for (ml = head->next; ml != head; ml = next) {
+		next = ml->next;
+		free (ml->magic);
+		free (ml);
+	}
+	free (head);
+}
+
+/* copy the top level tests of ml marked in keep, with their continuations */
+static bool slow_add(struct mlist *head, struct mlist *ml, ut8 *keep) {
+	ut32 i, n = 0;
+	struct mlist *sl = R_NEW0 (struct mlist);
+	// one more zeroed entry, match() looks one past the last continuation
+	struct r_magic *mg = calloc (ml->nmagic + 1, sizeof (struct r_magic));
+	if (!sl || !mg) {
+		free (sl);
+		free (mg);
+		return false;
+	}
+	for (i = 0; i < ml->nmagic; i++) {
+		ut32 top = i;
+		do {
+			if (keep[top]) {
+				mg[n++] = ml->magic[i];
+			}
+			i++;
+		} while (i < ml->nmagic && ml->magic[i].cont_level);
+		i--;
+	}
+	if (!n) {
+		free (sl);
+		free (mg);
+		return true;
+	}
+	sl->magic = mg;
+	sl->nmagic = n;
+	sl->prev = head->prev;
+	sl->next = head;
+	head->prev->next = sl;
+	head->prev = sl;
+	return true;
+}
+
+static int key_entry_cmp(const void *a, const void *b) {
+	const MagicKeyEntry *x = a, *y = b;
+	if (x->off != y->off) {
+		return x->off < y->off? -1: 1;
+	}
+	if (x->c != y->c) {
+		return x->c < y->c? -1: 1;
+	}
+	return x->id < y->id? -1: x->id > y->id;
+}
+
+static void key_fini(void *e, void *user) {
+	free (((MagicKey *)e)->ids);
+}
+
+/* index every pattern by its first fully masked byte, or its most masked one */
+static bool index_keys(RMagicIndex *mi) {
+	MagicKeyEntry e;
+	MagicPattern *p;
+	ut32 i, c, id = 0;
+	RVector *entries = r_vector_new (sizeof (MagicKeyEntry), NULL, NULL);
+	if (!entries) {
+		return false;
+	}
+	r_vector_foreach (mi->patterns, p) {
+		int b, k = 0, bits = -1;
+		for (i = 0; i < p->len; i++) {
+			for (b = 0, c = p->msk[i]; c; c >>= 1) {
+				b += c & 1;
+			}
+			if (b > bits) {
+				bits = b;
+				k = i;
+			}
+			if (b == 8) {
+				break;
+			}
+		}
+		e.off = p->off + k;
+		e.id = id++;
+		for (c = 0; c < 256; c++) {
+			ut8 v = c & p->msk[k];
+			if (v == p->val[k] || v == p->alt[k]) {
+				e.c = c;
+				r_vector_push (entries, &e);
+			}
+		}
+	}
+	if (entries->len) {
+		qsort (entries->a, entries->len, sizeof (MagicKeyEntry), key_entry_cmp);
+	}
+	MagicKeyEntry *all = entries->a;
+	for (i = 0; i < entries->len;) {
+		MagicKey *key = r_vector_push (mi->keys, NULL);
+		ut32 j, n = 0;
+		if (!key) {
+			break;
+		}
+		memset (key, 0, sizeof (MagicKey));
+		key->off = all[i].off;
+		for (j = i; j < entries->len && all[j].off == key->off; j++) {
+			key->at[all[j].c + 1]++;
+			n++;
+		}
+		if (!(key->ids = malloc (n * sizeof (ut32)))) {
+			break;
+		}
+		for (c = 1; c < 257; c++) {
+			key->at[c] += key->at[c - 1];
+		}
+		for (j = 0; j < n; j++) {
+			key->ids[j] = all[i + j].id;
+		}
+		i += n;
+	}
+	bool ret = i >= entries->len;
+	r_vector_free (entries);
+	return ret;
+}
+
+/**
+ * Build the prefilter for the tests loaded in ms. The index refers to ms,
+ * which must outlive it and not load more files meanwhile.
+ * Returns NULL when the flags of ms make the prefilter useless.
+ */
+R_API RMagicIndex *r_magic_index_new(RMagic *ms) {
+	struct mlist *ml;
+	ut32 i;
+
+	r_return_val_if_fail (ms, NULL);
+	if (!ms->mlist || ms->flags & (R_MAGIC_NO_CHECK_SOFT | R_MAGIC_MIME_ENCODING)) {
+		return NULL;
+	}
+	RMagicIndex *mi = R_NEW0 (RMagicIndex);
+	if (!mi) {
+		return NULL;
+	}
+	mi->ms = ms;
+	mi->tar = !(ms->flags & R_MAGIC_NO_CHECK_TAR);
+	mi->patterns = r_vector_new (sizeof (MagicPattern), NULL, NULL);
+	mi->keys = r_vector_new (sizeof (MagicKey), key_fini, NULL);
+	mi->slow = slow_new ();
+	mi->text = slow_new ();
+	if (!mi->patterns || !mi->keys || !mi->slow || !mi->text) {
+		goto fail;
+	}
+	for (ml = ms->mlist->next; ml != ms->mlist; ml = ml->next) {
+		ut8 *slow = calloc (ml->nmagic + 1, 1);
+		ut8 *text = calloc (ml->nmagic + 1, 1);
+		if (!slow || !text) {
+			free (slow);
+			free (text);
+			goto fail;
+		}
+		for (i = 0; i < ml->nmagic; i++) {
+			struct r_magic *m = &ml->magic[i];
+			if (m->cont_level) {
+				continue;
+			}
+			if (m->flag & BINTEST) {
+				slow[i] = !index_test (mi, m);
+			} else {
+				text[i] = true;
+			}
+		}
+		bool ok = slow_add (mi->slow, ml, slow) && slow_add (mi->text, ml, text);
+		free (slow);
+		free (text);
+		if (!ok) {
+			goto fail;
+		}
+	}
+	if (!index_keys (mi)) {
+		goto fail;
+	}
+	if (mi->slow->next == mi->slow) {
+		slow_free (mi->slow);
+		mi->slow = NULL;
+	}
+	if (mi->text->next == mi->text || ms->flags & R_MAGIC_NO_CHECK_ASCII) {
+		slow_free (mi->text);
+		mi->text = NULL;
+	}
+	return mi;
+fail:
+	r_magic_index_free (mi);
+	return NULL;
+}
+
+R_API void r_magic_index_free(RMagicIndex *mi) {
+	if (mi) {
+		r_vector_free (mi->patterns);
+		r_vector_free (mi->keys);
+		slow_free (mi->slow);
+		slow_free (mi->text);
+		free (mi);
+	}
+}
+
+/* true if offsets that are not candidates never match */
+R_API bool r_magic_index_complete(RMagicIndex *mi) {
+	r_return_val_if_fail (mi, false);
+	return !mi->slow;
+}
+
+/* same as the checksum field test of is_tar: spaces and an octal digit */
+static bool tar_candidate(const ut8 *buf, size_t nb) {
+	int i;
+	if (nb < 512) {
+		return false;
+	}
+	for (i = 148; i < 155 && isspace (buf[i]); i++) {
+		;
+	}
+	return buf[i] >= '0' && buf[i] <= '7';
+}
+
+static inline bool pattern_match(const MagicPattern *p, const ut8 *buf, size_t nb) {
+	ut32 i;
+	if (p->off + p->len > nb) {
+		return false;
+	}
+	buf += p->off;
+	for (i = 0; i < p->len; i++) {
+		ut8 b = buf[i] & p->msk[i];
+		if (b != p->val[i] && b != p->alt[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* false when no indexed test can match buf */
+R_API bool r_magic_index_candidate(RMagicIndex *mi, const ut8 *buf, size_t nb) {
+	MagicPattern *patterns = mi->patterns->a;
+	MagicKey *key;
+	ut32 i;
+
+	if (nb < 2 || (mi->tar && tar_candidate (buf, nb))) {
+		return true;
+	}
+	r_vector_foreach (mi->keys, key) {
+		if (key->off >= nb) {
+			continue;
+		}
+		ut8 c = buf[key->off];
+		for (i = key->at[c]; i < key->at[c + 1]; i++) {
+			if (pattern_match (&patterns[key->ids[i]], buf, nb)) {
+				return true;
+			}
+		}
+	}
+	return mi->text && file_looks_text (buf, nb);
+}
+
+/**
+ * Scan count offsets of buf (len bytes long) looking at window bytes from
+ * each one, as r_magic_buffer would. Returns the first candidate offset,
+ * or count when there are none.
+ */
+R_API int r_magic_index_next(RMagicIndex *mi, const ut8 *buf, int len, int count, int window) {
+	int i;
+	r_return_val_if_fail (mi && buf && window > 0, count);
+	for (i = 0; i < count && i < len; i++) {
+		if (r_magic_index_candidate (mi, buf + i, R_MIN (window, len - i))) {
+			return i;
+		}
+	}
+	return count;
+}
+
+/* same result as r_magic_buffer, running only the tests that may match */
+R_API const char *r_magic_index_buffer(RMagicIndex *mi, const void *buf, size_t nb) {
+	r_return_val_if_fail (mi, NULL);
+	RMagic *ms = mi->ms;
+	if (r_magic_index_candidate (mi, buf, nb)) {
+		return r_magic_buffer (ms, buf, nb);
+	}
+	if (!mi->slow) {
+		return NULL;
+	}
+	struct mlist *mlist = ms->mlist;
+	int flags = ms->flags;
+	ms->mlist = mi->slow;
+	ms->flags |= R_MAGIC_NO_CHECK_TAR;
+	const char *ret = r_magic_buffer (ms, buf, nb);
+	ms->mlist = mlist;
+	ms->flags = flags;
+	return ret;
+}
+#endif
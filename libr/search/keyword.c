@@ -51,6 +51,7 @@ R_API void r_search_keyword_free (RSearchKeyword *kw) {
 	}
 	free (kw->bin_binmask);
 	free (kw->bin_keyword);
+	r_regex_free (kw->rx);
 	free (kw);
 }
 
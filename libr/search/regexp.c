@@ -7,26 +7,24 @@ R_API int r_search_regexp_update(RSearch *s, ut64 from, const ut8 *buf, int len)
 	RSearchKeyword *kw;
 	RListIter *iter;
 	RRegexMatch match;
-	RRegex compiled = {0};
 	const int old_nhits = s->nhits;
 	int ret = 0;
 
 	r_list_foreach (s->kws, iter, kw) {
-		int reflags = R_REGEX_EXTENDED;
-
-		if (kw->icase) {
-			reflags |= R_REGEX_ICASE;
-		}
-
-		if (r_regex_comp (&compiled, (char *)kw->bin_keyword, reflags)) {
-			eprintf ("Cannot compile '%s' regexp\n", kw->bin_keyword);
-			return -1;
+		if (!kw->rx) {
+			// compile once, this is called for every block
+			const char *flags = kw->icase? "ei": "e";
+			kw->rx = r_regex_new ((char *)kw->bin_keyword, flags);
+			if (!kw->rx) {
+				eprintf ("Cannot compile '%s' regexp\n", kw->bin_keyword);
+				return -1;
+			}
 		}
 
 		match.rm_so = 0;
 		match.rm_eo = len;
 
-		while (!r_regex_exec (&compiled, (char *)buf, 1, &match, R_REGEX_STARTEND)) {
+		while (!r_regex_exec (kw->rx, (char *)buf, 1, &match, R_REGEX_STARTEND)) {
 			int t = r_search_hit_new (s, kw, from + match.rm_so);
 			if (!t) {
 				ret = -1;
@@ -42,7 +40,6 @@ R_API int r_search_regexp_update(RSearch *s, ut64 from, const ut8 *buf, int len)
 	}
 
 beach:
-	r_regex_fini (&compiled);
 	if (!ret) {
 		ret = s->nhits - old_nhits;
 	}
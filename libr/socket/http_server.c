@@ -10,35 +10,56 @@ R_API void r_socket_http_server_set_breaked(bool *b) {
 }
 
 R_API RSocketHTTPRequest *r_socket_http_accept (RSocket *s, RSocketHTTPOptions *so) {
+	RSocket *c = so->accept_timeout
+		? r_socket_accept_timeout (s, 1)
+		: r_socket_accept (s);
+	if (!c) {
+		return NULL;
+	}
+	if (so->timeout > 0) {
+		r_socket_block_time (c, 1, so->timeout, 0);
+	}
+	RSocketHTTPRequest *hr = r_socket_http_request (c, so);
+	if (!hr) {
+		r_socket_free (c);
+	}
+	return hr;
+}
+
+/* parse the next request sent on an already connected socket.
+ * the socket is owned by the returned request, but not freed on failure */
+R_API RSocketHTTPRequest *r_socket_http_request (RSocket *s, RSocketHTTPOptions *so) {
 	int content_length = 0, xx, yy;
-	int pxx = 1, first = 0;
+	int pxx = 1, first = 0, skipped = 0;
+	bool http11 = false, conn_close = false, conn_keep = false;
 	char buf[1500], *p, *q;
 	RSocketHTTPRequest *hr = R_NEW0 (RSocketHTTPRequest);
 	if (!hr) {
 		return NULL;
 	}
-	if (so->accept_timeout) {
-		hr->s = r_socket_accept_timeout (s, 1);
-	} else {
-		hr->s = r_socket_accept (s);
-	}
-	if (!hr->s) {
-		free (hr);
-		return NULL;
-	}
-	if (so->timeout > 0) {
-		r_socket_block_time (hr->s, 1, so->timeout, 0);
-	}
+	hr->s = s;
 	hr->auth = !so->httpauth;
 	for (;;) {
 #if __WINDOWS__
 		if (breaked && *breaked) {
-			r_socket_http_close (hr);
+			r_socket_http_detach (hr);
 			return NULL;
 		}
 #endif
 		memset (buf, 0, sizeof (buf));
 		xx = r_socket_gets (hr->s, buf, sizeof (buf));
+		if (xx < 0 && first == 0) {
+			r_socket_http_detach (hr);
+			return NULL;
+		}
+		if (xx == 0 && first == 0) {
+			// skip the line terminators left behind by the previous keep-alive request
+			if (++skipped > 4) {
+				r_socket_http_detach (hr);
+				return NULL;
+			}
+			continue;
+		}
 		yy = r_socket_ready (hr->s, 0, 20 * 1000); //this function uses usecs as argument
 //		eprintf ("READ %d (%s) READY %d\n", xx, buf, yy);
 		if (!yy || (!xx && !pxx)) {
@@ -49,7 +70,7 @@ R_API RSocketHTTPRequest *r_socket_http_accept (RSocket *s, RSocketHTTPOptions *
 		if (first == 0) {
 			first = 1;
 			if (strlen (buf)<3) {
-				r_socket_http_close (hr);
+				r_socket_http_detach (hr);
 				return NULL;
 			}
 			p = strchr (buf, ' ');
@@ -60,12 +81,16 @@ R_API RSocketHTTPRequest *r_socket_http_accept (RSocket *s, RSocketHTTPOptions *
 			if (p) {
 				q = strstr (p+1, " HTTP"); //strchr (p+1, ' ');
 				if (q) {
+					http11 = !strncmp (q, " HTTP/1.1", 9);
 					*q = 0;
 				}
 				hr->path = strdup (p+1);
 			}
 		} else {
-			if (!hr->referer && !strncmp (buf, "Referer: ", 9)) {
+			if (!r_str_ncasecmp (buf, "Connection: ", 12)) {
+				conn_close = r_str_casestr (buf + 12, "close");
+				conn_keep = r_str_casestr (buf + 12, "keep-alive");
+			} else if (!hr->referer && !strncmp (buf, "Referer: ", 9)) {
 				hr->referer = strdup (buf + 9);
 			} else if (!hr->agent && !strncmp (buf, "User-Agent: ", 12)) {
 				hr->agent = strdup (buf + 12);
@@ -103,6 +128,8 @@ R_API RSocketHTTPRequest *r_socket_http_accept (RSocket *s, RSocketHTTPOptions *
 			}
 		}
 	}
+	hr->http11 = http11;
+	hr->keepalive = so->keepalive && !conn_close && (http11 || conn_keep);
 	if (content_length>0) {
 		r_socket_read_block (hr->s, (ut8*)buf, 1); // one missing byte wtf
 		hr->data = malloc (content_length+1);
@@ -128,9 +155,10 @@ R_API void r_socket_http_response (RSocketHTTPRequest *rs, int code, const char
 	if (!headers) {
 		headers = code == 401 ? "WWW-Authenticate: Basic realm=\"R2 Web UI Access\"\n" : "";
 	}
-	r_socket_printf (rs->s, "HTTP/1.0 %d %s\r\n%s"
-		"Connection: close\r\nContent-Length: %d\r\n\r\n",
-		code, strcode, headers, len);
+	r_socket_printf (rs->s, "HTTP/1.%d %d %s\r\n%s"
+		"Connection: %s\r\nContent-Length: %d\r\n\r\n",
+		rs->http11, code, strcode, headers,
+		rs->keepalive? "keep-alive": "close", len);
 	if (out && len > 0) {
 		r_socket_write (rs->s, (void *)out, len);
 	}
@@ -182,15 +210,22 @@ R_API ut8 *r_socket_http_handle_upload(const ut8 *str, int len, int *retlen) {
 	return NULL;
 }
 
-/* close client socket and free struct */
-R_API void r_socket_http_close (RSocketHTTPRequest *rs) {
-	r_socket_free (rs->s);
+/* free struct and return the client socket to read the next keep-alive request */
+R_API RSocket *r_socket_http_detach (RSocketHTTPRequest *rs) {
+	RSocket *s = rs->s;
 	free (rs->path);
 	free (rs->host);
 	free (rs->agent);
 	free (rs->method);
+	free (rs->referer);
 	free (rs->data);
 	free (rs);
+	return s;
+}
+
+/* close client socket and free struct */
+R_API void r_socket_http_close (RSocketHTTPRequest *rs) {
+	r_socket_free (r_socket_http_detach (rs));
 }
 
 #if MAIN
@@ -81,12 +81,21 @@ R_API char *r2pipe_read(R2Pipe *r2pipe) {
 	}
 	buf[bufsz - 1] = 0;
 #else
+	/* only one reply is in flight, so reading past the NUL is not possible */
 	char *newbuf;
-	int i, rv;
-	for (i = 0; i < bufsz; i++) {
-		rv = read (r2pipe->output[0], buf + i, 1);
-		if (i + 2 >= bufsz) {
-			bufsz += 4096;
+	int i = 0, rv;
+	for (;;) {
+		rv = read (r2pipe->output[0], buf + i, bufsz - i - 1);
+		if (rv < 1) {
+			break;
+		}
+		if (memchr (buf + i, 0, rv)) {
+			i += rv;
+			break;
+		}
+		i += rv;
+		if (i + 1 >= bufsz) {
+			bufsz *= 2;
 			newbuf = realloc (buf, bufsz);
 			if (!newbuf) {
 				R_FREE (buf);
@@ -94,18 +103,64 @@ R_API char *r2pipe_read(R2Pipe *r2pipe) {
 			}
 			buf = newbuf;
 		}
-		if (rv != 1 || !buf[i]) {
-			break;
-		}
 	}
 	if (buf) {
-		int zpos = (i < bufsz)? i: i - 1;
-		buf[zpos] = 0;
+		buf[i] = 0;
 	}
 #endif
 	return buf;
 }
 
+#if __UNIX__
+/* send rounds of framed commands small enough to fit in the pipe buffer,
+ * so the other end never blocks on a reply we are not reading yet */
+static int r2pipe_batch_framed(R2Pipe *r2pipe, const char **cmds, int n, char **res) {
+	ut8 hdr[R2PIPE_FRAME_HDRSZ];
+	int i = 0, j, done = 0;
+	while (i < n) {
+		RStrBuf *sb = r_strbuf_new (NULL);
+		for (j = i; j < n; j++) {
+			int len = strlen (cmds[j]);
+			if (j > i && r_strbuf_length (sb) + len + sizeof (hdr) > R2PIPE_FRAME_BATCH) {
+				break;
+			}
+			hdr[0] = R2PIPE_FRAME_CMD;
+			r_write_be32 (hdr + 1, j);
+			r_write_be32 (hdr + 5, len);
+			r_strbuf_append_n (sb, (const char *)hdr, sizeof (hdr));
+			r_strbuf_append_n (sb, cmds[j], len);
+		}
+		bool ok = r_sys_write_full (r2pipe->input[1],
+			(const ut8 *)r_strbuf_get (sb), r_strbuf_length (sb));
+		r_strbuf_free (sb);
+		for (; ok && i < j; i++) {
+			if (!r_sys_read_full (r2pipe->output[0], hdr, sizeof (hdr))
+					|| hdr[0] != R2PIPE_FRAME_REPLY) {
+				return done;
+			}
+			ut32 id = r_read_be32 (hdr + 1);
+			ut32 len = r_read_be32 (hdr + 5);
+			char *out = malloc (len + 1);
+			if (!out || !r_sys_read_full (r2pipe->output[0], (ut8 *)out, len)) {
+				free (out);
+				return done;
+			}
+			out[len] = 0;
+			if (id < n && !res[id]) {
+				res[id] = out;
+				done++;
+			} else {
+				free (out);
+			}
+		}
+		if (!ok) {
+			break;
+		}
+	}
+	return done;
+}
+#endif
+
 R_API int r2pipe_close(R2Pipe *r2pipe) {
 	if (!r2pipe) {
 		return 0;
@@ -176,6 +231,10 @@ static R2Pipe* r2pipe_open_spawn(R2Pipe* r2pipe) {
 	if (!done) {
 		eprintf ("Cannot find R2PIPE_IN or R2PIPE_OUT environment\n");
 		R_FREE (r2pipe);
+	} else {
+		char *framed = r_sys_getenv ("R2PIPE_FRAMED");
+		r2pipe->framed = framed && *framed == '1';
+		free (framed);
 	}
 	free (in);
 	free (out);
@@ -324,3 +383,21 @@ R_API char *r2pipe_cmdf(R2Pipe *r2pipe, const char *fmt, ...) {
 	return (char*)fmt;
 }
 
+/* run n commands, res[i] gets the output of cmds[i]. returns the number of replies */
+R_API int r2pipe_cmd_batch(R2Pipe *r2pipe, const char **cmds, int n, char **res) {
+	r_return_val_if_fail (r2pipe && cmds && res && n >= 0, -1);
+	int i, done = 0;
+	memset (res, 0, sizeof (char *) * n);
+#if __UNIX__
+	if (r2pipe->framed && !r2pipe->coreb.core) {
+		return r2pipe_batch_framed (r2pipe, cmds, n, res);
+	}
+#endif
+	for (i = 0; i < n; i++) {
+		res[i] = r2pipe_cmd (r2pipe, cmds[i]);
+		if (res[i]) {
+			done++;
+		}
+	}
+	return done;
+}
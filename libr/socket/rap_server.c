@@ -2,6 +2,7 @@
 
 #include <r_socket.h>
 #include <r_util.h>
+#include <lz4.h>
 
 R_API RSocketRapServer *r_socket_server_new (bool use_ssl, const char *port) {
 	r_return_val_if_fail (port, NULL);
@@ -48,6 +49,59 @@ R_API RSocket* r_socket_server_accept (RSocketRapServer *s) {
 	return r_socket_accept (s->fd);
 }
 
+// serve one rap v2 packet, shared by the standalone rap server and r_core_serve
+R_API bool r_socket_rap_server_v2(RSocket *fd, ut8 type, int *features, rap_server_read_at read_at, rap_server_write_at write_at, void *user) {
+	r_return_val_if_fail (fd && features && read_at && write_at, false);
+	RSocketRapPacket pkt = { .type = type };
+	ut8 res[RAP_V2_HDRSZ];
+	bool ret = false;
+	if (!r_socket_rap_packet_read (fd, &pkt)) {
+		return false;
+	}
+	switch (type) {
+	case RAP_RMT_HELLO:
+		*features = (pkt.len >= 2)? pkt.data[1] & RAP_V2_F_LZ4: 0;
+		res[0] = RAP_V2_VERSION;
+		res[1] = *features;
+		r_write_be32 (res + 2, RAP_V2_MAX);
+		ret = r_socket_rap_packet_send (fd, type | RAP_RMT_REPLY, pkt.id, res, 6);
+		break;
+	case RAP_RMT_READ_AT:
+		if (pkt.len >= 12) {
+			ut64 addr = r_read_be64 (pkt.data);
+			ut32 len = R_MIN (r_read_be32 (pkt.data + 8), RAP_V2_MAX);
+			ut8 *buf = malloc (len + 1);
+			int n = buf? read_at (user, addr, buf, len): 0;
+			ret = r_socket_rap_packet_send_data (fd, type | RAP_RMT_REPLY,
+				pkt.id, buf, R_MAX (n, 0), *features);
+			free (buf);
+		}
+		break;
+	case RAP_RMT_WRITE_AT:
+		if (pkt.len >= 8) {
+			ut64 addr = r_read_be64 (pkt.data);
+			int n = write_at (user, addr, pkt.data + 8, pkt.len - 8);
+			r_write_be32 (res, R_MAX (n, 0));
+			ret = r_socket_rap_packet_send (fd, type | RAP_RMT_REPLY, pkt.id, res, 4);
+		}
+		break;
+	}
+	r_socket_rap_packet_fini (&pkt);
+	return ret;
+}
+
+static int rap_server_read_at_cb(void *user, ut64 addr, ut8 *buf, int len) {
+	RSocketRapServer *s = user;
+	s->seek (s->user, addr, SEEK_SET);
+	return s->read (s->user, buf, len);
+}
+
+static int rap_server_write_at_cb(void *user, ut64 addr, const ut8 *buf, int len) {
+	RSocketRapServer *s = user;
+	s->seek (s->user, addr, SEEK_SET);
+	return s->write (s->user, (ut8 *)buf, len);
+}
+
 R_API bool r_socket_server_continue (RSocketRapServer *s) {
 	r_return_val_if_fail (s && s->fd, false);
 
@@ -118,6 +172,11 @@ R_API bool r_socket_server_continue (RSocketRapServer *s) {
 		r_socket_flush (s->fd);
 		R_FREE (ptr);
 		break;
+	case RAP_RMT_HELLO:
+	case RAP_RMT_READ_AT:
+	case RAP_RMT_WRITE_AT:
+		return r_socket_rap_server_v2 (s->fd, s->buf[0], &s->features,
+			rap_server_read_at_cb, rap_server_write_at_cb, s);
 	case RAP_RMT_CLOSE:
 		r_socket_read_block (s->fd, &s->buf[1], 4);
 		i = r_read_be32 (&s->buf[1]);
@@ -133,3 +192,99 @@ R_API bool r_socket_server_continue (RSocketRapServer *s) {
 	}
 	return true;
 }
+
+R_API bool r_socket_rap_packet_send(RSocket *s, ut8 type, ut32 id, const ut8 *data, ut32 len) {
+	r_return_val_if_fail (s && (data || !len), false);
+	ut8 hdr[RAP_V2_HDRSZ];
+	hdr[0] = type;
+	r_write_be32 (hdr + 1, id);
+	r_write_be32 (hdr + 5, len);
+	if (r_socket_write (s, hdr, sizeof (hdr)) != sizeof (hdr)) {
+		return false;
+	}
+	if (len > 0 && r_socket_write (s, (void *)data, len) != len) {
+		return false;
+	}
+	r_socket_flush (s);
+	return true;
+}
+
+// the type byte is consumed by the caller to dispatch v1/v2 packets
+R_API bool r_socket_rap_packet_read(RSocket *s, RSocketRapPacket *pkt) {
+	r_return_val_if_fail (s && pkt, false);
+	ut8 hdr[8];
+	pkt->data = NULL;
+	if (r_socket_read_block (s, hdr, sizeof (hdr)) != sizeof (hdr)) {
+		return false;
+	}
+	pkt->id = r_read_be32 (hdr);
+	pkt->len = r_read_be32 (hdr + 4);
+	if (pkt->len > RAP_V2_MAX + 64) {
+		eprintf ("rap: packet too big (%u)\n", pkt->len);
+		return false;
+	}
+	pkt->data = malloc (pkt->len + 1);
+	if (!pkt->data) {
+		return false;
+	}
+	if (r_socket_read_block (s, pkt->data, pkt->len) != pkt->len) {
+		R_FREE (pkt->data);
+		return false;
+	}
+	pkt->data[pkt->len] = 0;
+	return true;
+}
+
+R_API void r_socket_rap_packet_fini(RSocketRapPacket *pkt) {
+	if (pkt) {
+		R_FREE (pkt->data);
+		pkt->len = 0;
+	}
+}
+
+// payload: [flags:1][size:4][bytes], bytes are lz4 compressed if RAP_V2_F_LZ4 is set
+R_API bool r_socket_rap_packet_send_data(RSocket *s, ut8 type, ut32 id, const ut8 *buf, int len, int features) {
+	r_return_val_if_fail (s && len >= 0, false);
+	int bound = (features & RAP_V2_F_LZ4)? LZ4_compressBound (len): len;
+	ut8 *pkt = malloc (bound + 5);
+	if (!pkt) {
+		return false;
+	}
+	int plen = 0;
+	pkt[0] = 0;
+	r_write_be32 (pkt + 1, len);
+	if (features & RAP_V2_F_LZ4 && len > 64) {
+		plen = LZ4_compress_default ((const char *)buf, (char *)pkt + 5, len, bound);
+	}
+	if (plen > 0 && plen < len) {
+		pkt[0] = RAP_V2_F_LZ4;
+	} else {
+		if (len > 0) {
+			memcpy (pkt + 5, buf, len);
+		}
+		plen = len;
+	}
+	bool ret = r_socket_rap_packet_send (s, type, id, pkt, plen + 5);
+	free (pkt);
+	return ret;
+}
+
+R_API int r_socket_rap_packet_data(RSocketRapPacket *pkt, ut8 *out, int outlen) {
+	r_return_val_if_fail (pkt && out, -1);
+	if (pkt->len < 5) {
+		return -1;
+	}
+	int size = r_read_be32 (pkt->data + 1);
+	if (size < 0 || size > outlen) {
+		return -1;
+	}
+	if (pkt->data[0] & RAP_V2_F_LZ4) {
+		int n = LZ4_decompress_safe ((const char *)pkt->data + 5, (char *)out, pkt->len - 5, size);
+		return (n == size)? size: -1;
+	}
+	if (pkt->len - 5 < size) {
+		return -1;
+	}
+	memcpy (out, pkt->data + 5, size);
+	return size;
+}
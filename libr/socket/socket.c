@@ -746,7 +746,7 @@ R_API int r_socket_write(RSocket *s, void *buf, int len) {
 	signal (SIGPIPE, SIG_IGN);
 #endif
 	for (;;) {
-		int b = 1500; //65536; // Use MTU 1500?
+		int b = 65536;
 		if (b > len) {
 			b = len;
 		}
@@ -767,7 +767,7 @@ R_API int r_socket_write(RSocket *s, void *buf, int len) {
 			break;
 		}
 		if (ret == len) {
-			return len;
+			return delta + len;
 		}
 		delta += ret;
 		len -= ret;
@@ -1,7 +1,7 @@
 #include <r_util.h>
 
 struct buf_sparse_priv {
-	RList *sparse;
+	RSkipList *chunks; // RBufferSparse sorted by address, never overlapping or touching
 	ut64 offset;
 };
 
@@ -11,67 +11,119 @@ static void buffer_sparse_free(void *a) {
 	free (s);
 }
 
-static bool sparse_limits(RList *l, ut64 *max) {
-	bool set = false;
-	RBufferSparse *s;
-	RListIter *iter;
+static int sparse_cmp(const void *a, const void *b) {
+	const RBufferSparse *sa = a, *sb = b;
+	return sa->from < sb->from? -1: sa->from > sb->from;
+}
 
-	r_list_foreach (l, iter, s) {
-		if (set) {
-			if (max && s->to > *max) {
-				*max = s->to;
-			}
-		} else {
-			set = true;
-			if (max) {
-				*max = s->to;
-			}
-		}
+static bool sparse_limits(RSkipList *chunks, ut64 *max) {
+	RBufferSparse key = { .from = UT64_MAX };
+	RBufferSparse *last = r_skiplist_get_leq (chunks, &key);
+	if (!last) {
+		return false;
+	}
+	if (max) {
+		*max = last->to;
 	}
-	return set;
+	return true;
 }
 
-static RBufferSparse *sparse_append(RList *l, ut64 addr, const ut8 *data, ut64 len) {
-	if (l && data) {
-		RBufferSparse *s = R_NEW0 (RBufferSparse);
-		if (s) {
-			s->data = calloc (1, len);
-			if (s->data) {
-				s->from = addr;
-				s->to = addr + len;
-				s->size = len;
-				memcpy (s->data, data, len);
-				return r_list_append (l, s)? s: NULL;
-			}
-			free (s);
+/* first chunk ending after addr, or touching it if adjacent */
+static RSkipListNode *sparse_lower(RSkipList *chunks, ut64 addr, bool adjacent) {
+	RBufferSparse key = { .from = addr };
+	RSkipListNode *n = r_skiplist_find_leq (chunks, &key);
+	if (n) {
+		RBufferSparse *s = n->data;
+		if (adjacent? s->to >= addr: s->to > addr) {
+			return n;
 		}
+		n = n->forward[0];
+	} else {
+		n = chunks->head->forward[0];
 	}
-	return NULL;
+	return n != chunks->head? n: NULL;
+}
+
+static RBufferSparse *sparse_new(ut64 addr, const ut8 *data, ut64 len) {
+	RBufferSparse *s = R_NEW0 (RBufferSparse);
+	if (!s) {
+		return NULL;
+	}
+	s->data = malloc (len);
+	if (!s->data) {
+		free (s);
+		return NULL;
+	}
+	s->from = addr;
+	s->to = addr + len;
+	s->size = len;
+	memcpy (s->data, data, len);
+	return s;
 }
 
 //ret -1 if failed; # of bytes copied if success
-static st64 sparse_write(RList *l, ut64 addr, const ut8 *data, ut64 len) {
-	RBufferSparse *s;
-	RListIter *iter;
-	ut64 olen = len;
-
-	r_list_foreach (l, iter, s) {
-		if (addr >= s->from && addr < s->to) {
-			ut64 delta = addr - s->from;
-			ut64 reallen = s->size - delta >= len? len: s->size - delta;
-			memcpy (s->data + delta, data, reallen);
-			data += reallen;
-			len -= reallen;
-			addr += reallen;
+static st64 sparse_write(RSkipList *chunks, ut64 addr, const ut8 *data, ut64 len) {
+	if (!len) {
+		return 0;
+	}
+	ut64 end = addr + len;
+	RSkipListNode *n = sparse_lower (chunks, addr, true);
+	RBufferSparse *first = n? n->data: NULL;
+	if (!first || first->from > end) {
+		RBufferSparse *s = sparse_new (addr, data, len);
+		if (!s || !r_skiplist_insert (chunks, s)) {
+			if (s) {
+				buffer_sparse_free (s);
+			}
+			return -1;
 		}
-		if (len == 0) {
-			return olen;
+		return len;
+	}
+	RBufferSparse *last = first;
+	RSkipListNode *m;
+	for (m = n->forward[0]; m != chunks->head; m = m->forward[0]) {
+		RBufferSparse *s = m->data;
+		if (s->from > end) {
+			break;
 		}
+		last = s;
 	}
-	if (len > 0 && !sparse_append (l, addr, data, len)) {
-		return -1;
+	if (last == first && addr >= first->from && end <= first->to) {
+		// overwrite inside a single chunk, the common patching case
+		memcpy (first->data + (addr - first->from), data, len);
+		return len;
+	}
+	// merge the new bytes and every chunk they overlap or touch into first
+	ut64 from = R_MIN (addr, first->from);
+	ut64 to = R_MAX (end, last->to);
+	ut8 *buf;
+	if (from == first->from) {
+		buf = realloc (first->data, to - from);
+		if (!buf) {
+			return -1;
+		}
+	} else {
+		buf = malloc (to - from);
+		if (!buf) {
+			return -1;
+		}
+		memcpy (buf + (first->from - from), first->data, first->size);
+		free (first->data);
+	}
+	first->data = buf;
+	while (last != first) {
+		RBufferSparse *s = n->forward[0]->data;
+		memcpy (buf + (s->from - from), s->data, s->size);
+		if (s == last) {
+			last = first;
+		}
+		r_skiplist_delete (chunks, s);
 	}
-	return olen;
+	memcpy (buf + (addr - from), data, len);
+	first->from = from;
+	first->to = to;
+	first->size = to - from;
+	return len;
 }
 
 static inline struct buf_sparse_priv *get_priv_sparse(RBuffer *b) {
@@ -85,7 +137,11 @@ static bool buf_sparse_init(RBuffer *b, const void *user) {
 	if (!priv) {
 		return false;
 	}
-	priv->sparse = r_list_newf (buffer_sparse_free);
+	priv->chunks = r_skiplist_new (buffer_sparse_free, sparse_cmp);
+	if (!priv->chunks) {
+		free (priv);
+		return false;
+	}
 	priv->offset = 0;
 	b->priv = priv;
 	return true;
@@ -93,41 +149,29 @@ static bool buf_sparse_init(RBuffer *b, const void *user) {
 
 static bool buf_sparse_fini(RBuffer *b) {
 	struct buf_sparse_priv *priv = get_priv_sparse (b);
-	r_list_free (priv->sparse);
+	r_skiplist_free (priv->chunks);
 	R_FREE (b->priv);
 	return true;
 }
 
 static bool buf_sparse_resize(RBuffer *b, ut64 newsize) {
 	struct buf_sparse_priv *priv = get_priv_sparse (b);
-	RListIter *iter, *tmp;
-	RBufferSparse *s;
-
-	r_list_foreach_safe (priv->sparse, iter, tmp, s) {
-		if (s->from >= newsize) {
-			r_list_delete (priv->sparse, iter);
-		} else if (s->to >= newsize) {
-			RBufferSparse *ns = R_NEW (RBufferSparse);
-			ns->from = s->from;
-			ns->to = newsize;
-			ns->size = ns->to - ns->from;
-			ut8 *tmp = realloc (s->data, s->size);
-			if (!tmp) {
-				free (ns);
-				return false;
-			}
-			// otherwise it will be double-freed by r_list_delete
-			s->data = NULL;
-			ns->data = tmp;
-			ns->written = s->written;
-			r_list_append (priv->sparse, ns);
-			r_list_delete (priv->sparse, iter);
+	RSkipListNode *n = sparse_lower (priv->chunks, newsize, false);
+	while (n) {
+		RBufferSparse *s = n->data;
+		n = n->forward[0] != priv->chunks->head? n->forward[0]: NULL;
+		if (s->from < newsize) {
+			// chunk crossing the new end, keep its head
+			s->to = newsize;
+			s->size = s->to - s->from;
+		} else {
+			r_skiplist_delete (priv->chunks, s);
 		}
 	}
 	ut64 max;
-	max = sparse_limits (priv->sparse, &max)? max: 0;
+	max = sparse_limits (priv->chunks, &max)? max: 0;
 	if (max < newsize) {
-		return !!sparse_write (priv->sparse, newsize - 1, (ut8 *)&b->Oxff_priv, 1);
+		return !!sparse_write (priv->chunks, newsize - 1, (ut8 *)&b->Oxff_priv, 1);
 	}
 	return true;
 }
@@ -136,31 +180,29 @@ static ut64 buf_sparse_size(RBuffer *b) {
 	struct buf_sparse_priv *priv = get_priv_sparse (b);
 	ut64 max;
 
-	return sparse_limits (priv->sparse, &max)? max: 0;
+	return sparse_limits (priv->chunks, &max)? max: 0;
 }
 
 static st64 buf_sparse_read(RBuffer *b, ut8 *buf, ut64 len) {
 	struct buf_sparse_priv *priv = get_priv_sparse (b);
-	RBufferSparse *c;
-	RListIter *iter;
+	RSkipListNode *n;
 	ut64 max = 0;
 
 	memset (buf, b->Oxff_priv, len);
-	r_list_foreach (priv->sparse, iter, c) {
-		if (max < c->to) {
-			max = c->to;
+	for (n = sparse_lower (priv->chunks, priv->offset, false); n && n != priv->chunks->head; n = n->forward[0]) {
+		RBufferSparse *c = n->data;
+		if (c->from >= priv->offset + len) {
+			break;
 		}
-		if (priv->offset < c->to && c->from < priv->offset + len) {
-			if (priv->offset < c->from) {
-				ut64 l = R_MIN (priv->offset + len - c->from, c->size);
-				memcpy (buf + c->from - priv->offset, c->data, l);
-			} else {
-				ut64 l = R_MIN (c->to - priv->offset, len);
-				memcpy (buf, c->data + priv->offset - c->from, l);
-			}
+		if (priv->offset < c->from) {
+			ut64 l = R_MIN (priv->offset + len - c->from, c->size);
+			memcpy (buf + c->from - priv->offset, c->data, l);
+		} else {
+			ut64 l = R_MIN (c->to - priv->offset, len);
+			memcpy (buf, c->data + priv->offset - c->from, l);
 		}
 	}
-	if (priv->offset > max) {
+	if (!sparse_limits (priv->chunks, &max) || priv->offset > max) {
 		return -1;
 	}
 	ut64 r = R_MIN (max - priv->offset, len);
@@ -170,7 +212,7 @@ static st64 buf_sparse_read(RBuffer *b, ut8 *buf, ut64 len) {
 
 static st64 buf_sparse_write(RBuffer *b, const ut8 *buf, ut64 len) {
 	struct buf_sparse_priv *priv = get_priv_sparse (b);
-	st64 r = sparse_write (priv->sparse, priv->offset, buf, len);
+	st64 r = sparse_write (priv->chunks, priv->offset, buf, len);
 	priv->offset += r;
 	return r;
 }
@@ -190,7 +232,7 @@ static st64 buf_sparse_seek(RBuffer *b, st64 addr, int whence) {
 		priv->offset = addr;
 		break;
 	case R_BUF_END:
-		if (!sparse_limits (priv->sparse, &max)) {
+		if (!sparse_limits (priv->chunks, &max)) {
 			max = 0;
 		}
 		priv->offset = max + addr;
@@ -204,7 +246,7 @@ static st64 buf_sparse_seek(RBuffer *b, st64 addr, int whence) {
 
 static RList *buf_sparse_nonempty_list(RBuffer *b) {
 	struct buf_sparse_priv *priv = get_priv_sparse (b);
-	return r_list_clone (priv->sparse);
+	return r_skiplist_to_list (priv->chunks);
 }
 
 static const RBufferMethods buffer_sparse_methods = {
@@ -178,7 +178,14 @@ R_API void r_graph_del_node(RGraph *t, RGraphNode *n) {
 		t->n_edges--;
 	}
 
-	r_list_delete_data (t->nodes, n);
+	/* the nodes deleted are usually the last ones added, like the dummy
+	 * nodes of the graph layout, so look for it from the tail */
+	r_list_foreach_prev (t->nodes, it, gn) {
+		if (gn == n) {
+			r_list_delete (t->nodes, it);
+			break;
+		}
+	}
 	t->n_nodes--;
 }
 
@@ -0,0 +1,482 @@
+/* radare - LGPL - Copyright 2026 - agent */
+
+#include <r_util.h>
+#include <r_vector.h>
+#include <zlib.h>
+
+/* zran-like index over a deflate stream: a first pass inflates everything
+ * once and every SPAN bytes of output, at a deflate block boundary, records
+ * where the block starts in the input together with the 32K dictionary
+ * before it. reads start inflating at the closest checkpoint, and inflated
+ * blocks are kept in a small LRU */
+
+#define SPAN (1024 * 1024)
+#define WINSIZE 32768
+#define CHUNK 16384
+#define BLOCK (64 * 1024)
+#define NBLOCKS 64
+#define INDEX_MAGIC "R2ZI"
+#define INDEX_VERSION 1
+
+typedef struct {
+	ut64 out; // offset in the inflated data
+	ut64 in; // offset in the compressed data of the first full byte
+	int bits; // bits of the byte at in - 1 that belong to the block
+	ut8 *win; // deflated dictionary, NULL at the start of a stream/member
+	ut32 winlen;
+} InflatePoint;
+
+typedef struct {
+	ut64 idx; // block number + 1, 0 if unused
+	ut64 used;
+	int len;
+	ut8 *data;
+} InflateBlock;
+
+struct r_inflate_index_t {
+	int fd;
+	ut64 from;
+	ut64 size;
+	ut64 mtime;
+	bool gzip;
+	ut64 length;
+	RVector points;
+	InflateBlock blocks[NBLOCKS];
+	ut64 tick;
+	/* the decoder stays where the last block ended, so sequential reads go
+	 * on from there instead of starting over at a checkpoint */
+	z_stream strm;
+	bool live;
+	bool raw;
+	ut64 in;
+	ut64 out;
+	ut8 inbuf[CHUNK];
+};
+
+static void point_free(void *e, void *user) {
+	InflatePoint *p = e;
+	free (p->win);
+}
+
+static int zi_input(RInflateIndex *zi, ut64 off, ut8 *buf, int len) {
+	if (off >= zi->size) {
+		return 0;
+	}
+	len = (int)R_MIN ((ut64)len, zi->size - off);
+	if (lseek (zi->fd, zi->from + off, SEEK_SET) < 0) {
+		return -1;
+	}
+	return read (zi->fd, buf, len);
+}
+
+static bool zi_refill(RInflateIndex *zi) {
+	int n = zi_input (zi, zi->in, zi->inbuf, CHUNK);
+	if (n <= 0) {
+		return false;
+	}
+	zi->in += n;
+	zi->strm.next_in = zi->inbuf;
+	zi->strm.avail_in = n;
+	return true;
+}
+
+static RInflateIndex *zi_new(const char *file, ut64 from, ut64 size, bool gzip) {
+	struct stat st;
+	if (stat (file, &st) == -1 || from > (ut64)st.st_size) {
+		return NULL;
+	}
+	RInflateIndex *zi = R_NEW0 (RInflateIndex);
+	if (!zi) {
+		return NULL;
+	}
+	zi->fd = r_sandbox_open (file, O_RDONLY | O_BINARY, 0);
+	if (zi->fd == -1) {
+		free (zi);
+		return NULL;
+	}
+	zi->from = from;
+	zi->size = size? size: st.st_size - from;
+	zi->mtime = st.st_mtime;
+	zi->gzip = gzip;
+	r_vector_init (&zi->points, sizeof (InflatePoint), point_free, NULL);
+	return zi;
+}
+
+static bool zi_add_point(RInflateIndex *zi, ut64 in, ut64 out, int bits, const ut8 *window, int left) {
+	InflatePoint *p = r_vector_push (&zi->points, NULL);
+	if (!p) {
+		return false;
+	}
+	memset (p, 0, sizeof (InflatePoint));
+	p->in = in;
+	p->out = out;
+	p->bits = bits;
+	if (!window) {
+		return true;
+	}
+	// the window is circular, left is where it continues
+	ut8 *dict = malloc (WINSIZE);
+	uLongf zlen = compressBound (WINSIZE);
+	p->win = malloc (zlen);
+	if (!dict || !p->win) {
+		free (dict);
+		return false;
+	}
+	if (left) {
+		memcpy (dict, window + WINSIZE - left, left);
+	}
+	if (left < WINSIZE) {
+		memcpy (dict + left, window, WINSIZE - left);
+	}
+	bool ok = compress2 (p->win, &zlen, dict, WINSIZE, Z_BEST_SPEED) == Z_OK;
+	free (dict);
+	if (ok) {
+		ut8 *win = realloc (p->win, zlen);
+		p->win = win? win: p->win;
+		p->winlen = zlen;
+	}
+	return ok;
+}
+
+static bool zi_build(RInflateIndex *zi) {
+	ut8 *input = malloc (CHUNK);
+	ut8 *window = calloc (1, WINSIZE);
+	ut64 totin = 0, totout = 0, last = 0;
+	z_stream strm = {0};
+	bool ok = false;
+	int ret = Z_OK;
+
+	if (!input || !window || inflateInit2 (&strm, zi->gzip? 15 + 16: -15) != Z_OK) {
+		free (input);
+		free (window);
+		return false;
+	}
+	zi_add_point (zi, 0, 0, 0, NULL, 0);
+	strm.avail_out = 0;
+	for (;;) {
+		if (!strm.avail_in) {
+			int n = zi_input (zi, totin, input, CHUNK);
+			if (n <= 0) {
+				// truncated stream, keep what could be inflated
+				ok = totout > 0;
+				break;
+			}
+			strm.next_in = input;
+			strm.avail_in = n;
+		}
+		if (!strm.avail_out) {
+			strm.next_out = window;
+			strm.avail_out = WINSIZE;
+		}
+		totin += strm.avail_in;
+		totout += strm.avail_out;
+		ret = inflate (&strm, Z_BLOCK);
+		totin -= strm.avail_in;
+		totout -= strm.avail_out;
+		if (ret == Z_STREAM_END) {
+			ok = true;
+			if (!zi->gzip) {
+				break;
+			}
+			// concatenated gzip members are one stream
+			if (!strm.avail_in) {
+				int n = zi_input (zi, totin, input, CHUNK);
+				if (n <= 0) {
+					break;
+				}
+				strm.next_in = input;
+				strm.avail_in = n;
+			}
+			if (strm.next_in[0] != 0x1f) {
+				break;
+			}
+			inflateReset (&strm);
+			zi_add_point (zi, totin, totout, 0, NULL, 0);
+			continue;
+		}
+		if (ret != Z_OK) {
+			ok = totout > 0;
+			break;
+		}
+		if ((strm.data_type & 128) && !(strm.data_type & 64) && totout - last > SPAN) {
+			if (!zi_add_point (zi, totin, totout, strm.data_type & 7, window, strm.avail_out)) {
+				break;
+			}
+			last = totout;
+		}
+	}
+	inflateEnd (&strm);
+	free (input);
+	free (window);
+	zi->length = totout;
+	return ok;
+}
+
+/* restarts the decoder at the last checkpoint before out */
+static bool zi_start(RInflateIndex *zi, ut64 out) {
+	InflatePoint *p = NULL, *points = zi->points.a;
+	size_t lo = 0, hi = zi->points.len;
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		if (points[mid].out <= out) {
+			p = &points[mid];
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if (!p) {
+		return false;
+	}
+	if (zi->live) {
+		inflateEnd (&zi->strm);
+		zi->live = false;
+	}
+	memset (&zi->strm, 0, sizeof (z_stream));
+	zi->raw = p->win || !zi->gzip;
+	if (inflateInit2 (&zi->strm, zi->raw? -15: 15 + 16) != Z_OK) {
+		return false;
+	}
+	zi->live = true;
+	zi->in = p->in;
+	zi->out = p->out;
+	if (p->bits) {
+		ut8 b;
+		if (zi_input (zi, p->in - 1, &b, 1) != 1) {
+			return false;
+		}
+		inflatePrime (&zi->strm, p->bits, b >> (8 - p->bits));
+	}
+	if (p->win) {
+		uLongf dlen = WINSIZE;
+		ut8 *dict = malloc (WINSIZE);
+		bool ok = dict && uncompress (dict, &dlen, p->win, p->winlen) == Z_OK
+			&& inflateSetDictionary (&zi->strm, dict, dlen) == Z_OK;
+		free (dict);
+		return ok;
+	}
+	return true;
+}
+
+static int zi_inflate(RInflateIndex *zi, ut8 *buf, int len) {
+	z_stream *s = &zi->strm;
+	s->next_out = buf;
+	s->avail_out = len;
+	while (s->avail_out) {
+		if (!s->avail_in && !zi_refill (zi)) {
+			break;
+		}
+		int ret = inflate (s, Z_NO_FLUSH);
+		if (ret == Z_STREAM_END) {
+			if (!zi->gzip) {
+				break;
+			}
+			if (zi->raw) {
+				// started mid member, skip its trailer to reach the next one
+				int trailer = 8;
+				while (trailer > 0) {
+					if (!s->avail_in && !zi_refill (zi)) {
+						break;
+					}
+					int n = R_MIN (trailer, (int)s->avail_in);
+					s->next_in += n;
+					s->avail_in -= n;
+					trailer -= n;
+				}
+				inflateReset2 (s, 15 + 16);
+				zi->raw = false;
+			} else {
+				inflateReset (s);
+			}
+			continue;
+		}
+		if (ret != Z_OK) {
+			break;
+		}
+	}
+	int n = len - s->avail_out;
+	zi->out += n;
+	return n;
+}
+
+static InflateBlock *zi_block(RInflateIndex *zi, ut64 idx) {
+	InflateBlock *b = zi->blocks, *victim = zi->blocks;
+	int i;
+	for (i = 0; i < NBLOCKS; i++, b++) {
+		if (b->idx == idx + 1) {
+			b->used = ++zi->tick;
+			return b;
+		}
+		if (b->used < victim->used) {
+			victim = b;
+		}
+	}
+	if (!victim->data && !(victim->data = malloc (BLOCK))) {
+		return NULL;
+	}
+	victim->idx = 0;
+	ut64 at = idx * BLOCK;
+	bool restart = !zi->live || at < zi->out;
+	if (!restart) {
+		// a checkpoint past the decoder is closer
+		InflatePoint *points = zi->points.a;
+		size_t lo = 0, hi = zi->points.len;
+		while (lo < hi) {
+			size_t mid = (lo + hi) / 2;
+			if (points[mid].out <= at) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		restart = lo && points[lo - 1].out > zi->out;
+	}
+	if (restart && !zi_start (zi, at)) {
+		return NULL;
+	}
+	while (zi->out < at) {
+		if (zi_inflate (zi, victim->data, (int)R_MIN (BLOCK, at - zi->out)) <= 0) {
+			return NULL;
+		}
+	}
+	victim->len = zi_inflate (zi, victim->data, (int)R_MIN (BLOCK, zi->length - at));
+	victim->idx = idx + 1;
+	victim->used = ++zi->tick;
+	return victim;
+}
+
+R_API RInflateIndex *r_inflate_index_new(const char *file, ut64 from, ut64 size, bool gzip) {
+	r_return_val_if_fail (file, NULL);
+	RInflateIndex *zi = zi_new (file, from, size, gzip);
+	if (zi && !zi_build (zi)) {
+		r_inflate_index_free (zi);
+		return NULL;
+	}
+	return zi;
+}
+
+R_API bool r_inflate_index_save(RInflateIndex *zi, const char *path) {
+	r_return_val_if_fail (zi && path, false);
+	InflatePoint *p;
+	ut64 len = 4 + 4 + 8 * 5 + 1 + 4;
+	r_vector_foreach (&zi->points, p) {
+		len += 8 + 8 + 1 + 4 + p->winlen;
+	}
+	ut8 *buf = malloc (len), *b = buf;
+	if (!buf) {
+		return false;
+	}
+	memcpy (b, INDEX_MAGIC, 4);
+	r_write_le32 (b + 4, INDEX_VERSION);
+	r_write_le64 (b + 8, zi->from);
+	r_write_le64 (b + 16, zi->size);
+	r_write_le64 (b + 24, zi->mtime);
+	r_write_le64 (b + 32, zi->length);
+	r_write_le64 (b + 40, SPAN);
+	b[48] = zi->gzip;
+	r_write_le32 (b + 49, (ut32)zi->points.len);
+	b += 53;
+	r_vector_foreach (&zi->points, p) {
+		r_write_le64 (b, p->out);
+		r_write_le64 (b + 8, p->in);
+		b[16] = p->bits;
+		r_write_le32 (b + 17, p->winlen);
+		memcpy (b + 21, p->win, p->winlen);
+		b += 21 + p->winlen;
+	}
+	bool ret = r_file_dump (path, buf, (int)len, false);
+	free (buf);
+	return ret;
+}
+
+static bool zi_parse(RInflateIndex *zi, const ut8 *b, int len) {
+	const ut8 *end = b + len;
+	if (len < 53 || memcmp (b, INDEX_MAGIC, 4) || r_read_le32 (b + 4) != INDEX_VERSION) {
+		return false;
+	}
+	// must describe this very stream
+	if (r_read_le64 (b + 8) != zi->from || r_read_le64 (b + 16) != zi->size
+			|| r_read_le64 (b + 24) != zi->mtime || b[48] != zi->gzip) {
+		return false;
+	}
+	zi->length = r_read_le64 (b + 32);
+	ut32 i, n = r_read_le32 (b + 49);
+	b += 53;
+	for (i = 0; i < n; i++) {
+		if (end - b < 21) {
+			return false;
+		}
+		ut32 winlen = r_read_le32 (b + 17);
+		if ((ut64)(end - b - 21) < winlen) {
+			return false;
+		}
+		if (!zi_add_point (zi, r_read_le64 (b + 8), r_read_le64 (b), b[16] & 7, NULL, 0)) {
+			return false;
+		}
+		if (winlen) {
+			InflatePoint *p = r_vector_index_ptr (&zi->points, zi->points.len - 1);
+			if (!(p->win = r_mem_dup (b + 21, winlen))) {
+				return false;
+			}
+			p->winlen = winlen;
+		}
+		b += 21 + winlen;
+	}
+	return n > 0;
+}
+
+/* uses the index saved in path when it matches the stream */
+R_API RInflateIndex *r_inflate_index_load(const char *file, ut64 from, ut64 size, bool gzip, const char *path) {
+	r_return_val_if_fail (file && path, NULL);
+	int len = 0;
+	ut8 *data = (ut8 *)r_file_slurp (path, &len);
+	if (!data) {
+		return NULL;
+	}
+	RInflateIndex *zi = zi_new (file, from, size, gzip);
+	if (zi && !zi_parse (zi, data, len)) {
+		r_inflate_index_free (zi);
+		zi = NULL;
+	}
+	free (data);
+	return zi;
+}
+
+R_API void r_inflate_index_free(RInflateIndex *zi) {
+	if (!zi) {
+		return;
+	}
+	int i;
+	for (i = 0; i < NBLOCKS; i++) {
+		free (zi->blocks[i].data);
+	}
+	if (zi->live) {
+		inflateEnd (&zi->strm);
+	}
+	r_vector_clear (&zi->points);
+	close (zi->fd);
+	free (zi);
+}
+
+R_API ut64 r_inflate_index_size(RInflateIndex *zi) {
+	r_return_val_if_fail (zi, 0);
+	return zi->length;
+}
+
+/* returns the number of bytes read, short at the end of the data */
+R_API int r_inflate_index_read(RInflateIndex *zi, ut64 addr, ut8 *buf, int len) {
+	r_return_val_if_fail (zi && buf && len >= 0, -1);
+	int done = 0;
+	while (done < len && addr < zi->length) {
+		InflateBlock *b = zi_block (zi, addr / BLOCK);
+		int off = addr % BLOCK;
+		if (!b || b->len <= off) {
+			break;
+		}
+		int n = R_MIN (len - done, b->len - off);
+		memcpy (buf + done, b->data + off, n);
+		done += n;
+		addr += n;
+	}
+	return done;
+}
@@ -41,3 +41,329 @@ R_API double r_prof_end(struct r_prof_t *p) {
 		+ ((double)diff.tv_usec / 1000000.)));
 	return R_ABS (sign);
 }
+
+/* hot path profiler, see r_prof.h */
+
+typedef struct {
+	RProfNode root;
+	RProfNode *cur;
+	ut64 *counts;
+	int ncounts;
+	bool dead; // its thread is gone, freed on reset
+} RProfThread;
+
+R_API bool r_prof_on = false;
+static R_TH_LOCAL RProfThread *prof_th = NULL;
+static RThreadLock *prof_lock = NULL;
+static RList *prof_threads = NULL;
+static RProfSite **prof_sites = NULL;
+static int prof_nsites = 0;
+
+static RProfThread *prof_thread(void) {
+	if (!prof_th) {
+		RProfThread *th = R_NEW0 (RProfThread);
+		if (!th) {
+			return NULL;
+		}
+		th->cur = &th->root;
+		r_th_lock_enter (prof_lock);
+		r_list_append (prof_threads, th);
+		r_th_lock_leave (prof_lock);
+		prof_th = th;
+	}
+	return prof_th;
+}
+
+static int prof_site_id(RProfSite *site) {
+	if (!site->id) {
+		r_th_lock_enter (prof_lock);
+		int i;
+		// sites with the same name in different places are merged
+		for (i = 0; !site->id && i < prof_nsites; i++) {
+			if (prof_sites[i]->timer == site->timer && !strcmp (prof_sites[i]->name, site->name)) {
+				site->id = i + 1;
+			}
+		}
+		if (!site->id) {
+			RProfSite **sites = realloc (prof_sites, sizeof (RProfSite *) * (prof_nsites + 1));
+			if (sites) {
+				prof_sites = sites;
+				prof_sites[prof_nsites++] = site;
+				site->id = prof_nsites;
+			}
+		}
+		r_th_lock_leave (prof_lock);
+	}
+	return site->id;
+}
+
+R_API void r_prof_enable(bool enable) {
+	if (!prof_lock) {
+		prof_lock = r_th_lock_new (false);
+		prof_threads = r_list_new ();
+	}
+	r_prof_on = enable && prof_lock && prof_threads;
+}
+
+static void prof_node_reset(RProfNode *node) {
+	for (; node; node = node->next) {
+		node->calls = node->total = 0;
+		prof_node_reset (node->child);
+	}
+}
+
+static void prof_node_free(RProfNode *node) {
+	RProfNode *next;
+	for (; node; node = next) {
+		next = node->next;
+		prof_node_free (node->child);
+		free (node);
+	}
+}
+
+/* called by the threads started with r_th_new when they end, what they
+ * collected stays until the next reset */
+R_API void r_prof_thread_exit(void) {
+	if (prof_th) {
+		r_th_lock_enter (prof_lock);
+		prof_th->dead = true;
+		r_th_lock_leave (prof_lock);
+		prof_th = NULL;
+	}
+}
+
+/* zeroes what was collected so far, scopes open meanwhile still end fine */
+R_API void r_prof_reset(void) {
+	RProfThread *th;
+	RListIter *iter, *tmp;
+	if (!prof_lock) {
+		return;
+	}
+	r_th_lock_enter (prof_lock);
+	r_list_foreach_safe (prof_threads, iter, tmp, th) {
+		if (th->dead) {
+			prof_node_free (th->root.child);
+			free (th->counts);
+			free (th);
+			r_list_delete (prof_threads, iter);
+			continue;
+		}
+		prof_node_reset (th->root.child);
+		memset (th->counts, 0, sizeof (ut64) * th->ncounts);
+	}
+	r_th_lock_leave (prof_lock);
+}
+
+R_API void r_prof_count(RProfSite *site) {
+	RProfThread *th = prof_thread ();
+	int id = prof_site_id (site);
+	if (!th || !id) {
+		return;
+	}
+	if (id > th->ncounts) {
+		// dump and reset walk the counts of every thread
+		r_th_lock_enter (prof_lock);
+		int n = prof_nsites + 16;
+		ut64 *counts = realloc (th->counts, sizeof (ut64) * n);
+		if (counts) {
+			memset (counts + th->ncounts, 0, sizeof (ut64) * (n - th->ncounts));
+			th->counts = counts;
+			th->ncounts = n;
+		}
+		r_th_lock_leave (prof_lock);
+		if (!counts) {
+			return;
+		}
+	}
+	th->counts[id - 1]++;
+}
+
+R_API RProfNode *r_prof_enter(RProfSite *site) {
+	RProfThread *th = prof_thread ();
+	if (!th || !prof_site_id (site)) {
+		return NULL;
+	}
+	RProfNode *node, *parent = th->cur;
+	for (node = parent->child; node; node = node->next) {
+		if (node->site->id == site->id) {
+			break;
+		}
+	}
+	if (!node) {
+		if (!(node = R_NEW0 (RProfNode))) {
+			return NULL;
+		}
+		node->site = site;
+		node->parent = parent;
+		// dump and reset walk the trees of every thread
+		r_th_lock_enter (prof_lock);
+		node->next = parent->child;
+		parent->child = node;
+		r_th_lock_leave (prof_lock);
+	}
+	node->calls++;
+	th->cur = node;
+	node->start = r_sys_now_mono ();
+	return node;
+}
+
+R_API void r_prof_leave(RProfNode *node) {
+	node->total += r_sys_now_mono () - node->start;
+	// also closes the scopes whose end was skipped
+	prof_th->cur = node->parent;
+}
+
+typedef struct {
+	ut64 calls;
+	ut64 total;
+	ut64 self;
+	ut64 count;
+} RProfStat;
+
+static bool prof_nested(RProfNode *node) {
+	RProfNode *p;
+	for (p = node->parent; p && p->site; p = p->parent) {
+		if (p->site->id == node->site->id) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static ut64 prof_self(RProfNode *node) {
+	ut64 children = 0;
+	RProfNode *c;
+	for (c = node->child; c; c = c->next) {
+		children += c->total;
+	}
+	return node->total > children? node->total - children: 0;
+}
+
+static void prof_stats(RProfNode *node, RProfStat *stats) {
+	for (; node; node = node->next) {
+		RProfStat *st = &stats[node->site->id - 1];
+		st->calls += node->calls;
+		st->self += prof_self (node);
+		if (!prof_nested (node)) {
+			st->total += node->total;
+		}
+		prof_stats (node->child, stats);
+	}
+}
+
+/* one line per call path with its self time in us, as flamegraph.pl wants */
+static void prof_folded(RProfNode *node, char *path, int len, RStrBuf *sb) {
+	for (; node; node = node->next) {
+		int n = snprintf (path + len, 1024 - len, "%s%s", len? ";": "", node->site->name);
+		if (n < 0 || len + n >= 1024) {
+			continue;
+		}
+		ut64 self = prof_self (node) / 1000;
+		if (self) {
+			r_strbuf_appendf (sb, "%s %"PFMT64d"\n", path, self);
+		}
+		prof_folded (node->child, path, len + n, sb);
+		path[len] = 0;
+	}
+}
+
+static RProfStat *prof_sorted_stats;
+
+static int prof_cmp(const void *a, const void *b) {
+	const RProfStat *sa = &prof_sorted_stats[(*(RProfSite **)a)->id - 1];
+	const RProfStat *sb = &prof_sorted_stats[(*(RProfSite **)b)->id - 1];
+	ut64 va = sa->total + sa->count;
+	ut64 vb = sb->total + sb->count;
+	return (va < vb) - (va > vb);
+}
+
+/* mode is 'j' for json, 'f' for folded stacks, else a table */
+R_API char *r_prof_dump(int mode) {
+	RProfThread *th;
+	RListIter *iter;
+	int i;
+	if (!prof_lock) {
+		return strdup (mode == 'j'? "{\"timers\":[],\"counters\":[]}": "");
+	}
+	RStrBuf *sb = r_strbuf_new ("");
+	r_th_lock_enter (prof_lock);
+	if (mode == 'f') {
+		char path[1024] = {0};
+		r_list_foreach (prof_threads, iter, th) {
+			prof_folded (th->root.child, path, 0, sb);
+		}
+		r_th_lock_leave (prof_lock);
+		return r_strbuf_drain (sb);
+	}
+	RProfStat *stats = calloc (prof_nsites + 1, sizeof (RProfStat));
+	RProfSite **sites = R_NEWS (RProfSite *, prof_nsites + 1);
+	if (!stats || !sites) {
+		r_th_lock_leave (prof_lock);
+		free (stats);
+		free (sites);
+		return r_strbuf_drain (sb);
+	}
+	r_list_foreach (prof_threads, iter, th) {
+		prof_stats (th->root.child, stats);
+		for (i = 0; i < th->ncounts && i < prof_nsites; i++) {
+			stats[i].count += th->counts[i];
+		}
+	}
+	memcpy (sites, prof_sites, sizeof (RProfSite *) * prof_nsites);
+	int nsites = prof_nsites;
+	r_th_lock_leave (prof_lock);
+	prof_sorted_stats = stats;
+	qsort (sites, nsites, sizeof (RProfSite *), prof_cmp);
+	if (mode == 'j') {
+		PJ *pj = pj_new ();
+		pj_o (pj);
+		pj_k (pj, "timers");
+		pj_a (pj);
+		for (i = 0; i < nsites; i++) {
+			RProfStat *st = &stats[sites[i]->id - 1];
+			if (sites[i]->timer && st->calls) {
+				pj_o (pj);
+				pj_ks (pj, "name", sites[i]->name);
+				pj_kn (pj, "calls", st->calls);
+				pj_kn (pj, "total_ns", st->total);
+				pj_kn (pj, "self_ns", st->self);
+				pj_end (pj);
+			}
+		}
+		pj_end (pj);
+		pj_k (pj, "counters");
+		pj_a (pj);
+		for (i = 0; i < nsites; i++) {
+			if (!sites[i]->timer && stats[sites[i]->id - 1].count) {
+				pj_o (pj);
+				pj_ks (pj, "name", sites[i]->name);
+				pj_kn (pj, "count", stats[sites[i]->id - 1].count);
+				pj_end (pj);
+			}
+		}
+		pj_end (pj);
+		pj_end (pj);
+		r_strbuf_free (sb);
+		sb = NULL;
+		char *s = pj_drain (pj);
+		free (stats);
+		free (sites);
+		return s;
+	}
+	r_strbuf_append (sb, "      calls    total ms     self ms  name\n");
+	for (i = 0; i < nsites; i++) {
+		RProfStat *st = &stats[sites[i]->id - 1];
+		if (!st->calls && !st->count) {
+			continue;
+		}
+		if (sites[i]->timer) {
+			r_strbuf_appendf (sb, "%11"PFMT64d" %11.3f %11.3f  %s\n", st->calls,
+				st->total / 1000000.0, st->self / 1000000.0, sites[i]->name);
+		} else {
+			r_strbuf_appendf (sb, "%11"PFMT64d" %11s %11s  %s\n", st->count, "-", "-", sites[i]->name);
+		}
+	}
+	free (stats);
+	free (sites);
+	return r_strbuf_drain (sb);
+}
@@ -724,6 +724,15 @@ R_API char *r_str_newf(const char *fmt, ...) {
 	return p;
 }
 
+/* formats into buf and returns it, used by the r_strf macros */
+R_API char *r_strf_into(char *buf, size_t size, const char *fmt, ...) {
+	va_list ap;
+	va_start (ap, fmt);
+	vsnprintf (buf, size, fmt, ap);
+	va_end (ap);
+	return buf;
+}
+
 // Secure string copy with null terminator (like strlcpy or strscpy but ours
 R_API void r_str_ncpy(char *dst, const char *src, size_t n) {
 	int i;
@@ -2012,6 +2021,124 @@ R_API bool r_str_glob(const char* str, const char *glob) {
         return (*glob == '\x00');
 }
 
+enum {
+	GLOB_ANY,    // NULL or "*"
+	GLOB_SUBSTR, // no '*' and no '^', same as strstr
+	GLOB_PREFIX, // "^foo"
+	GLOB_WILD,   // anchored at both ends, with '*' between the literals
+};
+
+struct r_str_glob_t {
+	int kind;
+	char *pat;     // the literals, nul separated
+	size_t len;    // strlen (pat) for GLOB_PREFIX
+	char **parts;  // literal between each '*' for GLOB_WILD
+	size_t *lens;
+	int nparts;
+};
+
+R_API void r_str_glob_free(RStrGlob *g) {
+	if (g) {
+		free (g->pat);
+		free (g->parts);
+		free (g->lens);
+		free (g);
+	}
+}
+
+/* compile the glob once, r_str_glob_match (g, s) is r_str_glob (s, glob) */
+R_API RStrGlob *r_str_glob_new(const char *glob) {
+	RStrGlob *g = R_NEW0 (RStrGlob);
+	if (!g) {
+		return NULL;
+	}
+	if (!glob || !strcmp (glob, "*")) {
+		g->kind = GLOB_ANY;
+		return g;
+	}
+	bool wild = strchr (glob, '*');
+	if (*glob == '^') {
+		glob++;
+		g->kind = wild? GLOB_WILD: GLOB_PREFIX;
+	} else {
+		g->kind = wild? GLOB_WILD: GLOB_SUBSTR;
+	}
+	g->pat = strdup (glob);
+	if (!g->pat) {
+		goto fail;
+	}
+	if (g->kind != GLOB_WILD) {
+		g->len = strlen (g->pat);
+		return g;
+	}
+	g->nparts = r_str_char_count (g->pat, '*') + 1;
+	g->parts = R_NEWS (char *, g->nparts);
+	g->lens = R_NEWS (size_t, g->nparts);
+	if (!g->parts || !g->lens) {
+		goto fail;
+	}
+	char *p = g->pat;
+	int i;
+	for (i = 0; i < g->nparts; i++) {
+		char *star = strchr (p, '*');
+		if (star) {
+			*star = 0;
+		}
+		g->parts[i] = p;
+		g->lens[i] = strlen (p);
+		p = star? star + 1: p + g->lens[i];
+	}
+	return g;
+fail:
+	r_str_glob_free (g);
+	return NULL;
+}
+
+R_API bool r_str_glob_match(const RStrGlob *g, const char *str) {
+	r_return_val_if_fail (g && str, false);
+	switch (g->kind) {
+	case GLOB_ANY:
+		return true;
+	case GLOB_SUBSTR:
+		return strstr (str, g->pat) != NULL;
+	case GLOB_PREFIX:
+		if (!g->len) {
+			return !*str;
+		}
+		if (strncmp (str, g->pat, g->len)) {
+			// like r_str_glob, a string shorter than the prefix still
+			// matches if only one more '^' is left in the pattern
+			size_t n = strlen (str);
+			return n < g->len && !strncmp (str, g->pat, n)
+				&& !strcmp (g->pat + n, "^");
+		}
+		return true;
+	}
+	// the first literal is a prefix, the last one a suffix and the ones
+	// in between are found left to right with strstr
+	size_t len = strlen (str);
+	size_t head = g->lens[0];
+	size_t tail = g->lens[g->nparts - 1];
+	if (head + tail > len || strncmp (str, g->parts[0], head)
+			|| strcmp (str + len - tail, g->parts[g->nparts - 1])) {
+		return false;
+	}
+	const char *s = str + head;
+	const char *end = str + len - tail;
+	int i;
+	for (i = 1; i < g->nparts - 1; i++) {
+		if (!g->lens[i]) {
+			continue;
+		}
+		const char *m = strstr (s, g->parts[i]);
+		if (!m || m + g->lens[i] > end) {
+			return false;
+		}
+		s = m + g->lens[i];
+	}
+	return true;
+}
+
 // Escape the string arg so that it is parsed as a single argument by r_str_argv
 R_API char *r_str_arg_escape(const char *arg) {
 	char *str;
@@ -137,6 +137,49 @@ R_API ut64 r_sys_now(void) {
 	return ret;
 }
 
+/* nanoseconds from a monotonic clock, for measuring elapsed time */
+R_API ut64 r_sys_now_mono(void) {
+#if __UNIX__ && defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return (ut64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#else
+	ut64 now = r_sys_now ();
+	return ((now >> 20) * 1000000 + (now & 0xfffff)) * 1000;
+#endif
+}
+
+// write or read exactly len bytes, retrying short transfers on pipes and sockets
+R_API bool r_sys_write_full(int fd, const ut8 *buf, int len) {
+	while (len > 0) {
+		int rv = write (fd, buf, len);
+		if (rv < 1) {
+			if (rv == -1 && errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		buf += rv;
+		len -= rv;
+	}
+	return true;
+}
+
+R_API bool r_sys_read_full(int fd, ut8 *buf, int len) {
+	while (len > 0) {
+		int rv = read (fd, buf, len);
+		if (rv < 1) {
+			if (rv == -1 && errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		buf += rv;
+		len -= rv;
+	}
+	return true;
+}
+
 R_API int r_sys_truncate(const char *file, int sz) {
 #if __WINDOWS__
 	int fd = r_sandbox_open (file, O_RDWR, 0644);
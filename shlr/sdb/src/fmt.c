@@ -20,11 +20,20 @@
 	} \
 }
 
+/* each thread gets its own ring of buffers */
+#if defined(_MSC_VER)
+#define SDB_TLS __declspec(thread)
+#elif defined(__GNUC__)
+#define SDB_TLS __thread
+#else
+#define SDB_TLS
+#endif
+
 SDB_API char *sdb_fmt(const char *fmt, ...) {
 #define KL 256
 #define KN 16
-	static char Key[KN][KL];
-	static int n = 0;
+	static SDB_TLS char Key[KN][KL];
+	static SDB_TLS int n = 0;
 	va_list ap;
 	va_start (ap, fmt);
 	n = (n + 1) % KN;
@@ -0,0 +1,1891 @@
+/* radare - LGPL - Copyright 2026 - agent */
+
+/* micro and macro benchmarks for the core libraries.
+ * every benchmark runs a fixed amount of work on inputs generated from a
+ * fixed seed, so two runs on the same machine are comparable. results are
+ * written as json and can be checked against a stored baseline */
+
+#include <r_core.h>
+#include <r_getopt.h>
+
+#define BENCH_SEED 0x31337
+#define BENCH_FCN_SIZE 32
+#define BENCH_BASE 0x400000
+#define BENCH_CODE 0x1000
+
+typedef struct {
+	const char *name;
+	const char *desc;
+	ut64 iters; // work done by one sample
+	bool macro;
+	void *(*init)(void);
+	bool (*run)(void *user, ut64 iters);
+	void (*fini)(void *user);
+	bool (*setup)(void *user); // before each sample, not timed
+	double (*p99)(void *user); // for the benchmarks keeping the latency of each op
+} RBench;
+
+typedef struct {
+	const char *name;
+	ut64 iters;
+	double ns; // median per iteration
+	double min;
+	double max;
+	double p99; // ns, 0 when not measured
+} RBenchResult;
+
+static const char *bench_file = NULL;
+static int bench_nfcns = 2000;
+
+static ut32 bench_rand(ut32 *seed) {
+	// xorshift32, the same sequence everywhere
+	ut32 x = *seed;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return *seed = x;
+}
+
+static int bench_cmp_double(const void *a, const void *b) {
+	double da = *(const double *)a;
+	double db = *(const double *)b;
+	return (da > db) - (da < db);
+}
+
+static ut8 *bench_bytes(int len) {
+	ut32 seed = BENCH_SEED;
+	ut8 *buf = malloc (len);
+	int i;
+	if (buf) {
+		for (i = 0; i < len; i++) {
+			buf[i] = bench_rand (&seed) & 0xff;
+		}
+	}
+	return buf;
+}
+
+/* x86-64 code made of nfcns functions of BENCH_FCN_SIZE bytes calling each
+ * other, so the analysis finds all of them starting from the entrypoint */
+static ut8 *bench_code(int nfcns, int *len) {
+	const int size = nfcns * BENCH_FCN_SIZE;
+	ut8 *code = malloc (size);
+	ut32 seed = BENCH_SEED;
+	int i;
+	if (!code) {
+		return NULL;
+	}
+	for (i = 0; i < nfcns; i++) {
+		ut8 *p = code + i * BENCH_FCN_SIZE;
+		int at = i * BENCH_FCN_SIZE;
+		int next = ((i + 1) % nfcns) * BENCH_FCN_SIZE;
+		int other = (bench_rand (&seed) % nfcns) * BENCH_FCN_SIZE;
+		memcpy (p, "\x55" // push rbp
+			"\x48\x89\xe5" // mov rbp, rsp
+			"\x89\x7d\xfc" // mov dword [rbp - 4], edi
+			"\x8b\x45\xfc" // mov eax, dword [rbp - 4]
+			"\x83\xc0\x00" // add eax, i
+			"\x83\xf8\x10" // cmp eax, 0x10
+			"\x7e\x05" // jle +5
+			"\xe8\x00\x00\x00\x00" // call next
+			"\x89\xc7" // mov edi, eax
+			"\xe8\x00\x00\x00\x00" // call other
+			"\xc9" // leave
+			"\xc3", BENCH_FCN_SIZE); // ret
+		p[12] = i & 0x7f;
+		r_write_le32 (p + 19, next - (at + 23));
+		r_write_le32 (p + 26, other - (at + 30));
+	}
+	*len = size;
+	return code;
+}
+
+/* minimal static elf64 with a single rx segment */
+static bool bench_gen(const char *file, int nfcns) {
+	int i, len = 0;
+	ut8 *code = bench_code (nfcns, &len);
+	if (!code) {
+		return false;
+	}
+	const int size = BENCH_CODE + len;
+	ut8 *elf = calloc (1, size);
+	if (!elf) {
+		free (code);
+		return false;
+	}
+	memcpy (elf, "\x7f" "ELF\x02\x01\x01", 7);
+	r_write_le16 (elf + 16, 2); // ET_EXEC
+	r_write_le16 (elf + 18, 62); // EM_X86_64
+	r_write_le32 (elf + 20, 1);
+	r_write_le64 (elf + 24, BENCH_BASE + BENCH_CODE);
+	r_write_le64 (elf + 32, 64);
+	r_write_le16 (elf + 52, 64);
+	r_write_le16 (elf + 54, 56);
+	r_write_le16 (elf + 56, 1);
+	r_write_le16 (elf + 58, 64);
+	ut8 *ph = elf + 64;
+	r_write_le32 (ph, 1); // PT_LOAD
+	r_write_le32 (ph + 4, 5); // R+X
+	r_write_le64 (ph + 16, BENCH_BASE);
+	r_write_le64 (ph + 24, BENCH_BASE);
+	r_write_le64 (ph + 32, size);
+	r_write_le64 (ph + 40, size);
+	r_write_le64 (ph + 48, 0x1000);
+	memcpy (elf + BENCH_CODE, code, len);
+	for (i = 64 + 56; i < BENCH_CODE; i++) {
+		elf[i] = 0xcc;
+	}
+	bool ret = r_file_dump (file, elf, size, false);
+	free (code);
+	free (elf);
+	return ret;
+}
+
+/* r_io: random reads through a skyline made of many overlapping maps */
+
+typedef struct {
+	RIO *io;
+	ut64 *addrs;
+} BenchIO;
+
+#define IO_NMAPS 256
+#define IO_NADDRS 4096
+
+static void *io_init(void) {
+	BenchIO *b = R_NEW0 (BenchIO);
+	ut32 seed = BENCH_SEED;
+	int i;
+	if (!b || !(b->io = r_io_new ())) {
+		free (b);
+		return NULL;
+	}
+	RIODesc *desc = r_io_open_at (b->io, "malloc://0x100000", R_PERM_RW, 0644, 0);
+	if (!desc) {
+		r_io_free (b->io);
+		free (b);
+		return NULL;
+	}
+	for (i = 0; i < IO_NMAPS; i++) {
+		ut64 addr = (bench_rand (&seed) % 0x100) * 0x1000;
+		ut64 size = 0x1000 + (bench_rand (&seed) % 0x10) * 0x1000;
+		r_io_map_add (b->io, desc->fd, R_PERM_RW, bench_rand (&seed) % 0x80000, addr, size);
+	}
+	b->addrs = R_NEWS (ut64, IO_NADDRS);
+	for (i = 0; b->addrs && i < IO_NADDRS; i++) {
+		b->addrs[i] = bench_rand (&seed) % 0x110000;
+	}
+	return b;
+}
+
+static bool io_run(void *user, ut64 iters) {
+	BenchIO *b = user;
+	ut8 buf[64];
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		r_io_read_at (b->io, b->addrs[i % IO_NADDRS], buf, sizeof (buf));
+	}
+	return true;
+}
+
+static void io_fini(void *user) {
+	BenchIO *b = user;
+	r_io_free (b->io);
+	free (b->addrs);
+	free (b);
+}
+
+/* r_anal: decode the generated code with the x86 plugin */
+
+typedef struct {
+	RAnal *anal;
+	RAnalEsil *esil;
+	ut8 *code;
+	int len;
+} BenchAnal;
+
+static void *anal_init(void) {
+	BenchAnal *b = R_NEW0 (BenchAnal);
+	if (!b || !(b->anal = r_anal_new ())) {
+		free (b);
+		return NULL;
+	}
+	if (!r_anal_use (b->anal, "x86")) {
+		eprintf ("Cannot find the x86 analysis plugin\n");
+		r_anal_free (b->anal);
+		free (b);
+		return NULL;
+	}
+	r_anal_set_bits (b->anal, 64);
+	b->code = bench_code (bench_nfcns, &b->len);
+	return b;
+}
+
+static bool anal_run(void *user, ut64 iters) {
+	BenchAnal *b = user;
+	RAnalOp op;
+	int at = 0;
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		int n = r_anal_op (b->anal, &op, BENCH_BASE + BENCH_CODE + at,
+			b->code + at, b->len - at, R_ANAL_OP_MASK_BASIC);
+		r_anal_op_fini (&op);
+		if (n < 1) {
+			return false;
+		}
+		at += n;
+		if (at >= b->len) {
+			at = 0;
+		}
+	}
+	return true;
+}
+
+static void anal_fini(void *user) {
+	BenchAnal *b = user;
+	r_anal_esil_free (b->esil);
+	r_anal_free (b->anal);
+	free (b->code);
+	free (b);
+}
+
+/* capstone engines under threads: each thread alternates between an arm
+ * and a thumb RAnal on every op, so it keeps switching engines, and checks
+ * every result against a single threaded pass. iters counts ops per thread */
+
+#define CS_NTHREADS 4
+#define CS_NOPS 4096
+
+typedef struct {
+	RAnal *arm;
+	RAnal *thumb;
+	RThread *th;
+	ut64 iters;
+	bool ok;
+	void *bench;
+} BenchCsThread;
+
+typedef struct {
+	BenchCsThread t[CS_NTHREADS + 1];
+	ut8 *code;
+	ut32 ref[CS_NOPS];
+} BenchCs;
+
+static ut32 cs_op(BenchCs *b, BenchCsThread *t, int k) {
+	RAnal *anal = (k & 1)? t->thumb: t->arm;
+	RAnalOp op;
+	int n = r_anal_op (anal, &op, BENCH_BASE + k * 4, b->code + k * 4, 4, R_ANAL_OP_MASK_BASIC);
+	ut32 res = (R_MAX (n, 0) << 16) | (op.type & 0xffff);
+	r_anal_op_fini (&op);
+	return res;
+}
+
+static RThreadFunctionRet cs_thread(RThread *th) {
+	BenchCsThread *t = th->user;
+	BenchCs *b = t->bench;
+	ut64 i;
+	for (i = 0; i < t->iters; i++) {
+		int k = i % CS_NOPS;
+		if (cs_op (b, t, k) != b->ref[k]) {
+			t->ok = false;
+			break;
+		}
+	}
+	return R_TH_STOP;
+}
+
+static void cs_fini(void *user) {
+	BenchCs *b = user;
+	int i;
+	for (i = 0; i <= CS_NTHREADS; i++) {
+		r_anal_free (b->t[i].arm);
+		r_anal_free (b->t[i].thumb);
+	}
+	free (b->code);
+	free (b);
+}
+
+static void *cs_init(void) {
+	BenchCs *b = R_NEW0 (BenchCs);
+	int i;
+	if (!b || !(b->code = bench_bytes (CS_NOPS * 4))) {
+		free (b);
+		return NULL;
+	}
+	for (i = 0; i <= CS_NTHREADS; i++) {
+		BenchCsThread *t = &b->t[i];
+		t->bench = b;
+		t->arm = r_anal_new ();
+		t->thumb = r_anal_new ();
+		if (!t->arm || !t->thumb || !r_anal_use (t->arm, "arm") || !r_anal_use (t->thumb, "arm")) {
+			eprintf ("Cannot find the arm analysis plugin\n");
+			cs_fini (b);
+			return NULL;
+		}
+		r_anal_set_bits (t->arm, 32);
+		r_anal_set_bits (t->thumb, 16);
+	}
+	// the last one is the reference, decoded from this thread only
+	for (i = 0; i < CS_NOPS; i++) {
+		b->ref[i] = cs_op (b, &b->t[CS_NTHREADS], i);
+	}
+	return b;
+}
+
+static bool cs_run(void *user, ut64 iters) {
+	BenchCs *b = user;
+	bool ok = true;
+	int i;
+	for (i = 0; i < CS_NTHREADS; i++) {
+		BenchCsThread *t = &b->t[i];
+		t->iters = iters;
+		t->ok = true;
+		t->th = r_th_new (cs_thread, t, 0);
+	}
+	for (i = 0; i < CS_NTHREADS; i++) {
+		BenchCsThread *t = &b->t[i];
+		if (t->th) {
+			r_th_wait (t->th);
+			r_th_free (t->th);
+			t->th = NULL;
+		}
+		if (!t->ok) {
+			eprintf ("cs_threads: thread %d decoded differently\n", i);
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+/* esil: parse and evaluate an expression touching registers and flags */
+
+static void *esil_init(void) {
+	BenchAnal *b = anal_init ();
+	if (b) {
+		b->esil = r_anal_esil_new (32, 0, 64);
+		if (!b->esil || !r_anal_esil_setup (b->esil, b->anal, 0, 0, 1)) {
+			anal_fini (b);
+			return NULL;
+		}
+	}
+	return b;
+}
+
+static bool esil_run(void *user, ut64 iters) {
+	BenchAnal *b = user;
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		r_anal_esil_parse (b->esil, "1,rax,+=,rax,rbx,*,rcx,=,0x10,rcx,>,?{,rcx,rdx,^=,},rdx,0xff,&,rsi,=");
+		r_anal_esil_stack_free (b->esil);
+	}
+	return true;
+}
+
+/* sdb: hashtable and key-value store with symbol-like keys */
+
+typedef struct {
+	char **keys;
+	HtPP *ht;
+	Sdb *db;
+} BenchSdb;
+
+#define SDB_NKEYS 65536
+
+static void *sdb_init(void) {
+	BenchSdb *b = R_NEW0 (BenchSdb);
+	ut32 seed = BENCH_SEED;
+	int i;
+	if (!b || !(b->keys = R_NEWS0 (char *, SDB_NKEYS))) {
+		free (b);
+		return NULL;
+	}
+	for (i = 0; i < SDB_NKEYS; i++) {
+		b->keys[i] = r_str_newf ("sym.imp.fcn_%08x_%d", bench_rand (&seed), i);
+	}
+	return b;
+}
+
+static void sdb_fini(void *user) {
+	BenchSdb *b = user;
+	int i;
+	for (i = 0; i < SDB_NKEYS; i++) {
+		free (b->keys[i]);
+	}
+	free (b->keys);
+	ht_pp_free (b->ht);
+	sdb_free (b->db);
+	free (b);
+}
+
+static bool ht_insert_run(void *user, ut64 iters) {
+	BenchSdb *b = user;
+	ut64 i;
+	ht_pp_free (b->ht);
+	b->ht = ht_pp_new0 ();
+	for (i = 0; i < iters; i++) {
+		ht_pp_insert (b->ht, b->keys[i % SDB_NKEYS], b);
+	}
+	return true;
+}
+
+static void *ht_find_init(void) {
+	BenchSdb *b = sdb_init ();
+	if (b) {
+		ht_insert_run (b, SDB_NKEYS);
+	}
+	return b;
+}
+
+static bool ht_find_run(void *user, ut64 iters) {
+	BenchSdb *b = user;
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		if (!ht_pp_find (b->ht, b->keys[(i * 7) % SDB_NKEYS], NULL)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool sdb_set_run(void *user, ut64 iters) {
+	BenchSdb *b = user;
+	ut64 i;
+	sdb_free (b->db);
+	b->db = sdb_new0 ();
+	for (i = 0; i < iters; i++) {
+		sdb_set (b->db, b->keys[i % SDB_NKEYS], "0x8048000,32,func", 0);
+	}
+	return true;
+}
+
+static void *sdb_get_init(void) {
+	BenchSdb *b = sdb_init ();
+	if (b) {
+		sdb_set_run (b, SDB_NKEYS);
+	}
+	return b;
+}
+
+static bool sdb_get_run(void *user, ut64 iters) {
+	BenchSdb *b = user;
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		if (!sdb_const_get (b->db, b->keys[(i * 7) % SDB_NKEYS], NULL)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* r_strf keys under threads: each thread runs the symbol name filter of
+ * RBin on an Sdb of its own and checks every name against a single threaded
+ * pass, plus two r_strf keys built in the same expression. iters counts
+ * names per thread */
+
+#define STRF_NTHREADS 4
+#define STRF_NSYMS 4096
+
+typedef struct {
+	Sdb *db;
+	RThread *th;
+	ut64 iters;
+	bool ok;
+	void *bench;
+} BenchStrfThread;
+
+typedef struct {
+	BenchStrfThread t[STRF_NTHREADS];
+	ut32 ref[STRF_NSYMS];
+} BenchStrf;
+
+static ut32 strf_filter(Sdb *db, int k) {
+	r_strf_buffer (64);
+	// every name is used by four symbols, so the counters get dupped too
+	char *name = strdup (r_strf ("sym.fcn_%d", k % (STRF_NSYMS / 4)));
+	char *res = r_bin_filter_name (NULL, db, BENCH_BASE + k * 16, name);
+	ut32 hash = res? sdb_hash (res): 0;
+	free (res);
+	return hash;
+}
+
+static bool strf_keys(int k) {
+	r_strf_buffer (32);
+	char a[32], b[32];
+	snprintf (a, sizeof (a), "%d.%x", k, k);
+	snprintf (b, sizeof (b), "%x.%d", k, k);
+	return !strcmp (r_strf ("%d.%x", k, k), a) && !strcmp (r_strf ("%x.%d", k, k), b);
+}
+
+static RThreadFunctionRet strf_thread(RThread *th) {
+	BenchStrfThread *t = th->user;
+	BenchStrf *b = t->bench;
+	ut64 i;
+	for (i = 0; i < t->iters; i++) {
+		int k = i % STRF_NSYMS;
+		if (!k) {
+			sdb_reset (t->db);
+		}
+		if (strf_filter (t->db, k) != b->ref[k] || !strf_keys (k)) {
+			t->ok = false;
+			break;
+		}
+	}
+	return R_TH_STOP;
+}
+
+static void strf_fini(void *user) {
+	BenchStrf *b = user;
+	int i;
+	for (i = 0; i < STRF_NTHREADS; i++) {
+		sdb_free (b->t[i].db);
+	}
+	free (b);
+}
+
+static void *strf_init(void) {
+	BenchStrf *b = R_NEW0 (BenchStrf);
+	Sdb *db = sdb_new0 ();
+	int i;
+	if (!b || !db) {
+		free (b);
+		sdb_free (db);
+		return NULL;
+	}
+	for (i = 0; i < STRF_NSYMS; i++) {
+		b->ref[i] = strf_filter (db, i);
+	}
+	sdb_free (db);
+	for (i = 0; i < STRF_NTHREADS; i++) {
+		b->t[i].bench = b;
+		if (!(b->t[i].db = sdb_new0 ())) {
+			strf_fini (b);
+			return NULL;
+		}
+	}
+	return b;
+}
+
+static bool strf_run(void *user, ut64 iters) {
+	BenchStrf *b = user;
+	bool ok = true;
+	int i;
+	for (i = 0; i < STRF_NTHREADS; i++) {
+		BenchStrfThread *t = &b->t[i];
+		t->iters = iters;
+		t->ok = true;
+		t->th = r_th_new (strf_thread, t, 0);
+	}
+	for (i = 0; i < STRF_NTHREADS; i++) {
+		BenchStrfThread *t = &b->t[i];
+		if (t->th) {
+			r_th_wait (t->th);
+			r_th_free (t->th);
+			t->th = NULL;
+		}
+		if (!t->ok) {
+			eprintf ("strf_threads: thread %d filtered differently\n", i);
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+/* RFlag: insert and lookup by name and by offset */
+
+typedef struct {
+	BenchSdb *names;
+	RFlag *flags;
+	RFlagBatchItem *items;
+} BenchFlag;
+
+static void *flag_init(void) {
+	BenchFlag *b = R_NEW0 (BenchFlag);
+	if (!b || !(b->names = sdb_init ())) {
+		free (b);
+		return NULL;
+	}
+	return b;
+}
+
+static void flag_fini(void *user) {
+	BenchFlag *b = user;
+	sdb_fini (b->names);
+	r_flag_free (b->flags);
+	free (b->items);
+	free (b);
+}
+
+static bool flag_set_run(void *user, ut64 iters) {
+	BenchFlag *b = user;
+	ut64 i;
+	r_flag_free (b->flags);
+	b->flags = r_flag_new ();
+	for (i = 0; i < iters; i++) {
+		ut64 n = i % SDB_NKEYS;
+		r_flag_set (b->flags, b->names->keys[n], BENCH_BASE + n * 16, 16);
+	}
+	return true;
+}
+
+static void *flag_batch_init(void) {
+	BenchFlag *b = flag_init ();
+	int i;
+	if (b && !(b->items = R_NEWS0 (RFlagBatchItem, SDB_NKEYS))) {
+		flag_fini (b);
+		return NULL;
+	}
+	for (i = 0; b && i < SDB_NKEYS; i++) {
+		b->items[i].name = b->names->keys[i];
+		b->items[i].offset = BENCH_BASE + i * 16;
+		b->items[i].size = 16;
+	}
+	return b;
+}
+
+/* same flags as flag_set in a single r_flag_set_batch call, then checks
+ * that a flag moved by a batch keeps its realname */
+static bool flag_set_batch_run(void *user, ut64 iters) {
+	BenchFlag *b = user;
+	int n = (int)R_MIN (iters, SDB_NKEYS);
+	r_flag_free (b->flags);
+	b->flags = r_flag_new ();
+	if (r_flag_set_batch (b->flags, b->items, n) != n) {
+		eprintf ("flag_set_batch: not every flag was set\n");
+		return false;
+	}
+	RFlagItem *fi = b->items[0].item;
+	r_flag_item_set_realname (fi, "foo::real");
+	RFlagBatchItem move = { .name = fi->name, .offset = 0x1000, .size = 4 };
+	if (r_flag_set_batch (b->flags, &move, 1) != 1 || move.item != fi
+			|| strcmp (fi->realname, "foo::real") || r_flag_get_i (b->flags, 0x1000) != fi) {
+		eprintf ("flag_set_batch: moved flag lost its realname or offset\n");
+		return false;
+	}
+	return true;
+}
+
+static void *flag_get_init(void) {
+	BenchFlag *b = flag_init ();
+	if (b) {
+		flag_set_run (b, SDB_NKEYS);
+	}
+	return b;
+}
+
+static bool flag_get_run(void *user, ut64 iters) {
+	BenchFlag *b = user;
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		ut64 n = (i * 7) % SDB_NKEYS;
+		if (!r_flag_get (b->flags, b->names->keys[n])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool flag_get_i_run(void *user, ut64 iters) {
+	BenchFlag *b = user;
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		ut64 n = (i * 7) % SDB_NKEYS;
+		if (!r_flag_get_i (b->flags, BENCH_BASE + n * 16)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* r_search: keywords over random data, iters counts bytes */
+
+typedef struct {
+	RSearch *s;
+	ut8 *buf;
+	int hits;
+} BenchSearch;
+
+#define SEARCH_SIZE (4 * 1024 * 1024)
+
+static int search_hit(RSearchKeyword *kw, void *user, ut64 addr) {
+	((BenchSearch *)user)->hits++;
+	return 1;
+}
+
+static void *search_init(void) {
+	BenchSearch *b = R_NEW0 (BenchSearch);
+	int i;
+	if (!b || !(b->buf = bench_bytes (SEARCH_SIZE))) {
+		free (b);
+		return NULL;
+	}
+	for (i = 0; i < SEARCH_SIZE - 16; i += 65521) {
+		memcpy (b->buf + i, "\x55\x48\x89\xe5", 4);
+	}
+	b->s = r_search_new (R_SEARCH_KEYWORD);
+	r_search_kw_add (b->s, r_search_keyword_new_hexmask ("554889e5", NULL));
+	r_search_kw_add (b->s, r_search_keyword_new_str ("radare", NULL, NULL, 0));
+	r_search_set_callback (b->s, search_hit, b);
+	return b;
+}
+
+static bool search_run(void *user, ut64 iters) {
+	BenchSearch *b = user;
+	ut64 at = 0;
+	b->hits = 0;
+	r_search_begin (b->s);
+	while (at < iters) {
+		int len = (int)R_MIN (iters - at, SEARCH_SIZE);
+		r_search_update (b->s, at, b->buf, len);
+		at += len;
+	}
+	return b->hits > 0;
+}
+
+static void search_fini(void *user) {
+	BenchSearch *b = user;
+	r_search_free (b->s);
+	free (b->buf);
+	free (b);
+}
+
+/* sparse RBuffer: small writes at random addresses, then the ihex writer
+ * going through all the chunks they leave */
+
+#define SPARSE_SPAN 0x400000
+#define IHEX_NCHUNKS 4096
+
+typedef struct {
+	RBuffer *buf;
+	ut32 seed;
+} BenchSparse;
+
+static void *sparse_init(void) {
+	BenchSparse *b = R_NEW0 (BenchSparse);
+	if (!b || !(b->buf = r_buf_new_sparse (0xff))) {
+		free (b);
+		return NULL;
+	}
+	b->seed = BENCH_SEED;
+	return b;
+}
+
+static bool sparse_run(void *user, ut64 iters) {
+	BenchSparse *b = user;
+	ut8 data[4] = { 0x90, 0x90, 0xcc, 0xc3 };
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		ut32 r = bench_rand (&b->seed);
+		if (r_buf_write_at (b->buf, r % SPARSE_SPAN, data, 1 + (r >> 30)) < 1) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void sparse_fini(void *user) {
+	BenchSparse *b = user;
+	r_buf_free (b->buf);
+	free (b);
+}
+
+typedef struct {
+	RIO *io;
+	char *file;
+	ut32 seed;
+} BenchIhex;
+
+static void ihex_fini(void *user) {
+	BenchIhex *b = user;
+	r_io_free (b->io);
+	if (b->file) {
+		r_file_rm (b->file);
+		free (b->file);
+	}
+	free (b);
+}
+
+/* one 04 and one 16 byte data record per chunk */
+static bool ihex_gen(const char *file, ut32 *seed) {
+	RStrBuf *sb = r_strbuf_new (NULL);
+	int i, j;
+	for (i = 0; i < IHEX_NCHUNKS; i++) {
+		ut32 addr = (bench_rand (seed) % SPARSE_SPAN) & ~0xf;
+		ut8 cks = 0 - (6 + (addr >> 24) + ((addr >> 16) & 0xff));
+		r_strbuf_appendf (sb, ":02000004%04X%02X\n", addr >> 16, cks);
+		cks = 0x10 + ((addr >> 8) & 0xff) + (addr & 0xff);
+		r_strbuf_appendf (sb, ":10%04X00", addr & 0xffff);
+		for (j = 0; j < 16; j++) {
+			r_strbuf_appendf (sb, "%02X", i & 0xff);
+			cks += i & 0xff;
+		}
+		r_strbuf_appendf (sb, "%02X\n", (ut8)(0 - cks));
+	}
+	r_strbuf_append (sb, ":00000001FF\n");
+	bool ret = r_file_dump (file, (const ut8 *)r_strbuf_get (sb), -1, false);
+	r_strbuf_free (sb);
+	return ret;
+}
+
+static void *ihex_init(void) {
+	BenchIhex *b = R_NEW0 (BenchIhex);
+	if (!b) {
+		return NULL;
+	}
+	b->seed = BENCH_SEED;
+	b->io = r_io_new ();
+	b->file = r_file_temp ("r2bench.hex");
+	if (!b->io || !b->file || !ihex_gen (b->file, &b->seed)) {
+		ihex_fini (b);
+		return NULL;
+	}
+	char *uri = r_str_newf ("ihex://%s", b->file);
+	RIODesc *desc = uri? r_io_open_nomap (b->io, uri, R_PERM_RW, 0644): NULL;
+	free (uri);
+	if (!desc) {
+		ihex_fini (b);
+		return NULL;
+	}
+	r_io_use_fd (b->io, desc->fd);
+	b->io->va = false;
+	return b;
+}
+
+/* every write through the ihex plugin rewrites the whole file */
+static bool ihex_run(void *user, ut64 iters) {
+	BenchIhex *b = user;
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		ut64 addr = bench_rand (&b->seed) % SPARSE_SPAN;
+		r_io_seek (b->io, addr, R_IO_SEEK_SET);
+		if (!r_io_write_at (b->io, addr, (const ut8 *)"\xcc", 1)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* dyldcache: 64 byte reads of the data mapping of a generated arm64 cache
+ * with v3 slide info, so every pointer is rebased on the way out. a read
+ * only descriptor goes through the rebased page cache, a writable one
+ * takes the rebase in place path. both check the values they read */
+
+#define DYLD_TEXT_VA 0x180000000ULL
+#define DYLD_DATA_OFF 0x10000
+#define DYLD_PAGE 0x1000
+#define DYLD_NPAGES 4096
+#define DYLD_HOT 128 // pages hit by the reads, half of the page cache
+#define DYLD_SLOT 64 // one pointer every DYLD_SLOT bytes
+
+typedef struct {
+	RBin *bin;
+	RIO *io;
+	RCore *core;
+	RIOPlugin *plugin;
+	int (*read)(RIO *io, RIODesc *fd, ut8 *buf, int count);
+	char *file;
+	int fd;
+	ut32 seed;
+} BenchDyld;
+
+static ut64 dyld_ptr(ut64 off) {
+	return DYLD_TEXT_VA + off;
+}
+
+/* header, two mappings (text and data), one image with an empty mach-o
+ * header, the accelerator info and the page starts of the slide info */
+static bool dyld_gen(const char *file) {
+	const int size = DYLD_DATA_OFF + DYLD_NPAGES * DYLD_PAGE;
+	const int slide_size = 24 + DYLD_NPAGES * 2;
+	ut8 *c = calloc (1, size);
+	int i, j;
+	if (!c) {
+		return false;
+	}
+	memcpy (c, "dyld_v1   arm64", 15);
+	r_write_le32 (c + 16, 0x100); // mappings
+	r_write_le32 (c + 20, 2);
+	r_write_le32 (c + 24, 0x140); // images
+	r_write_le32 (c + 28, 1);
+	r_write_le64 (c + 56, 0x3000); // slide info
+	r_write_le64 (c + 64, slide_size);
+	r_write_le64 (c + 120, DYLD_TEXT_VA + 0x2000); // accelerator info
+	r_write_le64 (c + 128, 0x48);
+	r_write_le64 (c + 0x100, DYLD_TEXT_VA);
+	r_write_le64 (c + 0x108, DYLD_DATA_OFF);
+	r_write_le32 (c + 0x118, 5);
+	r_write_le32 (c + 0x11c, 5);
+	r_write_le64 (c + 0x120, DYLD_TEXT_VA + DYLD_DATA_OFF);
+	r_write_le64 (c + 0x128, DYLD_NPAGES * DYLD_PAGE);
+	r_write_le64 (c + 0x130, DYLD_DATA_OFF);
+	r_write_le32 (c + 0x138, 3);
+	r_write_le32 (c + 0x13c, 3);
+	r_write_le64 (c + 0x140, DYLD_TEXT_VA + 0x1000);
+	r_write_le32 (c + 0x158, 0x180);
+	strcpy ((char *)c + 0x180, "/usr/lib/libbench.dylib");
+	r_write_le32 (c + 0x1000, 0xfeedfacf);
+	r_write_le32 (c + 0x1004, 0x0100000c);
+	r_write_le32 (c + 0x3000, 3);
+	r_write_le32 (c + 0x3004, DYLD_PAGE);
+	r_write_le32 (c + 0x3008, DYLD_NPAGES);
+	for (i = 0; i < DYLD_NPAGES; i++) {
+		ut8 *page = c + DYLD_DATA_OFF + i * DYLD_PAGE;
+		r_write_le16 (c + 0x3018 + i * 2, 0); // first pointer at the page start
+		for (j = 0; j < DYLD_PAGE; j += DYLD_SLOT) {
+			// chained in 8 byte units, the last one of the page ends the chain
+			ut64 next = j + DYLD_SLOT < DYLD_PAGE? DYLD_SLOT / 8: 0;
+			r_write_le64 (page + j, (next << 51) | dyld_ptr (DYLD_DATA_OFF + i * DYLD_PAGE + j));
+		}
+	}
+	bool ret = r_file_dump (file, c, size, false);
+	free (c);
+	return ret;
+}
+
+static void dyld_fini(void *user) {
+	BenchDyld *b = user;
+	if (b->plugin) {
+		// the plugin swaps the read of the io plugin and never puts it back
+		b->plugin->read = b->read;
+	}
+	r_bin_free (b->bin);
+	r_io_free (b->io);
+	free (b->core);
+	if (b->file) {
+		r_file_rm (b->file);
+		free (b->file);
+	}
+	free (b);
+}
+
+static BenchDyld *dyld_init(int perm) {
+	BenchDyld *b = R_NEW0 (BenchDyld);
+	RBinOptions opt;
+	if (!b) {
+		return NULL;
+	}
+	b->seed = BENCH_SEED;
+	b->bin = r_bin_new ();
+	b->io = r_io_new ();
+	b->core = R_NEW0 (RCore);
+	b->file = r_file_temp ("r2bench.dyld");
+	if (!b->bin || !b->io || !b->core || !b->file || !dyld_gen (b->file)) {
+		dyld_fini (b);
+		return NULL;
+	}
+	// dyldcache_io_read finds the cache through the RCore in io->user
+	b->core->bin = b->bin;
+	b->core->io = b->io;
+	b->io->user = b->core;
+	r_io_bind (b->io, &b->bin->iob);
+	b->fd = r_io_fd_open (b->io, b->file, perm, 0644);
+	RIODesc *desc = r_io_desc_get (b->io, b->fd);
+	if (!desc) {
+		dyld_fini (b);
+		return NULL;
+	}
+	r_io_use_fd (b->io, b->fd);
+	b->plugin = desc->plugin;
+	b->read = desc->plugin->read;
+	r_bin_options_init (&opt, b->fd, 0, 0, false);
+	opt.pluginname = "dyldcache";
+	if (!r_bin_open_io (b->bin, &opt) || b->plugin->read == b->read) {
+		eprintf ("Cannot load %s as a dyldcache\n", b->file);
+		dyld_fini (b);
+		return NULL;
+	}
+	return b;
+}
+
+static void *dyld_lru_init(void) {
+	return dyld_init (R_PERM_R);
+}
+
+static void *dyld_raw_init(void) {
+	return dyld_init (R_PERM_RW);
+}
+
+static bool dyld_run(void *user, ut64 iters) {
+	BenchDyld *b = user;
+	ut8 buf[DYLD_SLOT];
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		ut32 r = bench_rand (&b->seed);
+		ut64 off = DYLD_DATA_OFF + (r % DYLD_HOT) * DYLD_PAGE + ((r >> 16) % (DYLD_PAGE / DYLD_SLOT)) * DYLD_SLOT;
+		if (r_io_fd_read_at (b->io, b->fd, off, buf, sizeof (buf)) != sizeof (buf)) {
+			return false;
+		}
+		if (r_read_le64 (buf) != dyld_ptr (off)) {
+			eprintf ("dyld: 0x%"PFMT64x" reads 0x%"PFMT64x"\n", off, r_read_le64 (buf));
+			return false;
+		}
+	}
+	return true;
+}
+
+#if !USE_LIB_MAGIC
+/* RMagic: the prefilter must give the same answers as running every test,
+ * on text and on binary data with some known headers in it */
+
+#define MAGIC_SIZE 8192
+#define MAGIC_WINDOW 256
+#define MAGIC_TREE "../../libr/magic/d/default"
+
+typedef struct {
+	RMagic *ms;
+	RMagicIndex *mi;
+	ut8 *buf;
+	ut64 at;
+} BenchMagic;
+
+static void magic_fini(void *user) {
+	BenchMagic *b = user;
+	r_magic_index_free (b->mi);
+	r_magic_free (b->ms);
+	free (b->buf);
+	free (b);
+}
+
+static void *magic_init(void) {
+	const char *text = "#!/bin/sh\necho hello world\n<?xml version=\"1.0\"?>\n"
+		"<html><head></head></html>\n%!PS-Adobe-3.0\nFrom: someone\n";
+	BenchMagic *b = R_NEW0 (BenchMagic);
+	char *path = r_file_is_directory (MAGIC_TREE)? strdup (MAGIC_TREE)
+		: r_str_newf (R_JOIN_2_PATHS ("%s", R2_SDB_MAGIC), r_sys_prefix (NULL));
+	int i, len = strlen (text);
+	if (!b || !path || !(b->ms = r_magic_new (0)) || r_magic_load (b->ms, path) == -1) {
+		eprintf ("Cannot load magic from %s\n", r_str_get (path));
+		goto fail;
+	}
+	if (!(b->mi = r_magic_index_new (b->ms)) || !(b->buf = bench_bytes (MAGIC_SIZE))) {
+		goto fail;
+	}
+	for (i = 0; i + len < MAGIC_SIZE / 2; i += len) {
+		memcpy (b->buf + i, text, len);
+	}
+	memcpy (b->buf + 5000, "\x7f" "ELF\x02\x01\x01", 7);
+	memcpy (b->buf + 6000, "\x1f\x8b\x08", 3);
+	memcpy (b->buf + 7000, "PK\x03\x04", 4);
+	memcpy (b->buf + 7500, "\x89PNG\r\n\x1a\n", 8);
+	free (path);
+	return b;
+fail:
+	free (path);
+	if (b) {
+		magic_fini (b);
+	}
+	return NULL;
+}
+
+static bool magic_run(void *user, ut64 iters) {
+	BenchMagic *b = user;
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		const ut8 *p = b->buf + b->at;
+		int n = R_MIN (MAGIC_WINDOW, MAGIC_SIZE - b->at);
+		const char *s = r_magic_buffer (b->ms, p, n);
+		char *full = (s && strcmp (s, "data"))? strdup (s): NULL;
+		const char *fast = r_magic_index_buffer (b->mi, p, n);
+		bool same = full? fast && !strcmp (full, fast): !fast || !strcmp (fast, "data");
+		if (!same) {
+			eprintf ("magic mismatch at %d: %s vs %s\n", (int)b->at, r_str_get (full), r_str_get (fast));
+			free (full);
+			return false;
+		}
+		free (full);
+		b->at = (b->at + 1) % (MAGIC_SIZE - 1);
+	}
+	return true;
+}
+#endif
+
+/* RCons: buffered output as done by the print commands, never flushed */
+
+static void *cons_init(void) {
+	return r_cons_new ();
+}
+
+static bool cons_run(void *user, ut64 iters) {
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		r_cons_printf ("0x%08"PFMT64x"      %02x%02x  %s\n", BENCH_BASE + i, (int)(i & 0xff), (int)(i >> 8) & 0xff, "mov eax, dword [rbp - 4]");
+		if ((i & 1023) == 1023) {
+			r_cons_reset ();
+		}
+	}
+	r_cons_reset ();
+	return true;
+}
+
+static void cons_fini(void *user) {
+	r_cons_free ();
+}
+
+/* agraph: full layout of synthetic control flow graphs. every block falls
+ * through to the next one, a third of them also jump a few blocks forward,
+ * one in eight closes a loop and one in 64 is a switch of up to 16 cases.
+ * the layout adds dummy nodes to the graph, so it is rebuilt before each
+ * sample */
+
+typedef struct {
+	RAGraph *g;
+	int nblocks;
+} BenchGraph;
+
+static bool graph_setup(void *user) {
+	BenchGraph *b = user;
+	RANode **nodes = R_NEWS0 (RANode *, b->nblocks);
+	ut32 seed = BENCH_SEED;
+	int i, k;
+	if (!nodes) {
+		return false;
+	}
+	r_agraph_reset (b->g);
+	for (i = 0; i < b->nblocks; i++) {
+		char *title = r_str_newf ("0x%08x", BENCH_BASE + i * BENCH_FCN_SIZE);
+		nodes[i] = r_agraph_add_node (b->g, title, "mov eax, dword [rbp - 4]\ncmp eax, 1\njne 0x400000\n");
+		free (title);
+	}
+	for (i = 0; i + 1 < b->nblocks; i++) {
+		ut32 r = bench_rand (&seed);
+		r_agraph_add_edge (b->g, nodes[i], nodes[i + 1]);
+		if (r % 3 == 0) {
+			r_agraph_add_edge (b->g, nodes[i], nodes[R_MIN (i + 2 + (r >> 8) % 6, b->nblocks - 1)]);
+		} else if (r % 8 == 1 && i > 0) {
+			r_agraph_add_edge (b->g, nodes[i], nodes[i - 1 - (r >> 8) % R_MIN (i, 8)]);
+		} else if (r % 64 == 2) {
+			int cases = 2 + (r >> 8) % 15;
+			for (k = 2; k < cases && i + k < b->nblocks; k++) {
+				r_agraph_add_edge (b->g, nodes[i], nodes[i + k]);
+			}
+		}
+	}
+	free (nodes);
+	return true;
+}
+
+static void *graph_init(int nblocks) {
+	BenchGraph *b = R_NEW0 (BenchGraph);
+	if (!b) {
+		return NULL;
+	}
+	r_cons_new ();
+	b->nblocks = nblocks;
+	b->g = r_agraph_new (r_cons_canvas_new (80, 25));
+	if (!b->g || !graph_setup (b)) {
+		r_agraph_free (b->g);
+		r_cons_free ();
+		free (b);
+		return NULL;
+	}
+	return b;
+}
+
+static void *graph_init_1k(void) {
+	return graph_init (1000);
+}
+
+static void *graph_init_5k(void) {
+	return graph_init (5000);
+}
+
+static bool graph_run(void *user, ut64 iters) {
+	BenchGraph *b = user;
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		// as done by aggk: size the nodes and lay the graph out
+		if (!r_agraph_get_sdb (b->g)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void graph_fini(void *user) {
+	BenchGraph *b = user;
+	r_agraph_free (b->g);
+	r_cons_free ();
+	free (b);
+}
+
+/* rap v2: sequential 4K read_at round trips over a local socket pair,
+ * served by the same handler used by r_core_serve */
+
+#define RAP_SIZE (4 * 1024 * 1024)
+#define RAP_BLOCK 4096
+
+typedef struct {
+	RSocket *client;
+	RSocket *server;
+	RThread *th;
+	ut8 *buf;
+	ut8 *out;
+	int features;
+	ut32 id;
+} BenchRap;
+
+static int rap_read_at(void *user, ut64 addr, ut8 *buf, int len) {
+	BenchRap *b = user;
+	if (addr >= RAP_SIZE) {
+		return 0;
+	}
+	len = R_MIN (len, RAP_SIZE - (int)addr);
+	memcpy (buf, b->buf + addr, len);
+	return len;
+}
+
+static int rap_write_at(void *user, ut64 addr, const ut8 *buf, int len) {
+	return 0;
+}
+
+static RThreadFunctionRet rap_serve(RThread *th) {
+	BenchRap *b = th->user;
+	ut8 type;
+	while (r_socket_read_block (b->server, &type, 1) == 1) {
+		if (!r_socket_rap_server_v2 (b->server, type, &b->features, rap_read_at, rap_write_at, b)) {
+			break;
+		}
+	}
+	return R_TH_STOP;
+}
+
+static void rap_fini(void *user) {
+	BenchRap *b = user;
+	r_socket_free (b->client);
+	if (b->th) {
+		r_th_wait (b->th);
+		r_th_free (b->th);
+	}
+	r_socket_free (b->server);
+	free (b->buf);
+	free (b->out);
+	free (b);
+}
+
+static void *rap_init(void) {
+#if __UNIX__
+	BenchRap *b = R_NEW0 (BenchRap);
+	int fds[2];
+	if (!b) {
+		return NULL;
+	}
+	if (socketpair (AF_UNIX, SOCK_STREAM, 0, fds) == -1) {
+		free (b);
+		return NULL;
+	}
+	b->client = r_socket_new_from_fd (fds[0]);
+	b->server = r_socket_new_from_fd (fds[1]);
+	b->buf = bench_bytes (RAP_SIZE);
+	b->out = malloc (RAP_BLOCK);
+	if (!b->client || !b->server || !b->buf || !b->out) {
+		rap_fini (b);
+		return NULL;
+	}
+	b->th = r_th_new (rap_serve, b, 0);
+	return b;
+#else
+	return NULL;
+#endif
+}
+
+static bool rap_run(void *user, ut64 iters) {
+	BenchRap *b = user;
+	ut8 req[12];
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		RSocketRapPacket pkt = {0};
+		ut8 type = 0;
+		r_write_be64 (req, (i * RAP_BLOCK) % RAP_SIZE);
+		r_write_be32 (req + 8, RAP_BLOCK);
+		if (!r_socket_rap_packet_send (b->client, RAP_RMT_READ_AT, b->id++, req, sizeof (req))) {
+			return false;
+		}
+		if (r_socket_read_block (b->client, &type, 1) != 1 || !r_socket_rap_packet_read (b->client, &pkt)) {
+			return false;
+		}
+		bool ok = r_socket_rap_packet_data (&pkt, b->out, RAP_BLOCK) == RAP_BLOCK;
+		r_socket_rap_packet_fini (&pkt);
+		if (!ok) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* r2pipe: framed command batches answered by the pipe lang plugin. the
+ * client is this same binary running with -P, iters counts commands */
+
+#define PIPE_NCMDS 20000
+
+static const char *bench_self = NULL;
+
+static char *pipe_cmd_str(void *user, const char *cmd) {
+	return strdup ("0x400000\n");
+}
+
+static void *pipe_init(void) {
+	RLang *lang = r_lang_new ();
+	if (!lang || !bench_self || !r_lang_use (lang, "pipe")) {
+		r_lang_free (lang);
+		return NULL;
+	}
+	r_cons_new ();
+	lang->cmd_str = pipe_cmd_str;
+	return lang;
+}
+
+static bool pipe_run(void *user, ut64 iters) {
+	char *cmd = r_str_newf ("%s -P %"PFMT64d, bench_self, iters);
+	int ret = r_lang_run_string (user, cmd);
+	free (cmd);
+	return ret;
+}
+
+static void pipe_fini(void *user) {
+	r_lang_free (user);
+	r_cons_free ();
+}
+
+// the r2pipe side of pipe_run
+static int pipe_client(int n) {
+	R2Pipe *r2p = r2pipe_open (NULL);
+	const char **cmds = R_NEWS (const char *, n);
+	char **res = R_NEWS0 (char *, n);
+	int i, done = -1;
+	if (r2p && cmds && res) {
+		for (i = 0; i < n; i++) {
+			cmds[i] = "?v entry0";
+		}
+		done = r2pipe_cmd_batch (r2p, cmds, n, res);
+		for (i = 0; i < n; i++) {
+			free (res[i]);
+		}
+	}
+	free (cmds);
+	free (res);
+	r2pipe_close (r2p);
+	return done == n? 0: 1;
+}
+
+/* macro: whole commands run by RCore over the generated binary */
+
+typedef struct {
+	RCore *core;
+	const char *cmd;
+} BenchCore;
+
+static RCore *core_load(void) {
+	RCore *core = r_core_new ();
+	if (!core) {
+		return NULL;
+	}
+	r_config_set_i (core->config, "scr.interactive", false);
+	r_config_set_i (core->config, "scr.color", 0);
+	r_config_set_i (core->config, "bin.cache", false);
+	if (!r_core_file_open (core, bench_file, R_PERM_R, 0) || !r_core_bin_load (core, bench_file, UT64_MAX)) {
+		eprintf ("Cannot open %s\n", bench_file);
+		r_core_free (core);
+		return NULL;
+	}
+	return core;
+}
+
+static void *core_init(void) {
+	return R_NEW0 (BenchCore);
+}
+
+static bool core_open_run(void *user, ut64 iters) {
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		RCore *core = core_load ();
+		if (!core) {
+			return false;
+		}
+		r_core_free (core);
+	}
+	return true;
+}
+
+/* every sample starts from a fresh session */
+static bool core_setup(void *user) {
+	BenchCore *b = user;
+	r_core_free (b->core);
+	return (b->core = core_load ()) != NULL;
+}
+
+static bool core_cmd_run(BenchCore *b, const char *cmd, ut64 iters) {
+	ut64 i;
+	for (i = 0; i < iters; i++) {
+		r_cons_push ();
+		r_core_cmd0 (b->core, cmd);
+		r_cons_pop ();
+	}
+	return true;
+}
+
+static bool core_aaa_run(void *user, ut64 iters) {
+	return core_cmd_run (user, "aaa", iters);
+}
+
+static bool core_pd_run(void *user, ut64 iters) {
+	return core_cmd_run (user, "pD $s-0x1000 @ entry0", iters);
+}
+
+static bool core_search_run(void *user, ut64 iters) {
+	return core_cmd_run (user, "/x e8", iters);
+}
+
+static void core_fini(void *user) {
+	BenchCore *b = user;
+	r_core_free (b->core);
+	free (b);
+}
+
+/* =h: keep-alive connection sending pipelined command requests, iters
+ * counts requests. the latency of a request goes from sending its batch
+ * to reading its answer */
+
+#define HTTP_DEPTH 8
+#define HTTP_REQ "GET /cmd/%3fv%20entry0 HTTP/1.1\r\nHost: localhost\r\nConnection: keep-alive\r\n\r\n"
+
+typedef struct {
+	RCore *core;
+	RThread *th;
+	RSocket *s;
+	char *root;
+	char port[16];
+	char in[0x10000];
+	int inlen;
+	double *lat;
+	int nlat;
+	int maxlat;
+} BenchHttp;
+
+static RThreadFunctionRet http_serve(RThread *th) {
+	BenchHttp *b = th->user;
+	r_core_rtr_http (b->core, 0, 0, "");
+	return R_TH_STOP;
+}
+
+/* consumes one response, false on errors or when it is not a 200 */
+static bool http_response(BenchHttp *b) {
+	for (;;) {
+		b->in[b->inlen] = 0;
+		char *end = strstr (b->in, "\r\n\r\n");
+		if (end) {
+			const char *cl = r_str_casestr (b->in, "Content-Length:");
+			int len = (end + 4 - b->in) + (cl && cl < end? atoi (cl + 15): 0);
+			if (len <= b->inlen) {
+				bool ok = r_str_startswith (b->in, "HTTP/1.1 200");
+				memmove (b->in, b->in + len, b->inlen - len);
+				b->inlen -= len;
+				return ok;
+			}
+		}
+		if (b->inlen >= sizeof (b->in) - 1) {
+			return false;
+		}
+		int n = r_socket_read (b->s, (ut8 *)b->in + b->inlen, sizeof (b->in) - 1 - b->inlen);
+		if (n < 1) {
+			return false;
+		}
+		b->inlen += n;
+	}
+}
+
+static void http_fini(void *user) {
+	BenchHttp *b = user;
+	if (b->th) {
+		if (b->s) {
+			r_socket_puts (b->s, "GET /cmd/=h-- HTTP/1.1\r\nHost: localhost\r\n\r\n");
+			(void)http_response (b);
+		}
+		r_th_wait (b->th);
+		r_th_free (b->th);
+	}
+	r_socket_free (b->s);
+	r_core_free (b->core);
+	if (b->root) {
+		r_file_rm (b->root);
+		free (b->root);
+	}
+	free (b->lat);
+	free (b);
+}
+
+static void *http_init(void) {
+	BenchHttp *b = R_NEW0 (BenchHttp);
+	int i;
+	if (!b || !(b->core = core_load ())) {
+		free (b);
+		return NULL;
+	}
+	// the server wants an existing http.root
+	b->root = r_file_temp ("r2bench-www");
+	if (!b->root || !r_sys_mkdir (b->root)) {
+		http_fini (b);
+		return NULL;
+	}
+	r_num_irand ();
+	snprintf (b->port, sizeof (b->port), "%d", 20000 + r_num_rand (20000));
+	r_config_set (b->core->config, "http.port", b->port);
+	r_config_set (b->core->config, "http.root", b->root);
+	r_config_set (b->core->config, "http.sandbox", "false");
+	r_config_set (b->core->config, "http.log", "false");
+	r_config_set (b->core->config, "http.timeout", "5");
+	b->th = r_th_new (http_serve, b, 0);
+	b->s = r_socket_new (false);
+	if (!b->th || !b->s) {
+		http_fini (b);
+		return NULL;
+	}
+	for (i = 0; i < 50 && !r_socket_connect_tcp (b->s, "localhost", b->port, 1); i++) {
+		r_sys_usleep (100000);
+	}
+	if (i == 50) {
+		eprintf ("Cannot connect to the http server on port %s\n", b->port);
+		r_socket_free (b->s);
+		b->s = NULL;
+		http_fini (b);
+		return NULL;
+	}
+	return b;
+}
+
+static bool http_run(void *user, ut64 iters) {
+	BenchHttp *b = user;
+	char req[HTTP_DEPTH * sizeof (HTTP_REQ)];
+	ut64 i;
+	int j;
+	if (b->nlat + iters > b->maxlat) {
+		int n = b->nlat + iters;
+		double *lat = realloc (b->lat, n * sizeof (double));
+		if (!lat) {
+			return false;
+		}
+		b->lat = lat;
+		b->maxlat = n;
+	}
+	for (i = 0; i < iters; i += HTTP_DEPTH) {
+		int depth = R_MIN (HTTP_DEPTH, iters - i);
+		for (j = 0; j < depth; j++) {
+			memcpy (req + j * (sizeof (HTTP_REQ) - 1), HTTP_REQ, sizeof (HTTP_REQ) - 1);
+		}
+		ut64 t0 = r_sys_now_mono ();
+		if (r_socket_write (b->s, req, depth * (sizeof (HTTP_REQ) - 1)) < 1) {
+			return false;
+		}
+		for (j = 0; j < depth; j++) {
+			if (!http_response (b)) {
+				return false;
+			}
+			b->lat[b->nlat++] = r_sys_now_mono () - t0;
+		}
+	}
+	return true;
+}
+
+static double http_p99(void *user) {
+	BenchHttp *b = user;
+	if (b->nlat < 1) {
+		return 0;
+	}
+	qsort (b->lat, b->nlat, sizeof (double), bench_cmp_double);
+	return b->lat[(b->nlat - 1) * 99 / 100];
+}
+
+static RBench benchs[] = {
+	{ "io_read_skyline", "64 byte reads through 256 overlapping maps", 200000, false, io_init, io_run, io_fini },
+	{ "anal_op_x86", "decode x86-64 instructions", 200000, false, anal_init, anal_run, anal_fini },
+	{ "cs_threads", "arm/thumb ops decoded from 4 threads, checked", 50000, false, cs_init, cs_run, cs_fini },
+	{ "esil_parse", "parse and evaluate an esil expression", 50000, false, esil_init, esil_run, anal_fini },
+	{ "ht_pp_insert", "insert string keys in a HtPP", SDB_NKEYS, false, sdb_init, ht_insert_run, sdb_fini },
+	{ "ht_pp_find", "lookup string keys in a HtPP", 500000, false, ht_find_init, ht_find_run, sdb_fini },
+	{ "sdb_set", "set string keys in an Sdb", SDB_NKEYS, false, sdb_init, sdb_set_run, sdb_fini },
+	{ "sdb_get", "get string keys from an Sdb", 500000, false, sdb_get_init, sdb_get_run, sdb_fini },
+	{ "strf_threads", "bin name filter keys from 4 threads, checked", 20000, false, strf_init, strf_run, strf_fini },
+	{ "flag_set", "create flags", SDB_NKEYS, false, flag_init, flag_set_run, flag_fini },
+	{ "flag_set_batch", "create the flag_set flags in one batch, checked", SDB_NKEYS, false, flag_batch_init, flag_set_batch_run, flag_fini },
+	{ "flag_get", "lookup flags by name", 500000, false, flag_get_init, flag_get_run, flag_fini },
+	{ "flag_get_i", "lookup flags by offset", 500000, false, flag_get_init, flag_get_i_run, flag_fini },
+	{ "search_kw", "search two keywords, per byte", 4 * SEARCH_SIZE, false, search_init, search_run, search_fini },
+	{ "buf_sparse", "1-4 byte writes at random addresses of a sparse buffer", 100000, false, sparse_init, sparse_run, sparse_fini },
+	{ "ihex_write", "write a byte to an ihex file of 4096 chunks", 20, false, ihex_init, ihex_run, ihex_fini },
+	{ "dyld_read_lru", "64 byte reads of rebased dyldcache pointers, page cache, checked", 100000, false, dyld_lru_init, dyld_run, dyld_fini },
+	{ "dyld_read_raw", "the dyld_read_lru reads rebased in place, checked", 100000, false, dyld_raw_init, dyld_run, dyld_fini },
+#if !USE_LIB_MAGIC
+	{ "magic_index", "magic tests at each offset, indexed and not, checked", 2000, false, magic_init, magic_run, magic_fini },
+#endif
+	{ "cons_printf", "buffered console output lines", 200000, false, cons_init, cons_run, cons_fini },
+	{ "agraph_1k", "layout of a synthetic 1000 block graph", 1, false, graph_init_1k, graph_run, graph_fini, graph_setup },
+	{ "agraph_5k", "layout of a synthetic 5000 block graph", 1, false, graph_init_5k, graph_run, graph_fini, graph_setup },
+	{ "rap_read_at", "rap v2 read_at round trips of 4K", 20000, false, rap_init, rap_run, rap_fini },
+	{ "r2pipe_batch", "framed r2pipe commands through the pipe plugin", PIPE_NCMDS, true, pipe_init, pipe_run, pipe_fini },
+	{ "core_open", "open and load the test binary", 1, true, core_init, core_open_run, core_fini },
+	{ "core_aaa", "aaa on the test binary", 1, true, core_init, core_aaa_run, core_fini, core_setup },
+	{ "core_pd", "disassemble the whole test binary", 1, true, core_init, core_pd_run, core_fini, core_setup },
+	{ "core_search", "/x over the test binary", 1, true, core_init, core_search_run, core_fini, core_setup },
+	{ "http_keepalive", "=h pipelined commands on a keep-alive connection", 20000, true, http_init, http_run, http_fini, NULL, http_p99 },
+	{ NULL }
+};
+
+static bool bench_run(RBench *bench, int nsamples, RBenchResult *res) {
+	double *samples = R_NEWS (double, nsamples);
+	void *user = bench->init ();
+	bool ok = samples && user;
+	int i;
+	// warm up caches and lazy initializations
+	if (ok && !bench->macro) {
+		ok = bench->run (user, R_MAX (bench->iters / 10, 1));
+	}
+	for (i = 0; ok && i < nsamples; i++) {
+		if (bench->setup && !bench->setup (user)) {
+			ok = false;
+			break;
+		}
+		ut64 t0 = r_sys_now_mono ();
+		ok = bench->run (user, bench->iters);
+		samples[i] = (double)(r_sys_now_mono () - t0) / bench->iters;
+	}
+	if (ok && bench->p99) {
+		res->p99 = bench->p99 (user);
+	}
+	if (user) {
+		bench->fini (user);
+	}
+	if (ok) {
+		qsort (samples, nsamples, sizeof (double), bench_cmp_double);
+		res->name = bench->name;
+		res->iters = bench->iters;
+		res->ns = samples[nsamples / 2];
+		res->min = samples[0];
+		res->max = samples[nsamples - 1];
+	}
+	free (samples);
+	return ok;
+}
+
+static bool bench_match(RBench *bench, const char *filter) {
+	if (!filter) {
+		return true;
+	}
+	char *s = strdup (filter);
+	RList *words = r_str_split_list (s, ",");
+	const char *w;
+	RListIter *iter;
+	bool ret = false;
+	r_list_foreach (words, iter, w) {
+		if (r_str_glob (bench->name, w)) {
+			ret = true;
+			break;
+		}
+	}
+	r_list_free (words);
+	free (s);
+	return ret;
+}
+
+static char *bench_json(RBenchResult *res, int count, int nsamples) {
+	PJ *pj = pj_new ();
+	int i;
+	pj_o (pj);
+	pj_ks (pj, "version", R2_VERSION);
+	pj_ki (pj, "samples", nsamples);
+	pj_k (pj, "bench");
+	pj_o (pj);
+	for (i = 0; i < count; i++) {
+		pj_k (pj, res[i].name);
+		pj_o (pj);
+		pj_kn (pj, "iters", res[i].iters);
+		pj_kd (pj, "ns", res[i].ns);
+		pj_kd (pj, "min", res[i].min);
+		pj_kd (pj, "max", res[i].max);
+		if (res[i].p99 > 0) {
+			pj_kd (pj, "p99", res[i].p99);
+		}
+		pj_end (pj);
+	}
+	pj_end (pj);
+	pj_end (pj);
+	return pj_drain (pj);
+}
+
+static double bench_json_ns(const char *json, const char *name) {
+	char *path = r_str_newf ("bench.%s.ns", name);
+	char *v = sdb_json_get_str (json, path);
+	double ns = v? atof (v): -1;
+	free (path);
+	free (v);
+	return ns;
+}
+
+/* prints one line per benchmark in cur, returns the number of regressions */
+static int bench_compare(const char *base, const char *cur, double threshold) {
+	const char *p = strstr (cur, "\"bench\"");
+	int regressions = 0;
+	printf ("%-18s %12s %12s %8s\n", "name", "base ns/op", "ns/op", "delta");
+	if (!p || !(p = strchr (p, '{'))) {
+		return 0;
+	}
+	// walk the keys of the bench object, the values have no nested objects
+	while ((p = strchr (p + 1, '"'))) {
+		const char *e = strchr (p + 1, '"');
+		if (!e) {
+			break;
+		}
+		char *name = r_str_ndup (p + 1, e - p - 1);
+		double b = bench_json_ns (base, name);
+		double c = bench_json_ns (cur, name);
+		if (b > 0 && c >= 0) {
+			double delta = (c - b) * 100 / b;
+			const char *mark = "";
+			if (delta > threshold) {
+				mark = "  REGRESSION";
+				regressions++;
+			} else if (delta < -threshold) {
+				mark = "  faster";
+			}
+			printf ("%-18s %12.2f %12.2f %+7.1f%%%s\n", name, b, c, delta, mark);
+		} else if (c >= 0) {
+			printf ("%-18s %12s %12.2f %8s\n", name, "-", c, "new");
+		}
+		free (name);
+		if (!(p = strchr (e, '}'))) {
+			break;
+		}
+	}
+	return regressions;
+}
+
+static int show_help(int v) {
+	printf ("Usage: r2bench [-hlj] [-b name,glob*] [-n samples] [-o file] [-c baseline [-t pct] [-i results]] [-f bin] [-g bin]\n");
+	if (v) {
+		printf (
+		" -b [names]   run only the benchmarks matching these comma separated globs\n"
+		" -c [file]    compare against a baseline, exit with 1 on regressions\n"
+		" -f [file]    binary for the macro benchmarks (generated if missing)\n"
+		" -g [file]    just generate the test binary\n"
+		" -h           show this help\n"
+		" -i [file]    compare these results instead of running the benchmarks\n"
+		" -j           print the results as json\n"
+		" -l           list the benchmarks\n"
+		" -m           skip the macro benchmarks\n"
+		" -n [num]     samples per benchmark, the median is reported (5)\n"
+		" -o [file]    save the results as json\n"
+		" -t [pct]     slowdown tolerated by -c (10)\n");
+	}
+	return 0;
+}
+
+int main(int argc, char **argv) {
+	const char *filter = NULL;
+	const char *output = NULL;
+	const char *baseline = NULL;
+	const char *input = NULL;
+	double threshold = 10;
+	bool json = false;
+	bool list = false;
+	bool micro = false;
+	int nsamples = 5;
+	int c, i, ret = 0;
+
+	bench_self = argv[0];
+	while ((c = r_getopt (argc, argv, "b:c:f:g:hi:jlmn:o:P:t:")) != -1) {
+		switch (c) {
+		case 'b': filter = r_optarg; break;
+		case 'c': baseline = r_optarg; break;
+		case 'f': bench_file = r_optarg; break;
+		case 'g':
+			if (!bench_gen (r_optarg, bench_nfcns)) {
+				eprintf ("Cannot write %s\n", r_optarg);
+				return 1;
+			}
+			return 0;
+		case 'h': return show_help (1);
+		case 'i': input = r_optarg; break;
+		case 'j': json = true; break;
+		case 'l': list = true; break;
+		case 'm': micro = true; break;
+		case 'n': nsamples = R_MAX (atoi (r_optarg), 1); break;
+		case 'o': output = r_optarg; break;
+		case 'P': return pipe_client (atoi (r_optarg));
+		case 't': threshold = atof (r_optarg); break;
+		default: return show_help (0);
+		}
+	}
+	if (list) {
+		for (i = 0; benchs[i].name; i++) {
+			printf ("%-18s %s%s\n", benchs[i].name, benchs[i].desc, benchs[i].macro? " (macro)": "");
+		}
+		return 0;
+	}
+	char *results = NULL;
+	if (input) {
+		if (!(results = r_file_slurp (input, NULL))) {
+			eprintf ("Cannot open %s\n", input);
+			return 1;
+		}
+	} else {
+		RBenchResult *res = R_NEWS0 (RBenchResult, R_ARRAY_SIZE (benchs));
+		char *tmp = NULL;
+		int count = 0;
+		if (!res) {
+			return 1;
+		}
+		if (!micro && !bench_file) {
+			bench_file = tmp = r_file_temp ("r2bench");
+		}
+		if (bench_file && !r_file_exists (bench_file) && !bench_gen (bench_file, bench_nfcns)) {
+			eprintf ("Cannot write %s\n", bench_file);
+			micro = true;
+		}
+		for (i = 0; benchs[i].name; i++) {
+			RBench *b = &benchs[i];
+			if ((micro && b->macro) || !bench_match (b, filter)) {
+				continue;
+			}
+			if (!bench_run (b, nsamples, &res[count])) {
+				eprintf ("%s: failed\n", b->name);
+				ret = 1;
+				continue;
+			}
+			if (!json && !baseline) {
+				printf ("%-18s %12.2f ns/op  (min %.2f max %.2f, %"PFMT64d" iters)",
+					b->name, res[count].ns, res[count].min, res[count].max, b->iters);
+				if (res[count].p99 > 0) {
+					printf ("  %.0f ops/s, p99 %.0f ns", 1e9 / res[count].ns, res[count].p99);
+				}
+				printf ("\n");
+				fflush (stdout);
+			}
+			count++;
+		}
+		if (tmp) {
+			r_file_rm (tmp);
+			free (tmp);
+		}
+		results = bench_json (res, count, nsamples);
+		free (res);
+		if (output && !r_file_dump (output, (const ut8 *)results, strlen (results), false)) {
+			eprintf ("Cannot write %s\n", output);
+			ret = 1;
+		}
+	}
+	if (json) {
+		printf ("%s\n", results);
+	}
+	if (baseline) {
+		char *base = r_file_slurp (baseline, NULL);
+		if (base) {
+			int n = bench_compare (base, results, threshold);
+			if (n > 0) {
+				eprintf ("%d benchmark%s slower than %s by more than %.0f%%\n",
+					n, n > 1? "s are": " is", baseline, threshold);
+				ret = 1;
+			}
+			free (base);
+		} else {
+			eprintf ("Cannot open %s\n", baseline);
+			ret = 1;
+		}
+	}
+	free (results);
+	return ret;
+}